@@ -0,0 +1,168 @@
+#include "AmbientLight.h"
+#include <Wire.h>
+#include <Firebase_ESP_Client.h>
+#include "DisplayHelpers.h"
+#include "DeviceRegistration.h"
+#include "Trace.h"
+#include "LoopScheduler.h"
+
+#define BH1750_ADDR 0x23
+#define BH1750_ADDR_ALT 0x5C
+#define BH1750_POWER_ON 0x01
+#define BH1750_CONT_HRES 0x10
+#define VEML7700_ADDR 0x10
+#define VEML7700_REG_CONF 0x00
+#define VEML7700_REG_ALS 0x04
+#define VEML7700_CONF 0x1800        // Gain x1/4, 100 ms integration, powered on
+#define VEML7700_LUX_PER_COUNT 0.2304f
+
+extern FirebaseData fbdo;
+
+AmbientLight ambientLight;
+
+static uint8_t levelToScale(float level) {
+  return (uint8_t)constrain(lroundf(level * 25.5f), 25, 255);
+}
+
+void BrightnessController::configure(int minLevel, int maxLevel) {
+  this->minLevel = constrain(minLevel, 1, 10);
+  this->maxLevel = constrain(maxLevel, this->minLevel, 10);
+}
+
+uint8_t BrightnessController::update(float lux) {
+  float logLux = log10f(max(lux, 0.01f));
+  if (!primed) {
+    filteredLog = logLux;
+  } else {
+    filteredLog += AMBIENT_FILTER_ALPHA * (logLux - filteredLog);
+  }
+
+  // Perceived brightness is roughly logarithmic, so map log-lux linearly onto the level range
+  const float darkLog = log10f(AMBIENT_DARK_LUX);
+  const float brightLog = log10f(AMBIENT_BRIGHT_LUX);
+  float t = constrain((filteredLog - darkLog) / (brightLog - darkLog), 0.0f, 1.0f);
+  float target = minLevel + t * (maxLevel - minLevel);
+
+  if (!primed || fabsf(target - appliedLevel) >= AMBIENT_HYSTERESIS ||
+      target <= minLevel || target >= maxLevel) {
+    appliedLevel = target;
+  }
+  primed = true;
+  return levelToScale(appliedLevel);
+}
+
+static bool probe(uint8_t addr) {
+  Wire.beginTransmission(addr);
+  return Wire.endTransmission() == 0;
+}
+
+void AmbientLight::begin() {
+  if (probe(VEML7700_ADDR)) {
+    sensor = AmbientSensor::VEML7700;
+    address = VEML7700_ADDR;
+    Wire.beginTransmission(address);
+    Wire.write(VEML7700_REG_CONF);
+    Wire.write(VEML7700_CONF & 0xFF);
+    Wire.write(VEML7700_CONF >> 8);
+    Wire.endTransmission();
+  } else if (probe(BH1750_ADDR) || probe(BH1750_ADDR_ALT)) {
+    sensor = AmbientSensor::BH1750;
+    address = probe(BH1750_ADDR) ? BH1750_ADDR : BH1750_ADDR_ALT;
+    Wire.beginTransmission(address);
+    Wire.write(BH1750_POWER_ON);
+    Wire.endTransmission();
+    Wire.beginTransmission(address);
+    Wire.write(BH1750_CONT_HRES);
+    Wire.endTransmission();
+  }
+
+  if (sensor == AmbientSensor::NONE) {
+    Serial.println("🔆 No ambient light sensor — brightness stays manual");
+  } else {
+    Serial.printf("🔆 Ambient light sensor: %s at 0x%02X\n",
+                  sensor == AmbientSensor::VEML7700 ? "VEML7700" : "BH1750", address);
+  }
+}
+
+bool AmbientLight::readLux(float& lux) {
+  if (sensor == AmbientSensor::VEML7700) {
+    Wire.beginTransmission(address);
+    Wire.write(VEML7700_REG_ALS);
+    if (Wire.endTransmission(false) != 0 || Wire.requestFrom(address, (uint8_t)2) != 2) return false;
+    uint16_t raw = Wire.read() | (Wire.read() << 8);
+    lux = raw * VEML7700_LUX_PER_COUNT;
+    return true;
+  }
+  if (sensor == AmbientSensor::BH1750) {
+    if (Wire.requestFrom(address, (uint8_t)2) != 2) return false;
+    uint16_t raw = (Wire.read() << 8) | Wire.read();
+    lux = raw / 1.2f;
+    return true;
+  }
+  return false;
+}
+
+// The setting's value, `missing` when the node doesn't exist, or `current` when the read failed
+static int readSettingInt(SettingsField field, int missing, int current) {
+  Tracer::countRequest(Endpoint::RTDB);
+  if (Firebase.RTDB.getInt(&fbdo, getSettingsPath(field))) return fbdo.intData();
+  return fbdo.errorReason() == "path not exist" ? missing : current;
+}
+
+static bool readSettingBool(SettingsField field, bool missing, bool current) {
+  Tracer::countRequest(Endpoint::RTDB);
+  if (Firebase.RTDB.getBool(&fbdo, getSettingsPath(field))) return fbdo.boolData();
+  return fbdo.errorReason() == "path not exist" ? missing : current;
+}
+
+// autoBrightness (bool) and brightnessMin/brightnessMax (1–10) live in the device settings. A read
+// that fails for any other reason than a missing node keeps what is in force.
+void AmbientLight::pollSettings() {
+  unsigned long now = millis();
+  if (lastSettingsPoll != 0 && now - lastSettingsPoll < AMBIENT_SETTINGS_POLL_MS) return;
+  lastSettingsPoll = now;
+  if (!Firebase.ready() || getMacId()[0] == '\0') return;
+
+  bool wasEnabled = enabled;
+  {
+    TRACE_SCOPE(NETWORK);
+    FrameUnlocked unlocked;
+    enabled = readSettingBool(SettingsField::AUTO_BRIGHTNESS, false, enabled);
+    minLevel = readSettingInt(SettingsField::BRIGHTNESS_MIN, 1, minLevel);
+    maxLevel = readSettingInt(SettingsField::BRIGHTNESS_MAX, 10, maxLevel);
+  }
+  controller.configure(minLevel, maxLevel);
+
+  if (enabled != wasEnabled) {
+    Serial.printf("🔆 Auto-brightness %s (levels %d–%d)\n", enabled ? "on" : "off", minLevel, maxLevel);
+    if (enabled) {
+      controller.reset();
+    } else {
+      setBrightnessScale(brightnessLevelToScale(brightnessLevel));  // Back to the manual level
+    }
+  }
+}
+
+void AmbientLight::update() {
+  if (sensor == AmbientSensor::NONE) return;
+  pollSettings();
+  if (!enabled) return;
+
+  unsigned long now = millis();
+  if (now - lastSample < AMBIENT_SAMPLE_MS) return;
+  lastSample = now;
+
+  float lux;
+  if (!readLux(lux)) return;
+  setBrightnessScale(controller.update(lux));
+}
+
+bool AmbientLight::isActive() const {
+  return sensor != AmbientSensor::NONE && enabled;
+}
+
+unsigned long AmbientLight::msUntilNextSample() const {
+  if (!isActive()) return LOOP_MAX_IDLE_MS;
+  unsigned long elapsed = millis() - lastSample;
+  return elapsed >= AMBIENT_SAMPLE_MS ? 0 : AMBIENT_SAMPLE_MS - elapsed;
+}
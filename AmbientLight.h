@@ -0,0 +1,54 @@
+// AmbientLight.h
+#pragma once
+
+#include <Arduino.h>
+
+#define AMBIENT_SAMPLE_MS 1000           // Sensor read cadence
+#define AMBIENT_SETTINGS_POLL_MS 60000UL // autoBrightness / brightnessMin / brightnessMax
+#define AMBIENT_DARK_LUX 2.0f            // At or below this the panel sits at brightnessMin
+#define AMBIENT_BRIGHT_LUX 1000.0f       // At or above this it sits at brightnessMax
+#define AMBIENT_FILTER_ALPHA 0.2f        // EMA weight of a new sample (in log-lux)
+#define AMBIENT_HYSTERESIS 0.5f          // Levels the target must move before we follow
+
+// Pure control loop: lux in, brightness scale out. No I²C or Firebase, so it can be
+// driven from a recorded or simulated lux trace.
+class BrightnessController {
+public:
+  void configure(int minLevel, int maxLevel);  // 1–10, the same units as the manual setting
+  uint8_t update(float lux);                   // Returns the brightness scale (0–255) to apply
+  void reset() { primed = false; }
+
+  float getFilteredLux() const { return primed ? powf(10.0f, filteredLog) : 0; }
+
+private:
+  int minLevel = 1;
+  int maxLevel = 10;
+  bool primed = false;
+  float filteredLog = 0;
+  float appliedLevel = 0;
+};
+
+enum class AmbientSensor : uint8_t { NONE, BH1750, VEML7700 };
+
+class AmbientLight {
+public:
+  void begin();                 // Probes the I²C bus; harmless when no sensor is fitted
+  void update();                // Once per loop pass: sample, filter, apply
+  bool isActive() const;        // Sensor present and autoBrightness enabled in settings
+  unsigned long msUntilNextSample() const;
+
+private:
+  bool readLux(float& lux);
+  void pollSettings();
+
+  AmbientSensor sensor = AmbientSensor::NONE;
+  uint8_t address = 0;
+  BrightnessController controller;
+  bool enabled = false;
+  int minLevel = 1;
+  int maxLevel = 10;
+  unsigned long lastSample = 0;
+  unsigned long lastSettingsPoll = 0;
+};
+
+extern AmbientLight ambientLight;
@@ -3,18 +3,40 @@
 #include <Firebase_ESP_Client.h>
 #include "DeviceRegistration.h"
 #include "TimeCache.h"
-#include <map>
+#include "RemoteConfigManager.h"
+#include "Trace.h"
+#include "FrameKernels.h"
+#include "StreamReceiver.h"
+#include "LoopScheduler.h"
 #include <vector>
 #include <ArduinoJson.h>
 
 extern FirebaseData fbdo;
 extern FirebaseAuth auth;
 extern FirebaseConfig config;
-extern std::map<String, BaseApp*> appRegistry;
 extern String deviceID;
 extern TimeCache timeCache;
 extern AppManager appManager;
 
+void AppManager::toAppIds(const std::vector<String>& names, std::vector<AppId>& ids) {
+  ids.clear();
+  for (const auto& app : names) {
+    AppId id = AppRegistry::findId(app.c_str());
+    if (id != AppId::NONE) {
+      ids.push_back(id);
+    } else {
+      Serial.println("⚠️ Skipping unregistered or empty app ID: " + app);
+    }
+  }
+}
+
+void AppManager::toAppNames(const std::vector<AppId>& ids, std::vector<String>& names) {
+  names.clear();
+  for (AppId id : ids) {
+    names.push_back(AppRegistry::getName(id));
+  }
+}
+
 void AppManager::init() {
   std::vector<String> loadedApps;
   if (!getEnabledAppsFromFirebase(loadedApps, true)) {
@@ -22,30 +44,28 @@ void AppManager::init() {
     loadedApps.push_back("clock");
   }
 
-  std::vector<String> validApps;
-  for (const auto& app : loadedApps) {
-    if (app.length() > 0 && appRegistry.count(app)) {
-      validApps.push_back(app);
-    } else {
-      Serial.println("⚠️ Skipping invalid app ID: " + app);
-    }
-  }
+  std::vector<AppId> validApps;
+  toAppIds(loadedApps, validApps);
 
   if (validApps.empty()) {
-    validApps.push_back("clock");
+    validApps.push_back(AppId::clock);
     Serial.println("⚠️ No valid apps. Using fallback: clock");
   }
 
   std::vector<String> currentSequence;
+  std::vector<String> validNames;
   fetchAppSequenceFromFirebase(currentSequence, true);
+  toAppNames(validApps, validNames);
 
-  if (currentSequence != validApps) {
+  if (currentSequence != validNames) {
     Serial.println("🔁 Detected mismatch or missing appSequence. Updating Firebase...");
-    setAppSequenceToFirebase(validApps);
+    setAppSequenceToFirebase(validNames);
   }
 
   enabledApps = validApps;
   currentIndex = 0;
+  preloadedIndex = -1;
+  preloadAttempted = false;
   loadApp(enabledApps[currentIndex]);
   lastSwitchTime = millis();
 }
@@ -53,7 +73,24 @@ void AppManager::init() {
 void AppManager::loop() {
   unsigned long now = millis();
 
-  if (enabledApps.size() >= 2 && now - lastSwitchTime >= appDuration) {
+  // A live LAN stream takes over the panel; the rotation resumes where it left off once it stops
+  if (streamReceiver.isLive() != streaming) {
+    streaming = !streaming;
+    Serial.println(streaming ? "📡 Stream started — pausing rotation" : "📡 Stream stopped — resuming rotation");
+    preloadedIndex = -1;
+    preloadAttempted = false;
+    AppId target = streaming ? AppId::stream : enabledApps[currentIndex];
+    if (target != currentAppId) loadApp(target);
+    lastSwitchTime = now;
+  }
+
+  // Preload a little before the deadline so the switch itself is just a buffer swap
+  unsigned long lead = min(RemoteConfigManager::getDurationMs(ConfigKey::PRELOAD_LEAD_SEC), appDuration / 2);
+  if (!streaming && enabledApps.size() >= 2 && !preloadAttempted && now - lastSwitchTime >= appDuration - lead) {
+    preloadNextApp();
+  }
+
+  if (!streaming && enabledApps.size() >= 2 && now - lastSwitchTime >= appDuration) {
     Serial.println("⏭️ Switching to next app...");
     nextApp();
     lastSwitchTime = now;
@@ -61,9 +98,13 @@ void AppManager::loop() {
 
   if (currentApp) {
     timeCache.updateIfNeeded();
-    currentApp->loop();
+    {
+      TRACE_SCOPE(APP_LOOP);
+      currentApp->loop();
+    }
 
     if (currentApp->getNeedsRedraw()) {
+      TRACE_SCOPE(REDRAW);
       currentApp->redraw(true);
       currentApp->setNeedsRedraw(false);
     }
@@ -71,8 +112,6 @@ void AppManager::loop() {
     Serial.println("❌ currentApp is NULL");
   }
 
-  static unsigned long lastPoll = 0;
-  static unsigned long pollInterval = 30000;  // Start at 30 seconds
   static int failureCount = 0;
   const unsigned long maxPollInterval = 5 * 60 * 1000;  // Cap at 5 mins
 
@@ -86,37 +125,39 @@ void AppManager::loop() {
       return;
     }
 
-    std::vector<String> updatedApps;
-    if (getEnabledAppsFromFirebase(updatedApps, true)) {
+    bool fetched;
+    {
+      TRACE_SCOPE(NETWORK);
+      FrameUnlocked unlocked;  // A gesture may switch apps meanwhile; nothing below relies on the old one
+      fetched = getEnabledAppsFromFirebase(polledApps, true);
+    }
+    if (fetched) {
       failureCount = 0;
       pollInterval = 30000;  // Reset interval on success
 
-      std::vector<String> validApps;
-      for (const auto& app : updatedApps) {
-        if (app.length() > 0 && appRegistry.count(app)) {
-          validApps.push_back(app);
-        } else {
-          Serial.println("⚠️ Skipping unregistered or empty app ID: " + app);
-        }
-      }
+      toAppIds(polledApps, polledIds);
 
-      if (validApps != enabledApps) {
+      if (polledIds != enabledApps) {
         Serial.println("🔁 Firebase appSequence changed. Reloading apps.");
-        enabledApps = validApps;
+        enabledApps = polledIds;
 
         if (enabledApps.empty()) {
-          enabledApps.push_back("clock");
+          enabledApps.push_back(AppId::clock);
           Serial.println("⚠️ No valid apps after update. Using fallback: clock.");
         }
 
         currentIndex = 0;
-        loadApp(enabledApps[currentIndex]);
+        preloadedIndex = -1;
+        preloadAttempted = false;
+        if (!streaming) loadApp(enabledApps[currentIndex]);  // Otherwise picked up when the stream ends
         lastSwitchTime = now;
         if (!Firebase.ready()) {
           Serial.println("⚠️ Firebase not ready. Skipping app sequence update.");
           return;
         }
-        setAppSequenceToFirebase(enabledApps);
+        std::vector<String> names;
+        toAppNames(enabledApps, names);
+        setAppSequenceToFirebase(names);
       }
     } else {
       failureCount++;
@@ -129,29 +170,134 @@ void AppManager::loop() {
 void AppManager::nextApp() {
   if (enabledApps.empty()) return;
   currentIndex = (currentIndex + 1) % enabledApps.size();
+
+  if (preloadedIndex != currentIndex) {
+    preloadedIndex = -1;
+    preloadAttempted = false;
+    loadApp(enabledApps[currentIndex]);
+    return;
+  }
+
+  // Already initialised and rendered — present the stored frame
+  unsigned long start = micros();
+  currentAppId = enabledApps[currentIndex];
+  currentApp = AppRegistry::get(currentAppId);
+  memcpy(matrix.getBuffer(), backBuffer, sizeof(backBuffer));
+  presentFrame();
+  currentApp->setNeedsRedraw(false);
+  preloadedIndex = -1;
+  preloadAttempted = false;
+  recordSwitch(start, enabledApps[currentIndex], true);
+}
+
+void AppManager::previousApp() {
+  if (enabledApps.empty()) return;
+  currentIndex = (currentIndex + enabledApps.size() - 1) % enabledApps.size();
+  preloadedIndex = -1;
+  preloadAttempted = false;
   loadApp(enabledApps[currentIndex]);
 }
 
-void AppManager::loadApp(const String& appId) {
-  if (appId.length() == 0) {
-    Serial.println("⚠️ Ignoring empty app ID.");
+void AppManager::skipToNext() {
+  if (streaming || enabledApps.size() < 2) return;  // The stream owns the panel until it stops
+  Serial.println("⏭️ Button: next app");
+  nextApp();
+  lastSwitchTime = millis();
+}
+
+void AppManager::skipToPrevious() {
+  if (streaming || enabledApps.size() < 2) return;
+  Serial.println("⏮️ Button: previous app");
+  previousApp();
+  lastSwitchTime = millis();
+}
+
+bool AppManager::jumpTo(AppId appId) {
+  if (streaming) return false;
+  for (size_t i = 0; i < enabledApps.size(); i++) {
+    if (enabledApps[i] != appId) continue;
+    if ((int)i != currentIndex) {
+      currentIndex = i;
+      preloadedIndex = -1;
+      preloadAttempted = false;
+      loadApp(appId);
+    }
+    lastSwitchTime = millis();
+    return true;
+  }
+  return false;
+}
+
+void AppManager::preloadNextApp() {
+  int nextIndex = (currentIndex + 1) % enabledApps.size();
+  AppId appId = enabledApps[nextIndex];
+  BaseApp* next = AppRegistry::get(appId);
+  preloadAttempted = true;  // Once per rotation slot, even when there is nothing to render ahead
+  if (!next || next == currentApp) return;  // Same instance — nothing to render ahead
+
+  unsigned long start = micros();
+  BaseApp* shown = currentApp;
+  {
+    FrameUnlocked unlocked;  // prepare() may fetch; gestures shouldn't wait on it
+    next->prepare();
+  }
+  if (currentApp != shown || !preloadAttempted) return;  // A gesture switched apps meanwhile
+
+  // Render into the canvas without presenting, keep the result, then put the current frame back
+  memcpy(frontBuffer, matrix.getBuffer(), sizeof(frontBuffer));
+  holdPresent(true);
+  clearFrame();
+  next->init();
+  next->setNeedsRedraw(true);
+  next->redraw(true);
+  next->setNeedsRedraw(false);
+  holdPresent(false);
+  memcpy(backBuffer, matrix.getBuffer(), sizeof(backBuffer));
+  memcpy(matrix.getBuffer(), frontBuffer, sizeof(frontBuffer));
+
+  preloadedIndex = nextIndex;
+  Serial.printf("🎞️ Preloaded %s in %lu us\n", AppRegistry::getName(appId), micros() - start);
+}
+
+void AppManager::recordSwitch(unsigned long startMicros, AppId appId, bool preloaded) {
+  lastSwitchMicros = micros() - startMicros;
+  maxSwitchMicros = max(maxSwitchMicros, lastSwitchMicros);
+  Serial.printf("⏱️ Switched to %s in %lu us (%s, max %lu us)\n", AppRegistry::getName(appId), lastSwitchMicros,
+                preloaded ? "preloaded" : "cold", maxSwitchMicros);
+}
+
+void AppManager::loadApp(AppId appId) {
+  BaseApp* app = AppRegistry::get(appId);
+  if (!app) {
+    Serial.printf("❌ App not registered: %d\n", (int)appId);
     return;
   }
 
-  if (appRegistry.count(appId)) {
-    matrix.fillScreen(0);
-    matrix.show();
+  unsigned long start = micros();
+  clearFrame();
+  matrix.show();
 
-    currentApp = appRegistry[appId];
-    currentApp->init();
-    currentApp->setNeedsRedraw(true);
-    currentApp->redraw(true);
+  currentApp = app;
+  currentAppId = appId;
+  currentApp->prepare();
+  currentApp->init();
+  currentApp->setNeedsRedraw(true);
+  currentApp->redraw(true);
 
-    Serial.println("✅ App loaded and redrawn: " + appId);
-  } else {
-    Serial.print("❌ App not registered: ");
-    Serial.println(appId);
+  Serial.printf("✅ App loaded and redrawn: %s\n", AppRegistry::getName(appId));
+  recordSwitch(start, appId, false);
+}
+
+unsigned long AppManager::msUntilNextEvent() {
+  unsigned long now = millis();
+  unsigned long next = pollInterval - min(now - lastPoll, pollInterval);
+
+  if (!streaming && enabledApps.size() >= 2) {
+    unsigned long lead = min(RemoteConfigManager::getDurationMs(ConfigKey::PRELOAD_LEAD_SEC), appDuration / 2);
+    unsigned long deadline = preloadAttempted ? appDuration : appDuration - lead;
+    next = min(next, deadline - min(now - lastSwitchTime, deadline));
   }
+  return next;
 }
 
 BaseApp* AppManager::getActiveApp() {
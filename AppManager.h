@@ -3,6 +3,8 @@
 #include <Arduino.h>
 #include <vector>
 #include "BaseApp.h"
+#include "AppRegistry.h"
+#include "DisplayHelpers.h"
 
 class AppManager {
 public:
@@ -10,14 +12,42 @@ public:
   void loop();          // Handle app switching and rendering
 
   BaseApp* getActiveApp();  // Get the currently active app
+  AppId getActiveAppId() { return currentAppId; }
+  unsigned long msUntilNextEvent();  // Next preload/switch/poll deadline
+  void skipToNext();                 // Button: switch now and restart the rotation timer
+  void skipToPrevious();
+  bool jumpTo(AppId appId);          // LAN API: show an enabled app now; false if it isn't enabled
+  const std::vector<AppId>& getEnabledApps() const { return enabledApps; }
+  unsigned long getLastSwitchMicros() { return lastSwitchMicros; }
+  unsigned long getMaxSwitchMicros() { return maxSwitchMicros; }
 
 private:
   void nextApp();                   // Advance to next app in sequence
-  void loadApp(const String& appId); // Load app by ID
+  void previousApp();               // Step back one app (never preloaded, so always a cold load)
+  void loadApp(AppId appId);        // Load app by ID
+  void preloadNextApp();            // Warm data + render the next app's first frame off-screen
+  void recordSwitch(unsigned long startMicros, AppId appId, bool preloaded);
 
-  std::vector<String> enabledApps;  // App IDs from Firebase
+  static void toAppIds(const std::vector<String>& names, std::vector<AppId>& ids);
+  static void toAppNames(const std::vector<AppId>& ids, std::vector<String>& names);
+
+  std::vector<AppId> enabledApps;   // Registered apps in Firebase order
   int currentIndex = 0;
   unsigned long lastSwitchTime = 0;
+  unsigned long lastPoll = 0;
+  unsigned long pollInterval = 30000;  // Start at 30 seconds
   const unsigned long appDuration = 10000; // 10 seconds per app
   BaseApp* currentApp = nullptr;
+  AppId currentAppId = AppId::NONE;
+
+  // Off-screen first frame of the next app, swapped in at the switch deadline
+  int preloadedIndex = -1;
+  bool preloadAttempted = false;     // Set even when preloadNextApp() had nothing to do, so it isn't retried every pass
+  uint16_t backBuffer[PANEL_WIDTH * PANEL_HEIGHT];
+  uint16_t frontBuffer[PANEL_WIDTH * PANEL_HEIGHT];  // Current app's canvas, restored after preloading
+  bool streaming = false;            // Rotation paused while a LAN stream owns the panel
+  std::vector<String> polledApps;    // Poll scratch, kept so an unchanged poll reuses its capacity
+  std::vector<AppId> polledIds;
+  unsigned long lastSwitchMicros = 0;
+  unsigned long maxSwitchMicros = 0;
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "AppRegistry.h"
+#include <new>
+#include "ClockApp.h"
+#include "ClockWeatherApp.h"
+#include "WeatherApp.h"
+#include "ForecastApp.h"
+#include "SparklineApp.h"
+#include "StreamApp.h"
+#include "ClipApp.h"
+
+#define APP_ARENA_ALIGN 8
+#define APP_ALIGNED_SIZE(type) ((sizeof(type) + APP_ARENA_ALIGN - 1) & ~(size_t)(APP_ARENA_ALIGN - 1))
+
+static constexpr size_t APP_COUNT = (size_t)AppId::COUNT;
+
+static constexpr const char* APP_NAMES[APP_COUNT] = {
+#define APP_NAME(id, type) #id,
+  APP_REGISTRY(APP_NAME)
+#undef APP_NAME
+};
+
+// Room for every app at once; only enabled apps are ever placed here
+static constexpr size_t APP_ARENA_SIZE = 0
+#define APP_SIZE(id, type) + APP_ALIGNED_SIZE(type)
+  APP_REGISTRY(APP_SIZE)
+#undef APP_SIZE
+  ;
+
+typedef BaseApp* (*AppFactory)(void* slot);
+
+static const AppFactory APP_FACTORIES[APP_COUNT] = {
+#define APP_FACTORY(id, type) [](void* slot) -> BaseApp* { return new (slot) type(); },
+  APP_REGISTRY(APP_FACTORY)
+#undef APP_FACTORY
+};
+
+static const size_t APP_SIZES[APP_COUNT] = {
+#define APP_SIZE_ENTRY(id, type) APP_ALIGNED_SIZE(type),
+  APP_REGISTRY(APP_SIZE_ENTRY)
+#undef APP_SIZE_ENTRY
+};
+
+alignas(APP_ARENA_ALIGN) static uint8_t appArena[APP_ARENA_SIZE];
+static size_t arenaUsed = 0;
+static BaseApp* instances[APP_COUNT] = {};
+
+AppId AppRegistry::findId(const char* name) {
+  for (size_t i = 0; i < APP_COUNT; i++) {
+    if (strcmp(APP_NAMES[i], name) == 0) return (AppId)i;
+  }
+  return AppId::NONE;
+}
+
+const char* AppRegistry::getName(AppId id) {
+  return (size_t)id < APP_COUNT ? APP_NAMES[(size_t)id] : "";
+}
+
+BaseApp* AppRegistry::get(AppId id) {
+  size_t i = (size_t)id;
+  if (i >= APP_COUNT) return nullptr;
+
+  if (!instances[i]) {
+    instances[i] = APP_FACTORIES[i](appArena + arenaUsed);
+    arenaUsed += APP_SIZES[i];
+    Serial.printf("🧩 Constructed app %s (%u/%u arena bytes)\n", APP_NAMES[i],
+                  (unsigned)arenaUsed, (unsigned)APP_ARENA_SIZE);
+  }
+  return instances[i];
+}
+
+bool AppRegistry::isConstructed(AppId id) {
+  return (size_t)id < APP_COUNT && instances[(size_t)id] != nullptr;
+}
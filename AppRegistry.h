@@ -0,0 +1,32 @@
+// AppRegistry.h
+#pragma once
+
+#include <Arduino.h>
+#include "BaseApp.h"
+
+// Every app the firmware ships: X(id, class). Registering an app is one line here
+// plus its header include in AppRegistry.cpp. The id doubles as the Firebase app name.
+#define APP_REGISTRY(X) \
+  X(clock,        ClockApp) \
+  X(clockWeather, ClockWeatherApp) \
+  X(weather,      WeatherApp) \
+  X(forecast,     ForecastApp) \
+  X(sparkline,    SparklineApp) \
+  X(stream,       StreamApp) \
+  X(clip,         ClipApp)
+
+enum class AppId : uint8_t {
+#define APP_ID_ENUM(id, type) id,
+  APP_REGISTRY(APP_ID_ENUM)
+#undef APP_ID_ENUM
+  COUNT,
+  NONE = 0xFF
+};
+
+class AppRegistry {
+public:
+  static AppId findId(const char* name);  // AppId::NONE if not registered
+  static const char* getName(AppId id);
+  static BaseApp* get(AppId id);          // Constructs the app in the arena on first use
+  static bool isConstructed(AppId id);
+};
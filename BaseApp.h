@@ -2,14 +2,17 @@
 #pragma once
 
 #include <Arduino.h>
+#include "LoopScheduler.h"
 
 class BaseApp {
 public:
+    virtual void prepare() {}          // Warm data dependencies ahead of the first frame
     virtual void init() = 0;
     virtual void loop() = 0;
     virtual void redraw(bool force = false, int xOffset = 0) = 0;
     virtual void setNeedsRedraw(bool flag) = 0;
     virtual bool getNeedsRedraw() = 0;
+    virtual unsigned long getNextUpdateMs() { return LOOP_DEFAULT_TICK_MS; }  // How long loop() may be skipped
     virtual ~BaseApp() {}
     virtual String getAppId() = 0;
 };
\ No newline at end of file
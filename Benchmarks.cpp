@@ -0,0 +1,254 @@
+#include "Benchmarks.h"
+
+#if NOVAFRAME_BENCH
+
+#include <vector>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include "DisplayHelpers.h"
+#include "WeatherIcons.h"
+#include "WeatherCache.h"
+#include "TimeCache.h"
+#include "FirebaseHelper.h"
+#include "AppRegistry.h"
+#include "FrameKernels.h"
+
+extern TimeCache timeCache;
+
+// Recorded One Call 3.0 response (48 hourly, 8 daily entries), trimmed only of "minutely"
+static const char ONE_CALL_SAMPLE[] = R"json(
+{"lat":43.6532,"lon":-79.3832,"timezone":"America/Toronto","timezone_offset":-14400,
+"current":{"dt":1760000400,"sunrise":1759980400,"sunset":1760020400,"temp":12.34,"feels_like":11.02,"pressure":1018,"humidity":71,"dew_point":7.1,"uvi":1.2,"clouds":40,"visibility":10000,"wind_speed":4.1,"wind_deg":250,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}]},
+"hourly":[
+{"dt":1760000400,"temp":11.58,"feels_like":10.48,"pressure":1018,"humidity":59,"dew_point":7.3,"uvi":0.4,"clouds":50,"visibility":10000,"wind_speed":5.56,"wind_deg":37,"wind_gust":10.21,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"pop":0.37},
+{"dt":1760004000,"temp":10.52,"feels_like":9.42,"pressure":1018,"humidity":82,"dew_point":7.3,"uvi":0.4,"clouds":27,"visibility":10000,"wind_speed":1.26,"wind_deg":222,"wind_gust":6.18,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.09},
+{"dt":1760007600,"temp":10.34,"feels_like":9.24,"pressure":1018,"humidity":86,"dew_point":7.3,"uvi":0.4,"clouds":15,"visibility":10000,"wind_speed":7.63,"wind_deg":322,"wind_gust":8.27,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.58},
+{"dt":1760011200,"temp":10.09,"feels_like":8.99,"pressure":1018,"humidity":64,"dew_point":7.3,"uvi":0.4,"clouds":5,"visibility":10000,"wind_speed":4.9,"wind_deg":68,"wind_gust":4.9,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"pop":0.54},
+{"dt":1760014800,"temp":10.26,"feels_like":9.16,"pressure":1018,"humidity":85,"dew_point":7.3,"uvi":0.4,"clouds":87,"visibility":10000,"wind_speed":2.27,"wind_deg":297,"wind_gust":7.71,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.37},
+{"dt":1760018400,"temp":10.37,"feels_like":9.27,"pressure":1018,"humidity":54,"dew_point":7.3,"uvi":0.4,"clouds":72,"visibility":10000,"wind_speed":1.42,"wind_deg":105,"wind_gust":6.96,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10n"}],"pop":0.43},
+{"dt":1760022000,"temp":9.93,"feels_like":8.83,"pressure":1018,"humidity":87,"dew_point":7.3,"uvi":0.4,"clouds":58,"visibility":10000,"wind_speed":3.53,"wind_deg":127,"wind_gust":9.94,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.08},
+{"dt":1760025600,"temp":9.45,"feels_like":8.35,"pressure":1018,"humidity":81,"dew_point":7.3,"uvi":0.4,"clouds":43,"visibility":10000,"wind_speed":6.11,"wind_deg":147,"wind_gust":8.09,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"pop":0.12},
+{"dt":1760029200,"temp":9.25,"feels_like":8.15,"pressure":1018,"humidity":71,"dew_point":7.3,"uvi":0.4,"clouds":19,"visibility":10000,"wind_speed":7.53,"wind_deg":215,"wind_gust":2.39,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"pop":0.76},
+{"dt":1760032800,"temp":9.43,"feels_like":8.33,"pressure":1018,"humidity":70,"dew_point":7.3,"uvi":0.4,"clouds":43,"visibility":10000,"wind_speed":5.87,"wind_deg":304,"wind_gust":6.97,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04n"}],"pop":0.07},
+{"dt":1760036400,"temp":8.45,"feels_like":7.35,"pressure":1018,"humidity":67,"dew_point":7.3,"uvi":0.4,"clouds":60,"visibility":10000,"wind_speed":5.88,"wind_deg":33,"wind_gust":2.61,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10d"}],"pop":0.65},
+{"dt":1760040000,"temp":9.63,"feels_like":8.53,"pressure":1018,"humidity":78,"dew_point":7.3,"uvi":0.4,"clouds":36,"visibility":10000,"wind_speed":6.02,"wind_deg":342,"wind_gust":5.47,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04n"}],"pop":0.36},
+{"dt":1760043600,"temp":9.9,"feels_like":8.8,"pressure":1018,"humidity":81,"dew_point":7.3,"uvi":0.4,"clouds":7,"visibility":10000,"wind_speed":2.53,"wind_deg":147,"wind_gust":3.29,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.4},
+{"dt":1760047200,"temp":10.9,"feels_like":9.8,"pressure":1018,"humidity":81,"dew_point":7.3,"uvi":0.4,"clouds":10,"visibility":10000,"wind_speed":2.16,"wind_deg":205,"wind_gust":7.49,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"pop":0.82},
+{"dt":1760050800,"temp":11.77,"feels_like":10.67,"pressure":1018,"humidity":67,"dew_point":7.3,"uvi":0.4,"clouds":90,"visibility":10000,"wind_speed":3.91,"wind_deg":183,"wind_gust":8.83,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02n"}],"pop":0.96},
+{"dt":1760054400,"temp":10.94,"feels_like":9.84,"pressure":1018,"humidity":61,"dew_point":7.3,"uvi":0.4,"clouds":19,"visibility":10000,"wind_speed":2.62,"wind_deg":119,"wind_gust":2.12,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"pop":0.26},
+{"dt":1760058000,"temp":9.75,"feels_like":8.65,"pressure":1018,"humidity":76,"dew_point":7.3,"uvi":0.4,"clouds":68,"visibility":10000,"wind_speed":3.58,"wind_deg":289,"wind_gust":5.19,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"pop":0.69},
+{"dt":1760061600,"temp":9.78,"feels_like":8.68,"pressure":1018,"humidity":89,"dew_point":7.3,"uvi":0.4,"clouds":83,"visibility":10000,"wind_speed":5.73,"wind_deg":27,"wind_gust":6.57,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10n"}],"pop":0.39},
+{"dt":1760065200,"temp":9.54,"feels_like":8.44,"pressure":1018,"humidity":56,"dew_point":7.3,"uvi":0.4,"clouds":61,"visibility":10000,"wind_speed":5.44,"wind_deg":31,"wind_gust":3.91,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.44},
+{"dt":1760068800,"temp":8.6,"feels_like":7.5,"pressure":1018,"humidity":88,"dew_point":7.3,"uvi":0.4,"clouds":6,"visibility":10000,"wind_speed":1.72,"wind_deg":290,"wind_gust":3.51,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"pop":0.95},
+{"dt":1760072400,"temp":8.88,"feels_like":7.78,"pressure":1018,"humidity":54,"dew_point":7.3,"uvi":0.4,"clouds":26,"visibility":10000,"wind_speed":5.3,"wind_deg":76,"wind_gust":8.34,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"pop":0.6},
+{"dt":1760076000,"temp":8.82,"feels_like":7.72,"pressure":1018,"humidity":57,"dew_point":7.3,"uvi":0.4,"clouds":62,"visibility":10000,"wind_speed":7.95,"wind_deg":238,"wind_gust":6.8,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10d"}],"pop":0.09},
+{"dt":1760079600,"temp":7.86,"feels_like":6.76,"pressure":1018,"humidity":71,"dew_point":7.3,"uvi":0.4,"clouds":94,"visibility":10000,"wind_speed":2.85,"wind_deg":354,"wind_gust":3.61,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.21},
+{"dt":1760083200,"temp":8.95,"feels_like":7.85,"pressure":1018,"humidity":73,"dew_point":7.3,"uvi":0.4,"clouds":18,"visibility":10000,"wind_speed":5.83,"wind_deg":13,"wind_gust":9.58,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10d"}],"pop":0.98},
+{"dt":1760086800,"temp":9.82,"feels_like":8.72,"pressure":1018,"humidity":94,"dew_point":7.3,"uvi":0.4,"clouds":33,"visibility":10000,"wind_speed":4.63,"wind_deg":85,"wind_gust":5.56,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.53},
+{"dt":1760090400,"temp":10.49,"feels_like":9.39,"pressure":1018,"humidity":71,"dew_point":7.3,"uvi":0.4,"clouds":81,"visibility":10000,"wind_speed":2.56,"wind_deg":99,"wind_gust":10.06,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02n"}],"pop":0.74},
+{"dt":1760094000,"temp":9.83,"feels_like":8.73,"pressure":1018,"humidity":83,"dew_point":7.3,"uvi":0.4,"clouds":63,"visibility":10000,"wind_speed":3.49,"wind_deg":14,"wind_gust":11.9,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10d"}],"pop":0.47},
+{"dt":1760097600,"temp":9.1,"feels_like":8.0,"pressure":1018,"humidity":88,"dew_point":7.3,"uvi":0.4,"clouds":44,"visibility":10000,"wind_speed":4.13,"wind_deg":178,"wind_gust":11.55,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"pop":0.08},
+{"dt":1760101200,"temp":8.14,"feels_like":7.04,"pressure":1018,"humidity":80,"dew_point":7.3,"uvi":0.4,"clouds":25,"visibility":10000,"wind_speed":3.36,"wind_deg":247,"wind_gust":8.24,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.48},
+{"dt":1760104800,"temp":8.51,"feels_like":7.41,"pressure":1018,"humidity":91,"dew_point":7.3,"uvi":0.4,"clouds":10,"visibility":10000,"wind_speed":6.84,"wind_deg":61,"wind_gust":11.1,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.48},
+{"dt":1760108400,"temp":7.74,"feels_like":6.64,"pressure":1018,"humidity":90,"dew_point":7.3,"uvi":0.4,"clouds":42,"visibility":10000,"wind_speed":1.61,"wind_deg":202,"wind_gust":6.63,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"pop":0.72},
+{"dt":1760112000,"temp":6.94,"feels_like":5.84,"pressure":1018,"humidity":58,"dew_point":7.3,"uvi":0.4,"clouds":3,"visibility":10000,"wind_speed":2.06,"wind_deg":238,"wind_gust":10.07,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"pop":0.61},
+{"dt":1760115600,"temp":7.17,"feels_like":6.07,"pressure":1018,"humidity":80,"dew_point":7.3,"uvi":0.4,"clouds":84,"visibility":10000,"wind_speed":7.56,"wind_deg":79,"wind_gust":7.49,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"pop":0.02},
+{"dt":1760119200,"temp":7.89,"feels_like":6.79,"pressure":1018,"humidity":91,"dew_point":7.3,"uvi":0.4,"clouds":13,"visibility":10000,"wind_speed":4.69,"wind_deg":71,"wind_gust":6.34,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.83},
+{"dt":1760122800,"temp":7.2,"feels_like":6.1,"pressure":1018,"humidity":66,"dew_point":7.3,"uvi":0.4,"clouds":27,"visibility":10000,"wind_speed":3.05,"wind_deg":123,"wind_gust":9.64,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"pop":0.26},
+{"dt":1760126400,"temp":7.01,"feels_like":5.91,"pressure":1018,"humidity":58,"dew_point":7.3,"uvi":0.4,"clouds":7,"visibility":10000,"wind_speed":7.37,"wind_deg":181,"wind_gust":10.98,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10n"}],"pop":0.42},
+{"dt":1760130000,"temp":8.01,"feels_like":6.91,"pressure":1018,"humidity":82,"dew_point":7.3,"uvi":0.4,"clouds":16,"visibility":10000,"wind_speed":4.72,"wind_deg":268,"wind_gust":7.11,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04n"}],"pop":0.78},
+{"dt":1760133600,"temp":8.27,"feels_like":7.17,"pressure":1018,"humidity":59,"dew_point":7.3,"uvi":0.4,"clouds":22,"visibility":10000,"wind_speed":1.99,"wind_deg":316,"wind_gust":9.25,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10n"}],"pop":0.06},
+{"dt":1760137200,"temp":8.71,"feels_like":7.61,"pressure":1018,"humidity":83,"dew_point":7.3,"uvi":0.4,"clouds":71,"visibility":10000,"wind_speed":4.38,"wind_deg":54,"wind_gust":10.83,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.25},
+{"dt":1760140800,"temp":8.17,"feels_like":7.07,"pressure":1018,"humidity":56,"dew_point":7.3,"uvi":0.4,"clouds":64,"visibility":10000,"wind_speed":4.17,"wind_deg":14,"wind_gust":9.6,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"pop":0.44},
+{"dt":1760144400,"temp":8.44,"feels_like":7.34,"pressure":1018,"humidity":82,"dew_point":7.3,"uvi":0.4,"clouds":77,"visibility":10000,"wind_speed":4.59,"wind_deg":354,"wind_gust":4.77,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10n"}],"pop":0.53},
+{"dt":1760148000,"temp":8.39,"feels_like":7.29,"pressure":1018,"humidity":65,"dew_point":7.3,"uvi":0.4,"clouds":89,"visibility":10000,"wind_speed":4.66,"wind_deg":132,"wind_gust":11.23,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.84},
+{"dt":1760151600,"temp":7.52,"feels_like":6.42,"pressure":1018,"humidity":57,"dew_point":7.3,"uvi":0.4,"clouds":50,"visibility":10000,"wind_speed":4.09,"wind_deg":37,"wind_gust":8.71,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02n"}],"pop":0.07},
+{"dt":1760155200,"temp":7.92,"feels_like":6.82,"pressure":1018,"humidity":57,"dew_point":7.3,"uvi":0.4,"clouds":99,"visibility":10000,"wind_speed":2.08,"wind_deg":329,"wind_gust":8.6,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"pop":0.25},
+{"dt":1760158800,"temp":7.05,"feels_like":5.95,"pressure":1018,"humidity":79,"dew_point":7.3,"uvi":0.4,"clouds":28,"visibility":10000,"wind_speed":6.23,"wind_deg":48,"wind_gust":5.98,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04n"}],"pop":0.16},
+{"dt":1760162400,"temp":7.46,"feels_like":6.36,"pressure":1018,"humidity":64,"dew_point":7.3,"uvi":0.4,"clouds":20,"visibility":10000,"wind_speed":5.94,"wind_deg":263,"wind_gust":6.04,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02n"}],"pop":0.2},
+{"dt":1760166000,"temp":7.02,"feels_like":5.92,"pressure":1018,"humidity":73,"dew_point":7.3,"uvi":0.4,"clouds":2,"visibility":10000,"wind_speed":3.37,"wind_deg":234,"wind_gust":6.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.38},
+{"dt":1760169600,"temp":7.06,"feels_like":5.96,"pressure":1018,"humidity":68,"dew_point":7.3,"uvi":0.4,"clouds":65,"visibility":10000,"wind_speed":7.73,"wind_deg":57,"wind_gust":11.85,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"04d"}],"pop":0.97}
+],"daily":[
+{"dt":1760000400,"sunrise":1759980400,"sunset":1760020400,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":6.31,"max":15.06,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"clouds":55,"pop":0.4,"uvi":2.1},
+{"dt":1760086800,"sunrise":1760066800,"sunset":1760106800,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":8.72,"max":14.73,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"clouds":55,"pop":0.4,"uvi":2.1},
+{"dt":1760173200,"sunrise":1760153200,"sunset":1760193200,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":8.46,"max":17.4,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10d"}],"clouds":55,"pop":0.4,"uvi":2.1},
+{"dt":1760259600,"sunrise":1760239600,"sunset":1760279600,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":7.22,"max":16.15,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"10n"}],"clouds":55,"pop":0.4,"uvi":2.1},
+{"dt":1760346000,"sunrise":1760326000,"sunset":1760366000,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":7.71,"max":16.8,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"clouds":55,"pop":0.4,"uvi":2.1},
+{"dt":1760432400,"sunrise":1760412400,"sunset":1760452400,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":6.84,"max":17.2,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"03d"}],"clouds":55,"pop":0.4,"uvi":2.1},
+{"dt":1760518800,"sunrise":1760498800,"sunset":1760538800,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":7.28,"max":14.29,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"clouds":55,"pop":0.4,"uvi":2.1},
+{"dt":1760605200,"sunrise":1760585200,"sunset":1760625200,"moon_phase":0.5,"summary":"Expect a day of partly cloudy with rain","temp":{"day":14.1,"min":7.9,"max":17.21,"night":8.2,"eve":11.0,"morn":7.5},"feels_like":{"day":13.2,"night":7.1,"eve":10.2,"morn":6.4},"pressure":1017,"humidity":66,"dew_point":6.9,"wind_speed":5.2,"wind_deg":240,"wind_gust":10.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"02d"}],"clouds":55,"pop":0.4,"uvi":2.1}
+]})json";
+
+// Recorded /novaFrame/devices/<id>/apps node
+static const char APPS_SAMPLE[] = R"json({
+"clock":{"enabled":true,"name":"Clock","order":0},
+"clockWeather":{"enabled":true,"name":"Clock + Weather","order":1},
+"forecast":{"enabled":true,"name":"Forecast","order":2},
+"sparkline":{"enabled":false,"name":"48h Trend","order":3},
+"weather":{"enabled":true,"name":"Weather","order":4}
+})json";
+
+struct Benchmark {
+  const char* name;
+  void (*run)();
+  uint32_t iterations;
+  uint32_t pixelsPerOp;  // For fill/blit kernels; 0 where throughput in pixels means nothing
+};
+
+static volatile uint32_t sink;  // Keeps results observable so the work isn't optimised away
+
+static void benchFormattedTime() {
+  String s = timeCache.getFormattedTime();
+  sink += s.length();
+}
+
+static void benchFormatTime() {
+  char buf[8];
+  sink += timeCache.formatTime(buf, sizeof(buf));
+}
+
+static void benchWeatherIcon() {
+  drawWeatherIcon(ICON_CLOUD, 0, 0);
+}
+
+static void benchClockWeatherRedraw() {
+  matrix.fillScreen(0);
+  AppRegistry::get(AppId::clockWeather)->redraw(true);
+}
+
+static void benchForecastRedraw() {
+  matrix.fillScreen(0);
+  AppRegistry::get(AppId::forecast)->redraw(true);
+}
+
+static void benchOneCallParse() {
+  sink += parseOneCallPayload(ONE_CALL_SAMPLE, sizeof(ONE_CALL_SAMPLE) - 1);
+}
+
+static void benchAppsParse() {
+  std::vector<String> apps;
+  parseEnabledApps(APPS_SAMPLE, apps);
+  sink += apps.size();
+}
+
+// Kernels next to the Adafruit_GFX calls they replace
+static void benchClearFrame() { clearFrame(); }
+static void benchGfxFillScreen() { matrix.fillScreen(0); }
+static void benchFillRect() { fillRectFast(3, 3, 40, 20, 0x1234); }
+static void benchGfxFillRect() { matrix.fillRect(3, 3, 40, 20, 0x1234); }
+static void benchSpanH() { fillSpanH(1, 10, 62, 0x1234); }
+static void benchSpanV() { fillSpanV(42, 0, 32, 0x1234); }
+static void benchGfxPixelColumn() {
+  for (int y = 0; y < 32; y++) matrix.drawPixel(42, y, 0x1234);
+}
+static void benchBlitMask() { drawWeatherIcon(ICON_CLOUD, 0, 0); }  // Now a blitMask call
+static void benchGfxBitmap() {
+  static const uint8_t pattern[128] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xF0, 0x0F, 0xF0 };
+  matrix.drawBitmap(0, 0, pattern, 32, 32, 0x1234);
+}
+
+static const Benchmark BENCHMARKS[] = {
+  { "getFormattedTime",        benchFormattedTime,      5000,  0 },
+  { "formatTime",              benchFormatTime,         5000,  0 },
+  { "drawWeatherIcon",         benchWeatherIcon,        1000,  0 },
+  { "ClockWeatherApp.redraw",  benchClockWeatherRedraw, 200,   0 },
+  { "ForecastApp.redraw",      benchForecastRedraw,     200,   0 },
+  { "parseOneCallPayload",     benchOneCallParse,       20,    0 },
+  { "parseEnabledApps",        benchAppsParse,          500,   0 },
+  { "clearFrame",              benchClearFrame,         2000,  Panel::pixels },
+  { "gfx.fillScreen",          benchGfxFillScreen,      2000,  Panel::pixels },
+  { "fillRectFast",            benchFillRect,           5000,  40 * 20 },
+  { "gfx.fillRect",            benchGfxFillRect,        5000,  40 * 20 },
+  { "fillSpanH",               benchSpanH,              20000, 62 },
+  { "fillSpanV",               benchSpanV,              20000, 32 },
+  { "gfx.drawPixel x32",       benchGfxPixelColumn,     20000, 32 },
+  { "blitMask 32x32",          benchBlitMask,           5000,  32 * 32 },
+  { "gfx.drawBitmap 32x32",    benchGfxBitmap,          5000,  32 * 32 },
+};
+
+// Every allocation inside the timed loop, counted by the IDF heap hooks (CONFIG_HEAP_USE_HOOKS).
+// Without them, the net change in live blocks/bytes is all there is: retained growth, not churn.
+#if CONFIG_HEAP_USE_HOOKS
+#define BENCH_HEAP_HOOKS 1
+
+static volatile bool countingAllocs = false;
+static uint32_t allocCount = 0;
+static uint64_t allocBytes = 0;
+
+void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+  if (!countingAllocs) return;
+  allocCount++;
+  allocBytes += size;
+}
+
+void esp_heap_trace_free_hook(void* ptr) {}
+
+static void beginHeapCount() {
+  allocCount = 0;
+  allocBytes = 0;
+  countingAllocs = true;
+}
+
+static void endHeapCount(double& allocs, double& bytes) {
+  countingAllocs = false;
+  allocs = allocCount;
+  bytes = (double)allocBytes;
+}
+#else
+#define BENCH_HEAP_HOOKS 0
+
+static size_t blocksBefore, bytesBefore;
+
+static void beginHeapCount() {
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  blocksBefore = info.allocated_blocks;
+  bytesBefore = info.total_allocated_bytes;
+}
+
+static void endHeapCount(double& allocs, double& bytes) {
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  allocs = (double)info.allocated_blocks - blocksBefore;
+  bytes = (double)info.total_allocated_bytes - bytesBefore;
+}
+#endif
+
+void runBenchmarks() {
+  Serial.println("⏱️ Running benchmarks...");
+  holdPresent(true);  // Measure rendering into the canvas, not the panel refresh
+
+  // Warm-up: fills weatherData/hourlyForecast and constructs the apps outside the timed loops
+  parseOneCallPayload(ONE_CALL_SAMPLE, sizeof(ONE_CALL_SAMPLE) - 1);
+  AppRegistry::get(AppId::clockWeather);
+  AppRegistry::get(AppId::forecast);
+
+  for (const Benchmark& b : BENCHMARKS) {
+    b.run();
+
+    double allocs, bytes;
+    beginHeapCount();
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < b.iterations; i++) b.run();
+    int64_t elapsed = esp_timer_get_time() - start;
+    endHeapCount(allocs, bytes);
+
+    double nsPerOp = elapsed * 1000.0 / b.iterations;
+    double pixelsPerUs = b.pixelsPerOp ? b.pixelsPerOp * 1000.0 / nsPerOp : 0;
+    Serial.printf("BENCH {\"name\":\"%s\",\"iterations\":%lu,\"ns_op\":%.1f,\"px_us\":%.1f,"
+                  "\"allocs_op\":%.3f,\"bytes_op\":%.1f,\"heap_hooks\":%s,\"cpu_mhz\":%lu}\n",
+                  b.name, (unsigned long)b.iterations, nsPerOp, pixelsPerUs,
+                  allocs / b.iterations, bytes / b.iterations, BENCH_HEAP_HOOKS ? "true" : "false",
+                  (unsigned long)getCpuFrequencyMhz());
+  }
+
+  holdPresent(false);
+  matrix.fillScreen(0);
+  Serial.println("BENCH_DONE");
+}
+
+#else
+
+void runBenchmarks() {}
+
+#endif
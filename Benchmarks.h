@@ -0,0 +1,12 @@
+// Benchmarks.h
+#pragma once
+
+#include <Arduino.h>
+
+// Set to 1 to run the hot-path benchmarks once at boot, right after the display comes up.
+// Results are printed as "BENCH {json}" lines; compare them with tools/bench_compare.py.
+#ifndef NOVAFRAME_BENCH
+#define NOVAFRAME_BENCH 0
+#endif
+
+void runBenchmarks();
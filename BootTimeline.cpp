@@ -0,0 +1,47 @@
+#include "BootTimeline.h"
+#include <Firebase_ESP_Client.h>
+
+static const char* const STAGE_NAMES[] = {
+#define X(id, name) name,
+  BOOT_STAGES(X)
+#undef X
+};
+
+unsigned long BootTimeline::startMs[(int)BootStage::COUNT] = {};
+unsigned long BootTimeline::endMs[(int)BootStage::COUNT] = {};
+unsigned long BootTimeline::firstFrameMs = 0;
+
+void BootTimeline::start(BootStage stage) {
+  startMs[(int)stage] = millis();
+}
+
+void BootTimeline::finish(BootStage stage) {
+  endMs[(int)stage] = millis();
+}
+
+void BootTimeline::markFirstFrame() {
+  if (firstFrameMs == 0) firstFrameMs = millis();
+}
+
+void BootTimeline::print() {
+  Serial.println("🚀 Boot timeline (ms since reset):");
+  for (int i = 0; i < (int)BootStage::COUNT; i++) {
+    if (endMs[i] == 0) {
+      Serial.printf("   %-9s %6lu – (not finished)\n", STAGE_NAMES[i], startMs[i]);
+      continue;
+    }
+    Serial.printf("   %-9s %6lu – %6lu  (%lu ms)\n", STAGE_NAMES[i], startMs[i], endMs[i], endMs[i] - startMs[i]);
+  }
+  Serial.printf("   first useful frame at %lu ms\n", firstFrameMs);
+}
+
+void BootTimeline::addTo(FirebaseJson& json) {
+  char key[32];
+  for (int i = 0; i < (int)BootStage::COUNT; i++) {
+    snprintf(key, sizeof(key), "boot/%s/start", STAGE_NAMES[i]);
+    json.set(key, (int)startMs[i]);
+    snprintf(key, sizeof(key), "boot/%s/end", STAGE_NAMES[i]);
+    json.set(key, (int)endMs[i]);
+  }
+  json.set("boot/firstFrameMs", (int)firstFrameMs);
+}
@@ -0,0 +1,40 @@
+// BootTimeline.h
+#pragma once
+
+#include <Arduino.h>
+
+class FirebaseJson;
+
+// setup() stages. Several overlap: Wi-Fi associates while the panel, secrets and splash come up.
+#define BOOT_STAGES(X)          \
+  X(PANEL,    "panel")          \
+  X(SECRETS,  "secrets")        \
+  X(WIFI,     "wifi")           \
+  X(FIREBASE, "firebase")       \
+  X(REGISTER, "register")       \
+  X(TIME,     "time")           \
+  X(APPS,     "apps")           \
+  X(WEATHER,  "weather")
+
+enum class BootStage : uint8_t {
+#define X(id, name) id,
+  BOOT_STAGES(X)
+#undef X
+  COUNT
+};
+
+class BootTimeline {
+public:
+  static void start(BootStage stage);
+  static void finish(BootStage stage);
+  static void markFirstFrame();          // First frame with real content, not the splash
+  static unsigned long getFirstFrameMs() { return firstFrameMs; }
+
+  static void print();                   // One line per stage, offsets from reset
+  static void addTo(FirebaseJson& json); // boot/<stage>/start|end and boot/firstFrameMs
+
+private:
+  static unsigned long startMs[(int)BootStage::COUNT];
+  static unsigned long endMs[(int)BootStage::COUNT];
+  static unsigned long firstFrameMs;
+};
@@ -0,0 +1,111 @@
+#include "ButtonInput.h"
+#include "LoopScheduler.h"
+
+struct ButtonEdge {
+  bool down;
+  uint32_t ms;
+};
+
+ButtonInput buttonInput;
+
+static QueueHandle_t edgeQueue = nullptr;
+static uint8_t buttonPin = 0;
+
+ButtonEvent GestureRecognizer::onEdge(bool down, unsigned long ms) {
+  if (hasEdge && ms - lastEdge < BUTTON_DEBOUNCE_MS) return ButtonEvent::NONE;
+  hasEdge = true;
+  lastEdge = ms;
+
+  // Catch up on any timeout that expired before this edge arrived
+  ButtonEvent timedOut = checkTimeouts(ms);
+
+  switch (state) {
+    case State::IDLE:
+      if (down) { state = State::DOWN; stateSince = ms; }
+      break;
+    case State::DOWN:
+      if (!down) { state = State::WAIT_SECOND; stateSince = ms; }
+      break;
+    case State::WAIT_SECOND:
+      if (down) { state = State::DOWN_SECOND; stateSince = ms; }
+      break;
+    case State::DOWN_SECOND:
+      if (!down) { state = State::IDLE; return ButtonEvent::DOUBLE_PRESS; }
+      break;
+    case State::LONG_HELD:
+      if (!down) state = State::IDLE;
+      break;
+  }
+  return timedOut;
+}
+
+ButtonEvent GestureRecognizer::onTick(bool down, unsigned long ms) {
+  ButtonEvent timedOut = checkTimeouts(ms);
+  if (timedOut != ButtonEvent::NONE) return timedOut;
+
+  // A tap shorter than the debounce window loses its release edge; resync once the pin has settled
+  if (hasEdge && ms - lastEdge >= BUTTON_DEBOUNCE_MS && down != isHeld()) return onEdge(down, ms);
+  return ButtonEvent::NONE;
+}
+
+ButtonEvent GestureRecognizer::checkTimeouts(unsigned long ms) {
+  unsigned long elapsed = ms - stateSince;
+  if (state == State::DOWN && elapsed >= BUTTON_LONG_PRESS_MS) {
+    state = State::LONG_HELD;
+    return ButtonEvent::LONG_PRESS;
+  }
+  if (state == State::WAIT_SECOND && elapsed >= BUTTON_DOUBLE_GAP_MS) {
+    state = State::IDLE;
+    return ButtonEvent::SHORT_PRESS;
+  }
+  return ButtonEvent::NONE;
+}
+
+unsigned long GestureRecognizer::msUntilTimeout(unsigned long ms) const {
+  unsigned long elapsed = ms - stateSince;
+  if (state == State::DOWN) return BUTTON_LONG_PRESS_MS - min(elapsed, (unsigned long)BUTTON_LONG_PRESS_MS);
+  if (state == State::WAIT_SECOND) return BUTTON_DOUBLE_GAP_MS - min(elapsed, (unsigned long)BUTTON_DOUBLE_GAP_MS);
+  return ULONG_MAX;
+}
+
+static void IRAM_ATTR onButtonEdge() {
+  ButtonEdge edge = { digitalRead(buttonPin) == LOW, (uint32_t)millis() };
+  BaseType_t woken = pdFALSE;
+  xQueueSendFromISR(edgeQueue, &edge, &woken);  // A full queue drops bounce, not gestures
+  if (woken) portYIELD_FROM_ISR();
+}
+
+void ButtonInput::begin(uint8_t pin, GestureHandler onGesture) {
+  buttonPin = pin;
+  handler = onGesture;
+  edgeQueue = xQueueCreate(BUTTON_EDGE_QUEUE, sizeof(ButtonEdge));
+  pinMode(pin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(pin), onButtonEdge, CHANGE);
+  xTaskCreatePinnedToCore(taskMain, "button", BUTTON_TASK_STACK, this, BUTTON_TASK_PRIORITY, nullptr, BUTTON_TASK_CORE);
+}
+
+void ButtonInput::taskMain(void* self) {
+  static_cast<ButtonInput*>(self)->run();
+}
+
+// Sleeps until the next edge or the recognizer's next deadline (long press, double-press window,
+// or a resync once a swallowed edge has settled)
+void ButtonInput::run() {
+  for (;;) {
+    unsigned long waitMs = recognizer.msUntilTimeout(millis());
+    if (recognizer.isHeld() != (digitalRead(buttonPin) == LOW)) waitMs = min(waitMs, (unsigned long)BUTTON_DEBOUNCE_MS);
+    ButtonEdge edge;
+    if (xQueueReceive(edgeQueue, &edge, waitMs == ULONG_MAX ? portMAX_DELAY : pdMS_TO_TICKS(waitMs)) == pdTRUE) {
+      dispatch(recognizer.onEdge(edge.down, edge.ms));
+    }
+    dispatch(recognizer.onTick(digitalRead(buttonPin) == LOW, millis()));
+  }
+}
+
+void ButtonInput::dispatch(ButtonEvent event) {
+  if (event == ButtonEvent::NONE || !handler) return;
+  lockFrame();
+  handler(event);
+  unlockFrame();
+  wakeMainLoop();  // The new app's deadlines replace the ones the loop is sleeping on
+}
@@ -0,0 +1,55 @@
+// ButtonInput.h
+#pragma once
+
+#include <Arduino.h>
+
+#define BUTTON_DEBOUNCE_MS 30      // Edges closer than this to the last accepted one are contact bounce
+#define BUTTON_DOUBLE_GAP_MS 300   // Release-to-press gap that still counts as a double press
+#define BUTTON_LONG_PRESS_MS 2000  // Held this long: long press (Wi-Fi reset)
+#define BUTTON_EDGE_QUEUE 16
+#define BUTTON_TASK_STACK 8192     // Gestures switch apps, and an app's prepare() may fetch weather
+#define BUTTON_TASK_PRIORITY 2     // Above the loop task, so a gesture preempts it once it lets go
+#define BUTTON_TASK_CORE 1         // With the loop: the two only ever interleave at the frame lock
+
+enum class ButtonEvent : uint8_t { NONE, SHORT_PRESS, DOUBLE_PRESS, LONG_PRESS };
+
+// Pure debounce + gesture state machine: fed timestamped edges and clock ticks, no GPIO access,
+// so synthetic edge timings can drive it directly.
+class GestureRecognizer {
+public:
+  ButtonEvent onEdge(bool down, unsigned long ms);
+  ButtonEvent onTick(bool down, unsigned long ms);  // Timeouts, plus the settled level if a real edge was
+                                                    // swallowed as bounce
+  unsigned long msUntilTimeout(unsigned long ms) const;  // ULONG_MAX when nothing is pending
+  bool isHeld() const { return state == State::DOWN || state == State::DOWN_SECOND || state == State::LONG_HELD; }
+
+private:
+  enum class State : uint8_t { IDLE, DOWN, WAIT_SECOND, DOWN_SECOND, LONG_HELD };
+
+  ButtonEvent checkTimeouts(unsigned long ms);
+
+  State state = State::IDLE;
+  unsigned long lastEdge = 0;
+  unsigned long stateSince = 0;
+  bool hasEdge = false;
+};
+
+typedef void (*GestureHandler)(ButtonEvent event);
+
+class ButtonInput {
+public:
+  // Attaches the edge interrupt and starts the gesture task. The task waits on the ISR's edges and
+  // the recognizer's timeouts, and calls `handler` with the frame lock held as soon as a gesture is
+  // recognised — it does not wait for the loop to come round.
+  void begin(uint8_t pin, GestureHandler handler);
+
+private:
+  static void taskMain(void* self);
+  void run();
+  void dispatch(ButtonEvent event);
+
+  GestureRecognizer recognizer;
+  GestureHandler handler = nullptr;
+};
+
+extern ButtonInput buttonInput;
@@ -0,0 +1,105 @@
+#include "ClipApp.h"
+#include "ClipStore.h"
+#include "DisplayHelpers.h"
+#include "FrameKernels.h"
+#include <esp_heap_caps.h>
+
+#define CLIP_REPORT_MS 30000
+#define CLIP_MIN_DELAY_MS 10   // Frames with a 0 delay (common in GIFs) still get paced
+
+void ClipApp::init() {
+  frameIndex = 0;
+  loopsPlayed = 0;
+  holding = false;
+  clipGeneration = ClipStore::generation();
+  nextFrameAt = millis();
+  decodeMicrosTotal = decodeMicrosMax = framesDecoded = 0;
+  heapAtStart = heapLow = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  lastReport = millis();
+  setNeedsRedraw(true);
+}
+
+void ClipApp::loop() {
+  if (clipGeneration != ClipStore::generation()) {
+    init();  // Also covers the clip disappearing mid-download: falls back to the placeholder
+    return;
+  }
+  if (!ClipStore::clip() || holding) return;
+  if ((long)(millis() - nextFrameAt) < 0) return;
+  showFrame();
+}
+
+void ClipApp::showFrame() {
+  const ClipView* clip = ClipStore::clip();
+  const ClipHeader& h = *clip->header;
+
+  unsigned long start = micros();
+  if (!decodeClipFrame(*clip, frameIndex, matrix.getBuffer(), Panel::width, Panel::height)) {
+    Serial.printf("❌ Clip frame %d is corrupt — stopping playback\n", frameIndex);
+    holding = true;  // Until a new clip is mapped or a forced redraw starts over
+    return;
+  }
+  uint32_t elapsed = micros() - start;
+  decodeMicrosTotal += elapsed;
+  decodeMicrosMax = max(decodeMicrosMax, elapsed);
+  framesDecoded++;
+  heapLow = min(heapLow, (uint32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT));
+  presentFrame();
+
+  // Schedule from the previous deadline so decode time doesn't stretch the clip; resync if far behind
+  unsigned long delayMs = max((unsigned long)clip->frames[frameIndex].delayMs, (unsigned long)CLIP_MIN_DELAY_MS);
+  nextFrameAt += delayMs;
+  if ((long)(millis() - nextFrameAt) > (long)delayMs) nextFrameAt = millis() + delayMs;
+
+  if (++frameIndex >= h.frameCount) {
+    frameIndex = 0;
+    loopsPlayed++;
+    if (h.loopCount != 0 && loopsPlayed >= h.loopCount) {
+      frameIndex = h.frameCount - 1;
+      holding = true;
+    }
+  }
+  reportIfDue();
+}
+
+void ClipApp::reportIfDue() {
+  unsigned long now = millis();
+  if (now - lastReport < CLIP_REPORT_MS || framesDecoded == 0) return;
+  Serial.printf("🎬 Clip decode avg %lu us, max %lu us over %lu frames; peak RAM %lu bytes\n",
+                (unsigned long)(decodeMicrosTotal / framesDecoded), (unsigned long)decodeMicrosMax,
+                (unsigned long)framesDecoded, (unsigned long)(heapAtStart - heapLow));
+  decodeMicrosTotal = decodeMicrosMax = framesDecoded = 0;
+  lastReport = now;
+}
+
+void ClipApp::redraw(bool force, int xOffset) {
+  if (!force && !getNeedsRedraw()) return;
+  setNeedsRedraw(false);
+
+  if (ClipStore::clip()) {
+    // Frames only cover changed rows, so a forced redraw restarts from the full first frame
+    clearFrame();
+    frameIndex = 0;
+    loopsPlayed = 0;
+    holding = false;
+    nextFrameAt = millis();
+    showFrame();
+    return;
+  }
+  clearFrame();
+  showCenteredText("No clip", CONTENT.row(12), matrix.color565(192, 192, 192), 1, xOffset);
+}
+
+void ClipApp::setNeedsRedraw(bool flag) {
+  needsRedraw = flag;
+}
+
+bool ClipApp::getNeedsRedraw() {
+  return needsRedraw;
+}
+
+unsigned long ClipApp::getNextUpdateMs() {
+  if (!ClipStore::clip() || holding) return LOOP_MAX_IDLE_MS;
+  long remaining = (long)(nextFrameAt - millis());
+  return remaining > 0 ? remaining : 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "BaseApp.h"
+#include <Arduino.h>
+
+// Plays the clip stored in the "clips" flash partition (see ClipStore.h), decoding each frame
+// from mapped flash straight into the canvas, paced by the frame delays.
+class ClipApp : public BaseApp {
+public:
+  void init() override;
+  void loop() override;
+  void redraw(bool force = false, int xOffset = 0) override;
+
+  void setNeedsRedraw(bool flag) override;
+  bool getNeedsRedraw() override;
+  unsigned long getNextUpdateMs() override;
+  String getAppId() override { return "clip"; }
+
+private:
+  void showFrame();
+  void reportIfDue();
+
+  int frameIndex = 0;
+  uint16_t loopsPlayed = 0;
+  bool holding = false;            // loopCount reached or a frame is corrupt — the panel stays as it is
+  uint32_t clipGeneration = 0;     // Restart when a downloaded clip replaces this one
+  unsigned long nextFrameAt = 0;
+  bool needsRedraw = true;
+
+  // Decode cost and RAM while playing, logged every CLIP_REPORT_MS
+  uint32_t decodeMicrosTotal = 0;
+  uint32_t decodeMicrosMax = 0;
+  uint32_t framesDecoded = 0;
+  uint32_t heapAtStart = 0;
+  uint32_t heapLow = 0;
+  unsigned long lastReport = 0;
+};
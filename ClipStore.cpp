@@ -0,0 +1,166 @@
+#include "ClipStore.h"
+#include <esp_partition.h>
+#include "LoopScheduler.h"
+
+static const esp_partition_t* partition = nullptr;
+static const void* mapped = nullptr;
+static spi_flash_mmap_handle_t mmapHandle = 0;
+static ClipView view;
+static bool viewValid = false;
+static uint32_t mapGeneration = 0;
+
+// Download/loop handshake: the mapping is only ever touched on the loop task
+static volatile bool writeRequested = false;
+static volatile bool writeGranted = false;
+
+bool openClip(const uint8_t* data, size_t size, ClipView& out) {
+  if (!data || size < sizeof(ClipHeader)) return false;
+  const ClipHeader* header = (const ClipHeader*)data;
+  if (memcmp(header->magic, CLIP_MAGIC, 4) != 0) return false;
+  if (header->width == 0 || header->height == 0 || header->height > 255) return false;
+  if (header->frameCount == 0 || header->frameCount > CLIP_MAX_FRAMES || header->paletteSize == 0) return false;
+
+  size_t tableOffset = (sizeof(ClipHeader) + header->paletteSize * sizeof(uint16_t) + 3) & ~(size_t)3;
+  if (tableOffset + header->frameCount * sizeof(ClipFrame) > size) return false;
+
+  const ClipFrame* frames = (const ClipFrame*)(data + tableOffset);
+  for (int i = 0; i < header->frameCount; i++) {
+    if (frames[i].offset >= size || frames[i].firstRow + frames[i].rowCount > header->height) return false;
+  }
+
+  out.base = data;
+  out.size = size;
+  out.header = header;
+  out.palette = (const uint16_t*)(data + sizeof(ClipHeader));
+  out.frames = frames;
+  return true;
+}
+
+bool decodeClipFrame(const ClipView& view, int index, uint16_t* canvas, int canvasWidth, int canvasHeight) {
+  const ClipHeader& h = *view.header;
+  const ClipFrame& frame = view.frames[index];
+  const uint8_t* p = view.base + frame.offset;
+  const uint8_t* end = view.base + view.size;
+  int visibleWidth = min((int)h.width, canvasWidth);
+
+  for (int y = frame.firstRow; y < frame.firstRow + frame.rowCount; y++) {
+    uint16_t* row = y < canvasHeight ? canvas + y * canvasWidth : nullptr;
+    int x = 0;
+    while (x < h.width) {
+      if (p >= end) return false;
+      uint8_t token = *p++;
+      int run = (token & 0x7F) + 1;
+      if (x + run > h.width) return false;
+
+      if (token & 0x80) {
+        if (p >= end || *p >= h.paletteSize) return false;
+        uint16_t color = view.palette[*p++];
+        if (row) {
+          for (int i = x; i < min(x + run, visibleWidth); i++) row[i] = color;
+        }
+      } else {
+        if (p + run > end) return false;
+        if (row) {
+          for (int i = 0; i < run; i++) {
+            if (p[i] >= h.paletteSize) return false;
+            if (x + i < visibleWidth) row[x + i] = view.palette[p[i]];
+          }
+        }
+        p += run;
+      }
+      x += run;
+    }
+  }
+  return true;
+}
+
+void ClipStore::begin() {
+  partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, CLIP_PARTITION_LABEL);
+  if (!partition) {
+    Serial.println("🎬 No \"" CLIP_PARTITION_LABEL "\" partition — clip playback disabled");
+    return;
+  }
+  map();
+}
+
+void ClipStore::map() {
+  viewValid = false;
+  if (esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &mapped, &mmapHandle) != ESP_OK) {
+    Serial.println("❌ Could not map the clips partition");
+    mapped = nullptr;
+    return;
+  }
+  viewValid = openClip((const uint8_t*)mapped, partition->size, view);
+  mapGeneration++;
+  if (viewValid) {
+    Serial.printf("🎬 Clip %ux%u, %u frames, %u colours (mapped, %u KB partition)\n", view.header->width,
+                  view.header->height, view.header->frameCount, view.header->paletteSize,
+                  (unsigned)(partition->size / 1024));
+  } else {
+    Serial.println("🎬 Clips partition holds no valid clip");
+  }
+}
+
+void ClipStore::unmap() {
+  viewValid = false;
+  if (mapped) spi_flash_munmap(mmapHandle);
+  mapped = nullptr;
+}
+
+void ClipStore::update() {
+  if (writeRequested && !writeGranted) {
+    unmap();
+    writeGranted = true;
+  } else if (!writeRequested && writeGranted) {
+    writeGranted = false;
+    map();
+  }
+}
+
+const ClipView* ClipStore::clip() {
+  return viewValid ? &view : nullptr;
+}
+
+uint32_t ClipStore::generation() {
+  return mapGeneration;
+}
+
+bool ClipStore::beginWrite(size_t size) {
+  if (!partition || size > partition->size) {
+    Serial.printf("❌ Clip of %u bytes does not fit the clips partition\n", (unsigned)size);
+    return false;
+  }
+
+  writeRequested = true;
+  wakeMainLoop();
+  unsigned long start = millis();
+  while (!writeGranted) {
+    if (millis() - start > CLIP_WRITE_GRANT_MS) {
+      Serial.println("⚠️ Loop did not release the clip mapping — skipping download");
+      writeRequested = false;
+      return false;
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+
+  size_t eraseSize = (size + SPI_FLASH_SEC_SIZE - 1) & ~(size_t)(SPI_FLASH_SEC_SIZE - 1);
+  if (esp_partition_erase_range(partition, 0, eraseSize) != ESP_OK) {
+    Serial.println("❌ Could not erase the clips partition");
+    endWrite(false);
+    return false;
+  }
+  return true;
+}
+
+bool ClipStore::write(size_t offset, const uint8_t* data, size_t len) {
+  return esp_partition_write(partition, offset, data, len) == ESP_OK;
+}
+
+void ClipStore::endWrite(bool ok) {
+  if (!ok) {
+    static const uint8_t zeros[4] = {};
+    esp_partition_write(partition, 0, zeros, sizeof(zeros));  // Flash bits only clear, so this always lands
+  }
+  writeRequested = false;
+  wakeMainLoop();  // The loop maps the new clip on its next pass
+}
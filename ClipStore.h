@@ -0,0 +1,65 @@
+// ClipStore.h
+#pragma once
+
+#include <Arduino.h>
+
+// Clips live in a raw data partition labelled "clips", e.g. in partitions.csv:
+//   clips, data, 0x40, <offset>, 0x100000
+// Without one, playback shows a placeholder and clip downloads are skipped.
+#define CLIP_PARTITION_LABEL "clips"
+#define CLIP_MAGIC "NFC1"
+#define CLIP_MAX_FRAMES 1024
+#define CLIP_WRITE_GRANT_MS 3000      // How long a download waits for the player to let go of the mapping
+
+// "NFC1" clip, all little-endian, read in place from mapped flash:
+//   ClipHeader, palette (RGB565 x paletteSize), padding to 4, ClipFrame x frameCount, frame data.
+// Each frame covers rows [firstRow, firstRow + rowCount); rows outside keep the previous frame.
+// A row is RLE tokens until width pixels: t < 0x80 is t+1 literal palette indices,
+// t >= 0x80 repeats the next index (t & 0x7F) + 1 times.
+struct ClipHeader {
+  char magic[4];
+  uint16_t width;
+  uint16_t height;
+  uint16_t frameCount;
+  uint16_t paletteSize;
+  uint16_t loopCount;                 // 0 = forever
+  uint16_t reserved;
+};
+
+struct ClipFrame {
+  uint32_t offset;                    // From the start of the clip
+  uint16_t delayMs;
+  uint8_t firstRow;
+  uint8_t rowCount;
+};
+
+struct ClipView {
+  const uint8_t* base = nullptr;
+  size_t size = 0;
+  const ClipHeader* header = nullptr;
+  const uint16_t* palette = nullptr;
+  const ClipFrame* frames = nullptr;
+};
+
+// Pure: validates the header and tables, no flash access beyond the given bytes
+bool openClip(const uint8_t* data, size_t size, ClipView& view);
+
+// Decodes one frame's rows straight into an RGB565 canvas, clipped to it. False on corrupt data.
+bool decodeClipFrame(const ClipView& view, int index, uint16_t* canvas, int canvasWidth, int canvasHeight);
+
+class ClipStore {
+public:
+  static void begin();                // Finds and maps the partition
+  static void update();               // Loop side: hands the mapping to a download and takes it back
+  static const ClipView* clip();      // nullptr while no valid clip is mapped
+  static uint32_t generation();       // Bumped whenever a (new) clip is mapped
+
+  // Download side (OTA task). beginWrite blocks until the loop has released the mapping.
+  static bool beginWrite(size_t size);
+  static bool write(size_t offset, const uint8_t* data, size_t len);
+  static void endWrite(bool ok);      // A failed download clears the magic so the partial clip is never played
+
+private:
+  static void map();
+  static void unmap();
+};
@@ -1,20 +1,31 @@
 #include "ClockApp.h"
 #include "DisplayHelpers.h"
 #include "TimeCache.h"
+#include "FrameKernels.h"
 #include <Arduino.h>
 
 extern TimeCache timeCache;
 extern int brightnessLevel;
 
+void ClockApp::prepare() {
+  timeCache.updateIfNeeded();
+}
+
 void ClockApp::init() {
   lastMinute = -1;  // force initial draw
-  lastDisplayedTime = "";
+  lastDisplayedTime[0] = '\0';
+  nextCheckAt = millis();
   setNeedsRedraw(true);
 }
 
 void ClockApp::loop() {
   timeCache.updateIfNeeded();
 
+  // Sleep until the next minute boundary instead of polling every tick
+  unsigned long now = millis();
+  if ((long)(now - nextCheckAt) < 0) return;
+  nextCheckAt = now + timeCache.msUntilNextMinute();
+
   int currentMinute = timeCache.getMinute();
   if (currentMinute != lastMinute) {
     lastMinute = currentMinute;
@@ -25,33 +36,38 @@ void ClockApp::loop() {
 void ClockApp::redraw(bool force, int xOffset) {
   if (isUpdating || (!force && !getNeedsRedraw())) return;
 
-  String current = timeCache.getFormattedTime();
-  if (!force && current == lastDisplayedTime) return;
+  char current[TIME_TEXT_LEN];
+  timeCache.formatTime(current, sizeof(current));
+  if (!force && strcmp(current, lastDisplayedTime) == 0) return;
 
-  lastDisplayedTime = current;
+  strlcpy(lastDisplayedTime, current, sizeof(lastDisplayedTime));
+  lastMinute = timeCache.getMinute();
   setNeedsRedraw(false);
 
-  uint16_t timeColor = getScaledColor(255, 255, 255);
+  uint16_t timeColor = matrix.color565(255, 255, 255);
 
-  String timePart, suffix;
-  int suffixIndex = current.indexOf(" ");
-  if (suffixIndex > 0) {
-    timePart = current.substring(0, suffixIndex);
-    suffix = current.substring(suffixIndex + 1);
-    timePart += "    ";  // Extra spacing
-    timePart += suffix;
+  char digits[TIME_TEXT_LEN];
+  const char* suffix = timeCache.formatTimeDigits(digits, sizeof(digits));
+  char timePart[20];
+  if (*suffix) {
+    snprintf(timePart, sizeof(timePart), "%s    %s", digits, suffix);  // Extra spacing
   } else {
-    timePart = current;
+    strlcpy(timePart, digits, sizeof(timePart));
   }
 
-  matrix.fillScreen(0);
-  showCenteredText(timePart.c_str(), 12, timeColor, 1, xOffset);
+  clearFrame();
+  showCenteredText(timePart, CONTENT.row(12), timeColor, 1, xOffset);
 }
 
 void ClockApp::setNeedsRedraw(bool flag) {
   needsRedraw = flag;
 }
 
+unsigned long ClockApp::getNextUpdateMs() {
+  long remaining = (long)(nextCheckAt - millis());
+  return remaining > 0 ? remaining : 0;
+}
+
 bool ClockApp::getNeedsRedraw() {
   return needsRedraw;
 }
\ No newline at end of file
@@ -1,20 +1,24 @@
 #pragma once
 #include "BaseApp.h"
 #include <Arduino.h>
+#include "TimeCache.h"
 
 class ClockApp : public BaseApp {
 public:
+  void prepare() override;
   void init() override;
   void loop() override;
   void redraw(bool force = false, int xOffset = 0) override;
 
   void setNeedsRedraw(bool flag) override;
   bool getNeedsRedraw() override;
+  unsigned long getNextUpdateMs() override;
   String getAppId() override { return "clock"; }
 
 private:
-  String lastDisplayedTime = "";
+  char lastDisplayedTime[TIME_TEXT_LEN] = "";
   int lastMinute = -1;
+  unsigned long nextCheckAt = 0;  // millis() of the next minute boundary
   bool isUpdating = false;
   bool needsRedraw = true;
 };
\ No newline at end of file
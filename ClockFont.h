@@ -0,0 +1,58 @@
+// ClockFont.h — generated by tools/make_font.py from tools/fonts/clock_digits.bdf; do not edit
+#pragma once
+
+#include "PackedFont.h"
+
+static const uint8_t CLOCK_FONT_BITMAP[] = {
+  0xFC, 0xFC, 0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0x7E,
+  0x30, 0x70, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x7E, 0xFF,
+  0xC3, 0x03, 0x03, 0x07, 0x3E, 0x7C, 0xE0, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0x7E, 0xFF, 0xC3, 0x03,
+  0x03, 0x03, 0x3E, 0x3F, 0x03, 0x03, 0x03, 0xC3, 0xFF, 0x7E, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3,
+  0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xFE, 0xFF, 0x03,
+  0x03, 0x03, 0x03, 0xC3, 0xFF, 0x7E, 0x7E, 0xFF, 0xC3, 0xC0, 0xC0, 0xC0, 0xFE, 0xFF, 0xC3, 0xC3,
+  0xC3, 0xC3, 0xFF, 0x7E, 0xFF, 0xFF, 0x03, 0x03, 0x06, 0x06, 0x0C, 0x0C, 0x18, 0x18, 0x18, 0x18,
+  0x18, 0x18, 0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0x7E,
+  0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0x7F, 0x03, 0x03, 0x03, 0xC3, 0xFF, 0x7E, 0xC0, 0xC0,
+  0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0,
+};
+
+static const PackedGlyph CLOCK_FONT_GLYPHS[] = {
+  // offset, width, height, xOffset, top, advance
+  {    0,  0,  0,  0, 14,  4 },  // ' '
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  6,  2,  1,  6,  8 },  // '-'
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    0,  0,  0,  0,  0,  0 },  // missing
+  {    2,  8, 14,  0,  0, 10 },  // '0'
+  {   16,  4, 14,  0,  0,  6 },  // '1'
+  {   30,  8, 14,  0,  0, 10 },  // '2'
+  {   44,  8, 14,  0,  0, 10 },  // '3'
+  {   58,  8, 14,  0,  0, 10 },  // '4'
+  {   72,  8, 14,  0,  0, 10 },  // '5'
+  {   86,  8, 14,  0,  0, 10 },  // '6'
+  {  100,  8, 14,  0,  0, 10 },  // '7'
+  {  114,  8, 14,  0,  0, 10 },  // '8'
+  {  128,  8, 14,  0,  0, 10 },  // '9'
+  {  142,  2,  8,  0,  3,  4 },  // ':'
+};
+
+static const KernPair CLOCK_FONT_KERNING[] = {
+  { '7', ':', -1 },
+  { ':', '7', -1 },
+  { '1', '1', -1 },
+};
+
+static const PackedFont CLOCK_FONT = {
+  CLOCK_FONT_BITMAP, CLOCK_FONT_GLYPHS, CLOCK_FONT_KERNING, 3, 0x20, 0x3A, 14
+};
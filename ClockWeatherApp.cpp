@@ -3,119 +3,100 @@
 #include "WeatherCache.h"
 #include "TimeCache.h"
 #include "DeviceRegistration.h"
+#include "ClockFont.h"
+#include "FrameKernels.h"
 
 extern int brightnessLevel;
 extern TimeCache timeCache;
 extern bool isUpdating;
 
-String lastDisplayedTime = "";
+static char lastDisplayedTime[TIME_TEXT_LEN] = "";
 
 ClockWeatherApp::ClockWeatherApp() {
   setNeedsRedraw(true);
 }
 
-void ClockWeatherApp::init() {
+void ClockWeatherApp::prepare() {
   updateWeatherCache();
   timeCache.updateIfNeeded();
+}
+
+void ClockWeatherApp::init() {
+  lastMinute = -1;
   setNeedsRedraw(true);
 }
 
 void ClockWeatherApp::loop() {
-  updateWeatherCache();
+  if (msUntilWeatherRefresh() == 0) {
+    int16_t temp10 = weatherData.temp10;
+    updateWeatherCache();
+    if (weatherData.temp10 != temp10) setNeedsRedraw(true);
+  }
   timeCache.updateIfNeeded();
-}
 
-int ClockWeatherApp::getCharWidth(char c) {
-  if (c == ':') return 6;
-  if (c == '1') return 8;
-  return 12;
+  int currentMinute = timeCache.getMinute();
+  if (currentMinute != lastMinute) {
+    lastMinute = currentMinute;
+    setNeedsRedraw(true);
+  }
 }
 
 void ClockWeatherApp::redraw(bool force, int xOffset) {
   if (isUpdating || (!force && !getNeedsRedraw())) return;
 
-  String current = timeCache.getFormattedTime();
-  if (current != lastDisplayedTime || force || getNeedsRedraw()) {
-    lastDisplayedTime = current;
+  char current[TIME_TEXT_LEN];
+  timeCache.formatTime(current, sizeof(current));
+  if (strcmp(current, lastDisplayedTime) != 0 || force || getNeedsRedraw()) {
+    strlcpy(lastDisplayedTime, current, sizeof(lastDisplayedTime));
     setNeedsRedraw(false);
 
-    uint16_t timeColor = getScaledColor(255, 255, 255);
-    uint16_t tempColor = getScaledColor(0, 255, 255);
+    uint16_t timeColor = matrix.color565(255, 255, 255);
+    uint16_t tempColor = matrix.color565(0, 255, 255);
 
-    int suffixIndex = current.indexOf(" ");
-    String timePart = (suffixIndex > 0) ? current.substring(0, suffixIndex) : current;
-    String suffix    = (suffixIndex > 0) ? current.substring(suffixIndex + 1) : "";
+    clearFrame();  // Proportional digits and a dropped suffix would otherwise leave stale pixels
 
-    matrix.setTextSize(2);
-    matrix.setTextColor(timeColor);
+    // CLOCK_FONT has only digits and the colon; the suffix goes in the GFX font
+    char timePart[TIME_TEXT_LEN];
+    const char* suffix = timeCache.formatTimeDigits(timePart, sizeof(timePart));
+    int timeWidth = packedTextWidth(CLOCK_FONT, timePart);
 
     // --- 24h or 12h (no suffix) ---
-    if (timeFormatPreference == 2 || timeFormatPreference == 1) {
-      int timeWidth = 0;
-      for (char c : timePart) timeWidth += getCharWidth(c);
-      int startX = (PANEL_WIDTH - timeWidth) / 2 + xOffset;
-
-      int cursorX = startX;
-      for (int i = 0; i < timePart.length(); i++) {
-        char c = timePart[i];
-        int w = getCharWidth(c);
-        int offset = (c == ':' ? -1 : 0);
-
-        matrix.setCursor(cursorX + offset, 4);
-        matrix.print(c);
-        cursorX += w;
-      }
+    if (*suffix == '\0') {
+      int startX = CONTENT.x + (CONTENT.w - timeWidth) / 2 + xOffset;
+      drawPackedText(CLOCK_FONT, timePart, startX, CONTENT.row(4), timeColor);
     }
 
     // --- 12h with suffix ---
     else {
-      matrix.setTextSize(1);
-      matrix.setTextColor(getScaledColor(180, 180, 180));
-
-      int suffixWidth = (suffix == "PM") ? 12 : 14;
-      int suffixRightEdge = PANEL_WIDTH - 1 + xOffset;
+      int suffixWidth = (strcmp(suffix, "PM") == 0) ? 12 : 14;
+      int suffixRightEdge = SCREEN.right() + xOffset;
       int suffixLeftEdge = suffixRightEdge - suffixWidth + 1;
       int timeRightEdge = suffixLeftEdge - 2;
 
-      int timeWidth = 0;
-      for (char c : timePart) timeWidth += getCharWidth(c);
-      int timeStartX = timeRightEdge - timeWidth + 1;
-
-      matrix.setTextSize(2);
-      matrix.setTextColor(timeColor);
-
-      int cursorX = timeStartX;
-      for (int i = 0; i < timePart.length(); i++) {
-        char c = timePart[i];
-        int w = getCharWidth(c);
-        int offset = (c == ':' ? -1 : 0);
-
-        if (i == 0 && timePart.length() >= 3 && timePart[1] == ':') {
-          w -= 1;
-        }
-
-        matrix.setCursor(cursorX + offset + xOffset, 4);
-        matrix.print(c);
-        cursorX += w;
-      }
+      drawPackedText(CLOCK_FONT, timePart, timeRightEdge - timeWidth + 1, CONTENT.row(4), timeColor);
 
       matrix.setTextSize(1);
-      matrix.setTextColor(getScaledColor(180, 180, 180));
-      matrix.setCursor(suffixLeftEdge + xOffset + 1, 11);
+      matrix.setTextColor(matrix.color565(180, 180, 180));
+      matrix.setCursor(suffixLeftEdge + xOffset + 1, CONTENT.row(11));
       matrix.print(suffix);
     }
 
     // Temperature centered below
-    String tempStr = getTemperatureString(units);
-    showCenteredText(tempStr.c_str(), 20, tempColor, 1, xOffset);
+    char tempStr[12];
+    formatTemperatureString(tempStr, sizeof(tempStr));
+    showCenteredText(tempStr, CONTENT.row(20), tempColor, 1, xOffset);
   }
-  matrix.show();
+  presentFrame();
 }
 
 void ClockWeatherApp::setNeedsRedraw(bool flag) {
   needsRedraw = flag;
 }
 
+unsigned long ClockWeatherApp::getNextUpdateMs() {
+  return min(timeCache.msUntilNextMinute(), msUntilWeatherRefresh());
+}
+
 bool ClockWeatherApp::getNeedsRedraw() {
   return needsRedraw;
 }
\ No newline at end of file
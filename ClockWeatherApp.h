@@ -6,14 +6,16 @@
 class ClockWeatherApp : public BaseApp {
 public:
     ClockWeatherApp();                  // Constructor
+    void prepare() override;           // Called before load to warm caches
     void init() override;              // Called once on load
     void loop() override;              // Called repeatedly
     void redraw(bool force = false, int xOffset = 0) override;  // Called to draw
     void setNeedsRedraw(bool flag) override;    // Force redraw
     bool getNeedsRedraw() override;             // Check if redraw needed
+    unsigned long getNextUpdateMs() override;   // Next minute boundary or weather refresh
     String getAppId() override { return "clockWeather"; }
 
 private:
     bool needsRedraw = true;
-    int getCharWidth(char c);
+    int lastMinute = -1;
 };
\ No newline at end of file
@@ -7,44 +7,72 @@
 #include "SecretsManager.h"
 #include <LittleFS.h>
 #include "RemoteConfigManager.h"
+#include "Trace.h"
+#include "GeoCache.h"
+#include "TimeCache.h"
 
 FirebaseData fbdo;
 FirebaseAuth auth;
 FirebaseConfig config;
 
-String units = "metric";
+char units[UNITS_MAX_LEN] = "metric";
 String deviceID = "";
 int timeFormatPreference = 0;
 int lastTimeFormat = timeFormatPreference;
 float storedLat = 0.0;
 float storedLon = 0.0;
+char storedTimezone[GEO_TZ_MAX_LEN] = "";
+
+static char macId[13] = "";
+static char settingsPaths[(int)SettingsField::COUNT][64];
+static bool settingsPathsBuilt = false;
+static bool geoResolvedThisBoot = false;
+
+extern TimeCache timeCache;
+
+const char* getMacId() {
+  if (macId[0] == '\0') {
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    if ((mac[0] | mac[1] | mac[2] | mac[3] | mac[4] | mac[5]) == 0) return macId;  // Wi-Fi not up yet
+    snprintf(macId, sizeof(macId), "%02X%02X%02X%02X%02X%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  }
+  return macId;
+}
 
 String getSanitizedMac() {
-  String mac = WiFi.macAddress();
-  mac.replace(":", "");
-  return mac;
+  return String(getMacId());
 }
 
-void initializeWiFi() {
-  wm.setConnectTimeout(WIFI_TIMEOUT);
-  setupCustomWiFiManager(wm);
+const char* getSettingsPath(SettingsField field) {
+  if (!settingsPathsBuilt && getMacId()[0] != '\0') {
+    static const char* const suffixes[] = { "", "/brightness", "/timeFormat", "/units", "/nightStart", "/nightEnd",
+                                            "/autoBrightness", "/brightnessMin", "/brightnessMax" };
+    static_assert(sizeof(suffixes) / sizeof(suffixes[0]) == (int)SettingsField::COUNT, "suffix per field");
+    for (int i = 0; i < (int)SettingsField::COUNT; i++) {
+      snprintf(settingsPaths[i], sizeof(settingsPaths[i]), "/novaFrame/devices/%s/settings%s", macId, suffixes[i]);
+    }
+    settingsPathsBuilt = true;
+  }
+  return settingsPathsBuilt ? settingsPaths[(int)field] : "";
+}
 
+void beginWiFi() {
   Serial.println("Attempting connection using saved credentials...");
-  showConnectingToWiFi();
-
-  WiFi.disconnect(true);
-  delay(100);
+  WiFi.mode(WIFI_STA);
   WiFi.begin();
+}
 
-  unsigned long start = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - start < 15000) {
-    delay(200);
-  }
+static bool wifiConnected() {
+  return WiFi.status() == WL_CONNECTED;
+}
 
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println("✅ WiFi connected successfully.");
-    showWifiInfo();
-    delay(2000);
+void initializeWiFi() {
+  wm.setConnectTimeout(WIFI_TIMEOUT);
+  setupCustomWiFiManager(wm);
+
+  if (animateSplashUntil(wifiConnected, WIFI_TIMEOUT * 1000UL, "WiFi...")) {
+    Serial.printf("✅ WiFi connected to %s\n", WiFi.SSID().c_str());
     return;
   }
 
@@ -58,7 +86,7 @@ void initializeWiFi() {
   if (connected) {
     Serial.println("✅ Connected via portal.");
     matrix.fillScreen(0);
-    showCenteredText("Connected!", 10, matrix.color565(0, 255, 0));
+    showCenteredText("Connected!", CONTENT.row(10), matrix.color565(0, 255, 0));
     matrix.show();
     delay(1500);
     showWifiInfo();
@@ -67,14 +95,18 @@ void initializeWiFi() {
     Serial.println("❌ Portal failed. Resetting credentials.");
     wm.resetSettings();
     matrix.fillScreen(0);
-    showCenteredText("WiFi Fail", 10, matrix.color565(255, 0, 0));
+    showCenteredText("WiFi Fail", CONTENT.row(10), matrix.color565(255, 0, 0));
     matrix.show();
     delay(2000);
   }
 }
 
+static bool firebaseReady() {
+  return Firebase.ready();
+}
+
 void initializeFirebase() {
-  if (!SecretsManager::load()) {
+  if (!SecretsManager::isLoaded() && !SecretsManager::load()) {
     Serial.println("❌ Could not load secrets");
     return;
   }
@@ -87,30 +119,90 @@ void initializeFirebase() {
   Firebase.begin(&config, &auth);
   Firebase.reconnectWiFi(true);
   Serial.println("Waiting for Firebase token...");
-  while (!Firebase.ready()) delay(100);
   deviceID = getSanitizedMac();
   Serial.println("📟 deviceID set to: " + deviceID);
+  if (!animateSplashUntil(firebaseReady, FIREBASE_READY_TIMEOUT_MS, "Cloud...")) {
+    Serial.println("⚠️ Firebase not ready yet — starting with defaults, syncing in the background");
+    return;
+  }
   RemoteConfigManager::begin();
 }
 
-void updateGeoLocationAndTimezone(const String& settingsPath) {
-  while (!Firebase.ready()) delay(100);
+static void useLocation(const GeoLocation& loc) {
+  storedLat = loc.lat;
+  storedLon = loc.lon;
+  strlcpy(storedTimezone, loc.timezone, sizeof(storedTimezone));
+}
+
+bool applyCachedLocation() {
+  GeoLocation cached;
+  if (!GeoCache::lookup(cached)) {
+    Serial.println("🌍 No cached location for this network");
+    return false;
+  }
+  useLocation(cached);
+  Serial.printf("📍 Cached location for this network: %s, %s (%.4f, %.4f) %s\n",
+                cached.city, cached.region, cached.lat, cached.lon, cached.timezone);
+  return true;
+}
 
-  float currentLat = 0.0;
-  float currentLon = 0.0;
+// Plain-text public IP — a few bytes, and doesn't spend ip-api quota
+static bool fetchPublicIp(char* buf, size_t len) {
+  HTTPClient http;
+  http.begin("http://api.ipify.org");
+  Tracer::countRequest(Endpoint::IPIFY);
+  int code = http.GET();
+  if (code != 200) {
+    Serial.println("⚠️ Public IP check failed: " + http.errorToString(code));
+    http.end();
+    return false;
+  }
+  String ip = http.getString();
+  http.end();
+  ip.trim();
+  strlcpy(buf, ip.c_str(), len);
+  return buf[0] != '\0';
+}
 
-  Firebase.RTDB.getFloat(&fbdo, (settingsPath + "/lat").c_str());
-  currentLat = fbdo.floatData();
+void updateGeoLocationAndTimezone(const String& settingsPath) {
+  if (geoResolvedThisBoot) {
+    Serial.println("📍 Location already resolved this boot.");
+    return;
+  }
 
-  Firebase.RTDB.getFloat(&fbdo, (settingsPath + "/lon").c_str());
-  currentLon = fbdo.floatData();
+  // Same network, same public IP and not stale: the cached fix stands
+  GeoLocation cached;
+  bool hit = GeoCache::lookup(cached);
+  time_t now = timeCache.now();
+  if (hit && !GeoCache::isExpired(cached, now)) {
+    char ip[GEO_IP_MAX_LEN];
+    if (!fetchPublicIp(ip, sizeof(ip))) {
+      useLocation(cached);  // Keep the cached fix; checked again next boot
+      return;
+    }
+    if (strcmp(ip, cached.publicIp) == 0) {
+      useLocation(cached);
+      if (cached.resolvedAt == 0 && now > 0) {
+        cached.resolvedAt = now;  // Resolved before the clock was set — start its TTL now
+        GeoCache::store(cached);
+      }
+      Serial.println("📍 Network and public IP unchanged — skipping GeoIP.");
+      geoResolvedThisBoot = true;
+      return;
+    }
+    Serial.printf("🌍 Public IP changed (%s → %s) — resolving location\n", cached.publicIp, ip);
+  } else if (hit) {
+    Serial.println("🌍 Cached location expired — resolving again");
+  }
 
   HTTPClient geoHttp;
   geoHttp.begin("http://ip-api.com/json");
+  Tracer::countRequest(Endpoint::IP_API);
   int code = geoHttp.GET();
   if (code != 200) {
     Serial.println("❌ GeoIP failed: " + geoHttp.errorToString(code));
     geoHttp.end();
+    if (hit) useLocation(cached);
     return;
   }
 
@@ -118,35 +210,58 @@ void updateGeoLocationAndTimezone(const String& settingsPath) {
   geoHttp.end();
 
   DynamicJsonDocument geoDoc(1024);
-  deserializeJson(geoDoc, payload);
-  float newLat = geoDoc["lat"];
-  float newLon = geoDoc["lon"];
-  String city = geoDoc["city"] | "";
-  String region = geoDoc["region"] | "";
+  if (deserializeJson(geoDoc, payload) || strcmp(geoDoc["status"] | "", "success") != 0) {
+    Serial.println("❌ GeoIP returned no location.");
+    if (hit) useLocation(cached);
+    return;
+  }
 
-  bool shouldUpdate = fabs(currentLat - newLat) > 0.01 || fabs(currentLon - newLon) > 0.01;
+  GeoLocation resolved;
+  resolved.network = GeoCache::networkFingerprint();
+  strlcpy(resolved.publicIp, geoDoc["query"] | "", sizeof(resolved.publicIp));
+  resolved.lat = geoDoc["lat"];
+  resolved.lon = geoDoc["lon"];
+  resolved.resolvedAt = now;
+  strlcpy(resolved.timezone, geoDoc["timezone"] | "", sizeof(resolved.timezone));
+  strlcpy(resolved.city, geoDoc["city"] | "", sizeof(resolved.city));
+  strlcpy(resolved.region, geoDoc["region"] | "", sizeof(resolved.region));
+
+  // The cache mirrors what was last written to Firebase, so no read-back is needed
+  bool shouldUpdate = !hit || fabs(cached.lat - resolved.lat) > 0.01 || fabs(cached.lon - resolved.lon) > 0.01;
 
   if (shouldUpdate) {
+    if (!Firebase.ready()) {
+      Serial.println("⚠️ Firebase not ready — location not saved, retrying next boot.");
+      useLocation(resolved);
+      return;
+    }
     Serial.printf("🌍 Location changed — updating Firebase: (%.4f, %.4f) → (%.4f, %.4f)\n",
-                  currentLat, currentLon, newLat, newLon);
-    Firebase.RTDB.setString(&fbdo, (settingsPath + "/weatherLocation").c_str(), city + "," + region);
-    Firebase.RTDB.setFloat(&fbdo, (settingsPath + "/lat").c_str(), newLat);
-    Firebase.RTDB.setFloat(&fbdo, (settingsPath + "/lon").c_str(), newLon);
-    storedLat = newLat;
-    storedLon = newLon;
+                  cached.lat, cached.lon, resolved.lat, resolved.lon);
+    FirebaseJson patch;
+    patch.set("weatherLocation", String(resolved.city) + "," + resolved.region);
+    patch.set("lat", resolved.lat);
+    patch.set("lon", resolved.lon);
+    Tracer::countRequest(Endpoint::RTDB);
+    if (!Firebase.RTDB.updateNode(&fbdo, settingsPath.c_str(), &patch)) {
+      Serial.println("❌ Location update failed: " + fbdo.errorReason());
+      useLocation(resolved);
+      return;
+    }
   } else {
     Serial.println("📍 Location unchanged — skipping Firebase update.");
-    storedLat = currentLat;
-    storedLon = currentLon;
   }
+
+  useLocation(resolved);
+  GeoCache::store(resolved);
+  geoResolvedThisBoot = true;
 }
 
-void registerDeviceInFirebase(bool deferGeo) {
+bool registerDeviceInFirebase(bool deferGeo) {
   Serial.println("📝 Registering device in Firebase...");
 
   if (!Firebase.ready()) {
-    Serial.println("❌ Firebase not ready — skipping registration.");
-    return;
+    Serial.println("❌ Firebase not ready — registration waits for loop().");
+    return false;
   }
 
   String devicePath = "/novaFrame/devices/" + deviceID;
@@ -197,8 +312,9 @@ void registerDeviceInFirebase(bool deferGeo) {
   String brightnessPath = settingsPath + "/brightness";
 
   if (Firebase.RTDB.getString(&fbdo, unitsPath.c_str())) {
-    units = fbdo.stringData();
-    Serial.println("📏 Units loaded: " + units);
+    const char* loaded = fbdo.to<const char*>();
+    if (loaded) strlcpy(units, loaded, UNITS_MAX_LEN);
+    Serial.printf("📏 Units loaded: %s\n", units);
   }
 
   if (Firebase.RTDB.getInt(&fbdo, timeFmtPath.c_str())) {
@@ -211,23 +327,34 @@ void registerDeviceInFirebase(bool deferGeo) {
     Serial.println("🕒 Default time format set to 12hr (1)");
   }
 
-  int brightness = 7;
+  int brightness = RemoteConfigManager::getInt(ConfigKey::DEFAULT_BRIGHTNESS);
   if (Firebase.RTDB.getInt(&fbdo, brightnessPath.c_str())) {
     brightness = fbdo.intData();
     Serial.printf("💡 Brightness loaded: %d\n", brightness);
   } else {
     Firebase.RTDB.setInt(&fbdo, brightnessPath.c_str(), brightness);
-    Serial.println("⚠️ Brightness fallback set to 7");
+    Serial.printf("⚠️ Brightness fallback set to %d\n", brightness);
   }
   brightnessLevel = constrain(brightness, 1, 10);
+  setBrightnessScale(brightnessLevelToScale(brightnessLevel));
+
+  // An explicit -1 keeps the night-schedule poll on its success path instead of a 404 every minute
+  for (SettingsField field : { SettingsField::NIGHT_START, SettingsField::NIGHT_END }) {
+    if (!Firebase.RTDB.getInt(&fbdo, getSettingsPath(field)) && fbdo.errorReason() == "path not exist") {
+      Firebase.RTDB.setInt(&fbdo, getSettingsPath(field), -1);
+      Serial.printf("🌙 Night schedule default written: %s = -1\n", getSettingsPath(field));
+    }
+  }
 
   if (deferGeo) {
     Serial.println("🌐 Skipping GeoIP and Timezone for now — deferGeo = true");
-    return;
+    return true;
   }
 
-  updateGeoLocationAndTimezone(settingsPath);
+  // setup() already applied a cached fix if this network has one; loop() still checks the public IP
+  if (storedLat == 0.0 || storedLon == 0.0) updateGeoLocationAndTimezone(settingsPath);
   Serial.println("📍 Settings initialized or updated.");
+  return true;
 }
 
 bool loadSecretsFromFlash() {
@@ -10,6 +10,8 @@
 #include <Arduino.h>
 
 #define WIFI_TIMEOUT 15
+#define FIREBASE_READY_TIMEOUT_MS 15000  // Past this, boot continues and Firebase catches up from loop()
+#define UNITS_MAX_LEN 10
 
 extern FirebaseData fbdo;
 extern FirebaseAuth auth;
@@ -17,16 +19,27 @@ extern FirebaseConfig config;
 extern WiFiManager wm;
 extern String deviceID;
 
-extern String units;              // "metric" or "imperial"
+extern char units[];              // "metric" or "imperial"
 extern int timeFormatPreference; // 0 = 12h + AM/PM, 1 = 12h no suffix, 2 = 24h
 extern float storedLat;
 extern float storedLon;
+extern char storedTimezone[];     // IANA zone from GeoIP, "" until resolved
 
-void initializeWiFi();
-void initializeFirebase();
-void registerDeviceInFirebase(bool deferGeo); 
-void updateGeoLocationAndTimezone(const String& settingsPath); 
+void beginWiFi();                 // Starts associating with the saved network and returns at once
+void initializeWiFi();            // Waits for beginWiFi() under the splash; setup portal on timeout
+void initializeFirebase();        // Bounded wait for the auth token, splash running meanwhile
+bool registerDeviceInFirebase(bool deferGeo);  // False if Firebase wasn't ready yet: nothing ran
+bool applyCachedLocation();       // Boot, once Wi-Fi is up: location cached for this network, no round trips; false on a miss
+void updateGeoLocationAndTimezone(const String& settingsPath);  // Re-resolves only on a new public IP or stale cache
 bool loadSecretsFromFlash();
 String getSanitizedMac();
+const char* getMacId();           // Same as getSanitizedMac(), read once and cached
+
+// Firebase paths under /novaFrame/devices/<mac>/settings, built once so polling doesn't allocate
+enum class SettingsField : uint8_t {
+  ROOT, BRIGHTNESS, TIME_FORMAT, UNITS, NIGHT_START, NIGHT_END,
+  AUTO_BRIGHTNESS, BRIGHTNESS_MIN, BRIGHTNESS_MAX, COUNT
+};
+const char* getSettingsPath(SettingsField field);
 void fetchAndStoreTimezone(float lat, float lon);
 String getDeviceID(); 
\ No newline at end of file
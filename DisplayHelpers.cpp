@@ -2,37 +2,44 @@
 #include "DeviceRegistration.h"
 #include "BaseApp.h"
 #include "AppManager.h"
+#include "Trace.h"
+#include "FrameKernels.h"
+#include "LanApi.h"
 
 uint8_t rgbPins[]  = { 42, 41, 40, 38, 39, 37 };
-uint8_t addrPins[] = { 45, 36, 48, 35 };
+uint8_t addrPins[] = { 45, 36, 48, 35, 21 };  // A-D, plus E for 64-row panels
 uint8_t clockPin   = 2;
 uint8_t latchPin   = 47;
 uint8_t oePin      = 14;
 
-Adafruit_Protomatter matrix(PANEL_WIDTH, 4, 1, rgbPins, 4, addrPins, clockPin, latchPin, oePin, true);
+Adafruit_Protomatter matrix(Panel::width, Panel::bitDepth, 1, rgbPins, Panel::addrLines, addrPins,
+                            clockPin, latchPin, oePin, true);
 Adafruit_NeoPixel pixel(1, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
 
 extern bool isUpdating;
 extern AppManager appManager;  // ✅ updated from currentApp to appManager
-extern unsigned long lastWeatherFetchTime;
 extern FirebaseData fbdo;
 extern int timeFormatPreference;
-extern String units;
+extern char units[];
 
 int brightnessLevel = 10;
 
 void initializeDisplay() {
-  pixel.begin();
-  pixel.setBrightness(10);
-  pixel.setPixelColor(0, pixel.Color(0, 0, 64));
-  pixel.show();
-  delay(1000);
+  if (STATUS_PIXEL_ENABLED) {
+    pixel.begin();
+    pixel.setBrightness(10);
+    pixel.setPixelColor(0, pixel.Color(0, 0, 64));
+    pixel.show();
+  }
 
   ProtomatterStatus status = matrix.begin();
-  Serial.printf("Protomatter begin() status: %d\n", status);
+  Serial.printf("Protomatter begin() status: %d (%dx%d, %d tile chain)\n", status, Panel::width, Panel::height,
+                Panel::chainLength);
   if (status != PROTOMATTER_OK) {
-    pixel.setPixelColor(0, pixel.Color(64, 0, 0));
-    pixel.show();
+    if (STATUS_PIXEL_ENABLED) {
+      pixel.setPixelColor(0, pixel.Color(64, 0, 0));
+      pixel.show();
+    }
     while (1);
   }
 
@@ -51,7 +58,7 @@ void showCenteredText(const char* text, int y, uint16_t color, int size, int xOf
   int16_t x = (PANEL_WIDTH - w) / 2 + xOffset;
   matrix.setCursor(x, y);
   matrix.print(text);
-  matrix.show();  // ✅ Ensure it actually appears
+  presentFrame();  // ✅ Ensure it actually appears
 }
 
 void scrollText(const char* text, int y, uint16_t color, int delayMs) {
@@ -65,7 +72,7 @@ void scrollText(const char* text, int y, uint16_t color, int delayMs) {
   int totalWidth = textWidth + spacing;
   int startOffset = (PANEL_WIDTH - charWidth) / 2;
   for (int offset = -startOffset; offset < totalWidth; offset++) {
-    matrix.fillRect(0, y, PANEL_WIDTH, 8, 0);
+    fillRectFast(0, y, Panel::width, 8, 0);
     matrix.setCursor(-offset, y);
     matrix.setTextColor(color);
     matrix.print(text);
@@ -78,7 +85,7 @@ void showWifiInfo() {
   if (isUpdating) return;
 
   matrix.fillScreen(0);
-  showCenteredText("WiFi OK", 0, matrix.color565(0, 192, 64));
+  showCenteredText("WiFi OK", CONTENT.row(0), matrix.color565(0, 192, 64));
   matrix.show();  // Show the OK message right away
   delay(1000);
 
@@ -87,56 +94,137 @@ void showWifiInfo() {
 
   if (ssid.length() <= 10) {
     // If short, show it centered
-    showCenteredText(ssid.c_str(), 10, matrix.color565(192, 192, 192));
+    showCenteredText(ssid.c_str(), CONTENT.row(10), matrix.color565(192, 192, 192));
     matrix.show();
     delay(2000);  // Let it breathe
   } else {
     // Scroll long SSIDs
-    scrollText(ssid.c_str(), 10, matrix.color565(192, 192, 192));
+    scrollText(ssid.c_str(), CONTENT.row(10), matrix.color565(192, 192, 192));
   }
 }
 
 void showConnectingToWiFi() {
   matrix.fillScreen(0);
-  showCenteredText("Connecting", 6, matrix.color565(255, 255, 0));
-  showCenteredText("to WiFi", 16, matrix.color565(255, 255, 0));
+  showCenteredText("Connecting", CONTENT.row(6), matrix.color565(255, 255, 0));
+  showCenteredText("to WiFi", CONTENT.row(16), matrix.color565(255, 255, 0));
   matrix.show();
 }
 
 void showWifiNotSetNotice() {
   matrix.fillScreen(0);
-  showCenteredText("Wi-Fi", 6, matrix.color565(255, 255, 0));
-  showCenteredText("not set", 16, matrix.color565(255, 255, 0));
+  showCenteredText("Wi-Fi", CONTENT.row(6), matrix.color565(255, 255, 0));
+  showCenteredText("not set", CONTENT.row(16), matrix.color565(255, 255, 0));
   matrix.show();
 }
 
 void showJoinInstructions() {
   matrix.fillScreen(0);
   matrix.setTextWrap(false);
-  showCenteredText("Join", 0, matrix.color565(0, 200, 255));
-  showCenteredText("NovaFrame", 10, matrix.color565(255, 255, 255));
-  showCenteredText("Setup", 20, matrix.color565(255, 255, 255));
+  showCenteredText("Join", CONTENT.row(0), matrix.color565(0, 200, 255));
+  showCenteredText("NovaFrame", CONTENT.row(10), matrix.color565(255, 255, 255));
+  showCenteredText("Setup", CONTENT.row(20), matrix.color565(255, 255, 255));
   matrix.show();
 }
 
-void showWelcome() {
-  matrix.fillScreen(0);
-  showCenteredText("NovaFrame", 12, matrix.color565(0, 255, 0));
+#define SPLASH_FRAME_MS 33
+#define SPLASH_COMET_LEN 8
+
+void drawSplashFrame(const char* status) {
+  clearFrame();
+  matrix.setTextSize(1);
+
+  int16_t x1, y1;
+  uint16_t w, h;
+  matrix.getTextBounds("NovaFrame", 0, 0, &x1, &y1, &w, &h);
+  matrix.setCursor((PANEL_WIDTH - w) / 2, CONTENT.row(6));
+  matrix.setTextColor(matrix.color565(0, 255, 0));
+  matrix.print("NovaFrame");
+
+  matrix.getTextBounds(status, 0, 0, &x1, &y1, &w, &h);
+  matrix.setCursor((PANEL_WIDTH - w) / 2, CONTENT.row(18));
+  matrix.setTextColor(matrix.color565(96, 96, 96));
+  matrix.print(status);
+
+  // Comet sweeping along the bottom of the content band, tail fading out
+  int head = (millis() / 20) % (Panel::width + SPLASH_COMET_LEN);
+  for (int i = 0; i < SPLASH_COMET_LEN; i++) {
+    int x = head - i;
+    if (x < 0 || x >= Panel::width) continue;
+    uint8_t level = 255 >> i;
+    fillSpanH(x, CONTENT.bottom(), 1, matrix.color565(0, level, level / 2));
+  }
+  presentFrame();
+}
+
+bool animateSplashUntil(bool (*done)(), unsigned long timeoutMs, const char* status) {
+  unsigned long start = millis();
+  while (!done()) {
+    if (millis() - start >= timeoutMs) return false;
+    drawSplashFrame(status);
+    delay(SPLASH_FRAME_MS);
+  }
+  return true;
+}
+
+static bool presentHeld = false;
+
+void holdPresent(bool hold) {
+  presentHeld = hold;
+}
+
+// Brightness is a per-channel scale applied to a copy of the canvas on its way to the panel,
+// so a brightness change is one re-present rather than a redraw of the active app.
+static uint8_t brightnessScale = 255;
+static uint16_t scaleR[32], scaleG[64], scaleB[32];  // Already shifted into RGB565 position
+static uint16_t presentShadow[Panel::pixels];
+
+static void rebuildScaleTables() {
+  for (int i = 0; i < 32; i++) {
+    scaleR[i] = ((i * brightnessScale + 127) / 255) << 11;
+    scaleB[i] = (i * brightnessScale + 127) / 255;
+  }
+  for (int i = 0; i < 64; i++) {
+    scaleG[i] = ((i * brightnessScale + 127) / 255) << 5;
+  }
+}
+
+void presentFrame() {
+  if (presentHeld) return;
+  TRACE_SCOPE(PRESENT);
+  if (brightnessScale == 255) {
+    matrix.show();
+    return;
+  }
+
+  uint16_t* px = matrix.getBuffer();
+  memcpy(presentShadow, px, sizeof(presentShadow));
+  for (int i = 0; i < Panel::pixels; i++) {
+    uint16_t c = px[i];
+    px[i] = scaleR[c >> 11] | scaleG[(c >> 5) & 0x3F] | scaleB[c & 0x1F];
+  }
   matrix.show();
-  delay(4000);
+  memcpy(px, presentShadow, sizeof(presentShadow));
+}
+
+void setBrightnessScale(uint8_t scale) {
+  if (scale == brightnessScale) return;
+  brightnessScale = scale;
+  rebuildScaleTables();
+  presentFrame();
 }
 
-uint16_t getScaledColor(uint8_t r, uint8_t g, uint8_t b) {
-  float scale = max(0.1f, brightnessLevel / 10.0f);
-  r = round(r * scale);
-  g = round(g * scale);
-  b = round(b * scale);
-  return matrix.color565(r, g, b);
+uint8_t getBrightnessScale() {
+  return brightnessScale;
+}
+
+uint8_t brightnessLevelToScale(int level) {
+  return (uint8_t)(constrain(level, 1, 10) * 255 / 10);
 }
 
 void checkBrightnessUpdate() {
-  String path = "/novaFrame/devices/" + getSanitizedMac() + "/settings/brightness";
-  if (Firebase.RTDB.getInt(&fbdo, path.c_str())) {
+  if (lanApi.isUnsynced(SettingsField::BRIGHTNESS)) return;  // A LAN change Firebase hasn't taken yet
+  Tracer::countRequest(Endpoint::RTDB);
+  if (Firebase.RTDB.getInt(&fbdo, getSettingsPath(SettingsField::BRIGHTNESS))) {
     int newVal = constrain(fbdo.intData(), 1, 10);
     if (newVal != brightnessLevel) {
       brightnessLevel = newVal;
@@ -146,38 +234,30 @@ void checkBrightnessUpdate() {
 }
 
 void checkTimeFormatUpdate() {
-  String path = "/novaFrame/devices/" + getSanitizedMac() + "/settings/timeFormat";
-  if (Firebase.RTDB.getInt(&fbdo, path.c_str())) {
+  if (lanApi.isUnsynced(SettingsField::TIME_FORMAT)) return;
+  Tracer::countRequest(Endpoint::RTDB);
+  if (Firebase.RTDB.getInt(&fbdo, getSettingsPath(SettingsField::TIME_FORMAT))) {
     int newVal = fbdo.intData();
     if (newVal != timeFormatPreference) {
       timeFormatPreference = newVal;
       Serial.printf("🔄 Time format updated to: %d\n", timeFormatPreference);
-      BaseApp* current = appManager.getActiveApp();
-      if (current) {
-        current->setNeedsRedraw(true);
-      }
     }
   }
 }
 
 void checkUnitsUpdate() {
-  String path = "/novaFrame/devices/" + getSanitizedMac() + "/settings/units";
-  if (Firebase.RTDB.getString(&fbdo, path.c_str())) {
-    String newVal = fbdo.stringData();
-    if (newVal != units) {
-      units = newVal;
-      Serial.println("🔄 Units updated to: " + units);
-      lastWeatherFetchTime = 0;
-      updateWeatherCache();
-      BaseApp* current = appManager.getActiveApp();
-      if (current) {
-        current->setNeedsRedraw(true);
-      }
+  if (lanApi.isUnsynced(SettingsField::UNITS)) return;
+  Tracer::countRequest(Endpoint::RTDB);
+  if (Firebase.RTDB.getString(&fbdo, getSettingsPath(SettingsField::UNITS))) {
+    const char* newVal = fbdo.to<const char*>();
+    if (newVal && strcmp(newVal, units) != 0) {
+      strlcpy(units, newVal, UNITS_MAX_LEN);
+      Serial.printf("🔄 Units updated to: %s\n", units);  // Cached in canonical units; the loop re-renders
     }
   }
 }
 
-void drawCenteredText(const String& text, int x, int y) {
+void drawCenteredText(const char* text, int x, int y) {
   int16_t x1, y1;
   uint16_t w, h;
 
@@ -187,17 +267,17 @@ void drawCenteredText(const String& text, int x, int y) {
 
   int16_t xPos = x - w / 2;
   matrix.setCursor(xPos, y);
-  matrix.setTextColor(getScaledColor(255, 255, 255));
+  matrix.setTextColor(matrix.color565(255, 255, 255));
   matrix.print(text);
-  matrix.show();
+  presentFrame();
 }
 
-void drawSmallText(const String& text, int x, int y) {
+void drawSmallText(const char* text, int x, int y) {
   matrix.setTextSize(1);
   matrix.setTextWrap(false);
   matrix.setCursor(x, y);
-  matrix.setTextColor(getScaledColor(192, 192, 192));
+  matrix.setTextColor(matrix.color565(192, 192, 192));
   matrix.print(text);
-  matrix.show();
+  presentFrame();
 }
 
@@ -5,10 +5,10 @@
 #include <WiFi.h>
 #include "WeatherCache.h"
 #include "TimeCache.h"
+#include "PanelGeometry.h"
 
-#define PANEL_WIDTH 64
-#define PANEL_HEIGHT 32
 #define NEOPIXEL_PIN 21
+#define STATUS_PIXEL_ENABLED (Panel::addrLines < 5)  // 64-row panels need GPIO 21 as address line E
 
 extern Adafruit_Protomatter matrix;
 extern Adafruit_NeoPixel pixel;
@@ -21,10 +21,15 @@ void showWifiInfo();
 void showConnectingToWiFi();
 void showWifiNotSetNotice();
 void showJoinInstructions();
-void showWelcome();
-uint16_t getScaledColor(uint8_t r, uint8_t g, uint8_t b);
+void drawSplashFrame(const char* status);  // One frame of the animated boot splash
+bool animateSplashUntil(bool (*done)(), unsigned long timeoutMs, const char* status);  // False on timeout
+void presentFrame();               // matrix.show(), unless an off-screen render is in progress
+void setBrightnessScale(uint8_t scale);  // 0–255; re-presents the current frame, no app redraw
+uint8_t getBrightnessScale();
+uint8_t brightnessLevelToScale(int level);  // Manual 1–10 setting to a scale
+void holdPresent(bool hold);       // While held, drawing stays in the canvas and is not shown
 void checkBrightnessUpdate();
 void checkTimeFormatUpdate();
 void checkUnitsUpdate();
-void drawCenteredText(const String& text, int x, int y);
-void drawSmallText(const String& text, int x, int y);
\ No newline at end of file
+void drawCenteredText(const char* text, int x, int y);
+void drawSmallText(const char* text, int x, int y);
\ No newline at end of file
@@ -3,10 +3,30 @@
 #include <vector>
 #include <ArduinoJson.h>
 #include "DeviceRegistration.h"
+#include "Trace.h"
 
 extern FirebaseData fbdo;
 extern String deviceID;
 
+bool parseEnabledApps(const char* json, std::vector<String>& apps) {
+  StaticJsonDocument<2048> doc;
+  DeserializationError err = deserializeJson(doc, json);
+  if (err) {
+    Serial.printf("❌ Failed to parse JSON: %s\n", err.c_str());
+    return false;
+  }
+
+  apps.clear();
+  for (JsonPair kv : doc.as<JsonObject>()) {
+    const char* appName = kv.key().c_str();
+    JsonObject appData = kv.value().as<JsonObject>();
+    if (appData["enabled"] == true) {
+      apps.push_back(String(appName));
+    }
+  }
+  return true;
+}
+
 bool getEnabledAppsFromFirebase(std::vector<String>& enabledApps, bool forceRefresh) {
   static String lastJsonStr = "";
   static std::vector<String> lastEnabledApps;
@@ -21,36 +41,26 @@ bool getEnabledAppsFromFirebase(std::vector<String>& enabledApps, bool forceRefr
     return false;
   }
 
-  String appsPath = "/novaFrame/devices/" + deviceID + "/apps";
-  if (!Firebase.RTDB.getJSON(&fbdo, appsPath.c_str())) {
+  // Path and text buffers are reused so an unchanged poll doesn't touch the heap
+  static char appsPath[64];
+  snprintf(appsPath, sizeof(appsPath), "/novaFrame/devices/%s/apps", deviceID.c_str());
+  Tracer::countRequest(Endpoint::RTDB);
+  if (!Firebase.RTDB.getJSON(&fbdo, appsPath)) {
     Serial.printf("❌ Failed to get apps JSON: %s\n", fbdo.errorReason().c_str());
     return false;
   }
 
-  String jsonStr;
+  static String jsonStr;
   fbdo.jsonObject().toString(jsonStr, true);
 
-  // If same as last successful JSON, skip parsing
-  if (!forceRefresh && jsonStr == lastJsonStr) {
+  // If same as last successful JSON, skip parsing; the text was just fetched, so this holds on a forced refresh too
+  if (jsonStr == lastJsonStr) {
     enabledApps = lastEnabledApps;
     return true;
   }
 
-  StaticJsonDocument<2048> doc;
-  DeserializationError err = deserializeJson(doc, jsonStr);
-  if (err) {
-    Serial.printf("❌ Failed to parse JSON: %s\n", err.c_str());
-    return false;
-  }
-
   std::vector<String> apps;
-  for (JsonPair kv : doc.as<JsonObject>()) {
-    const char* appName = kv.key().c_str();
-    JsonObject appData = kv.value().as<JsonObject>();
-    if (appData["enabled"] == true) {
-      apps.push_back(String(appName));
-    }
-  }
+  if (!parseEnabledApps(jsonStr.c_str(), apps)) return false;
 
   enabledApps = apps;
   lastEnabledApps = apps;
@@ -75,6 +85,7 @@ bool fetchAppSequenceFromFirebase(std::vector<String>& sequence, bool forceRefre
   String path = "/novaFrame/devices/" + deviceID + "/settings/appSequence";
   Serial.println("📡 Fetching appSequence from: " + path);
 
+  Tracer::countRequest(Endpoint::RTDB);
   if (!Firebase.RTDB.getArray(&fbdo, path.c_str())) {
     Serial.println("❌ Failed to fetch appSequence: " + fbdo.errorReason());
     return false;
@@ -123,6 +134,7 @@ bool setAppSequenceToFirebase(const std::vector<String>& sequence) {
   FirebaseJson json;
   json.set("appSequence", jsonArray);
 
+  Tracer::countRequest(Endpoint::RTDB);
   if (!Firebase.RTDB.updateNode(&fbdo, path.c_str(), &json)) {
     Serial.printf("❌ Failed to write appSequence: %s\n", fbdo.errorReason().c_str());
     return false;
@@ -5,5 +5,7 @@
 
 // Returns enabled apps in order from Firebase, e.g. ["weather", "clockWeather"]
 bool getEnabledAppsFromFirebase(std::vector<String>& enabledApps, bool forceRefresh);
+// Parses the /apps node — { "<id>": { "enabled": true, ... } } — keeping enabled ids in order
+bool parseEnabledApps(const char* json, std::vector<String>& apps);
 bool fetchAppSequenceFromFirebase(std::vector<String>& sequence, bool forceRefresh);
 bool setAppSequenceToFirebase(const std::vector<String>& sequence);
\ No newline at end of file
@@ -3,21 +3,32 @@
 #include "WeatherCache.h"
 #include "DisplayHelpers.h"
 #include "WeatherIcons.h"              // ✅ Bitmap icon rendering
+#include "FrameKernels.h"
 #include "Adafruit_Protomatter.h"
 
 extern Adafruit_Protomatter matrix;
 
+// Today on the left two-thirds, tomorrow on the right, a one-pixel divider between them
+constexpr Region TODAY = CONTENT.leftFraction(2, 3);
+constexpr int16_t DIVIDER_X = TODAY.x + TODAY.w;
+constexpr Region TOMORROW = CONTENT.rightOf(DIVIDER_X);
+static_assert(Panel::width != 64 || (DIVIDER_X == 42 && TOMORROW.right() == 63), "64x32 layout matches the original");
+
+void ForecastApp::prepare() {
+  updateWeatherCache();
+}
+
 void ForecastApp::init() {
   scrollX = 0;
   startTime = millis();
   setNeedsRedraw(true);  // <== ✅ This is the KEY line
-  matrix.fillScreen(0);
+  clearFrame();
 
   Serial.println("📟 ForecastApp initialized");
-  Serial.println("Day1: " + weatherData.forecastDay1);
-  Serial.println("Icon1: " + weatherData.icon1);
-  Serial.println("High1: " + weatherData.forecastHigh1);
-  Serial.println("Low1: " + weatherData.forecastLow1);
+  Serial.printf("Day1: %s\n", getWeekdayName(weatherData.today.weekday));
+  Serial.printf("Icon1: %d\n", weatherData.today.icon);
+  Serial.printf("High1: %d\n", weatherData.today.high10);
+  Serial.printf("Low1: %d\n", weatherData.today.low10);
 }
 
 void ForecastApp::loop() {
@@ -29,60 +40,58 @@ void ForecastApp::loop() {
 
 void ForecastApp::redraw(bool force, int xOffset) {
   if (!force && !needsRedraw) return;
-  matrix.fillScreen(0);
+  clearFrame();
 
-  char degree = 247;
-  String high1 = weatherData.forecastHigh1 + degree;
-  String low1  = weatherData.forecastLow1 + degree;
-  String high2 = weatherData.forecastHigh2 + degree;
-  String low2  = weatherData.forecastLow2 + degree;
+  char high1[8], low1[8], high2[8], low2[8];
+  formatDegrees(high1, sizeof(high1), weatherData.today.high10);
+  formatDegrees(low1, sizeof(low1), weatherData.today.low10);
+  formatDegrees(high2, sizeof(high2), weatherData.tomorrow.high10);
+  formatDegrees(low2, sizeof(low2), weatherData.tomorrow.low10);
 
-  uint16_t white = getScaledColor(255, 255, 255);
-  uint16_t dividerBlue = getScaledColor(0, (uint8_t)(128 * 0.3), (uint8_t)(255 * 0.3));
+  uint16_t white = matrix.color565(255, 255, 255);
+  uint16_t dividerBlue = matrix.color565(0, (uint8_t)(128 * 0.3), (uint8_t)(255 * 0.3));
 
   // ───── LEFT SIDE ─────
-  drawWeatherIcon(weatherData.icon1, -4, -8); // 32x32, left-aligned
-  drawSmallText(weatherData.forecastDay1, 2, 24); // bottom-left corner
+  drawWeatherIcon(weatherData.today.icon, TODAY.col(-4), TODAY.row(-8)); // 32x32, left-aligned
+  drawSmallText(getWeekdayName(weatherData.today.weekday), TODAY.col(2), TODAY.row(24)); // bottom-left corner
 
   matrix.setTextColor(white);
 
   int16_t x1, y1;
   uint16_t w, h;
-  int rightEdgeLeft = 41;  // 1px left of divider
-
-  matrix.getTextBounds(high1.c_str(), 0, 0, &x1, &y1, &w, &h);
-  matrix.setCursor(rightEdgeLeft - w, 14);
+  matrix.getTextBounds(high1, 0, 0, &x1, &y1, &w, &h);
+  matrix.setCursor(TODAY.right() - w, TODAY.row(14));
   matrix.print(high1);
 
-  matrix.getTextBounds(low1.c_str(), 0, 0, &x1, &y1, &w, &h);
-  matrix.setCursor(rightEdgeLeft - w, 24);
+  matrix.getTextBounds(low1, 0, 0, &x1, &y1, &w, &h);
+  matrix.setCursor(TODAY.right() - w, TODAY.row(24));
   matrix.print(low1);
 
   // ───── DIVIDER ─────
-  for (int y = 0; y < 32; y++) {
-    matrix.drawPixel(42, y, dividerBlue);
-  }
+  fillSpanV(DIVIDER_X, SCREEN.y, SCREEN.h, dividerBlue);
 
   // ───── RIGHT SIDE ─────
-  drawSmallText(weatherData.forecastDay2, 45, 1); // top-right
-
-  int rightEdgeRight = 63; // max pixel on 64px width
+  drawSmallText(getWeekdayName(weatherData.tomorrow.weekday), TOMORROW.col(2), TOMORROW.row(1)); // top-right
 
-  matrix.getTextBounds(high2.c_str(), 0, 0, &x1, &y1, &w, &h);
-  matrix.setCursor(rightEdgeRight - w, 14);
+  matrix.getTextBounds(high2, 0, 0, &x1, &y1, &w, &h);
+  matrix.setCursor(TOMORROW.right() - w, TOMORROW.row(14));
   matrix.print(high2);
 
-  matrix.getTextBounds(low2.c_str(), 0, 0, &x1, &y1, &w, &h);
-  matrix.setCursor(rightEdgeRight - w, 24);
+  matrix.getTextBounds(low2, 0, 0, &x1, &y1, &w, &h);
+  matrix.setCursor(TOMORROW.right() - w, TOMORROW.row(24));
   matrix.print(low2);
 
-  matrix.show();
+  presentFrame();
 }
 
 void ForecastApp::setNeedsRedraw(bool flag) {
   needsRedraw = flag;
 }
 
+unsigned long ForecastApp::getNextUpdateMs() {
+  return needsRedraw ? 0 : LOOP_MAX_IDLE_MS;  // Only changes with the weather cache
+}
+
 bool ForecastApp::getNeedsRedraw() {
   return needsRedraw;
 }
\ No newline at end of file
@@ -4,11 +4,13 @@
 
 class ForecastApp : public BaseApp {
 public:
+  void prepare() override;
   void init() override;
   void loop() override;
   void redraw(bool force = false, int xOffset = 0) override;
   void setNeedsRedraw(bool flag) override;
   bool getNeedsRedraw() override;
+  unsigned long getNextUpdateMs() override;
   String getAppId() override { return "forecast"; }
 
 private:
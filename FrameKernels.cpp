@@ -0,0 +1,98 @@
+#include "FrameKernels.h"
+#include "DisplayHelpers.h"
+
+// Rows here are at most a few hundred bytes, so 32-bit stores (two pixels each) already run
+// at memory speed; 128-bit PIE stores would spend their gain on alignment setup per span.
+static inline void fillRow(uint16_t* dst, int n, uint16_t color) {
+  if (n <= 0) return;
+  if ((uintptr_t)dst & 2) {  // Bring the pointer to a word boundary
+    *dst++ = color;
+    n--;
+  }
+  uint32_t pair = ((uint32_t)color << 16) | color;
+  uint32_t* words = (uint32_t*)dst;
+  int pairs = n >> 1;
+  while (pairs >= 4) {
+    words[0] = pair;
+    words[1] = pair;
+    words[2] = pair;
+    words[3] = pair;
+    words += 4;
+    pairs -= 4;
+  }
+  while (pairs-- > 0) *words++ = pair;
+  if (n & 1) *(uint16_t*)words = color;
+}
+
+void clearFrame() {
+  memset(matrix.getBuffer(), 0, Panel::pixels * sizeof(uint16_t));
+}
+
+void fillSpanH(int x, int y, int w, uint16_t color) {
+  if (y < 0 || y >= Panel::height) return;
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (x + w > Panel::width) w = Panel::width - x;
+  fillRow(matrix.getBuffer() + y * Panel::width + x, w, color);
+}
+
+void fillSpanV(int x, int y, int h, uint16_t color) {
+  if (x < 0 || x >= Panel::width) return;
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (y + h > Panel::height) h = Panel::height - y;
+  uint16_t* dst = matrix.getBuffer() + y * Panel::width + x;
+  for (int i = 0; i < h; i++, dst += Panel::width) *dst = color;
+}
+
+void fillRectFast(int x, int y, int w, int h, uint16_t color) {
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > Panel::width) w = Panel::width - x;
+  if (y + h > Panel::height) h = Panel::height - y;
+  if (w <= 0 || h <= 0) return;
+
+  uint16_t* row = matrix.getBuffer() + y * Panel::width + x;
+  if (x == 0 && w == Panel::width) {
+    fillRow(row, w * h, color);  // Full-width rows are contiguous
+    return;
+  }
+  for (int r = 0; r < h; r++, row += Panel::width) fillRow(row, w, color);
+}
+
+void blitMask(const uint8_t* mask, int w, int h, int x, int y, uint16_t color) {
+  int rowBytes = (w + 7) / 8;
+  int firstRow = max(0, -y);
+  int lastRow = min(h, Panel::height - y);
+  int firstCol = max(0, -x);
+  int lastCol = min(w, Panel::width - x);
+  if (firstRow >= lastRow || firstCol >= lastCol) return;
+
+  uint16_t* frame = matrix.getBuffer();
+  for (int r = firstRow; r < lastRow; r++) {
+    const uint8_t* src = mask + r * rowBytes;
+    uint16_t* dst = frame + (y + r) * Panel::width + x;
+    for (int b = firstCol >> 3; b <= (lastCol - 1) >> 3; b++) {
+      uint8_t bits = src[b];
+      if (!bits) continue;  // Icons are mostly empty — skip whole bytes
+      if (bits == 0xFF && b * 8 >= firstCol && b * 8 + 8 <= lastCol) {
+        fillRow(dst + b * 8, 8, color);
+        continue;
+      }
+      for (int k = 0; k < 8; k++) {
+        int col = b * 8 + k;
+        if ((bits & (0x80 >> k)) && col >= firstCol && col < lastCol) dst[col] = color;
+      }
+    }
+  }
+}
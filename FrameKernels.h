@@ -0,0 +1,16 @@
+// FrameKernels.h
+#pragma once
+
+#include <Arduino.h>
+
+// Span kernels that write rows of the Protomatter canvas directly, bypassing the per-pixel
+// virtual drawPixel path. All of them clip to the panel; colours are RGB565. Unlike Adafruit_GFX,
+// a zero or negative width/height draws nothing rather than being flipped.
+void clearFrame();                                              // Whole canvas to black
+void fillSpanH(int x, int y, int w, uint16_t color);            // One row segment
+void fillSpanV(int x, int y, int h, uint16_t color);            // One column segment
+void fillRectFast(int x, int y, int w, int h, uint16_t color);
+
+// 1bpp mask, rows padded to whole bytes, MSB first — the same layout as Adafruit_GFX::drawBitmap.
+// Set bits take the colour, clear bits are left untouched.
+void blitMask(const uint8_t* mask, int w, int h, int x, int y, uint16_t color);
@@ -0,0 +1,109 @@
+#include "GeoCache.h"
+#include <WiFi.h>
+#include "SecretsManager.h"
+
+#define GEO_CACHE_FORMAT 1
+#define GEO_CACHE_FIELDS 9
+
+static void copyField(char* dst, size_t len, const char* src, size_t srcLen) {
+  size_t n = min(srcLen, len - 1);
+  memcpy(dst, src, n);
+  dst[n] = '\0';
+}
+
+// Numbers must fill their field exactly: strtod/strtoul skip leading whitespace, tabs included, so an
+// empty field would otherwise read the next one
+static bool numberField(const char* field, size_t len, double& out) {
+  char* end;
+  out = strtod(field, &end);
+  return len > 0 && !isspace((unsigned char)field[0]) && end == field + len;
+}
+
+static bool unsignedField(const char* field, size_t len, int base, unsigned long& out) {
+  char* end;
+  out = strtoul(field, &end, base);
+  return len > 0 && isxdigit((unsigned char)field[0]) && end == field + len;
+}
+
+size_t formatGeoLocation(const GeoLocation& loc, char* buf, size_t len) {
+  int n = snprintf(buf, len, "%d\t%08lx\t%s\t%.4f\t%.4f\t%lu\t%s\t%s\t%s", GEO_CACHE_FORMAT,
+                   (unsigned long)loc.network, loc.publicIp, loc.lat, loc.lon, (unsigned long)loc.resolvedAt,
+                   loc.timezone, loc.city, loc.region);
+  return (n < 0 || (size_t)n >= len) ? 0 : n;
+}
+
+bool parseGeoLocation(const char* text, GeoLocation& loc) {
+  const char* fields[GEO_CACHE_FIELDS];
+  size_t lens[GEO_CACHE_FIELDS];
+  int count = 0;
+  const char* start = text;
+  for (const char* p = text;; p++) {
+    if (*p != '\t' && *p != '\0') continue;
+    if (count == GEO_CACHE_FIELDS) return false;
+    fields[count] = start;
+    lens[count++] = p - start;
+    if (*p == '\0') break;
+    start = p + 1;
+  }
+  if (count != GEO_CACHE_FIELDS || atoi(fields[0]) != GEO_CACHE_FORMAT) return false;
+
+  double lat, lon;
+  unsigned long network, resolvedAt;
+  if (!unsignedField(fields[1], lens[1], 16, network) || !numberField(fields[3], lens[3], lat) ||
+      !numberField(fields[4], lens[4], lon) || !unsignedField(fields[5], lens[5], 10, resolvedAt)) {
+    return false;
+  }
+
+  GeoLocation parsed;
+  parsed.network = network;
+  copyField(parsed.publicIp, sizeof(parsed.publicIp), fields[2], lens[2]);
+  parsed.lat = lat;
+  parsed.lon = lon;
+  parsed.resolvedAt = resolvedAt;
+  copyField(parsed.timezone, sizeof(parsed.timezone), fields[6], lens[6]);
+  copyField(parsed.city, sizeof(parsed.city), fields[7], lens[7]);
+  copyField(parsed.region, sizeof(parsed.region), fields[8], lens[8]);
+  if (parsed.lat == 0.0 || parsed.lon == 0.0) return false;
+
+  loc = parsed;
+  return true;
+}
+
+uint32_t GeoCache::networkFingerprint() {
+  if (WiFi.status() != WL_CONNECTED) return 0;
+  const uint8_t* bssid = WiFi.BSSID();
+  if (!bssid) return 0;
+
+  uint32_t hash = 2166136261u;
+  String ssid = WiFi.SSID();
+  for (size_t i = 0; i < ssid.length(); i++) hash = (hash ^ (uint8_t)ssid[i]) * 16777619u;
+  for (int i = 0; i < 6; i++) hash = (hash ^ bssid[i]) * 16777619u;
+  return hash ? hash : 1;  // 0 means "no network"
+}
+
+bool GeoCache::lookup(GeoLocation& loc) {
+  const char* raw = SecretsManager::getRaw(GEO_CACHE_KEY);
+  if (raw[0] == '\0') return false;
+
+  GeoLocation cached;
+  if (!parseGeoLocation(raw, cached)) {
+    Serial.println("⚠️ Cached location unreadable — resolving again");
+    return false;
+  }
+  uint32_t network = networkFingerprint();
+  if (network == 0 || cached.network != network) return false;
+
+  loc = cached;
+  return true;
+}
+
+bool GeoCache::isExpired(const GeoLocation& loc, time_t now) {
+  if (now <= 0 || loc.resolvedAt == 0) return false;
+  return (uint32_t)now - loc.resolvedAt > GEO_CACHE_TTL_SEC;
+}
+
+bool GeoCache::store(const GeoLocation& loc) {
+  char value[GEO_IP_MAX_LEN + GEO_TZ_MAX_LEN + 2 * GEO_PLACE_MAX_LEN + 64];
+  if (!formatGeoLocation(loc, value, sizeof(value))) return false;
+  return SecretsManager::set(GEO_CACHE_KEY, value);  // Unchanged values don't touch flash
+}
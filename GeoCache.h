@@ -0,0 +1,35 @@
+// GeoCache.h
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+
+#define GEO_CACHE_KEY "GEO_CACHE"
+#define GEO_CACHE_TTL_SEC (30UL * 24 * 60 * 60)  // Re-resolve monthly even if the network never changes
+#define GEO_IP_MAX_LEN 40                        // Fits an IPv6 address
+#define GEO_PLACE_MAX_LEN 48                     // City, region
+#define GEO_TZ_MAX_LEN 40                        // IANA name, e.g. "America/Argentina/Buenos_Aires"
+
+// Last resolved location, valid while the device stays on the network it was resolved on
+struct GeoLocation {
+  uint32_t network = 0;                  // networkFingerprint() at resolve time
+  char publicIp[GEO_IP_MAX_LEN] = "";
+  float lat = 0.0;
+  float lon = 0.0;
+  uint32_t resolvedAt = 0;               // TimeCache epoch; 0 if the clock wasn't synced yet
+  char timezone[GEO_TZ_MAX_LEN] = "";
+  char city[GEO_PLACE_MAX_LEN] = "";
+  char region[GEO_PLACE_MAX_LEN] = "";
+};
+
+// Pure: one tab-separated flash value, "1\t<network>\t<ip>\t<lat>\t<lon>\t<resolvedAt>\t<tz>\t<city>\t<region>"
+size_t formatGeoLocation(const GeoLocation& loc, char* buf, size_t len);
+bool parseGeoLocation(const char* text, GeoLocation& loc);
+
+class GeoCache {
+public:
+  static uint32_t networkFingerprint();               // FNV-1a of SSID + BSSID, 0 while not connected
+  static bool lookup(GeoLocation& loc);               // False unless the entry was resolved on this network
+  static bool isExpired(const GeoLocation& loc, time_t now);  // Never while the clock is unsynced
+  static bool store(const GeoLocation& loc);
+};
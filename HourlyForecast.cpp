@@ -0,0 +1,34 @@
+#include "HourlyForecast.h"
+
+HourlyForecast hourlyForecast;
+
+void HourlyForecast::clear() {
+  head = 0;
+  count = 0;
+}
+
+void HourlyForecast::push(const HourlySample& sample) {
+  uint8_t tail = (head + count) % HOURLY_CAPACITY;
+  samples[tail] = sample;
+  if (count < HOURLY_CAPACITY) {
+    count++;
+  } else {
+    head = (head + 1) % HOURLY_CAPACITY;  // Overwrite oldest
+  }
+}
+
+void HourlyForecast::commit(time_t firstHour) {
+  startTime = firstHour;
+  revision++;
+}
+
+const HourlySample& HourlyForecast::at(size_t i) const {
+  return samples[(head + i) % HOURLY_CAPACITY];
+}
+
+uint8_t HourlyForecast::packIcon(const char* iconCode) {
+  if (!iconCode || !isdigit(iconCode[0]) || !isdigit(iconCode[1])) return 0;
+  uint8_t id = (iconCode[0] - '0') * 10 + (iconCode[1] - '0');
+  if (iconCode[2] == 'n') id |= 0x80;
+  return id;
+}
@@ -0,0 +1,38 @@
+// HourlyForecast.h
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+
+#define HOURLY_CAPACITY 48
+
+// One hour of forecast, packed into 4 bytes
+struct HourlySample {
+  int16_t temp10;   // Temperature in tenths of a degree Celsius
+  uint8_t pop;      // Precipitation probability, 0–100 %
+  uint8_t icon;     // OpenWeather icon number, high bit set for night ("10n")
+};
+
+// Fixed-size ring buffer of hourly samples, filled from the One Call "hourly" array
+class HourlyForecast {
+public:
+  void clear();
+  void push(const HourlySample& sample);
+  void commit(time_t firstHour);  // Marks a completed update
+
+  size_t size() const { return count; }
+  const HourlySample& at(size_t i) const;  // 0 = oldest
+  time_t getStartTime() const { return startTime; }
+  uint32_t getRevision() const { return revision; }
+
+  static uint8_t packIcon(const char* iconCode);
+
+private:
+  HourlySample samples[HOURLY_CAPACITY];
+  uint8_t head = 0;
+  uint8_t count = 0;
+  time_t startTime = 0;
+  uint32_t revision = 0;
+};
+
+extern HourlyForecast hourlyForecast;
@@ -0,0 +1,252 @@
+#include "KVStore.h"
+#include <rom/crc.h>
+
+#define KV_HEADER_MAGIC 0x564B464E   // "NFKV"
+#define KV_RECORD_MAGIC 0xA55A
+#define KV_HEADER_SIZE 16
+
+struct KVHeader {
+  uint32_t magic;
+  uint32_t seq;
+  uint32_t crc;
+  uint32_t reserved;
+};
+
+struct KVRecord {
+  uint16_t magic;
+  uint8_t keyLen;      // Includes the terminating '\0'
+  uint8_t reserved;
+  uint16_t valueLen;   // Includes the terminating '\0'
+  uint16_t pad;
+  uint32_t crc;        // Over keyLen, valueLen, key and value
+};
+
+static uint32_t alignUp(uint32_t v) {
+  return (v + 3) & ~3u;
+}
+
+static uint32_t recordCrc(uint8_t keyLen, uint16_t valueLen, const char* key, const char* value) {
+  uint8_t lens[3] = { keyLen, (uint8_t)(valueLen & 0xFF), (uint8_t)(valueLen >> 8) };
+  uint32_t crc = crc32_le(0, lens, sizeof(lens));
+  crc = crc32_le(crc, (const uint8_t*)key, keyLen);
+  return crc32_le(crc, (const uint8_t*)value, valueLen);
+}
+
+static bool isErased(const uint8_t* p, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (p[i] != 0xFF) return false;
+  }
+  return true;
+}
+
+static uint32_t headerCrc(uint32_t seq) {
+  uint32_t words[2] = { KV_HEADER_MAGIC, seq };
+  return crc32_le(0, (const uint8_t*)words, sizeof(words));
+}
+
+bool KVStore::begin(uint32_t offset, size_t regionSize) {
+  flashOffset = offset;
+  halfSize = regionSize / 2;
+  if (!lock) lock = xSemaphoreCreateMutex();
+
+  const void* ptr = nullptr;
+  esp_err_t err = spi_flash_mmap(flashOffset, regionSize, SPI_FLASH_MMAP_DATA, &ptr, &mmapHandle);
+  if (err != ESP_OK) {
+    Serial.printf("❌ Flash mmap failed: %s\n", esp_err_to_name(err));
+    return false;
+  }
+  base = (const uint8_t*)ptr;
+
+  // The half with the newest valid header is active
+  uint32_t seqA = readSeq(0);
+  uint32_t seqB = readSeq(1);
+  if (seqA == 0 && seqB == 0) {
+    activeHalf = -1;
+    entryCount = 0;
+    return true;
+  }
+
+  return scanHalf(seqA >= seqB ? 0 : 1);
+}
+
+uint32_t KVStore::readSeq(int half) const {
+  const KVHeader* h = (const KVHeader*)(base + half * halfSize);
+  if (h->magic != KV_HEADER_MAGIC || h->seq == 0xFFFFFFFF || h->crc != headerCrc(h->seq)) return 0;
+  return h->seq;
+}
+
+bool KVStore::scanHalf(int half) {
+  activeHalf = half;
+  activeSeq = readSeq(half);
+  entryCount = 0;
+  needsCompaction = false;
+
+  const uint8_t* start = base + half * halfSize;
+  uint32_t off = KV_HEADER_SIZE;
+
+  while (off + sizeof(KVRecord) <= halfSize) {
+    const KVRecord* rec = (const KVRecord*)(start + off);
+    if (rec->magic == 0xFFFF && isErased((const uint8_t*)rec, sizeof(KVRecord))) break;  // End of log
+
+    uint32_t len = alignUp(sizeof(KVRecord) + rec->keyLen + rec->valueLen);
+    const char* key = (const char*)(rec + 1);
+    const char* value = key + rec->keyLen;
+
+    if (rec->magic != KV_RECORD_MAGIC || rec->keyLen == 0 || rec->valueLen == 0 ||
+        off + len > halfSize || rec->crc != recordCrc(rec->keyLen, rec->valueLen, key, value)) {
+      // Torn append from a power cut — everything before it is intact
+      Serial.printf("⚠️ KV log: invalid record at 0x%04x, compacting on next write\n", off);
+      needsCompaction = true;
+      break;
+    }
+
+    int idx = findEntry(key);
+    if (idx >= 0) {
+      entries[idx].value = value;
+    } else if (entryCount < KV_MAX_KEYS) {
+      entries[entryCount++] = { key, value };
+    }
+    off += len;
+  }
+
+  tail = off;
+  return true;
+}
+
+int KVStore::findEntry(const char* key) const {
+  for (size_t i = 0; i < entryCount; i++) {
+    if (strcmp(entries[i].key, key) == 0) return i;
+  }
+  return -1;
+}
+
+const char* KVStore::get(const char* key) const {
+  xSemaphoreTake(lock, portMAX_DELAY);
+  int idx = findEntry(key);
+  const char* value = idx >= 0 ? entries[idx].value : nullptr;
+  xSemaphoreGive(lock);
+  return value;
+}
+
+bool KVStore::appendRecord(uint32_t offset, const char* key, const char* value, uint32_t& next) {
+  size_t keyLen = strlen(key) + 1;
+  size_t valueLen = strlen(value) + 1;
+  if (keyLen > 0xFF || valueLen > 0xFFFF) return false;
+
+  uint32_t len = alignUp(sizeof(KVRecord) + keyLen + valueLen);
+  if (offset + len > halfSize) return false;
+
+  KVRecord rec;
+  rec.magic = KV_RECORD_MAGIC;
+  rec.keyLen = keyLen;
+  rec.reserved = 0xFF;
+  rec.valueLen = valueLen;
+  rec.pad = 0xFFFF;
+  rec.crc = recordCrc(keyLen, valueLen, key, value);
+
+  // Header first: once any byte of a record is programmed the slot is claimed,
+  // and a cut before the payload completes fails the CRC on the next scan
+  uint32_t addr = halfOffset(activeHalf) + offset;
+  if (spi_flash_write(addr, &rec, sizeof(rec)) != ESP_OK ||
+      spi_flash_write(addr + sizeof(KVRecord), key, keyLen) != ESP_OK ||
+      spi_flash_write(addr + sizeof(KVRecord) + keyLen, value, valueLen) != ESP_OK) {
+    needsCompaction = true;
+    return false;
+  }
+
+  next = offset + len;
+  return true;
+}
+
+void KVStore::indexRecord(uint32_t offset) {
+  const KVRecord* rec = (const KVRecord*)(base + activeHalf * halfSize + offset);
+  const char* key = (const char*)(rec + 1);
+  const char* value = key + rec->keyLen;
+
+  int idx = findEntry(key);
+  if (idx >= 0) {
+    entries[idx].value = value;
+  } else if (entryCount < KV_MAX_KEYS) {
+    entries[entryCount++] = { key, value };
+  }
+}
+
+bool KVStore::compactInto(int half, const char* const* keys, const char* const* values, size_t n) {
+  uint32_t addr = halfOffset(half);
+  if (spi_flash_erase_range(addr, halfSize) != ESP_OK) {
+    Serial.println("❌ KV compaction erase failed");
+    return false;
+  }
+
+  // Write live records into the fresh half while the old one stays active
+  int oldHalf = activeHalf;
+  activeHalf = half;
+  uint32_t off = KV_HEADER_SIZE;
+  bool ok = true;
+
+  for (size_t i = 0; i < entryCount && ok; i++) {
+    bool replaced = false;
+    for (size_t j = 0; j < n; j++) {
+      if (strcmp(entries[i].key, keys[j]) == 0) replaced = true;
+    }
+    if (!replaced) ok = appendRecord(off, entries[i].key, entries[i].value, off);
+  }
+  for (size_t j = 0; j < n && ok; j++) {
+    ok = appendRecord(off, keys[j], values[j], off);
+  }
+
+  // Commit: the new header makes this half the newest
+  KVHeader h = { KV_HEADER_MAGIC, activeSeq + 1, headerCrc(activeSeq + 1), 0xFFFFFFFF };
+  if (!ok || spi_flash_write(addr, &h, sizeof(h)) != ESP_OK) {
+    Serial.println("❌ KV compaction failed — keeping previous copy");
+    activeHalf = oldHalf;
+    return false;
+  }
+
+  Serial.printf("🧹 KV log compacted into half %d (seq %u)\n", half, (unsigned)(activeSeq + 1));
+  return scanHalf(half);
+}
+
+bool KVStore::set(const char* key, const char* value) {
+  return setMany(&key, &value, 1);
+}
+
+bool KVStore::setMany(const char* const* keys, const char* const* values, size_t n) {
+  xSemaphoreTake(lock, portMAX_DELAY);
+
+  size_t newKeys = 0;
+  bool changed = false;
+  for (size_t i = 0; i < n; i++) {
+    int idx = findEntry(keys[i]);
+    if (idx < 0) newKeys++;
+    if (idx < 0 || strcmp(entries[idx].value, values[i]) != 0) changed = true;
+  }
+
+  if (!changed) {
+    xSemaphoreGive(lock);
+    return true;  // Unchanged — no flash wear
+  }
+  if (entryCount + newKeys > KV_MAX_KEYS) {
+    xSemaphoreGive(lock);
+    Serial.println("❌ KV store full");
+    return false;
+  }
+
+  // A single record is atomic on its own; batches go through compaction so
+  // they land under one header commit
+  bool ok = false;
+  uint32_t recordOffset = tail;
+  uint32_t next;
+  if (n == 1 && activeHalf >= 0 && !needsCompaction && appendRecord(tail, keys[0], values[0], next)) {
+    tail = next;
+    indexRecord(recordOffset);
+    ok = true;
+  } else {
+    // Empty stores compact into half 1 so a legacy image in half 0 survives until commit
+    int target = activeHalf == 1 ? 0 : 1;
+    ok = compactInto(target, keys, values, n);
+  }
+
+  xSemaphoreGive(lock);
+  return ok;
+}
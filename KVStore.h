@@ -0,0 +1,56 @@
+// KVStore.h
+#pragma once
+
+#include <Arduino.h>
+#include <esp_spi_flash.h>
+
+#define KV_MAX_KEYS 32
+
+// Append-only key/value log in raw flash, split into two halves that take turns
+// being active. Updates append a CRC-checked record; when a half fills up the live
+// records are compacted into the other half, whose header is written last so a
+// power cut at any point leaves one complete copy. Reads are served straight from
+// a memory-mapped view through an index built at boot.
+class KVStore {
+public:
+  bool begin(uint32_t flashOffset, size_t regionSize);
+
+  // Zero-copy: points into mapped flash, valid until the next set()
+  const char* get(const char* key) const;
+  bool set(const char* key, const char* value);
+  bool setMany(const char* const* keys, const char* const* values, size_t n);  // All or nothing
+
+  size_t count() const { return entryCount; }
+  const char* keyAt(size_t i) const { return entries[i].key; }
+
+  bool isEmpty() const { return activeHalf < 0; }
+  const uint8_t* rawRegion() const { return base; }  // For legacy migration
+
+private:
+  struct Entry {
+    const char* key;
+    const char* value;
+  };
+
+  bool scanHalf(int half);
+  bool compactInto(int half, const char* const* keys, const char* const* values, size_t n);
+  bool appendRecord(uint32_t offset, const char* key, const char* value, uint32_t& next);
+  void indexRecord(uint32_t offset);  // Points the index at a record in the active half
+  int findEntry(const char* key) const;
+  uint32_t halfOffset(int half) const { return flashOffset + half * halfSize; }
+  uint32_t readSeq(int half) const;
+
+  uint32_t flashOffset = 0;
+  size_t halfSize = 0;
+  const uint8_t* base = nullptr;
+  spi_flash_mmap_handle_t mmapHandle = 0;
+
+  int activeHalf = -1;
+  uint32_t activeSeq = 0;
+  uint32_t tail = 0;              // Next free byte within the active half
+  bool needsCompaction = false;   // Torn or corrupt record found at the tail
+
+  Entry entries[KV_MAX_KEYS];
+  size_t entryCount = 0;
+  SemaphoreHandle_t lock = nullptr;
+};
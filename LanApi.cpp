@@ -0,0 +1,291 @@
+#include "LanApi.h"
+#include <WebServer.h>
+#include <ESPmDNS.h>
+#include <ArduinoJson.h>
+#include <esp_heap_caps.h>
+#include "AppManager.h"
+#include "AmbientLight.h"
+#include "PowerManager.h"
+#include "Trace.h"
+#include "LoopScheduler.h"
+#include "SecretsManager.h"
+
+extern AppManager appManager;
+extern FirebaseData fbdo;
+
+LanApi lanApi;
+
+static WebServer server(LAN_API_PORT);
+static QueueHandle_t commandQueue = nullptr;
+static portMUX_TYPE snapshotMux = portMUX_INITIALIZER_UNLOCKED;
+static LanSnapshot snapshot;
+static char token[LAN_API_TOKEN_MAX];   // Copied at begin(); the HTTP task never reads the store
+
+static void sendJson(int code, const JsonDocument& doc) {
+  String body;
+  serializeJson(doc, body);
+  server.send(code, "application/json", body);
+}
+
+static void sendError(int code, const char* message) {
+  StaticJsonDocument<128> doc;
+  doc["error"] = message;
+  sendJson(code, doc);
+}
+
+// Writes must present the LAN_API_TOKEN secret as "Authorization: Bearer <token>" or X-Auth-Token.
+// With no token provisioned the API is read-only.
+static bool authorize() {
+  if (!token[0]) {
+    sendError(403, "writes disabled: no LAN_API_TOKEN provisioned");
+    return false;
+  }
+  String presented = server.header("X-Auth-Token");
+  String auth = server.header("Authorization");
+  if (auth.startsWith("Bearer ")) presented = auth.substring(7);
+
+  // Constant time: every byte of the token is compared whatever the guess
+  size_t len = strlen(token);
+  uint8_t diff = presented.length() != len;
+  for (size_t i = 0; i < len; i++) diff |= (uint8_t)presented.charAt(i) ^ (uint8_t)token[i];
+  if (diff) {
+    server.sendHeader("WWW-Authenticate", "Bearer");
+    sendError(401, "missing or wrong token");
+    return false;
+  }
+  return true;
+}
+
+static void handleGetSettings() {
+  LanSnapshot s = lanApi.readSnapshot();
+  StaticJsonDocument<512> doc;
+  doc["brightness"] = s.brightness;
+  doc["autoBrightness"] = s.autoBrightness;
+  doc["timeFormat"] = s.timeFormat;
+  doc["units"] = s.units;
+  doc["app"] = AppRegistry::getName(s.activeApp);
+  JsonArray apps = doc.createNestedArray("apps");
+  for (int i = 0; i < s.enabledCount; i++) apps.add(AppRegistry::getName(s.enabledApps[i]));
+  sendJson(200, doc);
+}
+
+// Body is a partial settings object, e.g. {"brightness":4} — every field is checked, then all are
+// queued as one command
+static void handlePutSettings() {
+  if (!authorize()) return;
+  StaticJsonDocument<256> doc;
+  if (deserializeJson(doc, server.arg("plain")) || !doc.is<JsonObject>()) {
+    sendError(400, "expected a JSON object");
+    return;
+  }
+
+  LanCommand command = {};
+  command.type = LanCommandType::SETTINGS;
+  if (doc.containsKey("brightness")) {
+    command.brightness = doc["brightness"] | 0;
+    if (command.brightness < 1 || command.brightness > 10) return sendError(400, "brightness must be 1-10");
+    command.fields |= LAN_SET_BRIGHTNESS;
+  }
+  if (doc.containsKey("timeFormat")) {
+    command.timeFormat = doc["timeFormat"] | -1;
+    if (command.timeFormat < 0 || command.timeFormat > 2) return sendError(400, "timeFormat must be 0-2");
+    command.fields |= LAN_SET_TIME_FORMAT;
+  }
+  if (doc.containsKey("units")) {
+    const char* value = doc["units"] | "";
+    if (strcmp(value, "metric") != 0 && strcmp(value, "imperial") != 0) {
+      return sendError(400, "units must be metric or imperial");
+    }
+    strlcpy(command.units, value, UNITS_MAX_LEN);
+    command.fields |= LAN_SET_UNITS;
+  }
+  if (!command.fields) return sendError(400, "no known settings in body");
+
+  if (!lanApi.enqueue(command)) return sendError(503, "busy, try again");
+  server.send(202, "application/json", "{\"accepted\":true}");
+}
+
+static void handleJumpToApp() {
+  if (!authorize()) return;
+  String name = server.arg("name");
+  AppId id = AppRegistry::findId(name.c_str());
+  LanSnapshot s = lanApi.readSnapshot();
+  bool enabled = false;
+  for (int i = 0; i < s.enabledCount; i++) enabled |= s.enabledApps[i] == id;
+  if (id == AppId::NONE || !enabled) return sendError(404, "app not enabled");
+
+  LanCommand command = {};
+  command.type = LanCommandType::JUMP_TO_APP;
+  command.app = id;
+  if (!lanApi.enqueue(command)) return sendError(503, "busy, try again");
+  server.send(202, "application/json", "{\"accepted\":true}");
+}
+
+static void handleMetrics() {
+  LanSnapshot s = lanApi.readSnapshot();
+  StaticJsonDocument<512> doc;
+  doc["uptimeMs"] = s.uptimeMs;
+  doc["freeHeap"] = s.freeHeap;
+  doc["largestBlock"] = s.largestBlock;
+  doc["rssi"] = s.rssi;
+  doc["app"] = AppRegistry::getName(s.activeApp);
+  doc["brightnessScale"] = s.brightnessScale;
+  doc["panelBlanked"] = s.panelBlanked;
+  doc["lastSwitchUs"] = s.lastSwitchMicros;
+  doc["maxSwitchUs"] = s.maxSwitchMicros;
+  doc["redrawP95Us"] = s.redrawP95Micros;
+  doc["presentP95Us"] = s.presentP95Micros;
+  sendJson(200, doc);
+}
+
+static void serverTask(void*) {
+  for (;;) {
+    server.handleClient();
+    vTaskDelay(pdMS_TO_TICKS(5));
+  }
+}
+
+void LanApi::begin() {
+  commandQueue = xQueueCreate(LAN_API_COMMAND_QUEUE, sizeof(LanCommand));
+  publishSnapshot();
+  strlcpy(token, SecretsManager::getRaw(LAN_API_TOKEN_KEY), sizeof(token));
+  if (!token[0]) Serial.println("⚠️ No LAN_API_TOKEN secret — LAN API is read-only");
+
+  char hostname[32];
+  snprintf(hostname, sizeof(hostname), "novaframe-%s", getMacId() + 8);  // Last four hex digits
+  if (MDNS.begin(hostname)) {
+    MDNS.addService("http", "tcp", LAN_API_PORT);
+    Serial.printf("🏠 LAN API at http://%s.local/api\n", hostname);
+  } else {
+    Serial.println("⚠️ mDNS failed — LAN API reachable by IP only");
+  }
+
+  server.on("/api/settings", HTTP_GET, handleGetSettings);
+  server.on("/api/settings", HTTP_PUT, handlePutSettings);
+  server.on("/api/settings", HTTP_POST, handlePutSettings);
+  server.on("/api/app", HTTP_POST, handleJumpToApp);
+  server.on("/api/metrics", HTTP_GET, handleMetrics);
+  server.onNotFound([]() { sendError(404, "not found"); });
+  static const char* authHeaders[] = { "Authorization", "X-Auth-Token" };
+  server.collectHeaders(authHeaders, 2);
+  server.begin();
+
+  xTaskCreatePinnedToCore(serverTask, "lanApi", LAN_API_TASK_STACK, nullptr, 1, nullptr, LAN_API_TASK_CORE);
+}
+
+void LanApi::publishSnapshot() {
+  LanSnapshot s;
+  s.uptimeMs = millis();
+  s.freeHeap = ESP.getFreeHeap();
+  s.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  s.rssi = WiFi.RSSI();
+  s.activeApp = appManager.getActiveAppId();
+  const std::vector<AppId>& apps = appManager.getEnabledApps();
+  s.enabledCount = min(apps.size(), (size_t)AppId::COUNT);
+  for (int i = 0; i < s.enabledCount; i++) s.enabledApps[i] = apps[i];
+  s.brightness = brightnessLevel;
+  s.brightnessScale = getBrightnessScale();
+  s.autoBrightness = ambientLight.isActive();
+  s.panelBlanked = powerManager.isPanelBlanked();
+  s.timeFormat = timeFormatPreference;
+  strlcpy(s.units, units, UNITS_MAX_LEN);
+  s.lastSwitchMicros = appManager.getLastSwitchMicros();
+  s.maxSwitchMicros = appManager.getMaxSwitchMicros();
+  s.redrawP95Micros = Tracer::percentileMicros(TraceSpan::REDRAW, 95);
+  s.presentP95Micros = Tracer::percentileMicros(TraceSpan::PRESENT, 95);
+
+  portENTER_CRITICAL(&snapshotMux);
+  snapshot = s;
+  portEXIT_CRITICAL(&snapshotMux);
+}
+
+LanSnapshot LanApi::readSnapshot() {
+  portENTER_CRITICAL(&snapshotMux);
+  LanSnapshot s = snapshot;
+  portEXIT_CRITICAL(&snapshotMux);
+  return s;
+}
+
+bool LanApi::enqueue(const LanCommand& command) {
+  if (!commandQueue || xQueueSend(commandQueue, &command, 0) != pdTRUE) return false;
+  wakeMainLoop();  // Applied on the next pass instead of after the current idle
+  return true;
+}
+
+bool LanApi::isUnsynced(SettingsField field) const {
+  switch (field) {
+    case SettingsField::BRIGHTNESS: return unsynced & LAN_SET_BRIGHTNESS;
+    case SettingsField::TIME_FORMAT: return unsynced & LAN_SET_TIME_FORMAT;
+    case SettingsField::UNITS: return unsynced & LAN_SET_UNITS;
+    default: return false;
+  }
+}
+
+void LanApi::applyPending() {
+  if (!commandQueue) return;
+  LanCommand command;
+  while (xQueueReceive(commandQueue, &command, 0) == pdTRUE) {
+    apply(command);
+  }
+  if (unsynced && millis() - lastSyncMs >= LAN_API_SYNC_RETRY_MS) syncSettings();
+}
+
+// Applies locally first; the settings node is then written by syncSettings()
+void LanApi::apply(const LanCommand& command) {
+  BaseApp* current = appManager.getActiveApp();
+
+  switch (command.type) {
+    case LanCommandType::SETTINGS:
+      if (command.fields & LAN_SET_BRIGHTNESS) {
+        brightnessLevel = command.brightness;
+        if (!ambientLight.isActive()) setBrightnessScale(brightnessLevelToScale(brightnessLevel));
+        Serial.printf("🏠 Brightness set to %d over LAN\n", brightnessLevel);
+      }
+      if (command.fields & LAN_SET_TIME_FORMAT) {
+        timeFormatPreference = command.timeFormat;
+        Serial.printf("🏠 Time format set to %d over LAN\n", timeFormatPreference);
+      }
+      if (command.fields & LAN_SET_UNITS) {
+        strlcpy(units, command.units, UNITS_MAX_LEN);
+        Serial.printf("🏠 Units set to %s over LAN\n", units);
+      }
+      if ((command.fields & (LAN_SET_TIME_FORMAT | LAN_SET_UNITS)) && current) current->setNeedsRedraw(true);
+      unsynced |= command.fields;
+      syncSettings();
+      break;
+
+    case LanCommandType::JUMP_TO_APP:
+      powerManager.notifyActivity();
+      appManager.jumpTo(command.app);
+      break;
+  }
+}
+
+// Writes the current value of every field a LAN change left unsynced; a field stays unsynced (and
+// the poll keeps off it) until its write succeeds, retried every LAN_API_SYNC_RETRY_MS
+void LanApi::syncSettings() {
+  lastSyncMs = millis();
+  TRACE_SCOPE(NETWORK);
+  FrameUnlocked unlocked;
+  if (unsynced & LAN_SET_BRIGHTNESS) {
+    Tracer::countRequest(Endpoint::RTDB);
+    if (Firebase.RTDB.setInt(&fbdo, getSettingsPath(SettingsField::BRIGHTNESS), brightnessLevel)) {
+      unsynced &= ~LAN_SET_BRIGHTNESS;
+    }
+  }
+  if (unsynced & LAN_SET_TIME_FORMAT) {
+    Tracer::countRequest(Endpoint::RTDB);
+    if (Firebase.RTDB.setInt(&fbdo, getSettingsPath(SettingsField::TIME_FORMAT), timeFormatPreference)) {
+      unsynced &= ~LAN_SET_TIME_FORMAT;
+    }
+  }
+  if (unsynced & LAN_SET_UNITS) {
+    Tracer::countRequest(Endpoint::RTDB);
+    if (Firebase.RTDB.setString(&fbdo, getSettingsPath(SettingsField::UNITS), units)) {
+      unsynced &= ~LAN_SET_UNITS;
+    }
+  }
+  if (unsynced) {
+    Serial.printf("⚠️ LAN change not written to Firebase, retrying: %s\n", fbdo.errorReason().c_str());
+  }
+}
@@ -0,0 +1,75 @@
+// LanApi.h
+#pragma once
+
+#include <Arduino.h>
+#include "AppRegistry.h"
+#include "DeviceRegistration.h"
+
+#define LAN_API_PORT 80
+#define LAN_API_TASK_STACK 6144
+#define LAN_API_TASK_CORE 0           // The loop (and rendering) runs on core 1
+#define LAN_API_COMMAND_QUEUE 8
+#define LAN_API_SYNC_RETRY_MS 5000    // Until a LAN change reaches the settings node
+#define LAN_API_TOKEN_KEY "LAN_API_TOKEN"   // Secret that writes must present
+#define LAN_API_TOKEN_MAX 65
+
+// What the HTTP task may read. Published by the loop each pass so handlers never touch live state.
+struct LanSnapshot {
+  unsigned long uptimeMs;
+  uint32_t freeHeap;
+  uint32_t largestBlock;
+  int rssi;
+  AppId activeApp;
+  AppId enabledApps[(int)AppId::COUNT];
+  uint8_t enabledCount;
+  int brightness;
+  uint8_t brightnessScale;
+  bool autoBrightness;
+  bool panelBlanked;
+  int timeFormat;
+  char units[UNITS_MAX_LEN];
+  unsigned long lastSwitchMicros;
+  unsigned long maxSwitchMicros;
+  uint32_t redrawP95Micros;
+  uint32_t presentP95Micros;
+};
+
+enum class LanCommandType : uint8_t { SETTINGS, JUMP_TO_APP };
+
+// Which settings a SETTINGS command carries; also the write-backs still owed to Firebase
+#define LAN_SET_BRIGHTNESS 0x01
+#define LAN_SET_TIME_FORMAT 0x02
+#define LAN_SET_UNITS 0x04
+
+// Queued by the HTTP task, applied by the loop — Firebase and the canvas stay single-threaded.
+// A whole PUT is one command, so it is queued (and applied) all or nothing.
+struct LanCommand {
+  LanCommandType type;
+  uint8_t fields;             // LAN_SET_*
+  int brightness;
+  int timeFormat;
+  char units[UNITS_MAX_LEN];
+  AppId app;
+};
+
+class LanApi {
+public:
+  void begin();               // After Wi-Fi is up: mDNS name + server task
+  void publishSnapshot();     // Once per loop pass
+  void applyPending();        // Once per loop pass; also writes changes back to the settings node
+
+  LanSnapshot readSnapshot();
+  bool enqueue(const LanCommand& command);
+
+  // A LAN change not yet in Firebase; the settings poll skips the field so it isn't reverted
+  bool isUnsynced(SettingsField field) const;
+
+private:
+  void apply(const LanCommand& command);
+  void syncSettings();
+
+  uint8_t unsynced = 0;       // LAN_SET_*
+  unsigned long lastSyncMs = 0;
+};
+
+extern LanApi lanApi;
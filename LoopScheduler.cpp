@@ -0,0 +1,60 @@
+#include "LoopScheduler.h"
+
+static TaskHandle_t loopTaskHandle = nullptr;
+static SemaphoreHandle_t frameLock = nullptr;
+static unsigned long idleMicros = 0;
+static unsigned long windowStartMicros = 0;
+static const char* windowApp = nullptr;  // Registry names are static, so the pointer is enough
+
+#define IDLE_REPORT_INTERVAL_US 60000000UL
+
+void initLoopScheduler() {
+  loopTaskHandle = xTaskGetCurrentTaskHandle();
+  windowStartMicros = micros();
+  frameLock = xSemaphoreCreateMutex();
+}
+
+void lockFrame() {
+  if (frameLock) xSemaphoreTake(frameLock, portMAX_DELAY);
+}
+
+void unlockFrame() {
+  if (frameLock) xSemaphoreGive(frameLock);
+}
+
+void wakeMainLoop() {
+  if (loopTaskHandle) xTaskNotifyGive(loopTaskHandle);
+}
+
+void IRAM_ATTR wakeMainLoopFromISR() {
+  if (!loopTaskHandle) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(loopTaskHandle, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+void idleUntilNextDeadline(unsigned long timeoutMs) {
+  timeoutMs = min(timeoutMs, (unsigned long)LOOP_MAX_IDLE_MS);
+  if (timeoutMs == 0) return;
+
+  unsigned long start = micros();
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs));
+  idleMicros += micros() - start;
+}
+
+void reportIdleStats(const char* appName) {
+  unsigned long now = micros();
+  unsigned long elapsed = now - windowStartMicros;
+  bool appChanged = appName != windowApp;
+
+  if (!appChanged && elapsed < IDLE_REPORT_INTERVAL_US) return;
+
+  if (windowApp && elapsed > 0) {
+    Serial.printf("💤 %s idle %.1f%% over %lus\n", windowApp,
+                  idleMicros * 100.0f / elapsed, elapsed / 1000000UL);
+  }
+
+  windowApp = appName;
+  windowStartMicros = now;
+  idleMicros = 0;
+}
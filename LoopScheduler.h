@@ -0,0 +1,32 @@
+// LoopScheduler.h
+#pragma once
+
+#include <Arduino.h>
+
+#define LOOP_MAX_IDLE_MS 1000     // Upper bound so Firebase/Wi-Fi housekeeping still runs
+#define LOOP_DEFAULT_TICK_MS 100  // Apps that don't declare a deadline keep the old polling rate
+
+void initLoopScheduler();                 // Call from setup() on the loop task
+void wakeMainLoop();                      // Ends the current idle early (any task)
+void IRAM_ATTR wakeMainLoopFromISR();     // Same, from an interrupt handler
+
+// Blocks for up to timeoutMs or until woken, and accounts the time as idle
+void idleUntilNextDeadline(unsigned long timeoutMs);
+
+// The canvas, the panel and the app state belong to whichever task holds the frame lock: the loop
+// task for its pass, the button task while it acts on a gesture. The loop lets go while it idles
+// and across its own network waits, so a press never queues behind them. No-ops before
+// initLoopScheduler().
+void lockFrame();
+void unlockFrame();
+
+class FrameUnlocked {
+public:
+  FrameUnlocked() { unlockFrame(); }
+  ~FrameUnlocked() { lockFrame(); }
+  FrameUnlocked(const FrameUnlocked&) = delete;
+  FrameUnlocked& operator=(const FrameUnlocked&) = delete;
+};
+
+// Logs idle % for the active app once a minute, and whenever the active app changes
+void reportIdleStats(const char* appName);
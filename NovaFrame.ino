@@ -1,152 +1,233 @@
 #include "DeviceRegistration.h"
 #include "DisplayHelpers.h"
 #include "BaseApp.h"
-#include "ClockWeatherApp.h"
-#include "ClockApp.h"
-#include "WeatherApp.h"
 #include "AppManager.h"
 #include "WiFiPortalCustomizer.h"
 #include "WeatherCache.h"
 #include "TimeCache.h"
 #include <HTTPClient.h>
 #include <Update.h>
-#include <map>
 #include "OTAUpdater.h"
 #include "RemoteConfigManager.h"
-#include "ForecastApp.h"
+#include "LoopScheduler.h"
+#include "PowerManager.h"
+#include "Trace.h"
+#include "Benchmarks.h"
+#include "AmbientLight.h"
+#include "ButtonInput.h"
+#include "LanApi.h"
+#include "StreamReceiver.h"
+#include "ClipStore.h"
+#include "BootTimeline.h"
+#include "SecretsManager.h"
 
 #define BUTTON_PIN A1
-#define HOLD_TIME 2000
 
 AppManager appManager;
-ClockApp clockApp;
-ClockWeatherApp clockWeatherApp;
-WeatherApp weatherApp;
 TimeCache timeCache;
-ForecastApp forecastApp;
-
-std::map<String, BaseApp*> appRegistry;
 
 WiFiManager wm;
-unsigned long buttonPressStart = 0;
-bool buttonHeld = false;
 bool isUpdating = false;
 unsigned long lastOTACheck = 0;
-const unsigned long OTA_INTERVAL = 60 * 60 * 1000;
 static bool geoUpdated = false;
+static bool deviceRegistered = false;  // Registration waits for Firebase if setup gave up on it
+
+static void handleButtonEvent(ButtonEvent event);
 
 void setup() {
   Serial.begin(115200);
-  delay(150);
+
+  // 📶 Start associating first — panel, secrets and splash all overlap with it
+  BootTimeline::start(BootStage::WIFI);
+  beginWiFi();
 
   Wire.begin();
   pinMode(LED_BUILTIN, OUTPUT);
   digitalWrite(LED_BUILTIN, HIGH);
-  pinMode(BUTTON_PIN, INPUT_PULLUP);
 
-  // 🔧 Initialize display and Wi-Fi
-  initializeDisplay();
-  showWelcome();
-  initializeWiFi();
+  // 💤 Main loop sleeps between deadlines; gestures are handled on their own task, which waits for
+  // the frame lock this pass (and setup) hold while they draw
+  initLoopScheduler();
+  lockFrame();
+  buttonInput.begin(BUTTON_PIN, handleButtonEvent);
 
-  // 🌐 Connect to Firebase
+  // 🔧 Panel up and the splash on it before anything slow
+  BootTimeline::start(BootStage::PANEL);
+  initializeDisplay();
+  drawSplashFrame("Starting");
+  ambientLight.begin();
+  ClipStore::begin();
+  BootTimeline::finish(BootStage::PANEL);
+#if NOVAFRAME_BENCH
+  runBenchmarks();
+#endif
+
+  // 🔐 Flash reads while the radio associates
+  BootTimeline::start(BootStage::SECRETS);
+  SecretsManager::load();
+  BootTimeline::finish(BootStage::SECRETS);
+
+  initializeWiFi();             // Splash animates until connected; setup portal on timeout
+  BootTimeline::finish(BootStage::WIFI);
+  applyCachedLocation();        // Flash only, so time and weather have it even if the cloud is slow
+
+  // 🌐 Connect to Firebase (bounded — loop() catches up if the token is slow)
+  BootTimeline::start(BootStage::FIREBASE);
   initializeFirebase();
+  BootTimeline::finish(BootStage::FIREBASE);
 
-  // 📱 Register device (but defer geo/timezone fetch to later)
-  registerDeviceInFirebase(false);
-
-  // 📦 Initialize app registry
-  appRegistry["clock"] = &clockApp;
-  appRegistry["clockWeather"] = &clockWeatherApp;
-  appRegistry["weather"] = &weatherApp;
-  appRegistry["forecast"] = &forecastApp;
+  // 📱 Register device; resolves the location if there was no cached fix
+  BootTimeline::start(BootStage::REGISTER);
+  deviceRegistered = registerDeviceInFirebase(false);
+  lanApi.begin();               // Local settings/app control, advertised over mDNS
+  streamReceiver.begin();       // DDP / E1.31 frames from the LAN take over the panel while live
+  BootTimeline::finish(BootStage::REGISTER);
 
-  // 🔄 Load initial settings & cache
-  updateWeatherCache();         // Safe now — we have Wi-Fi and Firebase
+  BootTimeline::start(BootStage::TIME);
   timeCache.init();             // Uses stored lat/lon, skips if not available
+  BootTimeline::finish(BootStage::TIME);
 
-  showWifiInfo();
-  delay(2000);
-  matrix.fillScreen(0);
+  // 🚀 First real frame — weather apps show placeholders until the fetch below lands
+  BootTimeline::start(BootStage::APPS);
+  appManager.init();
+  BootTimeline::finish(BootStage::APPS);
+  BootTimeline::markFirstFrame();
 
-  // ✅ Wait for Firebase to be fully ready before OTA/app manager
-  while (!Firebase.ready()) {
-    Serial.println("⏳ Waiting for Firebase to be ready...");
-    delay(100);
-  }
+  BootTimeline::start(BootStage::WEATHER);
+  updateWeatherCache();
+  BootTimeline::finish(BootStage::WEATHER);
+  BaseApp* first = appManager.getActiveApp();
+  if (first) first->setNeedsRedraw(true);
 
-  // 🔁 Check for OTA update (optional, runs in foreground)
+  // 🔁 Check for OTA update (runs in the background)
   checkForOTAUpdate();
-  delay(2000);  // Optional: reduce if OTA is fast
+  lastOTACheck = millis();
 
-  // 🚀 Start app rotation
-  appManager.init();
-  matrix.show();
+  BootTimeline::print();
+  unlockFrame();
 }
 
-void loop() {
-  if (isUpdating) return;
-
-  bool buttonDown = digitalRead(BUTTON_PIN) == LOW;
-  unsigned long now = millis();
-
-  if (buttonDown) {
-    if (buttonPressStart == 0) {
-      buttonPressStart = now;
-    } else if (!buttonHeld && (now - buttonPressStart >= HOLD_TIME)) {
-      buttonHeld = true;
+// Runs on the button task with the frame lock held: the loop task is idle or waiting on the
+// network, so the new frame is up within one frame of the gesture. Nothing here may touch the
+// RTDB; the loop task owns fbdo.
+static void handleButtonEvent(ButtonEvent event) {
+  bool wasBlanked = powerManager.isPanelBlanked();
+  powerManager.notifyActivity();
+  if (wasBlanked) return;  // First press during the night schedule only wakes the panel (the loop's update())
+
+  switch (event) {
+    case ButtonEvent::SHORT_PRESS:
+      appManager.skipToNext();
+      break;
+    case ButtonEvent::DOUBLE_PRESS:
+      appManager.skipToPrevious();
+      break;
+    case ButtonEvent::LONG_PRESS:
       matrix.fillScreen(0);
-      showCenteredText("Reset WiFi", 12, matrix.color565(255, 0, 0));
+      showCenteredText("Reset WiFi", CONTENT.row(12), matrix.color565(255, 0, 0));
       matrix.show();
       wm.resetSettings();
       geoUpdated = false;
       delay(1000);
       ESP.restart();
-    }
-  } else {
-    buttonPressStart = 0;
-    buttonHeld = false;
+      break;
+    default:
+      break;
   }
+}
+
+void loop() {
+  if (isUpdating) return;
+
+  lockFrame();
+  lanApi.applyPending();
+  unsigned long now = millis();
 
   static unsigned long lastGlobalBrightnessCheck = 0;
   if (now - lastGlobalBrightnessCheck > 5000) {
-    int prevLevel = brightnessLevel;
     int prevTimeFormat = timeFormatPreference;
-    String prevUnits = getUnits();  // Ensure getter exists
-
-    checkBrightnessUpdate();
-    checkTimeFormatUpdate();
-    checkUnitsUpdate();
+    bool prevImperial = useImperialUnits();
+
+    {
+      TRACE_SCOPE(NETWORK);
+      FrameUnlocked unlocked;
+      checkBrightnessUpdate();
+      checkTimeFormatUpdate();
+      checkUnitsUpdate();
+    }
+    if (!ambientLight.isActive()) setBrightnessScale(brightnessLevelToScale(brightnessLevel));
 
     BaseApp* current = appManager.getActiveApp();
     if (current && (
-          brightnessLevel != prevLevel ||
           timeFormatPreference != prevTimeFormat ||
-          getUnits() != prevUnits)) {
+          useImperialUnits() != prevImperial)) {
       current->setNeedsRedraw(true);
     }
 
     lastGlobalBrightnessCheck = now;
   }
 
-  BaseApp* current = appManager.getActiveApp();
+  ClipStore::update();    // Lends the clip mapping to a download, remaps when it's done
+  ambientLight.update();  // Brightness changes re-present the current frame; apps don't redraw
+  powerManager.update();
+
+  // Night schedule: the panel holds a black frame, so skip rotation and rendering entirely
+  BaseApp* current = powerManager.isPanelBlanked() ? nullptr : appManager.getActiveApp();
   if (current) {
     appManager.loop();
 
     if (current->getNeedsRedraw()) {
+      TRACE_SCOPE(REDRAW);
       current->redraw(true);
       current->setNeedsRedraw(false);
     }
   }
 
-  delay(100);
-  if (millis() - lastOTACheck > OTA_INTERVAL) {
+  otaLoop();  // Progress bar + reboot once the new image is verified
+
+  // 💤 Sleep until the earliest deadline: app update, rotation/poll, settings check or a wakeup
+  unsigned long idleMs = powerManager.isPanelBlanked() ? LOOP_MAX_IDLE_MS : appManager.msUntilNextEvent();
+  BaseApp* active = appManager.getActiveApp();
+  if (active && !powerManager.isPanelBlanked()) {
+    idleMs = min(idleMs, active->getNextUpdateMs());
+    reportIdleStats(AppRegistry::getName(appManager.getActiveAppId()));
+  }
+  idleMs = min(idleMs, 5001UL - min(millis() - lastGlobalBrightnessCheck, 5001UL));
+  idleMs = min(idleMs, ambientLight.msUntilNextSample());
+  if (isOTAInProgress()) idleMs = min(idleMs, 250UL);  // Keep the progress bar moving
+  lanApi.publishSnapshot();
+  Tracer::endPass();
+  powerManager.beginIdle(idleMs);
+  {
+    FrameUnlocked unlocked;
+    idleUntilNextDeadline(idleMs);
+  }
+  powerManager.endIdle();
+  Tracer::beginPass();
+
+  {
+    TRACE_SCOPE(NETWORK);
+    FrameUnlocked unlocked;
+    RemoteConfigManager::refreshIfChanged();
+  }
+  if (!deviceRegistered && Firebase.ready()) {
+    TRACE_SCOPE(NETWORK);
+    FrameUnlocked unlocked;
+    deviceRegistered = registerDeviceInFirebase(false);
+  }
+  if (millis() - lastOTACheck > RemoteConfigManager::getDurationMs(ConfigKey::OTA_CHECK_SEC)) {
+    TRACE_SCOPE(NETWORK);
+    FrameUnlocked unlocked;
     checkForOTAUpdate();
     lastOTACheck = millis();
   }
   if (!geoUpdated && millis() > 15000 && Firebase.ready()) {
-    Serial.println("🌎 Updating geo + timezone after startup...");
+    TRACE_SCOPE(NETWORK);
+    FrameUnlocked unlocked;
+    Serial.println("🌎 Checking location after startup...");
     updateGeoLocationAndTimezone("/novaFrame/devices/" + getDeviceID() + "/settings");
     geoUpdated = true;
   }
+  Tracer::pushDiagnosticsIfDue();
+  unlockFrame();
 }
@@ -0,0 +1,520 @@
+#include "OTAUpdater.h"
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include <Update.h>
+#include <WiFiClient.h>
+#include <mbedtls/sha256.h>
+#include <esp_ota_ops.h>
+#include "DisplayHelpers.h"
+#include "FrameKernels.h"
+#include "SecretsManager.h"
+#include "LoopScheduler.h"
+#include "Trace.h"
+#include "ClipStore.h"
+
+extern Adafruit_Protomatter matrix;
+extern bool isUpdating;
+
+#define OTA_CHUNK_SIZE 1024
+#define OTA_MAX_ATTEMPTS 5           // Reconnects per check before waiting for the next one
+#define OTA_RETRY_DELAY_MS 5000
+#define OTA_STALL_TIMEOUT_MS 10000   // No data for this long = dropped connection
+#define OTA_TASK_STACK 10240
+
+// Delta patch stream ("NFP1"): header, then COPY/INSERT ops against the running image
+#define PATCH_MAGIC "NFP1"
+#define PATCH_OP_END 0x00
+#define PATCH_OP_COPY 0x01    // u32 source offset, u32 length
+#define PATCH_OP_INSERT 0x02  // u32 length, then that many literal bytes
+
+enum OTAStatus : uint8_t {
+  OTA_IDLE,
+  OTA_CHECKING,
+  OTA_DOWNLOADING,
+  OTA_READY,     // Verified and finalised — waiting for loop() to reboot
+  OTA_FAILED
+};
+
+// Download state survives across checks so a later check can resume
+struct OTAState {
+  String version;
+  String url;
+  String sha256;              // Expected lowercase hex digest from version.json
+  size_t total = 0;
+  size_t written = 0;
+  bool updateBegun = false;
+  mbedtls_sha256_context shaCtx;
+};
+
+static OTAState ota;
+static volatile OTAStatus otaStatus = OTA_IDLE;
+static TaskHandle_t otaTaskHandle = nullptr;
+
+static void resetDownload() {
+  if (ota.updateBegun) {
+    Update.abort();
+    mbedtls_sha256_free(&ota.shaCtx);
+  }
+  ota.updateBegun = false;
+  ota.total = 0;
+  ota.written = 0;
+}
+
+// Parses "bytes start-end/total" from a 206 response
+static size_t parseContentRangeTotal(const String& header) {
+  int slash = header.lastIndexOf('/');
+  if (slash < 0) return 0;
+  return (size_t)header.substring(slash + 1).toInt();
+}
+
+// Fills patchUrl when version.json lists a patch from currentVersion, and clipUrl/clipSha256 when it lists a clip
+static bool fetchManifest(const String& currentVersion, String& version, String& url, String& sha256, String& patchUrl,
+                          String& clipUrl, String& clipSha256) {
+  String otaJsonUrl = SecretsManager::get("OTA_JSON_URL");
+  if (otaJsonUrl == "") {
+    Serial.println("❌ Missing OTA_JSON_URL in secrets.");
+    return false;
+  }
+
+  HTTPClient http;
+  http.begin(otaJsonUrl);
+  Tracer::countRequest(Endpoint::OTA_MANIFEST);
+  int httpCode = http.GET();
+  if (httpCode != 200) {
+    Serial.println("❌ Failed to check version.json: " + http.errorToString(httpCode));
+    http.end();
+    return false;
+  }
+
+  DynamicJsonDocument doc(2048);
+  DeserializationError error = deserializeJson(doc, http.getString());
+  http.end();
+
+  if (error || !doc.containsKey("version") || !doc.containsKey("url") || !doc.containsKey("sha256")) {
+    Serial.println("❌ Invalid or missing keys in version.json");
+    return false;
+  }
+
+  version = doc["version"].as<String>();
+  url = doc["url"].as<String>();
+  sha256 = doc["sha256"].as<String>();
+  sha256.toLowerCase();
+  patchUrl = doc["patches"][currentVersion]["url"] | "";
+  clipUrl = doc["clip"]["url"] | "";
+  clipSha256 = doc["clip"]["sha256"] | "";
+  clipSha256.toLowerCase();
+  return true;
+}
+
+// Streams the image from ota.written onwards. Returns true once every byte is written.
+static bool downloadFromOffset() {
+  HTTPClient http;
+  const char* headerKeys[] = { "Content-Range" };
+  http.begin(ota.url);
+  Tracer::countRequest(Endpoint::OTA_IMAGE);
+  http.collectHeaders(headerKeys, 1);
+  http.addHeader("Range", "bytes=" + String(ota.written) + "-");
+
+  int code = http.GET();
+  size_t skip = 0;
+  size_t total = 0;
+
+  if (code == 206) {
+    total = parseContentRangeTotal(http.header("Content-Range"));
+  } else if (code == 200) {
+    // Server ignored the range — discard what we already have
+    total = http.getSize() > 0 ? (size_t)http.getSize() : 0;
+    skip = ota.written;
+  } else {
+    Serial.println("❌ Failed to fetch firmware: " + http.errorToString(code));
+    http.end();
+    return false;
+  }
+
+  if (total == 0 || (ota.total != 0 && total != ota.total)) {
+    Serial.printf("❌ Unexpected firmware size %u (expected %u). Restarting download.\n",
+                  (unsigned)total, (unsigned)ota.total);
+    resetDownload();
+    http.end();
+    return false;
+  }
+
+  if (!ota.updateBegun) {
+    if (!Update.begin(total)) {
+      Serial.println("❌ Not enough space for OTA.");
+      http.end();
+      return false;
+    }
+    mbedtls_sha256_init(&ota.shaCtx);
+    mbedtls_sha256_starts(&ota.shaCtx, 0);
+    ota.total = total;
+    ota.updateBegun = true;
+  }
+
+  Serial.printf("⬇️ Downloading firmware from offset %u / %u\n", (unsigned)ota.written, (unsigned)ota.total);
+
+  WiFiClient* stream = http.getStreamPtr();
+  uint8_t buf[OTA_CHUNK_SIZE];
+  unsigned long lastData = millis();
+
+  while (ota.written < ota.total) {
+    size_t avail = stream->available();
+    if (avail == 0) {
+      if (!http.connected() || millis() - lastData > OTA_STALL_TIMEOUT_MS) break;
+      vTaskDelay(pdMS_TO_TICKS(5));
+      continue;
+    }
+
+    int n = stream->readBytes(buf, min(avail, sizeof(buf)));
+    if (n <= 0) continue;
+    lastData = millis();
+
+    size_t offset = 0;
+    if (skip > 0) {
+      offset = min((size_t)n, skip);
+      skip -= offset;
+      if (offset == (size_t)n) continue;
+    }
+
+    size_t len = n - offset;
+    if (Update.write(buf + offset, len) != len) {
+      Serial.println("❌ OTA flash write failed.");
+      resetDownload();
+      break;
+    }
+    mbedtls_sha256_update(&ota.shaCtx, buf + offset, len);
+    ota.written += len;
+  }
+
+  http.end();
+  return ota.updateBegun && ota.written == ota.total;
+}
+
+static bool verifyAndFinish() {
+  uint8_t digest[32];
+  mbedtls_sha256_finish(&ota.shaCtx, digest);
+  mbedtls_sha256_free(&ota.shaCtx);
+
+  char hex[65];
+  for (int i = 0; i < 32; i++) {
+    sprintf(hex + i * 2, "%02x", digest[i]);
+  }
+
+  if (ota.sha256 != hex) {
+    Serial.printf("❌ SHA-256 mismatch: got %s, expected %s\n", hex, ota.sha256.c_str());
+    Update.abort();
+    ota.updateBegun = false;
+    return false;
+  }
+
+  ota.updateBegun = false;
+  if (!Update.end()) {
+    Serial.println("❌ OTA finalise failed.");
+    return false;
+  }
+  return true;
+}
+
+// Reads exactly len bytes from the patch stream, waiting out short gaps
+static bool readPatchBytes(HTTPClient& http, WiFiClient* stream, uint8_t* buf, size_t len) {
+  size_t got = 0;
+  unsigned long lastData = millis();
+  while (got < len) {
+    int n = stream->read(buf + got, len - got);
+    if (n > 0) {
+      got += n;
+      lastData = millis();
+    } else if (!http.connected() && stream->available() == 0) {
+      return false;
+    } else if (millis() - lastData > OTA_STALL_TIMEOUT_MS) {
+      return false;
+    } else {
+      vTaskDelay(pdMS_TO_TICKS(5));
+    }
+  }
+  return true;
+}
+
+static bool readPatchU32(HTTPClient& http, WiFiClient* stream, uint32_t& value) {
+  uint8_t b[4];
+  if (!readPatchBytes(http, stream, b, 4)) return false;
+  value = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+  return true;
+}
+
+static bool writeImageBytes(const uint8_t* data, size_t len) {
+  if (Update.write((uint8_t*)data, len) != len) {
+    Serial.println("❌ OTA flash write failed.");
+    return false;
+  }
+  mbedtls_sha256_update(&ota.shaCtx, data, len);
+  ota.written += len;
+  return true;
+}
+
+// Rebuilds the new image from the running partition plus a streamed patch.
+// RAM use is one chunk buffer regardless of image size.
+static bool applyDeltaPatch(const String& patchUrl) {
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  if (!running) return false;
+
+  HTTPClient http;
+  http.begin(patchUrl);
+  Tracer::countRequest(Endpoint::OTA_IMAGE);
+  int code = http.GET();
+  if (code != 200) {
+    Serial.println("❌ Failed to fetch patch: " + http.errorToString(code));
+    http.end();
+    return false;
+  }
+
+  WiFiClient* stream = http.getStreamPtr();
+  uint8_t buf[OTA_CHUNK_SIZE];
+  uint32_t newSize = 0;
+  uint32_t oldSize = 0;
+
+  if (!readPatchBytes(http, stream, buf, 4) || memcmp(buf, PATCH_MAGIC, 4) != 0 ||
+      !readPatchU32(http, stream, newSize) || !readPatchU32(http, stream, oldSize) ||
+      newSize == 0 || oldSize > running->size) {
+    Serial.println("❌ Invalid patch header.");
+    http.end();
+    return false;
+  }
+
+  if (!Update.begin(newSize)) {
+    Serial.println("❌ Not enough space for OTA.");
+    http.end();
+    return false;
+  }
+  mbedtls_sha256_init(&ota.shaCtx);
+  mbedtls_sha256_starts(&ota.shaCtx, 0);
+  ota.total = newSize;
+  ota.written = 0;
+  ota.updateBegun = true;
+
+  Serial.printf("🧩 Applying delta patch → %u bytes\n", (unsigned)newSize);
+
+  bool ok = true;
+  while (ok) {
+    uint8_t op;
+    if (!readPatchBytes(http, stream, &op, 1)) { ok = false; break; }
+    if (op == PATCH_OP_END) break;
+
+    if (op == PATCH_OP_COPY) {
+      uint32_t offset, len;
+      ok = readPatchU32(http, stream, offset) && readPatchU32(http, stream, len) &&
+           len <= oldSize && offset <= oldSize - len && len <= newSize - ota.written;
+      while (ok && len > 0) {
+        size_t n = min((size_t)len, sizeof(buf));
+        ok = esp_partition_read(running, offset, buf, n) == ESP_OK && writeImageBytes(buf, n);
+        offset += n;
+        len -= n;
+      }
+    } else if (op == PATCH_OP_INSERT) {
+      uint32_t len;
+      ok = readPatchU32(http, stream, len) && len <= newSize - ota.written;
+      while (ok && len > 0) {
+        size_t n = min((size_t)len, sizeof(buf));
+        ok = readPatchBytes(http, stream, buf, n) && writeImageBytes(buf, n);
+        len -= n;
+      }
+    } else {
+      Serial.printf("❌ Unknown patch op 0x%02x\n", op);
+      ok = false;
+    }
+  }
+  http.end();
+
+  if (!ok || ota.written != ota.total) {
+    Serial.println("❌ Delta patch incomplete or malformed.");
+    resetDownload();
+    return false;
+  }
+
+  if (!verifyAndFinish()) {
+    resetDownload();
+    return false;
+  }
+  return true;
+}
+
+// Same streaming + SHA-256 path as the firmware image, into the clips partition instead of Update.
+// Clips are small, so a dropped connection restarts the download rather than resuming it.
+static bool downloadClip(const String& url, const String& expectedSha256) {
+  if (expectedSha256 == SecretsManager::getRaw("CLIP_SHA256")) return true;
+
+  HTTPClient http;
+  http.begin(url);
+  Tracer::countRequest(Endpoint::CLIP);
+  int code = http.GET();
+  int total = http.getSize();
+  if (code != 200 || total <= 0) {
+    Serial.println("❌ Failed to fetch clip: " + http.errorToString(code));
+    http.end();
+    return false;
+  }
+
+  Serial.printf("⬇️ Downloading clip (%d bytes)\n", total);
+  // beginWrite erases the partition: until a new clip verifies, no digest may claim it holds one
+  if (!SecretsManager::set("CLIP_SHA256", "") || !ClipStore::beginWrite(total)) {
+    http.end();
+    return false;
+  }
+
+  mbedtls_sha256_context sha;
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+
+  WiFiClient* stream = http.getStreamPtr();
+  uint8_t buf[OTA_CHUNK_SIZE];
+  size_t written = 0;
+  unsigned long lastData = millis();
+  bool ok = true;
+  while (ok && written < (size_t)total) {
+    size_t avail = stream->available();
+    if (avail == 0) {
+      if (!http.connected() || millis() - lastData > OTA_STALL_TIMEOUT_MS) break;
+      vTaskDelay(pdMS_TO_TICKS(5));
+      continue;
+    }
+    int n = stream->readBytes(buf, min(avail, sizeof(buf)));
+    if (n <= 0) continue;
+    lastData = millis();
+    ok = ClipStore::write(written, buf, n);
+    mbedtls_sha256_update(&sha, buf, n);
+    written += n;
+  }
+  http.end();
+
+  uint8_t digest[32];
+  mbedtls_sha256_finish(&sha, digest);
+  mbedtls_sha256_free(&sha);
+  char hex[65];
+  for (int i = 0; i < 32; i++) {
+    sprintf(hex + i * 2, "%02x", digest[i]);
+  }
+
+  ok = ok && written == (size_t)total && expectedSha256 == hex;
+  ClipStore::endWrite(ok);
+  if (!ok) {
+    Serial.printf("❌ Clip download failed at %u / %d bytes (sha %s)\n", (unsigned)written, total, hex);
+    return false;
+  }
+  SecretsManager::set("CLIP_SHA256", expectedSha256);
+  Serial.println("✅ New clip downloaded and verified.");
+  return true;
+}
+
+static void endTask(OTAStatus status) {
+  otaStatus = status;
+  otaTaskHandle = nullptr;
+  wakeMainLoop();  // Let loop() pick up the result without waiting out its idle
+  vTaskDelete(nullptr);
+}
+
+// The whole check. Its Strings are destroyed when it returns, before otaTask deletes itself —
+// vTaskDelete(nullptr) never returns, so anything still in scope there would leak.
+static OTAStatus runOtaCheck() {
+  String currentVersion = SecretsManager::get("CURRENT_VERSION");
+  String newVersion, url, sha256, patchUrl, clipUrl, clipSha256;
+
+  if (currentVersion == "") {
+    Serial.println("❌ Missing CURRENT_VERSION in secrets.");
+    return OTA_IDLE;
+  }
+
+  if (!fetchManifest(currentVersion, newVersion, url, sha256, patchUrl, clipUrl, clipSha256)) {
+    return OTA_IDLE;
+  }
+
+  if (newVersion == currentVersion) {
+    Serial.println("✅ Firmware is already up to date.");
+    if (clipUrl != "" && clipSha256 != "") downloadClip(clipUrl, clipSha256);  // Content only once firmware is current
+    return OTA_IDLE;
+  }
+
+  // A different release than the partial download — start over
+  if (ota.version != newVersion || ota.url != url || ota.sha256 != sha256) {
+    resetDownload();
+    ota.version = newVersion;
+    ota.url = url;
+    ota.sha256 = sha256;
+  }
+
+  Serial.println("🔁 New firmware available: " + newVersion);
+  otaStatus = OTA_DOWNLOADING;
+
+  // Prefer a patch against the running image unless a full download is already underway
+  if (patchUrl != "" && !ota.updateBegun) {
+    if (applyDeltaPatch(patchUrl)) {
+      Serial.println("✅ Delta OTA complete and verified.");
+      SecretsManager::set("CURRENT_VERSION", newVersion);
+      return OTA_READY;
+    }
+    Serial.println("⚠️ Delta update failed. Falling back to full image.");
+  }
+
+  bool complete = false;
+  for (int attempt = 0; attempt < OTA_MAX_ATTEMPTS && !complete; attempt++) {
+    if (attempt > 0) {
+      Serial.printf("🔄 Resuming OTA at %u bytes (attempt %d)\n", (unsigned)ota.written, attempt + 1);
+      vTaskDelay(pdMS_TO_TICKS(OTA_RETRY_DELAY_MS));
+    }
+    complete = downloadFromOffset();
+  }
+
+  if (!complete) {
+    Serial.printf("⚠️ OTA paused at %u / %u bytes. Will resume on next check.\n",
+                  (unsigned)ota.written, (unsigned)ota.total);
+    return OTA_FAILED;
+  }
+
+  if (!verifyAndFinish()) {
+    resetDownload();
+    return OTA_FAILED;
+  }
+
+  Serial.println("✅ OTA Update complete and verified.");
+  SecretsManager::set("CURRENT_VERSION", newVersion);
+  return OTA_READY;
+}
+
+static void otaTask(void*) {
+  otaStatus = OTA_CHECKING;
+  endTask(runOtaCheck());
+}
+
+void checkForOTAUpdate() {
+  if (otaTaskHandle != nullptr || otaStatus == OTA_READY) return;
+
+  // Pinned to core 0 so the app loop on core 1 keeps rendering
+  if (xTaskCreatePinnedToCore(otaTask, "ota", OTA_TASK_STACK, nullptr, 1, &otaTaskHandle, 0) != pdPASS) {
+    Serial.println("❌ Could not start OTA task.");
+    otaTaskHandle = nullptr;
+  }
+}
+
+bool isOTAInProgress() {
+  return otaStatus == OTA_DOWNLOADING || otaStatus == OTA_READY;
+}
+
+void otaLoop() {
+  if (otaStatus == OTA_READY) {
+    isUpdating = true;
+    matrix.fillScreen(0);
+    showCenteredText("Updating", CONTENT.row(12), matrix.color565(255, 255, 255));
+    matrix.show();
+    delay(500);
+    Serial.println("🔁 Rebooting into new firmware...");
+    ESP.restart();
+    return;
+  }
+
+  if (otaStatus != OTA_DOWNLOADING || ota.total == 0) return;
+
+  // Thin bar along the bottom row, drawn over whatever the current app shows
+  int progress = (int)((uint64_t)ota.written * PANEL_WIDTH / ota.total);
+  fillSpanH(0, SCREEN.bottom(), Panel::width, 0);
+  fillSpanH(0, SCREEN.bottom(), progress, matrix.color565(0, 255, 64));
+  presentFrame();
+}
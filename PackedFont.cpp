@@ -0,0 +1,73 @@
+#include "PackedFont.h"
+#include "DisplayHelpers.h"
+
+static const PackedGlyph* findGlyph(const PackedFont& font, char c) {
+  uint8_t code = (uint8_t)c;
+  if (code < font.first || code > font.last) return nullptr;
+  const PackedGlyph* g = &font.glyphs[code - font.first];
+  return g->advance ? g : nullptr;  // Gaps in the table have no advance
+}
+
+static int kerning(const PackedFont& font, char left, char right) {
+  for (uint8_t i = 0; i < font.kernCount; i++) {
+    if (font.kerning[i].left == left && font.kerning[i].right == right) return font.kerning[i].adjust;
+  }
+  return 0;
+}
+
+int packedTextWidth(const PackedFont& font, const char* text) {
+  int pen = 0;
+  int left = INT16_MAX;
+  int right = 0;
+  for (const char* p = text; *p; p++) {
+    const PackedGlyph* g = findGlyph(font, *p);
+    if (!g) continue;
+    if (g->width) {
+      left = min(left, pen + g->xOffset);
+      right = max(right, pen + g->xOffset + g->width);
+    }
+    pen += g->advance + (p[1] ? kerning(font, p[0], p[1]) : 0);
+  }
+  return left == INT16_MAX ? 0 : right - left;
+}
+
+// One glyph, one row at a time: whole source bytes are tested before touching pixels
+static void blitGlyph(const PackedFont& font, const PackedGlyph& g, int x, int y, uint16_t color) {
+  int gx = x + g.xOffset;
+  int gy = y + g.top;
+  if (gx >= Panel::width || gx + g.width <= 0 || gy >= Panel::height || gy + g.height <= 0) return;
+
+  uint16_t* frame = matrix.getBuffer();
+  uint8_t rowBytes = (g.width + 7) / 8;
+  const uint8_t* src = font.bitmap + g.offset;
+  int firstRow = max(0, -gy);
+  int lastRow = min((int)g.height, Panel::height - gy);
+  bool clipped = gx < 0 || gx + g.width > Panel::width;
+
+  for (int r = firstRow; r < lastRow; r++) {
+    const uint8_t* row = src + r * rowBytes;
+    uint16_t* dst = frame + (gy + r) * Panel::width + gx;
+    for (uint8_t b = 0; b < rowBytes; b++) {
+      uint8_t bits = row[b];
+      if (!bits) continue;
+      int base = b * 8;
+      for (uint8_t k = 0; bits; k++, bits <<= 1) {
+        if (!(bits & 0x80)) continue;
+        int col = base + k;
+        if (clipped && (gx + col < 0 || gx + col >= Panel::width)) continue;
+        dst[col] = color;
+      }
+    }
+  }
+}
+
+int drawPackedText(const PackedFont& font, const char* text, int x, int y, uint16_t color) {
+  int pen = x;
+  for (const char* p = text; *p; p++) {
+    const PackedGlyph* g = findGlyph(font, *p);
+    if (!g) continue;
+    if (g->width) blitGlyph(font, *g, pen, y, color);
+    pen += g->advance + (p[1] ? kerning(font, p[0], p[1]) : 0);
+  }
+  return pen;
+}
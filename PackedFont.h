@@ -0,0 +1,38 @@
+// PackedFont.h
+#pragma once
+
+#include <Arduino.h>
+
+// Bitmap fonts generated by tools/make_font.py. Glyph rows are byte-aligned, MSB first,
+// so a row can be blitted without per-pixel bit addressing across rows.
+struct PackedGlyph {
+  uint16_t offset;   // Into the font bitmap
+  uint8_t width;
+  uint8_t height;
+  int8_t xOffset;    // From the pen position to the first column
+  int8_t top;        // From the top of the line to the first row
+  uint8_t advance;   // Pen movement after the glyph
+};
+
+struct KernPair {
+  char left;
+  char right;
+  int8_t adjust;
+};
+
+struct PackedFont {
+  const uint8_t* bitmap;
+  const PackedGlyph* glyphs;
+  const KernPair* kerning;
+  uint8_t kernCount;
+  uint8_t first;
+  uint8_t last;
+  uint8_t lineHeight;
+};
+
+// Width in pixels from the first glyph's left edge to the last glyph's right edge
+int packedTextWidth(const PackedFont& font, const char* text);
+
+// Draws straight into the canvas with (x, y) as the top-left of the line. Clipped to the panel.
+// Returns the pen position after the last glyph.
+int drawPackedText(const PackedFont& font, const char* text, int x, int y, uint16_t color);
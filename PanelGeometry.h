@@ -0,0 +1,57 @@
+// PanelGeometry.h
+#pragma once
+
+#include <stdint.h>
+
+// Build for another panel by overriding these: 128x32 for two chained 64x32 tiles, or 64x64.
+#ifndef NOVAFRAME_PANEL_WIDTH
+#define NOVAFRAME_PANEL_WIDTH 64
+#endif
+#ifndef NOVAFRAME_PANEL_HEIGHT
+#define NOVAFRAME_PANEL_HEIGHT 32
+#endif
+
+// HUB75 chain geometry. Everything the Protomatter setup needs is derived from width x height.
+template <int W, int H, int TILE_W = 64>
+struct PanelGeometry {
+  static_assert(W % TILE_W == 0, "Chain width must be whole tiles");
+  static_assert(H == 32 || H == 64, "Layouts are designed for 32- and 64-row tiles");
+
+  static constexpr int16_t width = W;
+  static constexpr int16_t height = H;
+  static constexpr int pixels = W * H;
+  static constexpr int chainLength = W / TILE_W;
+  static constexpr uint8_t addrLines = (H == 64) ? 5 : 4;  // 1/32 or 1/16 scan
+  static constexpr uint8_t bitDepth = 4;
+};
+
+using Panel = PanelGeometry<NOVAFRAME_PANEL_WIDTH, NOVAFRAME_PANEL_HEIGHT>;
+
+#define PANEL_WIDTH Panel::width
+#define PANEL_HEIGHT Panel::height
+
+// A rectangle on the panel. All helpers are constexpr, so app layouts resolve at compile time.
+struct Region {
+  int16_t x, y, w, h;
+
+  constexpr int16_t right() const { return x + w - 1; }
+  constexpr int16_t bottom() const { return y + h - 1; }
+  constexpr int16_t centerX() const { return x + w / 2; }
+  constexpr int16_t col(int16_t offset) const { return x + offset; }  // Offset from the left edge
+  constexpr int16_t row(int16_t offset) const { return y + offset; }  // Offset from the top edge
+
+  // Left num/den of the width; the column right after it is free for a divider
+  constexpr Region leftFraction(int num, int den) const { return { x, y, (int16_t)(w * num / den), h }; }
+  constexpr Region rightOf(int16_t column) const { return { (int16_t)(column + 1), y, (int16_t)(x + w - column - 1), h }; }
+
+  // Band of the given height centred vertically
+  constexpr Region band(int16_t bandHeight) const {
+    return { x, (int16_t)(y + (h - bandHeight) / 2), w, bandHeight };
+  }
+};
+
+constexpr Region SCREEN = { 0, 0, Panel::width, Panel::height };
+
+// Apps were designed on 64x32; their row offsets are kept inside a 32-row band that is
+// centred on taller panels, while horizontal regions stretch across the whole chain.
+constexpr Region CONTENT = SCREEN.band(32);
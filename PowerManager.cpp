@@ -0,0 +1,174 @@
+#include "PowerManager.h"
+#include <WiFi.h>
+#include <Firebase_ESP_Client.h>
+#include "DisplayHelpers.h"
+#include "FrameKernels.h"
+#include "TimeCache.h"
+#include "OTAUpdater.h"
+#include "StreamReceiver.h"
+#include "AppManager.h"
+#include "Trace.h"
+#include "DeviceRegistration.h"
+
+extern FirebaseData fbdo;
+extern TimeCache timeCache;
+extern AppManager appManager;
+
+// Ballpark figures from the ESP32-S3 datasheet and a typical 64x32 1/16-scan panel
+#define MA_CPU_240 68.0f
+#define MA_CPU_80 40.0f
+#define MA_WIFI_AWAKE 95.0f
+#define MA_WIFI_MODEM_SLEEP 25.0f        // DTIM 1
+#define MA_WIFI_MAX_MODEM_SLEEP 12.0f    // Listen interval 3
+#define MA_PER_LIT_SUBPIXEL 0.33f   // ~2 A for a full-white panel
+
+#define SCHEDULE_POLL_MS 60000UL
+#define SAVINGS_REPORT_MS (60UL * 60UL * 1000UL)
+
+PowerManager powerManager;
+
+bool PowerPolicy::isNight(int minuteOfDay, int nightStart, int nightEnd) {
+  if (minuteOfDay < 0 || nightStart == NIGHT_DISABLED || nightEnd == NIGHT_DISABLED) return false;
+  if (nightStart == nightEnd) return false;
+  if (nightStart < nightEnd) return minuteOfDay >= nightStart && minuteOfDay < nightEnd;
+  return minuteOfDay >= nightStart || minuteOfDay < nightEnd;  // Wraps past midnight
+}
+
+PowerState PowerPolicy::evaluate(const PowerInputs& in) {
+  PowerState s;
+  s.panelOn = in.wakeOverride || !isNight(in.minuteOfDay, in.nightStart, in.nightEnd);
+  // Between sync windows the radio only has to catch the odd LAN request; a transfer needs it awake
+  s.radio = in.networkBusy ? RadioMode::AWAKE : RadioMode::MAX_MODEM_SLEEP;
+  s.idleCpuMhz = in.networkBusy ? CPU_MHZ_ACTIVE : CPU_MHZ_IDLE;
+  return s;
+}
+
+float PowerPolicy::estimateMilliamps(const PowerState& state, bool cpuIdle, float panelMilliamps) {
+  float ma = (cpuIdle && state.idleCpuMhz == CPU_MHZ_IDLE) ? MA_CPU_80 : MA_CPU_240;
+  switch (state.radio) {
+    case RadioMode::AWAKE: ma += MA_WIFI_AWAKE; break;
+    case RadioMode::MODEM_SLEEP: ma += MA_WIFI_MODEM_SLEEP; break;
+    case RadioMode::MAX_MODEM_SLEEP: ma += MA_WIFI_MAX_MODEM_SLEEP; break;
+  }
+  if (state.panelOn) ma += panelMilliamps;
+  return ma;
+}
+
+void PowerManager::update() {
+  pollSchedule();
+
+  PowerInputs in;
+  in.minuteOfDay = -1;
+  if (timeCache.isSynced()) {
+    const struct tm& t = timeCache.getTimeInfo();
+    in.minuteOfDay = t.tm_hour * 60 + t.tm_min;
+  }
+  in.nightStart = nightStart;
+  in.nightEnd = nightEnd;
+  in.networkBusy = isOTAInProgress() || streamReceiver.isLive();  // Modem sleep holds frames for the DTIM beacon
+  in.wakeOverride = (long)(wakeUntil - millis()) > 0;
+
+  PowerState next = PowerPolicy::evaluate(in);
+  if (next != state) apply(next);
+
+  // The frame only changes every second or so; sampling the canvas more often buys nothing
+  if (state.panelOn && millis() - lastPanelSample >= 1000) {
+    panelMilliamps = estimatePanelMilliamps();
+    lastPanelSample = millis();
+  }
+  accountSavings(false);
+}
+
+void PowerManager::apply(const PowerState& next) {
+  if (next.panelOn != state.panelOn) {
+    if (!next.panelOn) {
+      Serial.println("🌙 Night schedule — blanking panel");
+      clearFrame();
+      matrix.show();
+    } else {
+      Serial.println("☀️ Panel back on");
+      BaseApp* current = appManager.getActiveApp();
+      if (current) current->setNeedsRedraw(true);
+    }
+  }
+
+  if (next.radio != state.radio) {
+    static const wifi_ps_type_t modes[] = { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM };
+    static const char* names[] = { "off", "on", "max" };
+    WiFi.setSleep(modes[(int)next.radio]);
+    Serial.printf("📶 Wi-Fi modem sleep %s\n", names[(int)next.radio]);
+  }
+
+  state = next;
+}
+
+void PowerManager::beginIdle(unsigned long idleMs) {
+  accountSavings(false);
+  cpuLowered = state.idleCpuMhz != CPU_MHZ_ACTIVE && idleMs >= CPU_IDLE_MIN_MS;
+  if (cpuLowered) setCpuFrequencyMhz(state.idleCpuMhz);
+}
+
+void PowerManager::endIdle() {
+  accountSavings(cpuLowered);
+  if (!cpuLowered) return;
+  setCpuFrequencyMhz(CPU_MHZ_ACTIVE);
+  cpuLowered = false;
+}
+
+void PowerManager::notifyActivity() {
+  wakeUntil = millis() + WAKE_OVERRIDE_MS;
+}
+
+// The setting's value, NIGHT_DISABLED when the node is missing, or `current` when the read failed
+static int readScheduleMinute(SettingsField field, int current) {
+  Tracer::countRequest(Endpoint::RTDB);
+  if (Firebase.RTDB.getInt(&fbdo, getSettingsPath(field))) return fbdo.intData();
+  return fbdo.errorReason() == "path not exist" ? NIGHT_DISABLED : current;
+}
+
+// nightStart/nightEnd are minutes since midnight in the device settings; -1 or missing disables.
+// A read that fails for any other reason keeps the schedule already in force.
+void PowerManager::pollSchedule() {
+  unsigned long now = millis();
+  if (lastSchedulePoll != 0 && now - lastSchedulePoll < SCHEDULE_POLL_MS) return;
+  lastSchedulePoll = now;
+  if (!Firebase.ready() || getMacId()[0] == '\0') return;
+
+  TRACE_SCOPE(NETWORK);
+  int start = readScheduleMinute(SettingsField::NIGHT_START, nightStart);
+  int end = readScheduleMinute(SettingsField::NIGHT_END, nightEnd);
+
+  if (start != nightStart || end != nightEnd) {
+    nightStart = constrain(start, NIGHT_DISABLED, 1439);
+    nightEnd = constrain(end, NIGHT_DISABLED, 1439);
+    Serial.printf("🌙 Night schedule: %d → %d\n", nightStart, nightEnd);
+  }
+}
+
+float PowerManager::estimatePanelMilliamps() {
+  const uint16_t* px = matrix.getBuffer();
+  uint32_t sum = 0;  // In 1/63 units of a fully lit subpixel
+  for (int i = 0; i < PANEL_WIDTH * PANEL_HEIGHT; i++) {
+    uint16_t c = px[i];
+    sum += ((c >> 11) & 0x1F) * 2 + ((c >> 5) & 0x3F) + (c & 0x1F) * 2;
+  }
+  return sum / 63.0f * MA_PER_LIT_SUBPIXEL * getBrightnessScale() / 255.0f;  // Canvas is pre-brightness
+}
+
+// Integrates (stock-sketch estimate − current estimate) over time; an awake radio counts against it
+void PowerManager::accountSavings(bool wasIdle) {
+  unsigned long now = micros();
+  if (lastAccountMicros != 0) {
+    float seconds = (now - lastAccountMicros) / 1000000.0f;
+    PowerState stock;
+    float baseline = PowerPolicy::estimateMilliamps(stock, false, panelMilliamps);
+    float actual = PowerPolicy::estimateMilliamps(state, wasIdle, panelMilliamps);
+    savedMilliampSeconds += (baseline - actual) * seconds;
+  }
+  lastAccountMicros = now;
+
+  if (millis() - lastReport >= SAVINGS_REPORT_MS) {
+    lastReport = millis();
+    Serial.printf("🔋 Estimated saving: %.1f mAh since boot\n", savedMilliampSeconds / 3600.0f);
+  }
+}
@@ -0,0 +1,75 @@
+// PowerManager.h
+#pragma once
+
+#include <Arduino.h>
+
+#define CPU_MHZ_ACTIVE 240
+#define CPU_MHZ_IDLE 80          // Lowest clock that keeps Wi-Fi and the 80 MHz APB running
+#define NIGHT_DISABLED -1
+#define WAKE_OVERRIDE_MS 30000   // Button press during the night schedule shows the panel this long
+#define CPU_IDLE_MIN_MS 20       // Shorter idles stay at full clock; the switch costs more than it saves
+
+// Everything the policy looks at — no hardware access, so it can run against a fake clock
+struct PowerInputs {
+  int minuteOfDay;               // Local time, 0–1439, or -1 if the clock isn't set yet
+  int nightStart;                // Minute of day, NIGHT_DISABLED to turn the schedule off
+  int nightEnd;
+  bool networkBusy;              // OTA, a live stream or another long transfer in flight
+  bool wakeOverride;             // Recent button press
+};
+
+// Wi-Fi power save. MODEM_SLEEP (wake every DTIM) is what the Arduino core runs by default;
+// MAX_MODEM_SLEEP wakes only every listen interval.
+enum class RadioMode : uint8_t { AWAKE, MODEM_SLEEP, MAX_MODEM_SLEEP };
+
+// Defaults are a stock sketch's: the baseline the savings estimate is measured against
+struct PowerState {
+  bool panelOn = true;
+  RadioMode radio = RadioMode::MODEM_SLEEP;
+  uint16_t idleCpuMhz = CPU_MHZ_ACTIVE;
+
+  bool operator==(const PowerState& o) const {
+    return panelOn == o.panelOn && radio == o.radio && idleCpuMhz == o.idleCpuMhz;
+  }
+  bool operator!=(const PowerState& o) const { return !(*this == o); }
+};
+
+class PowerPolicy {
+public:
+  static PowerState evaluate(const PowerInputs& in);
+  static bool isNight(int minuteOfDay, int nightStart, int nightEnd);
+
+  // Rough ESP32-S3 + HUB75 current model used for the savings estimate
+  static float estimateMilliamps(const PowerState& state, bool cpuIdle, float panelMilliamps);
+};
+
+class PowerManager {
+public:
+  void update();                 // Once per loop pass: re-evaluate and apply the policy
+  void beginIdle(unsigned long idleMs);  // Drop the clock before the loop sleeps for idleMs
+  void endIdle();                // Restore it once there is work to do
+  void notifyActivity();         // Button press — lifts the night blanking on the next update()
+
+  bool isPanelBlanked() const { return !state.panelOn; }
+
+private:
+  void apply(const PowerState& next);
+  void pollSchedule();
+  void accountSavings(bool cpuIdle);
+  float estimatePanelMilliamps();
+
+  PowerState state;
+  int nightStart = NIGHT_DISABLED;
+  int nightEnd = NIGHT_DISABLED;
+  unsigned long lastSchedulePoll = 0;
+  volatile unsigned long wakeUntil = 0;  // Set from the button task
+  bool cpuLowered = false;       // beginIdle() dropped the clock and endIdle() owes a restore
+
+  float panelMilliamps = 0;      // Estimate for the last presented frame
+  unsigned long lastPanelSample = 0;
+  unsigned long lastAccountMicros = 0;
+  float savedMilliampSeconds = 0;
+  unsigned long lastReport = 0;
+};
+
+extern PowerManager powerManager;
@@ -2,45 +2,173 @@
 #include <Firebase_ESP_Client.h>
 #include "SecretsManager.h"
 #include "DeviceRegistration.h"
+#include "Trace.h"
+
+#define REMOTE_CONFIG_PATH "/novaFrame/remoteConfig"
+#define REMOTE_CONFIG_VERSION_PATH "/novaFrame/remoteConfig/version"
+#define NO_STRING 0xFFFF
+#define REMOTE_CONFIG_RETRY_MIN_MS 10000   // First retry after a failed initial fetch; doubles up to the poll interval
 
 FirebaseData remoteFbdo;
-std::map<String, String> RemoteConfigManager::configMap;
+int32_t RemoteConfigManager::numbers[(size_t)ConfigKey::COUNT];
+uint16_t RemoteConfigManager::stringOffsets[(size_t)ConfigKey::COUNT];
+bool RemoteConfigManager::present[(size_t)ConfigKey::COUNT];
+char RemoteConfigManager::stringArena[512];
+int32_t RemoteConfigManager::version = -1;
 bool RemoteConfigManager::fetched = false;
 
+static const ConfigType KEY_TYPES[] = {
+#define CONFIG_KEY_TYPE(name, type, str, num) type,
+  REMOTE_CONFIG_KEYS(CONFIG_KEY_TYPE)
+#undef CONFIG_KEY_TYPE
+};
+
+static const char* const DEFAULT_STRINGS[] = {
+#define CONFIG_KEY_STR(name, type, str, num) str,
+  REMOTE_CONFIG_KEYS(CONFIG_KEY_STR)
+#undef CONFIG_KEY_STR
+};
+
+static const int32_t DEFAULT_NUMBERS[] = {
+#define CONFIG_KEY_NUM(name, type, str, num) num,
+  REMOTE_CONFIG_KEYS(CONFIG_KEY_NUM)
+#undef CONFIG_KEY_NUM
+};
+
+// Slot → key index, resolved entirely at compile time
+static constexpr int8_t SLOT_TABLE[RemoteConfigHash::TABLE_SIZE] = {
+  RemoteConfigHash::keyForSlot(0),  RemoteConfigHash::keyForSlot(1),
+  RemoteConfigHash::keyForSlot(2),  RemoteConfigHash::keyForSlot(3),
+  RemoteConfigHash::keyForSlot(4),  RemoteConfigHash::keyForSlot(5),
+  RemoteConfigHash::keyForSlot(6),  RemoteConfigHash::keyForSlot(7),
+  RemoteConfigHash::keyForSlot(8),  RemoteConfigHash::keyForSlot(9),
+  RemoteConfigHash::keyForSlot(10), RemoteConfigHash::keyForSlot(11),
+  RemoteConfigHash::keyForSlot(12), RemoteConfigHash::keyForSlot(13),
+  RemoteConfigHash::keyForSlot(14), RemoteConfigHash::keyForSlot(15)
+};
+static_assert(RemoteConfigHash::TABLE_SIZE == 16, "SLOT_TABLE initialiser assumes 16 slots");
+
+int RemoteConfigManager::findKey(const char* name) {
+  uint32_t slot = RemoteConfigHash::slotFor(name, RemoteConfigHash::SEED);
+  int key = SLOT_TABLE[slot];
+  if (key < 0 || strcmp(RemoteConfigHash::KEY_NAMES[key], name) != 0) return -1;
+  return key;
+}
+
 void RemoteConfigManager::begin() {
   if (!Firebase.ready()) {
     Serial.println("⚠️ Firebase not ready. Cannot fetch remote config.");
     return;
   }
 
-  String globalPath = "/novaFrame/remoteConfig";
+  if (fetchAll()) {
+    Serial.println("✅ Remote config loaded.");
+  }
+}
 
-  if (!Firebase.RTDB.getJSON(&remoteFbdo, globalPath.c_str())) {
+bool RemoteConfigManager::fetchAll() {
+  Tracer::countRequest(Endpoint::RTDB);
+  if (!Firebase.RTDB.getJSON(&remoteFbdo, REMOTE_CONFIG_PATH)) {
     Serial.printf("❌ Failed to load global remote config: %s\n", remoteFbdo.errorReason().c_str());
-    return;
+    return false;
   }
 
   DynamicJsonDocument doc(2048);
-  auto err = deserializeJson(doc, remoteFbdo.payload().c_str());
+  DeserializationError err;
+  {
+    TRACE_SCOPE(PARSE);
+    err = deserializeJson(doc, remoteFbdo.payload().c_str());
+  }
   if (err) {
     Serial.printf("❌ Failed to parse global remote config: %s\n", err.c_str());
-    return;
+    return false;
+  }
+
+  // Reset to defaults, then overlay whatever keys are present
+  for (size_t i = 0; i < (size_t)ConfigKey::COUNT; i++) {
+    numbers[i] = DEFAULT_NUMBERS[i];
+    stringOffsets[i] = NO_STRING;
+    present[i] = false;
   }
 
+  size_t used = 0;
+  int matched = 0;
   for (JsonPair kv : doc.as<JsonObject>()) {
-    configMap[kv.key().c_str()] = kv.value().as<String>();
-    Serial.printf("🔧 Config key: %s = %s\n", kv.key().c_str(), kv.value().as<String>().c_str());
+    int key = findKey(kv.key().c_str());
+    if (key < 0) continue;
+
+    JsonVariant value = kv.value();
+    if (KEY_TYPES[key] == CONFIG_STRING) {
+      const char* str = value.as<const char*>();
+      if (!str) continue;
+      size_t len = strlen(str) + 1;
+      if (used + len > sizeof(stringArena)) {
+        Serial.printf("⚠️ Config string arena full, skipping %s\n", kv.key().c_str());
+        continue;
+      }
+      memcpy(stringArena + used, str, len);
+      stringOffsets[key] = used;
+      used += len;
+    } else {
+      numbers[key] = value.is<const char*>() ? atol(value.as<const char*>()) : value.as<long>();
+    }
+    present[key] = true;
+    matched++;
   }
 
+  version = doc["version"] | 0;
   fetched = true;
-  Serial.println("✅ Remote config loaded.");
+  Serial.printf("🔧 Remote config v%d: %d known keys\n", (int)version, matched);
+  return true;
+}
+
+void RemoteConfigManager::refreshIfChanged() {
+  static unsigned long lastPoll = 0;
+  static unsigned long retryMs = REMOTE_CONFIG_RETRY_MIN_MS / NOVAFRAME_TIME_SCALE;
+  unsigned long now = millis();
+  unsigned long pollMs = getDurationMs(ConfigKey::CONFIG_POLL_SEC);
+  // Until the first fetch lands there is nothing to compare a version against, so keep retrying
+  // the full fetch on a short backoff rather than waiting out the poll interval
+  unsigned long intervalMs = fetched ? pollMs : min(retryMs, pollMs);
+  if (now - lastPoll < intervalMs) return;
+  lastPoll = now;
+
+  if (!Firebase.ready()) return;
+
+  if (!fetched) {
+    if (fetchAll()) {
+      Serial.println("✅ Remote config loaded.");
+    } else {
+      retryMs = min(retryMs * 2, pollMs);
+    }
+    return;
+  }
+
+  Tracer::countRequest(Endpoint::RTDB);
+  if (!Firebase.RTDB.getInt(&remoteFbdo, REMOTE_CONFIG_VERSION_PATH)) return;
+  int32_t remoteVersion = remoteFbdo.intData();
+  if (remoteVersion == version) return;
+
+  Serial.printf("🔁 Remote config version %d → %d, refetching\n", (int)version, (int)remoteVersion);
+  fetchAll();
+}
+
+const char* RemoteConfigManager::getString(ConfigKey key) {
+  size_t i = (size_t)key;
+  if (!fetched || stringOffsets[i] == NO_STRING) return DEFAULT_STRINGS[i];
+  return stringArena + stringOffsets[i];
 }
 
-String RemoteConfigManager::get(const String& key, const String& fallback) {
-  if (!fetched) return fallback;
-  return configMap.count(key) ? configMap[key] : fallback;
+int32_t RemoteConfigManager::getInt(ConfigKey key) {
+  return fetched ? numbers[(size_t)key] : DEFAULT_NUMBERS[(size_t)key];
 }
 
-bool RemoteConfigManager::has(const String& key) {
-  return fetched && configMap.count(key);
-}
\ No newline at end of file
+unsigned long RemoteConfigManager::getDurationMs(ConfigKey key) {
+  int32_t seconds = getInt(key);
+  if (seconds <= 0) seconds = DEFAULT_NUMBERS[(size_t)key];  // Never poll in a tight loop
+  return max(1000UL, (unsigned long)seconds * 1000UL / NOVAFRAME_TIME_SCALE);
+}
+
+bool RemoteConfigManager::has(ConfigKey key) {
+  return fetched && present[(size_t)key];
+}
@@ -1,15 +1,106 @@
 // RemoteConfigManager.h
 #pragma once
 #include <Firebase_ESP_Client.h>
-#include <map>
+
+// Every remote config key the firmware understands: X(name, type, default string, default number).
+// Adding a key is one line here. Durations are given in seconds in Firebase and read back in ms.
+#define REMOTE_CONFIG_KEYS(X) \
+  X(OPENWEATHER_API_KEY,     CONFIG_STRING,   "", 0) \
+  X(IP_GEO_LOCATION_API_KEY, CONFIG_STRING,   "", 0) \
+  X(WEATHER_REFRESH_SEC,     CONFIG_DURATION, "", 60 * 60) \
+  X(TIME_SYNC_SEC,           CONFIG_DURATION, "", 6 * 60 * 60) \
+  X(OTA_CHECK_SEC,           CONFIG_DURATION, "", 60 * 60) \
+  X(CONFIG_POLL_SEC,         CONFIG_DURATION, "", 5 * 60) \
+  X(PRELOAD_LEAD_SEC,        CONFIG_DURATION, "", 2) \
+  X(DEFAULT_BRIGHTNESS,      CONFIG_INT,      "", 7)
+
+// Bench builds can compress every refresh interval (and the trace "day") by this factor to
+// watch days of request cadence in minutes on a board. Leave at 1 for real devices.
+#ifndef NOVAFRAME_TIME_SCALE
+#define NOVAFRAME_TIME_SCALE 1
+#endif
+
+enum ConfigType : uint8_t {
+  CONFIG_STRING,
+  CONFIG_INT,
+  CONFIG_DURATION
+};
+
+enum class ConfigKey : uint8_t {
+#define CONFIG_KEY_ENUM(name, type, str, num) name,
+  REMOTE_CONFIG_KEYS(CONFIG_KEY_ENUM)
+#undef CONFIG_KEY_ENUM
+  COUNT
+};
+
+namespace RemoteConfigHash {
+
+constexpr size_t KEY_COUNT = (size_t)ConfigKey::COUNT;
+constexpr uint32_t TABLE_SIZE = 16;
+static_assert(KEY_COUNT <= TABLE_SIZE / 2, "Grow TABLE_SIZE to keep the perfect hash easy to find");
+
+constexpr const char* KEY_NAMES[] = {
+#define CONFIG_KEY_NAME(name, type, str, num) #name,
+  REMOTE_CONFIG_KEYS(CONFIG_KEY_NAME)
+#undef CONFIG_KEY_NAME
+};
+
+constexpr uint32_t fnv1a(const char* s, uint32_t h) {
+  return *s ? fnv1a(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+
+// FNV's low bits only depend on the low bits of its input, so fold the high bits in
+constexpr uint32_t mix(uint32_t h) {
+  return (h ^ (h >> 16)) * 0x45d9f3bu;
+}
+
+constexpr uint32_t slotFor(const char* name, uint32_t seed) {
+  return (mix(fnv1a(name, seed)) >> 16) & (TABLE_SIZE - 1);
+}
+
+constexpr uint32_t slotOf(size_t key, uint32_t seed) {
+  return slotFor(KEY_NAMES[key], seed);
+}
+
+constexpr bool clashesAfter(size_t i, size_t j, uint32_t seed) {
+  return j >= KEY_COUNT ? false : (slotOf(i, seed) == slotOf(j, seed) || clashesAfter(i, j + 1, seed));
+}
+
+constexpr bool anyClash(size_t i, uint32_t seed) {
+  return i >= KEY_COUNT ? false : (clashesAfter(i, i + 1, seed) || anyClash(i + 1, seed));
+}
+
+// First FNV offset basis at or above the standard one with no slot collisions
+constexpr uint32_t findSeed(uint32_t seed) {
+  return anyClash(0, seed) ? findSeed(seed + 1) : seed;
+}
+
+constexpr uint32_t SEED = findSeed(2166136261u);
+
+constexpr int8_t keyForSlot(uint32_t slot, size_t key = 0) {
+  return key >= KEY_COUNT ? -1 : (slotOf(key, SEED) == slot ? (int8_t)key : keyForSlot(slot, key + 1));
+}
+
+}  // namespace RemoteConfigHash
 
 class RemoteConfigManager {
 public:
   static void begin();
-  static String get(const String& key, const String& fallback = "");
-  static bool has(const String& key);
+  static void refreshIfChanged();  // Polls the version stamp; refetches only when it moves (or never landed)
+
+  static const char* getString(ConfigKey key);  // Valid until the next refresh
+  static int32_t getInt(ConfigKey key);
+  static unsigned long getDurationMs(ConfigKey key);
+  static bool has(ConfigKey key);  // True when set remotely rather than defaulted
 
 private:
-  static std::map<String, String> configMap;
+  static bool fetchAll();
+  static int findKey(const char* name);
+
+  static int32_t numbers[(size_t)ConfigKey::COUNT];
+  static uint16_t stringOffsets[(size_t)ConfigKey::COUNT];
+  static bool present[(size_t)ConfigKey::COUNT];
+  static char stringArena[512];
+  static int32_t version;
   static bool fetched;
-};
\ No newline at end of file
+};
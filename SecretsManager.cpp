@@ -1,53 +1,76 @@
 #include "SecretsManager.h"
 #include <ArduinoJson.h>
-#include <esp_partition.h>
-#include <esp_spi_flash.h>
 
-DynamicJsonDocument SecretsManager::doc(2048);
+#define SECRETS_OFFSET 0x490000
+#define SECRETS_REGION_SIZE 0x10000   // 64KB, split into two 32KB log halves
+#define LEGACY_JSON_MAX 2048
+
+KVStore SecretsManager::store;
 bool SecretsManager::loaded = false;
 
 bool SecretsManager::load() {
-  const uint32_t secretsOffset = 0x490000;
-  const size_t maxSize = 2048;
-  uint8_t buffer[maxSize + 1];  // +1 for null terminator
-
-  const esp_partition_t* partition = esp_partition_find_first(
-    ESP_PARTITION_TYPE_DATA,
-    ESP_PARTITION_SUBTYPE_ANY,
-    NULL
-  );
-
-  if (!partition) {
-    Serial.println("❌ Failed to find data partition.");
+  if (!store.begin(SECRETS_OFFSET, SECRETS_REGION_SIZE)) {
+    Serial.println("❌ Failed to open secrets store.");
     return false;
   }
 
-  esp_err_t err = spi_flash_read(secretsOffset, buffer, maxSize);
-  if (err != ESP_OK) {
-    Serial.printf("❌ Flash read failed: %s\n", esp_err_to_name(err));
+  if (store.isEmpty() && !migrateLegacyJson()) {
     return false;
   }
 
-  buffer[maxSize] = '\0';  // Ensure null-termination just in case
+  loaded = true;
+  Serial.printf("✅ Secrets loaded from flash log (%u keys)\n", (unsigned)store.count());
+  return true;
+}
 
-  DeserializationError error = deserializeJson(doc, buffer);
+// Older firmware kept one JSON blob at the start of the region
+bool SecretsManager::migrateLegacyJson() {
+  const char* legacy = (const char*)store.rawRegion();
+  if (legacy[0] != '{') {
+    Serial.println("❌ No secrets found in flash");
+    return false;
+  }
+
+  DynamicJsonDocument doc(LEGACY_JSON_MAX);
+  DeserializationError error = deserializeJson(doc, legacy, strnlen(legacy, LEGACY_JSON_MAX));
   if (error) {
     Serial.println("❌ Failed to parse secrets from flash");
     return false;
   }
 
-  loaded = true;
-  Serial.println("✅ Secrets loaded from raw flash!");
+  JsonObject obj = doc.as<JsonObject>();
+  const char* keys[KV_MAX_KEYS];
+  const char* values[KV_MAX_KEYS];
+  size_t n = 0;
+  for (JsonPair kv : obj) {
+    if (n >= KV_MAX_KEYS || !kv.value().is<const char*>()) continue;
+    keys[n] = kv.key().c_str();
+    values[n] = kv.value().as<const char*>();
+    n++;
+  }
+
+  // One batch so a power cut mid-migration leaves the legacy copy authoritative
+  if (!store.setMany(keys, values, n)) {
+    Serial.println("❌ Failed to migrate secrets to flash log");
+    return false;
+  }
+
+  Serial.printf("🔁 Migrated %u secrets from legacy JSON\n", (unsigned)n);
   return true;
 }
 
 String SecretsManager::get(String key) {
+  return String(getRaw(key.c_str()));
+}
+
+const char* SecretsManager::getRaw(const char* key) {
   if (!loaded) {
     Serial.println("⚠️ Secrets not loaded! Call SecretsManager::load() first.");
     return "";
   }
 
-  return doc[key] | "";
+  const char* value = store.get(key);
+  return value ? value : "";
 }
 
 bool SecretsManager::set(String key, String value) {
@@ -56,27 +79,11 @@ bool SecretsManager::set(String key, String value) {
     return false;
   }
 
-  doc[key] = value;
-
-  String output;
-  serializeJson(doc, output);
-  const char* json = output.c_str();
-
-  const uint32_t secretsOffset = 0x490000;  // same as load()
-  size_t length = strlen(json) + 1;
-
-  esp_err_t err = spi_flash_erase_range(secretsOffset, 0x10000);  // 64KB block
-  if (err != ESP_OK) {
-    Serial.printf("❌ Flash erase failed: %s\n", esp_err_to_name(err));
+  if (!store.set(key.c_str(), value.c_str())) {
+    Serial.println("❌ Flash write failed for secret: " + key);
     return false;
   }
 
-  err = spi_flash_write(secretsOffset, json, length);
-  if (err != ESP_OK) {
-    Serial.printf("❌ Flash write failed: %s\n", esp_err_to_name(err));
-    return false;
-  }
-
-  Serial.println("✅ Secrets updated in raw flash!");
+  Serial.println("✅ Secrets updated in flash log!");
   return true;
-}
\ No newline at end of file
+}
@@ -3,14 +3,18 @@
 #include <ArduinoJson.h>
 #include <FS.h>
 #include <LittleFS.h>
+#include "KVStore.h"
 
 class SecretsManager {
 public:
   static bool load();
+  static bool isLoaded() { return loaded; }
   static String get(String key);
+  static const char* getRaw(const char* key);  // Zero-copy view into flash, "" if missing
   static bool set(String key, String value);
 
 private:
-  static DynamicJsonDocument doc;
+  static bool migrateLegacyJson();
+  static KVStore store;
   static bool loaded;
-};
\ No newline at end of file
+};
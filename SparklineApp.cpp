@@ -0,0 +1,123 @@
+// SparklineApp.cpp — 48h temperature/precipitation sparkline
+#include "SparklineApp.h"
+#include "HourlyForecast.h"
+#include "WeatherCache.h"
+#include "FrameKernels.h"
+
+// The chart uses the full panel height; the label row stays on top
+constexpr int16_t SPARK_TOP = 9;                            // First row of the temperature line
+constexpr int16_t POP_BOTTOM = SCREEN.bottom();             // Bars grow up from the bottom row
+constexpr int16_t POP_MAX_HEIGHT = Panel::height * 6 / 32;
+constexpr int16_t SPARK_HEIGHT = POP_BOTTOM - POP_MAX_HEIGHT - SPARK_TOP - 1;  // Rows for the line
+static_assert(Panel::height != 32 || SPARK_HEIGHT == 15, "64x32 layout matches the original");
+
+void SparklineApp::prepare() {
+  updateWeatherCache();
+}
+
+void SparklineApp::init() {
+  if (builtRevision != hourlyForecast.getRevision()) {
+    rebuild();
+  }
+  setNeedsRedraw(true);
+}
+
+void SparklineApp::loop() {
+  // Resample only when a new weather update has landed
+  if (builtRevision != hourlyForecast.getRevision()) {
+    rebuild();
+    setNeedsRedraw(true);
+  }
+}
+
+void SparklineApp::rebuild() {
+  builtRevision = hourlyForecast.getRevision();
+  size_t n = hourlyForecast.size();
+  hasData = n >= 2;
+  if (!hasData) return;
+
+  tempMin10 = INT16_MAX;
+  tempMax10 = INT16_MIN;
+  for (size_t i = 0; i < n; i++) {
+    int16_t t = hourlyForecast.at(i).temp10;
+    tempMin10 = min(tempMin10, t);
+    tempMax10 = max(tempMax10, t);
+  }
+  int32_t range = max(1, tempMax10 - tempMin10);
+
+  for (int x = 0; x < PANEL_WIDTH; x++) {
+    // Linear interpolation between samples in 8.8 fixed point
+    uint32_t pos = ((uint32_t)x * (n - 1) << 8) / (PANEL_WIDTH - 1);
+    size_t i = pos >> 8;
+    uint32_t frac = pos & 0xFF;
+    const HourlySample& a = hourlyForecast.at(i);
+    const HourlySample& b = hourlyForecast.at(min(i + 1, n - 1));
+
+    int32_t t = a.temp10 + (((int32_t)(b.temp10 - a.temp10) * (int32_t)frac) >> 8);
+    int32_t p = a.pop + (((int32_t)(b.pop - a.pop) * (int32_t)frac) >> 8);
+
+    tempY[x] = SPARK_TOP + ((tempMax10 - t) * (SPARK_HEIGHT - 1) + range / 2) / range;
+    popH[x] = (p * POP_MAX_HEIGHT + 50) / 100;
+  }
+
+  Serial.printf("📈 Sparkline rebuilt from %u hourly samples\n", (unsigned)n);
+}
+
+void SparklineApp::redraw(bool force, int xOffset) {
+  if (!force && !needsRedraw) return;
+  clearFrame();
+
+  if (!hasData) {
+    showCenteredText("No data", CONTENT.row(12), matrix.color565(192, 192, 192), 1, xOffset);
+    setNeedsRedraw(false);
+    return;
+  }
+
+  char degree = 247;
+  char label[16];
+  snprintf(label, sizeof(label), "%d-%d%c",
+           toDisplayDegrees(tempMin10), toDisplayDegrees(tempMax10), degree);
+
+  matrix.setTextSize(1);
+  matrix.setTextColor(matrix.color565(192, 192, 192));
+  matrix.setCursor(0 + xOffset, 0);
+  matrix.print("48h");
+
+  int16_t x1, y1;
+  uint16_t w, h;
+  matrix.getTextBounds(label, 0, 0, &x1, &y1, &w, &h);
+  matrix.setTextColor(matrix.color565(255, 255, 255));
+  matrix.setCursor(PANEL_WIDTH - w + xOffset, 0);
+  matrix.print(label);
+
+  uint16_t popColor = matrix.color565(0, 96, 255);
+  uint16_t tempColor = matrix.color565(255, 160, 0);
+
+  for (int x = 0; x < PANEL_WIDTH; x++) {
+    if (popH[x] > 0) {
+      fillSpanV(x + xOffset, POP_BOTTOM - popH[x] + 1, popH[x], popColor);
+    }
+
+    // Join to the previous column so steep changes stay continuous
+    int y0 = tempY[x];
+    int y1Prev = (x > 0) ? tempY[x - 1] : y0;
+    int top = min(y0, (y0 + y1Prev) / 2);
+    int bottom = max(y0, (y0 + y1Prev) / 2);
+    fillSpanV(x + xOffset, top, bottom - top + 1, tempColor);
+  }
+
+  presentFrame();
+  setNeedsRedraw(false);
+}
+
+void SparklineApp::setNeedsRedraw(bool flag) {
+  needsRedraw = flag;
+}
+
+unsigned long SparklineApp::getNextUpdateMs() {
+  return needsRedraw ? 0 : LOOP_MAX_IDLE_MS;  // Only changes with the weather cache
+}
+
+bool SparklineApp::getNeedsRedraw() {
+  return needsRedraw;
+}
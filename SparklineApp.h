@@ -0,0 +1,28 @@
+#pragma once
+
+#include "BaseApp.h"
+#include "DisplayHelpers.h"
+
+// 48h temperature line with precipitation bars underneath
+class SparklineApp : public BaseApp {
+public:
+  void prepare() override;
+  void init() override;
+  void loop() override;
+  void redraw(bool force = false, int xOffset = 0) override;
+  void setNeedsRedraw(bool flag) override;
+  bool getNeedsRedraw() override;
+  unsigned long getNextUpdateMs() override;
+  String getAppId() override { return "sparkline"; }
+
+private:
+  void rebuild();  // Resamples the hourly series into screen columns
+
+  bool needsRedraw = true;
+  uint32_t builtRevision = 0;
+  bool hasData = false;
+  int16_t tempMin10 = 0;
+  int16_t tempMax10 = 0;
+  uint8_t tempY[PANEL_WIDTH];   // Row of the temperature line per column
+  uint8_t popH[PANEL_WIDTH];    // Precipitation bar height per column
+};
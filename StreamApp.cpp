@@ -0,0 +1,50 @@
+#include "StreamApp.h"
+#include "StreamReceiver.h"
+#include "DisplayHelpers.h"
+#include "FrameKernels.h"
+#include <WiFi.h>
+
+void StreamApp::init() {
+  wasLive = false;
+  setNeedsRedraw(true);
+}
+
+void StreamApp::loop() {
+  bool live = streamReceiver.isLive();
+  if (live != wasLive) {
+    wasLive = live;
+    if (!live) setNeedsRedraw(true);  // Back to the idle card
+  }
+  if (!live) return;
+
+  // The frame was converted to RGB565 on arrival; this memcpy is its only copy
+  const uint16_t* frame = streamReceiver.takeDueFrame();
+  if (frame) {
+    memcpy(matrix.getBuffer(), frame, Panel::pixels * sizeof(uint16_t));
+    streamReceiver.release(frame);
+    presentFrame();
+  }
+  streamReceiver.logStatsIfDue();
+}
+
+void StreamApp::redraw(bool force, int xOffset) {
+  if (!force && !getNeedsRedraw()) return;
+  setNeedsRedraw(false);
+  if (wasLive) return;  // Frames come from the stream
+
+  clearFrame();
+  showCenteredText("Stream", CONTENT.row(4), matrix.color565(0, 200, 255), 1, xOffset);
+  showCenteredText(WiFi.localIP().toString().c_str(), CONTENT.row(18), matrix.color565(192, 192, 192), 1, xOffset);
+}
+
+void StreamApp::setNeedsRedraw(bool flag) {
+  needsRedraw = flag;
+}
+
+bool StreamApp::getNeedsRedraw() {
+  return needsRedraw;
+}
+
+unsigned long StreamApp::getNextUpdateMs() {
+  return wasLive ? streamReceiver.msUntilNextDue() : LOOP_DEFAULT_TICK_MS;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "BaseApp.h"
+#include <Arduino.h>
+
+// Shows frames pushed over the LAN (DDP / E1.31). A live stream takes over the panel from the
+// rotation; in the rotation without one, this app shows where to send.
+class StreamApp : public BaseApp {
+public:
+  void init() override;
+  void loop() override;
+  void redraw(bool force = false, int xOffset = 0) override;
+
+  void setNeedsRedraw(bool flag) override;
+  bool getNeedsRedraw() override;
+  unsigned long getNextUpdateMs() override;
+  String getAppId() override { return "stream"; }
+
+private:
+  bool wasLive = false;
+  bool needsRedraw = true;
+};
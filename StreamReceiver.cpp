@@ -0,0 +1,238 @@
+#include "StreamReceiver.h"
+#include <AsyncUDP.h>
+#include "LoopScheduler.h"
+
+#define DDP_HEADER_LEN 10
+#define DDP_FLAG_VERSION_MASK 0xC0
+#define DDP_FLAG_VERSION_1 0x40
+#define DDP_FLAG_TIMECODE 0x10
+#define DDP_FLAG_QUERY 0x02
+#define DDP_FLAG_PUSH 0x01
+#define E131_DATA_OFFSET 126
+#define E131_OPTION_PREVIEW 0x80
+
+StreamReceiver streamReceiver;
+
+static AsyncUDP ddpSocket;
+static AsyncUDP e131Socket;
+static portMUX_TYPE slotMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const uint8_t E131_ACN_ID[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+static constexpr uint16_t E131_LAST_UNIVERSE = STREAM_E131_FIRST_UNIVERSE + STREAM_E131_UNIVERSES - 1;
+
+static uint32_t readBE32(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint16_t readBE16(const uint8_t* p) {
+  return ((uint16_t)p[0] << 8) | p[1];
+}
+
+bool parseDdpPacket(const uint8_t* data, size_t len, StreamChunk& chunk) {
+  if (len < DDP_HEADER_LEN) return false;
+  uint8_t flags = data[0];
+  if ((flags & DDP_FLAG_VERSION_MASK) != DDP_FLAG_VERSION_1 || (flags & DDP_FLAG_QUERY)) return false;
+
+  size_t header = (flags & DDP_FLAG_TIMECODE) ? DDP_HEADER_LEN + 4 : DDP_HEADER_LEN;
+  uint32_t byteOffset = readBE32(data + 4);
+  uint16_t byteCount = readBE16(data + 8);
+  if (len < header + byteCount || byteOffset % 3 != 0) return false;
+
+  chunk.pixelOffset = byteOffset / 3;
+  chunk.pixelCount = byteCount / 3;
+  chunk.rgb = data + header;
+  chunk.sequence = data[1] & 0x0F;
+  chunk.universe = 0;
+  chunk.frameEnd = flags & DDP_FLAG_PUSH;
+  return true;
+}
+
+bool parseE131Packet(const uint8_t* data, size_t len, StreamChunk& chunk) {
+  if (len < E131_DATA_OFFSET || memcmp(data + 4, E131_ACN_ID, sizeof(E131_ACN_ID)) != 0) return false;
+  if (readBE32(data + 18) != 0x00000004 || readBE32(data + 40) != 0x00000002 || data[117] != 0x02) return false;
+  if (data[112] & E131_OPTION_PREVIEW) return false;
+  if (data[125] != 0) return false;  // Only the null start code carries levels
+
+  uint16_t channels = readBE16(data + 123) - 1;
+  if (len < (size_t)E131_DATA_OFFSET + channels) return false;
+
+  chunk.universe = readBE16(data + 113);
+  if (chunk.universe < STREAM_E131_FIRST_UNIVERSE) return false;
+  chunk.pixelOffset = (uint32_t)(chunk.universe - STREAM_E131_FIRST_UNIVERSE) * STREAM_E131_PIXELS_PER_UNIVERSE;
+  chunk.pixelCount = min(channels / 3, STREAM_E131_PIXELS_PER_UNIVERSE);
+  chunk.rgb = data + E131_DATA_OFFSET;
+  chunk.sequence = data[111];
+  chunk.frameEnd = chunk.universe == E131_LAST_UNIVERSE;
+  return true;
+}
+
+uint32_t writeStreamChunk(const StreamChunk& chunk, uint16_t* frame, uint32_t framePixels) {
+  if (chunk.pixelOffset >= framePixels) return 0;
+  uint32_t count = min((uint32_t)chunk.pixelCount, framePixels - chunk.pixelOffset);
+  const uint8_t* src = chunk.rgb;
+  uint16_t* dst = frame + chunk.pixelOffset;
+  for (uint32_t i = 0; i < count; i++, src += 3) {
+    dst[i] = ((src[0] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[2] >> 3);
+  }
+  return count;
+}
+
+void StreamReceiver::begin() {
+  if (ddpSocket.listen(STREAM_DDP_PORT)) {
+    ddpSocket.onPacket([](AsyncUDPPacket& packet) {
+      StreamChunk chunk;
+      if (parseDdpPacket(packet.data(), packet.length(), chunk)) streamReceiver.onChunk(chunk);
+    });
+  }
+  if (e131Socket.listen(STREAM_E131_PORT)) {
+    e131Socket.onPacket([](AsyncUDPPacket& packet) {
+      StreamChunk chunk;
+      if (parseE131Packet(packet.data(), packet.length(), chunk)) streamReceiver.onChunk(chunk);
+    });
+  }
+  Serial.printf("📡 Stream receiver on UDP %d (DDP) and %d (E1.31, universes %d-%d)\n", STREAM_DDP_PORT,
+                STREAM_E131_PORT, STREAM_E131_FIRST_UNIVERSE, E131_LAST_UNIVERSE);
+}
+
+// Both listeners are served by the one async UDP task, so this side has a single writer
+void StreamReceiver::onChunk(const StreamChunk& chunk) {
+  if (chunk.universe > E131_LAST_UNIVERSE) return;  // Off the panel
+
+  // Drop packets that arrive behind ones already applied (sequence 0 means unnumbered)
+  if (chunk.sequence != 0) {
+    if (chunk.universe == 0) {
+      uint8_t ahead = (chunk.sequence + 15 - lastDdpSequence) % 15;  // Numbers run 1..15, 15 wraps to 1
+      if (lastDdpSequence != 0 && (ahead == 0 || ahead > 7)) { stats.late++; return; }
+      // Packets went missing, perhaps a push with them: what's filled so far may be another frame's
+      if (lastDdpSequence != 0 && ahead > 1) filledPixels = 0;
+      lastDdpSequence = chunk.sequence;
+    } else {
+      uint8_t& last = lastE131Sequence[chunk.universe - STREAM_E131_FIRST_UNIVERSE];
+      int8_t ahead = (int8_t)(chunk.sequence - last);
+      if (ahead <= 0 && ahead > -20) { stats.late++; return; }
+      last = chunk.sequence;
+    }
+  }
+
+  // Senders go through a frame in pixel order (DDP offsets, E1.31 universes), so a chunk that doesn't
+  // move forward belongs to the next frame: the last one lost its end and is refilled, not presented
+  if (filling >= 0 && chunk.pixelOffset < fillEnd) {
+    stats.incomplete++;
+    startFrame();
+  }
+  if (filling < 0) {
+    filling = claimSlot();
+    startFrame();
+  }
+  filledPixels += writeStreamChunk(chunk, slots[filling], Panel::pixels);
+  fillEnd = chunk.pixelOffset + chunk.pixelCount;
+  if (chunk.frameEnd) finishFrame();
+}
+
+void StreamReceiver::startFrame() {
+  filledPixels = 0;
+  fillEnd = 0;
+}
+
+// A free slot, or the oldest queued frame if the loop has fallen behind
+int StreamReceiver::claimSlot() {
+  portENTER_CRITICAL(&slotMux);
+  int slot = -1;
+  for (int i = 0; i < STREAM_SLOTS && slot < 0; i++) {
+    if (state[i] == SlotState::FREE) slot = i;
+  }
+  if (slot < 0) {
+    for (int i = 0; i < STREAM_SLOTS; i++) {
+      if (state[i] == SlotState::READY && (slot < 0 || readyOrder[i] < readyOrder[slot])) slot = i;
+    }
+    stats.dropped++;
+  }
+  state[slot] = SlotState::FILLING;
+  portEXIT_CRITICAL(&slotMux);
+  return slot;
+}
+
+void StreamReceiver::finishFrame() {
+  unsigned long now = millis();
+  if (filledPixels < Panel::pixels) stats.incomplete++;
+  stats.frames++;
+  if (now - lastFrameAt > STREAM_TIMEOUT_MS) liveFrames = 0;
+  liveFrames++;
+  lastFrameAt = now;
+
+  portENTER_CRITICAL(&slotMux);
+  state[filling] = SlotState::READY;
+  readyAt[filling] = now;
+  readyOrder[filling] = nextOrder++;
+  portEXIT_CRITICAL(&slotMux);
+  filling = -1;
+
+  wakeMainLoop();
+}
+
+bool StreamReceiver::isLive() {
+  return liveFrames >= STREAM_START_FRAMES && millis() - lastFrameAt < STREAM_TIMEOUT_MS;
+}
+
+const uint16_t* StreamReceiver::takeDueFrame() {
+  unsigned long now = millis();
+  int newest = -1;
+
+  portENTER_CRITICAL(&slotMux);
+  for (int i = 0; i < STREAM_SLOTS; i++) {
+    if (state[i] != SlotState::READY || now - readyAt[i] < STREAM_JITTER_MS) continue;
+    if (newest < 0 || readyOrder[i] > readyOrder[newest]) newest = i;
+  }
+  if (newest >= 0) {
+    // Older due frames are superseded — showing them now would only add latency
+    for (int i = 0; i < STREAM_SLOTS; i++) {
+      if (i != newest && state[i] == SlotState::READY && readyOrder[i] < readyOrder[newest]) {
+        state[i] = SlotState::FREE;
+        stats.skipped++;
+      }
+    }
+    state[newest] = SlotState::SHOWING;
+    stats.presented++;
+  }
+  portEXIT_CRITICAL(&slotMux);
+
+  return newest >= 0 ? slots[newest] : nullptr;
+}
+
+void StreamReceiver::release(const uint16_t* frame) {
+  int slot = (frame - slots[0]) / Panel::pixels;
+  portENTER_CRITICAL(&slotMux);
+  state[slot] = SlotState::FREE;
+  portEXIT_CRITICAL(&slotMux);
+}
+
+unsigned long StreamReceiver::msUntilNextDue() {
+  unsigned long now = millis();
+  unsigned long next = LOOP_DEFAULT_TICK_MS;  // New frames wake the loop themselves
+  portENTER_CRITICAL(&slotMux);
+  for (int i = 0; i < STREAM_SLOTS; i++) {
+    if (state[i] != SlotState::READY) continue;
+    unsigned long age = now - readyAt[i];
+    next = min(next, age >= STREAM_JITTER_MS ? 0UL : STREAM_JITTER_MS - age);
+  }
+  portEXIT_CRITICAL(&slotMux);
+  return next;
+}
+
+StreamStats StreamReceiver::getStats() {
+  portENTER_CRITICAL(&slotMux);
+  StreamStats s = stats;
+  portEXIT_CRITICAL(&slotMux);
+  return s;
+}
+
+void StreamReceiver::logStatsIfDue() {
+  unsigned long now = millis();
+  if (now - lastStatsLog < STREAM_STATS_MS) return;
+  StreamStats s = getStats();
+  float fps = (s.frames - lastStatsFrames) * 1000.0f / (now - lastStatsLog);
+  lastStatsLog = now;
+  lastStatsFrames = s.frames;
+  Serial.printf("📡 Stream %.1f fps — frames %lu, presented %lu, dropped %lu, skipped %lu, late %lu, incomplete %lu\n",
+                fps, s.frames, s.presented, s.dropped, s.skipped, s.late, s.incomplete);
+}
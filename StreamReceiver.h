@@ -0,0 +1,81 @@
+// StreamReceiver.h
+#pragma once
+
+#include <Arduino.h>
+#include "PanelGeometry.h"
+
+#define STREAM_DDP_PORT 4048
+#define STREAM_E131_PORT 5568
+#define STREAM_E131_FIRST_UNIVERSE 1
+#define STREAM_E131_PIXELS_PER_UNIVERSE 170  // 510 of the 512 DMX channels
+#define STREAM_E131_UNIVERSES ((Panel::pixels + STREAM_E131_PIXELS_PER_UNIVERSE - 1) / STREAM_E131_PIXELS_PER_UNIVERSE)
+#define STREAM_SLOTS 4                 // One filling, one on screen, two queued
+#define STREAM_JITTER_MS 35            // Playout delay: ~1–2 frames at 30–60 fps
+#define STREAM_START_FRAMES 3          // Complete frames before a stream takes over the panel
+#define STREAM_TIMEOUT_MS 2000         // No complete frame this long: back to the rotation
+#define STREAM_STATS_MS 10000
+
+// One decoded packet: a run of RGB888 pixels at a pixel offset in the frame
+struct StreamChunk {
+  uint32_t pixelOffset;
+  uint16_t pixelCount;
+  const uint8_t* rgb;
+  uint8_t sequence;                    // 0 when the sender doesn't number packets
+  uint16_t universe;                   // E1.31 only
+  bool frameEnd;                       // DDP push flag; E1.31 decides from the universe
+};
+
+// Pure packet decoding, no sockets — fed raw datagrams, so recorded captures can be replayed
+bool parseDdpPacket(const uint8_t* data, size_t len, StreamChunk& chunk);
+bool parseE131Packet(const uint8_t* data, size_t len, StreamChunk& chunk);
+uint32_t writeStreamChunk(const StreamChunk& chunk, uint16_t* frame, uint32_t framePixels);  // Pixels written
+
+struct StreamStats {
+  uint32_t frames;                     // Complete frames received
+  uint32_t presented;
+  uint32_t dropped;                    // Overwritten in the jitter buffer before they could be shown
+  uint32_t late;                       // Packets arriving behind newer ones, discarded
+  uint32_t skipped;                    // Due frames superseded by a newer due frame before the loop got to them
+  uint32_t incomplete;                 // Frame ended with pixels missing, or its end never came
+};
+
+class StreamReceiver {
+public:
+  void begin();                        // Opens the DDP and E1.31 listeners
+  bool isLive();
+
+  // Loop side: the newest frame whose playout time has come, or nullptr. Hand it back with release().
+  const uint16_t* takeDueFrame();
+  void release(const uint16_t* frame);
+  unsigned long msUntilNextDue();
+
+  void onChunk(const StreamChunk& chunk);  // Network side (async UDP task)
+  StreamStats getStats();
+  void logStatsIfDue();
+
+private:
+  enum class SlotState : uint8_t { FREE, FILLING, READY, SHOWING };
+
+  int claimSlot();
+  void startFrame();
+  void finishFrame();
+
+  uint16_t slots[STREAM_SLOTS][Panel::pixels];
+  SlotState state[STREAM_SLOTS] = {};
+  unsigned long readyAt[STREAM_SLOTS] = {};
+  uint32_t readyOrder[STREAM_SLOTS] = {};
+  uint32_t nextOrder = 0;
+
+  int filling = -1;
+  uint32_t filledPixels = 0;
+  uint32_t fillEnd = 0;                // Just past the last chunk written; a chunk behind it starts a new frame
+  uint8_t lastDdpSequence = 0;
+  uint8_t lastE131Sequence[STREAM_E131_UNIVERSES] = {};
+  uint32_t liveFrames = 0;             // Complete frames since the stream (re)started
+  unsigned long lastFrameAt = 0;
+  StreamStats stats = {};
+  unsigned long lastStatsLog = 0;
+  uint32_t lastStatsFrames = 0;
+};
+
+extern StreamReceiver streamReceiver;
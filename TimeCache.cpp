@@ -3,61 +3,88 @@
 #include <ArduinoJson.h>
 #include "DeviceRegistration.h"  // for storedLat, storedLon, timeFormatPreference
 #include "RemoteConfigManager.h"
+#include "Trace.h"
 
-extern int timeFormatPreference;  // 0 = 12hr no AM/PM, 1 = 12hr with AM/PM, 24 = 24hr
+extern int timeFormatPreference;  // 0 = 12h + AM/PM, 1 = 12h no suffix, 2 = 24h (DeviceRegistration.h)
 extern float storedLat;
 extern float storedLon;
 
 void TimeCache::init() {
-  fetchTime();
-  lastSync = millis();
+  sync();
 }
 
 void TimeCache::updateIfNeeded() {
-  if (millis() - lastSync > SYNC_INTERVAL) {
-    fetchTime();
+  unsigned long now = millis();
+  bool due = !isSynced() || now - lastSync > RemoteConfigManager::getDurationMs(ConfigKey::TIME_SYNC_SEC);
+  if (!due || (retryMs && now - lastAttempt < retryMs)) return;
+  sync();
+}
+
+// Until the first fetch lands the clock reads epoch 0 and the night schedule is off, so a failure
+// (no location or Firebase yet, service down) is retried well before the next 6-hourly sync
+void TimeCache::sync() {
+  lastAttempt = millis();
+  if (fetchTime()) {
     lastSync = millis();
+    retryMs = 0;
+  } else {
+    retryMs = retryMs ? min(retryMs * 2, TIME_RETRY_MAX_MS) : TIME_RETRY_MIN_MS;
+    Serial.printf("🕒 Time sync retry in %lu s\n", retryMs / 1000);
   }
 }
 
-void TimeCache::fetchTime() {
+bool TimeCache::fetchTime() {
   
   if (storedLat == 0.0 || storedLon == 0.0) {
     Serial.println("⚠️ Lat/Lon not set, skipping time fetch");
-    return;
+    return false;
   }
   if (!Firebase.ready()) {
     Serial.println("⚠️ Firebase not ready — skipping time fetch.");
-    return;
+    return false;
   }
-  String apiKey = RemoteConfigManager::get("IP_GEO_LOCATION_API_KEY", "");
-  if (apiKey == "") {
+  const char* apiKey = RemoteConfigManager::getString(ConfigKey::IP_GEO_LOCATION_API_KEY);
+  if (apiKey[0] == '\0') {
     Serial.println("❌ API key for timezone not found in secrets.");
-    return;
+    return false;
   }
 
   HTTPClient http;
-  String query = "https://api.ipgeolocation.io/timezone?apiKey=" + apiKey +
-                 "&lat=" + String(storedLat, 4) + "&long=" + String(storedLon, 4);
+  // The zone name from the cached GeoIP result saves the service a reverse lookup
+  String query = "https://api.ipgeolocation.io/timezone?apiKey=" + String(apiKey);
+  if (storedTimezone[0] != '\0') {
+    query += "&tz=" + String(storedTimezone);
+  } else {
+    query += "&lat=" + String(storedLat, 4) + "&long=" + String(storedLon, 4);
+  }
   http.begin(query);
+  Tracer::countRequest(Endpoint::IPGEO);
   Serial.println("🌐 Time zone query: " + query);
 
-  int code = http.GET();
+  int code;
+  {
+    TRACE_SCOPE(NETWORK);
+    code = http.GET();
+  }
   if (code != 200) {
     Serial.println("❌ Time API failed: " + http.errorToString(code));
     http.end();
-    return;
+    return false;
   }
 
   String payload = http.getString();
 
   DynamicJsonDocument doc(2048);
-  DeserializationError err = deserializeJson(doc, payload);
+  DeserializationError err;
+  {
+    TRACE_SCOPE(PARSE);
+    err = deserializeJson(doc, payload);
+  }
   if (err) {
     Serial.print("❌ JSON parse error: ");
     Serial.println(err.c_str());
     http.end();
-    return;
+    return false;
   }
 
   // Try multiple keys to support both formats
@@ -74,7 +101,7 @@ void TimeCache::fetchTime() {
   } else {
     Serial.println("❌ No valid date/time fields found in API response.");
     http.end();
-    return;
+    return false;
   }
 
   Serial.println("🧪 Composed ISO datetime: " + isoTime);
@@ -84,11 +111,12 @@ void TimeCache::fetchTime() {
   if (!strptime(isoTime.c_str(), "%Y-%m-%dT%H:%M:%S", &t)) {
     Serial.println("❌ strptime failed. Could not parse time string.");
     http.end();
-    return;
+    return false;
   }
 
   baseEpoch = mktime(&t);
   epochStartMillis = millis();
+  cachedEpoch = -1;  // Invalidate cached broken-down time
 
   Serial.printf("✅ Parsed Time: %04d-%02d-%02d %02d:%02d:%02d\n",
                 t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
@@ -96,47 +124,75 @@ void TimeCache::fetchTime() {
   Serial.printf("🕒 Epoch set to: %ld\n", baseEpoch);
 
   http.end();
+  return true;
 }
 
-String TimeCache::getCurrentTimeString() {
-  time_t now = baseEpoch + ((millis() - epochStartMillis) / 1000);
-  struct tm* t = localtime(&now);
-  char buf[9];
-  sprintf(buf, "%02d:%02d:%02d", t->tm_hour, t->tm_min, t->tm_sec);
-  return String(buf);
+time_t TimeCache::now() const {
+  return isSynced() ? baseEpoch + (time_t)((millis() - epochStartMillis) / 1000) : 0;
 }
 
-int TimeCache::getHour() {
+const struct tm& TimeCache::getTimeInfo() {
   time_t now = baseEpoch + ((millis() - epochStartMillis) / 1000);
-  struct tm* t = localtime(&now);
-  return t->tm_hour;
+  if (now != cachedEpoch) {
+    localtime_r(&now, &cachedTm);
+    cachedEpoch = now;
+  }
+  return cachedTm;
 }
 
-int TimeCache::getMinute() {
-  time_t now = baseEpoch + ((millis() - epochStartMillis) / 1000);
-  struct tm* t = localtime(&now);
-  return t->tm_min;
+unsigned long TimeCache::msUntilNextSecond() {
+  return 1000 - ((millis() - epochStartMillis) % 1000);
 }
 
-String TimeCache::getFormattedTime() {
-  int h = getHour();
-  int m = getMinute();
-  String suffix = "";
+unsigned long TimeCache::msUntilNextMinute() {
+  const struct tm& t = getTimeInfo();
+  return (59 - t.tm_sec) * 1000UL + msUntilNextSecond();
+}
+
+size_t TimeCache::formatCurrentTime(char* buf, size_t len) {
+  const struct tm& t = getTimeInfo();
+  return snprintf(buf, len, "%02d:%02d:%02d", t.tm_hour, t.tm_min, t.tm_sec);
+}
+
+const char* TimeCache::formatTimeDigits(char* buf, size_t len) {
+  const struct tm& t = getTimeInfo();
+  int h = t.tm_hour;
+  const char* suffix = "";
 
   if (timeFormatPreference == 0 || timeFormatPreference == 1) {
     // Convert to 12-hour format
-    suffix = (timeFormatPreference == 1) ? ((h >= 12) ? "PM" : "AM") : "";
+    if (timeFormatPreference == 0) suffix = (h >= 12) ? "PM" : "AM";
     h = h % 12;
     if (h == 0) h = 12;
   }
 
-  char buffer[8];
-  snprintf(buffer, sizeof(buffer), "%d:%02d", h, m);  // ✅ Drop leading zero from hour
-  String timeStr = String(buffer);
+  snprintf(buf, len, "%d:%02d", h, t.tm_min);  // ✅ Drop leading zero from hour
+  return suffix;
+}
 
-  if (timeFormatPreference == 1) {
-    timeStr += suffix;
-  }
+size_t TimeCache::formatTime(char* buf, size_t len) {
+  const char* suffix = formatTimeDigits(buf, len);
+  size_t n = strlen(buf);
+  if (*suffix) n += snprintf(buf + n, len > n ? len - n : 0, " %s", suffix);
+  return n;
+}
+
+String TimeCache::getCurrentTimeString() {
+  char buf[9];
+  formatCurrentTime(buf, sizeof(buf));
+  return String(buf);
+}
 
-  return timeStr;
-}
\ No newline at end of file
+int TimeCache::getHour() {
+  return getTimeInfo().tm_hour;
+}
+
+int TimeCache::getMinute() {
+  return getTimeInfo().tm_min;
+}
+
+String TimeCache::getFormattedTime() {
+  char buffer[TIME_TEXT_LEN];
+  formatTime(buffer, sizeof(buffer));
+  return String(buffer);
+}
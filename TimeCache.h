@@ -3,20 +3,40 @@
 #include <Arduino.h>
 #include <time.h>
 
+#define TIME_TEXT_LEN 12  // "12:59 PM" and its terminator, with room to spare
+#define TIME_RETRY_MIN_MS 15000UL        // First retry after a failed fetch; doubles from there
+#define TIME_RETRY_MAX_MS (10UL * 60UL * 1000UL)
+
 class TimeCache {
 public:
   void init();                    // Fetches and sets the current time
-  void updateIfNeeded();         // Re-syncs time if 6 hours passed
+  void updateIfNeeded();         // Re-syncs time if 6 hours passed, retries a failed fetch with backoff
   String getCurrentTimeString(); // Returns HH:MM:SS
   String getFormattedTime();     // Formatted based on user preference
   int getHour();                 // Returns current hour
   int getMinute();               // Returns current minute
+  bool isSynced() const { return baseEpoch != 0; }  // False until the first successful fetch
+  time_t now() const;            // Current epoch, 0 until synced
+
+  // Allocation-free variants — format into caller-owned buffers
+  const struct tm& getTimeInfo();                 // Broken-down time, converted at most once per second
+  size_t formatCurrentTime(char* buf, size_t len); // HH:MM:SS
+  size_t formatTime(char* buf, size_t len);        // Same output as getFormattedTime(): "1:04 PM", "13:04"
+  const char* formatTimeDigits(char* buf, size_t len);  // Just "1:04"; returns "AM"/"PM", or "" without a suffix
+
+  unsigned long msUntilNextSecond();  // Time until the displayed second changes
+  unsigned long msUntilNextMinute();  // Time until the displayed minute changes
 
 private:
   time_t baseEpoch = 0;
   unsigned long epochStartMillis = 0;
-  unsigned long lastSync = 0;
-  const unsigned long SYNC_INTERVAL = 21600000; // 6 hours
+  unsigned long lastSync = 0;  // Last successful fetch; re-synced every TIME_SYNC_SEC (6 hours default)
+  unsigned long lastAttempt = 0;
+  unsigned long retryMs = 0;   // Backoff after a failed fetch, 0 after a success
+
+  time_t cachedEpoch = -1;  // Epoch second that cachedTm was built from
+  struct tm cachedTm = {};
 
-  void fetchTime();  // Fetch time from API and update epoch
-};
\ No newline at end of file
+  void sync();       // fetchTime() and the bookkeeping around it
+  bool fetchTime();  // Fetch time from API and update epoch; false if it failed or was skipped
+};
@@ -0,0 +1,239 @@
+#include "Trace.h"
+#include <Firebase_ESP_Client.h>
+#include <esp_heap_caps.h>
+#include "BootTimeline.h"
+#include "RemoteConfigManager.h"
+
+extern FirebaseData fbdo;
+extern String deviceID;
+
+static const char* const SPAN_NAMES[] = {
+#define X(id, name, budget) name,
+  TRACE_SPANS(X)
+#undef X
+};
+
+static const char* const ENDPOINT_NAMES[] = {
+#define X(id, name) name,
+  TRACE_ENDPOINTS(X)
+#undef X
+};
+
+#define TRACE_DAY_MS (24UL * 60UL * 60UL * 1000UL / NOVAFRAME_TIME_SCALE)
+
+static const uint32_t SPAN_BUDGET_US[] = {
+#define X(id, name, budget) (budget) * 1000UL,
+  TRACE_SPANS(X)
+#undef X
+};
+
+TraceSample Tracer::ring[TRACE_RING_SIZE];
+uint16_t Tracer::ringHead = 0;
+TraceStats Tracer::stats[(int)TraceSpan::COUNT] = {};
+uint32_t Tracer::nestedMicros[TRACE_MAX_DEPTH] = {};
+uint8_t Tracer::depth = 0;
+TaskHandle_t Tracer::owner = nullptr;
+
+uint32_t Tracer::passStartMicros = 0;
+TraceSpan Tracer::passWorstSpan = TraceSpan::COUNT;
+uint32_t Tracer::passWorstMicros = 0;
+uint32_t Tracer::loopStalls = 0;
+TraceSpan Tracer::lastStallSpan = TraceSpan::COUNT;
+uint32_t Tracer::lastStallMicros = 0;
+
+uint32_t Tracer::requestsToday[(int)Endpoint::COUNT] = {};
+uint32_t Tracer::requestsYesterday[(int)Endpoint::COUNT] = {};
+unsigned long Tracer::dayStart = 0;
+uint32_t Tracer::dayNumber = 0;
+uint64_t Tracer::dayBusyMicros = 0;
+uint32_t Tracer::dayMinFreeHeap = UINT32_MAX;
+
+uint32_t Tracer::minFreeHeap = UINT32_MAX;
+uint32_t Tracer::minLargestBlock = UINT32_MAX;
+uint32_t Tracer::minFreePsram = UINT32_MAX;
+unsigned long Tracer::lastPush = 0;
+
+// Bucket 0 is < 64 us, bucket n covers [32 << n, 64 << n), the last one everything above
+static uint8_t bucketFor(uint32_t us) {
+  uint8_t b = 0;
+  us >>= 6;
+  while (us && b < TRACE_HIST_BUCKETS - 1) {
+    us >>= 1;
+    b++;
+  }
+  return b;
+}
+
+const char* Tracer::getName(TraceSpan span) {
+  return span < TraceSpan::COUNT ? SPAN_NAMES[(int)span] : "none";
+}
+
+void Tracer::enter() {
+  if (depth < TRACE_MAX_DEPTH) nestedMicros[depth] = 0;
+  depth++;
+}
+
+void Tracer::exit(TraceSpan span, uint32_t startMicros, uint32_t durationMicros) {
+  if (depth == 0) return;
+  depth--;
+  uint32_t nested = depth < TRACE_MAX_DEPTH ? nestedMicros[depth] : 0;
+  if (depth > 0 && depth <= TRACE_MAX_DEPTH) nestedMicros[depth - 1] += durationMicros;
+  record(span, startMicros, durationMicros, durationMicros - min(nested, durationMicros));
+}
+
+void Tracer::record(TraceSpan span, uint32_t startMicros, uint32_t durationMicros, uint32_t selfMicros) {
+  if (span >= TraceSpan::COUNT) return;
+
+  ring[ringHead] = { startMicros, durationMicros, selfMicros, span };
+  ringHead = (ringHead + 1) % TRACE_RING_SIZE;
+
+  TraceStats& s = stats[(int)span];
+  s.count++;
+  s.totalMicros += durationMicros;
+  s.selfMicros += selfMicros;
+  s.maxMicros = max(s.maxMicros, durationMicros);
+  s.buckets[bucketFor(durationMicros)]++;
+
+  // Blame the pass on the span that spent the time itself, not the one wrapping it
+  if (selfMicros > passWorstMicros) {
+    passWorstMicros = selfMicros;
+    passWorstSpan = span;
+  }
+
+  if (durationMicros > SPAN_BUDGET_US[(int)span]) {
+    s.stalls++;
+    lastStallSpan = span;
+    lastStallMicros = durationMicros;
+    Serial.printf("🐢 Stall: %s took %lu ms (budget %lu ms)\n", SPAN_NAMES[(int)span],
+                  (unsigned long)(durationMicros / 1000), (unsigned long)(SPAN_BUDGET_US[(int)span] / 1000));
+  }
+}
+
+void Tracer::beginPass() {
+  owner = xTaskGetCurrentTaskHandle();
+  passStartMicros = micros();
+  passWorstSpan = TraceSpan::COUNT;
+  passWorstMicros = 0;
+}
+
+void Tracer::endPass() {
+  if (passStartMicros == 0) return;
+  uint32_t elapsed = micros() - passStartMicros;
+  passStartMicros = 0;
+  dayBusyMicros += elapsed;
+
+  if (elapsed > TRACE_LOOP_BUDGET_MS * 1000UL) {
+    loopStalls++;
+    Serial.printf("🐢 Loop pass took %lu ms — mostly %s (%lu ms)\n", (unsigned long)(elapsed / 1000),
+                  getName(passWorstSpan), (unsigned long)(passWorstMicros / 1000));
+  }
+  sampleMemory();
+  if (millis() - dayStart >= TRACE_DAY_MS) rollDay();
+}
+
+// One line per day: how busy the loop was, the heap floor, and how often each service was hit
+void Tracer::rollDay() {
+  unsigned long now = millis();
+  float busy = dayBusyMicros / (float)(now - dayStart) / 10.0f;  // us over ms → percent
+
+  Serial.printf("📈 Day %lu: busy %.2f%%, heap min %lu |", (unsigned long)dayNumber, busy,
+                (unsigned long)dayMinFreeHeap);
+  for (int i = 0; i < (int)Endpoint::COUNT; i++) {
+    Serial.printf(" %s %lu", ENDPOINT_NAMES[i], (unsigned long)requestsToday[i]);
+    requestsYesterday[i] = requestsToday[i];
+    requestsToday[i] = 0;
+  }
+  Serial.println();
+
+  dayNumber++;
+  dayStart = now;
+  dayBusyMicros = 0;
+  dayMinFreeHeap = UINT32_MAX;
+}
+
+void Tracer::sampleMemory() {
+  uint32_t freeHeap = ESP.getFreeHeap();
+  minFreeHeap = min(minFreeHeap, freeHeap);
+  dayMinFreeHeap = min(dayMinFreeHeap, freeHeap);
+  minLargestBlock = min(minLargestBlock, (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+  if (ESP.getPsramSize() > 0) minFreePsram = min(minFreePsram, (uint32_t)ESP.getFreePsram());
+}
+
+uint32_t Tracer::percentileMicros(TraceSpan span, uint8_t pct) {
+  const TraceStats& s = stats[(int)span];
+  if (s.count == 0) return 0;
+
+  uint32_t target = (uint32_t)(((uint64_t)s.count * pct + 99) / 100);
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < TRACE_HIST_BUCKETS; b++) {
+    seen += s.buckets[b];
+    if (seen >= target) return (b == TRACE_HIST_BUCKETS - 1) ? s.maxMicros : (64UL << b);
+  }
+  return s.maxMicros;
+}
+
+void Tracer::printSummary() {
+  Serial.println("📊 Trace summary (count / p50 / p95 / max us / stalls / total / self ms):");
+  for (int i = 0; i < (int)TraceSpan::COUNT; i++) {
+    TraceSpan span = (TraceSpan)i;
+    const TraceStats& s = stats[i];
+    Serial.printf("   %-8s %6lu %7lu %7lu %8lu %4lu %8lu %8lu\n", SPAN_NAMES[i], (unsigned long)s.count,
+                  (unsigned long)percentileMicros(span, 50), (unsigned long)percentileMicros(span, 95),
+                  (unsigned long)s.maxMicros, (unsigned long)s.stalls, (unsigned long)(s.totalMicros / 1000),
+                  (unsigned long)(s.selfMicros / 1000));
+  }
+  Serial.printf("   heap min %lu, largest block min %lu, PSRAM min %lu, loop stalls %lu\n",
+                (unsigned long)minFreeHeap, (unsigned long)minLargestBlock,
+                (unsigned long)(minFreePsram == UINT32_MAX ? 0 : minFreePsram), (unsigned long)loopStalls);
+}
+
+void Tracer::pushDiagnosticsIfDue() {
+  unsigned long now = millis();
+  if (now - lastPush < DIAGNOSTICS_PUSH_MS) return;
+  lastPush = now;
+
+  printSummary();
+  if (!Firebase.ready() || deviceID == "") return;
+
+  FirebaseJson json;
+  json.set("uptimeSec", (int)(now / 1000));
+  json.set("heapMin", (int)minFreeHeap);
+  json.set("largestBlockMin", (int)minLargestBlock);
+  json.set("psramMin", (int)(minFreePsram == UINT32_MAX ? 0 : minFreePsram));
+  json.set("loopStalls", (int)loopStalls);
+  json.set("lastStall/span", getName(lastStallSpan));
+  json.set("lastStall/ms", (int)(lastStallMicros / 1000));
+  BootTimeline::addTo(json);
+
+  for (int i = 0; i < (int)Endpoint::COUNT; i++) {
+    char key[32];
+    snprintf(key, sizeof(key), "requestsPerDay/%s", ENDPOINT_NAMES[i]);
+    json.set(key, (int)(dayNumber > 0 ? requestsYesterday[i] : requestsToday[i]));
+  }
+
+  for (int i = 0; i < (int)TraceSpan::COUNT; i++) {
+    TraceSpan span = (TraceSpan)i;
+    const TraceStats& s = stats[i];
+    char key[32];
+    snprintf(key, sizeof(key), "spans/%s/n", SPAN_NAMES[i]);
+    json.set(key, (int)s.count);
+    snprintf(key, sizeof(key), "spans/%s/p50", SPAN_NAMES[i]);
+    json.set(key, (int)percentileMicros(span, 50));
+    snprintf(key, sizeof(key), "spans/%s/p95", SPAN_NAMES[i]);
+    json.set(key, (int)percentileMicros(span, 95));
+    snprintf(key, sizeof(key), "spans/%s/max", SPAN_NAMES[i]);
+    json.set(key, (int)s.maxMicros);
+    snprintf(key, sizeof(key), "spans/%s/stalls", SPAN_NAMES[i]);
+    json.set(key, (int)s.stalls);
+    snprintf(key, sizeof(key), "spans/%s/selfMs", SPAN_NAMES[i]);
+    json.set(key, (int)(s.selfMicros / 1000));
+  }
+
+  char path[64];
+  snprintf(path, sizeof(path), "/novaFrame/devices/%s/diagnostics", deviceID.c_str());
+  TRACE_SCOPE(NETWORK);
+  countRequest(Endpoint::RTDB);
+  if (!Firebase.RTDB.setJSON(&fbdo, path, &json)) {
+    Serial.printf("❌ Diagnostics push failed: %s\n", fbdo.errorReason().c_str());
+  }
+}
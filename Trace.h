@@ -0,0 +1,134 @@
+// Trace.h
+#pragma once
+
+#include <Arduino.h>
+
+// Main-loop stages. Budgets are the point past which a span counts as a stall.
+#define TRACE_SPANS(X)              \
+  X(NETWORK,    "network",  300)    \
+  X(PARSE,      "parse",    50)     \
+  X(APP_LOOP,   "appLoop",  20)     \
+  X(REDRAW,     "redraw",   30)     \
+  X(PRESENT,    "present",  5)
+
+// External services, counted per (possibly time-scaled) day
+#define TRACE_ENDPOINTS(X)              \
+  X(OPENWEATHER,  "openweather")        \
+  X(IPGEO,        "ipgeolocation")      \
+  X(IP_API,       "ipApi")              \
+  X(IPIFY,        "ipify")              \
+  X(RTDB,         "rtdb")               \
+  X(OTA_MANIFEST, "otaManifest")        \
+  X(OTA_IMAGE,    "otaImage")           \
+  X(CLIP,         "clip")
+
+#define TRACE_RING_SIZE 128        // Most recent samples, for post-mortem dumps
+#define TRACE_HIST_BUCKETS 12      // log2 buckets from <64 us up to >65 ms
+#define TRACE_LOOP_BUDGET_MS 500   // A whole busy pass (idle excluded)
+#define TRACE_MAX_DEPTH 8          // Nested TRACE_SCOPEs tracked for self time
+#define DIAGNOSTICS_PUSH_MS (5UL * 60UL * 1000UL)
+
+enum class TraceSpan : uint8_t {
+#define X(id, name, budget) id,
+  TRACE_SPANS(X)
+#undef X
+  COUNT
+};
+
+enum class Endpoint : uint8_t {
+#define X(id, name) id,
+  TRACE_ENDPOINTS(X)
+#undef X
+  COUNT
+};
+
+struct TraceSample {
+  uint32_t startMicros;
+  uint32_t durationMicros;
+  uint32_t selfMicros;       // Duration minus the spans nested inside it
+  TraceSpan span;
+};
+
+struct TraceStats {
+  uint32_t count;
+  uint32_t maxMicros;
+  uint64_t totalMicros;
+  uint64_t selfMicros;       // Exclusive time: a parse inside a network span counts only once
+  uint32_t stalls;
+  uint32_t buckets[TRACE_HIST_BUCKETS];
+};
+
+// Everything here is meant for the loop task only. Spans opened on any other task (the button
+// task's gesture redraws, which can run while the loop sits inside one of its unlocked network
+// spans) are dropped rather than mixed into the loop's nesting.
+class Tracer {
+public:
+  static bool tracesThisTask() { return !owner || owner == xTaskGetCurrentTaskHandle(); }
+
+  // ScopedTrace brackets each span with these so nested spans can be subtracted from their parent
+  static void enter();
+  static void exit(TraceSpan span, uint32_t startMicros, uint32_t durationMicros);
+  static void record(TraceSpan span, uint32_t startMicros, uint32_t durationMicros, uint32_t selfMicros);
+
+  static void beginPass();   // Right after the loop wakes
+  static void endPass();     // Right before it idles; reports which span ate an over-budget pass
+
+  static void sampleMemory();               // Track heap/PSRAM low-water marks
+  static uint32_t percentileMicros(TraceSpan span, uint8_t pct);  // Bucket upper bound
+  static const TraceStats& getStats(TraceSpan span) { return stats[(int)span]; }
+  static const char* getName(TraceSpan span);
+
+  // Safe from the OTA task too: each counter only ever has one writer task
+  static void countRequest(Endpoint endpoint) { requestsToday[(int)endpoint]++; }
+
+  static void printSummary();
+  static void pushDiagnosticsIfDue();       // Compact summary to /novaFrame/devices/<id>/diagnostics
+
+private:
+  static TraceSample ring[TRACE_RING_SIZE];
+  static uint16_t ringHead;
+  static TraceStats stats[(int)TraceSpan::COUNT];
+  static uint32_t nestedMicros[TRACE_MAX_DEPTH];  // Per open span: time spent in its children so far
+  static uint8_t depth;
+  static TaskHandle_t owner;  // The task that last called beginPass()
+
+  static uint32_t passStartMicros;
+  static TraceSpan passWorstSpan;
+  static uint32_t passWorstMicros;
+  static uint32_t loopStalls;
+  static TraceSpan lastStallSpan;
+  static uint32_t lastStallMicros;
+
+  static void rollDay();
+
+  static uint32_t requestsToday[(int)Endpoint::COUNT];
+  static uint32_t requestsYesterday[(int)Endpoint::COUNT];
+  static unsigned long dayStart;
+  static uint32_t dayNumber;
+  static uint64_t dayBusyMicros;
+  static uint32_t dayMinFreeHeap;
+
+  static uint32_t minFreeHeap;
+  static uint32_t minLargestBlock;
+  static uint32_t minFreePsram;
+  static unsigned long lastPush;
+};
+
+class ScopedTrace {
+public:
+  explicit ScopedTrace(TraceSpan span) : span(span), start(micros()), traced(Tracer::tracesThisTask()) {
+    if (traced) Tracer::enter();
+  }
+  ~ScopedTrace() {
+    if (traced) Tracer::exit(span, start, micros() - start);
+  }
+
+private:
+  TraceSpan span;
+  uint32_t start;
+  bool traced;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(span) ScopedTrace TRACE_CONCAT(traceScope_, __LINE__)(TraceSpan::span)
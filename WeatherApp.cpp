@@ -3,6 +3,10 @@
 #include "WeatherCache.h"
 #include "DeviceRegistration.h"
 
+void WeatherApp::prepare() {
+  updateWeatherCache();
+}
+
 void WeatherApp::init() {
   setNeedsRedraw(true);  // Trigger initial draw
 }
@@ -15,27 +19,25 @@ void WeatherApp::redraw(bool force, int xOffset) {
   if (!force && !getNeedsRedraw()) return;
 
   // Weather data from cache
-  String temp = weatherData.temp;
-  String city = weatherData.city;
+  char tempStr[12];
+  formatTemperatureString(tempStr, sizeof(tempStr));
 
   matrix.setTextSize(2);
-  matrix.setTextColor(getScaledColor(255, 255, 255));
-  matrix.setCursor(0 + xOffset, 0);
+  matrix.setTextColor(matrix.color565(255, 255, 255));
+  matrix.setCursor(CONTENT.col(0) + xOffset, CONTENT.row(0));
   matrix.print("*");  // Icon placeholder
 
-  char degree = 247;
-  String tempStr = temp + String(degree) + (units == "imperial" ? "F" : "C");
-  matrix.setCursor(18 + xOffset, 6);
-  matrix.setTextColor(getScaledColor(0, 255, 255));
+  matrix.setCursor(CONTENT.col(18) + xOffset, CONTENT.row(6));
+  matrix.setTextColor(matrix.color565(0, 255, 255));
   matrix.print(tempStr);
 
   matrix.setTextSize(1);
-  matrix.setCursor(0 + xOffset, 24);
-  matrix.setTextColor(getScaledColor(255, 255, 255));
-  matrix.print(city);
+  matrix.setCursor(CONTENT.col(0) + xOffset, CONTENT.row(24));
+  matrix.setTextColor(matrix.color565(255, 255, 255));
+  matrix.print(weatherData.city);
 
   matrix.setTextSize(2);  // Reset
-  matrix.show();
+  presentFrame();
   setNeedsRedraw(false);
 }
 
@@ -43,6 +45,10 @@ void WeatherApp::setNeedsRedraw(bool flag) {
   needsRedraw = flag;
 }
 
+unsigned long WeatherApp::getNextUpdateMs() {
+  return needsRedraw ? 0 : LOOP_MAX_IDLE_MS;  // Only changes with the weather cache
+}
+
 bool WeatherApp::getNeedsRedraw() {
   return needsRedraw;
 }
\ No newline at end of file
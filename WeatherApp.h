@@ -3,12 +3,14 @@
 
 class WeatherApp : public BaseApp {
 public:
+  void prepare() override;
   void init() override;
   void loop() override;
   void redraw(bool force = false, int xOffset = 0) override;
 
   void setNeedsRedraw(bool flag) override;
   bool getNeedsRedraw() override;
+  unsigned long getNextUpdateMs() override;
   String getAppId() override { return "weather"; }
 
 private:
@@ -6,10 +6,11 @@
 #include "DeviceRegistration.h"
 #include "RemoteConfigManager.h"
 #include "AppManager.h"
+#include "HourlyForecast.h"
+#include "Trace.h"
 
 extern FirebaseData fbdo;
-extern String getSanitizedMac();
-extern String units;
+extern char units[];
 extern float storedLat;
 extern float storedLon;
 extern BaseApp* getActiveApp();
@@ -17,14 +18,127 @@ extern AppManager appManager;
 
 WeatherData weatherData;
 unsigned long lastWeatherFetchTime = 0;
-const unsigned long WEATHER_CACHE_INTERVAL = 60UL * 60UL * 1000UL; // 1 hour
+unsigned long lastWeatherAttemptTime = 0;  // Failed attempts wait WEATHER_RETRY_MS before the next one
+
+// Keep only the fields we use — the hourly array is large otherwise
+static void buildOneCallFilter(JsonDocument& filter) {
+  filter["current"]["temp"] = true;
+  filter["current"]["feels_like"] = true;
+  filter["current"]["weather"][0]["icon"] = true;
+  filter["daily"][0]["dt"] = true;
+  filter["daily"][0]["temp"]["max"] = true;
+  filter["daily"][0]["temp"]["min"] = true;
+  filter["daily"][0]["weather"][0]["icon"] = true;
+  filter["hourly"][0]["dt"] = true;
+  filter["hourly"][0]["temp"] = true;
+  filter["hourly"][0]["pop"] = true;
+  filter["hourly"][0]["weather"][0]["icon"] = true;
+}
 
-void updateWeatherCache() {
-  unsigned long now = millis();
+static bool applyOneCall(JsonDocument& doc);
 
-  if (now - lastWeatherFetchTime < WEATHER_CACHE_INTERVAL && lastWeatherFetchTime != 0) {
-    return;
+// Fills weatherData and hourlyForecast from a One Call 3.0 response
+bool parseOneCallPayload(const char* payload, size_t len) {
+  StaticJsonDocument<512> filter;
+  buildOneCallFilter(filter);
+
+  DynamicJsonDocument doc(12288);
+  DeserializationError err;
+  {
+    TRACE_SCOPE(PARSE);
+    err = deserializeJson(doc, payload, len, DeserializationOption::Filter(filter));
   }
+  if (err) {
+    Serial.print("❌ JSON parse error: ");
+    Serial.println(err.c_str());
+    return false;
+  }
+  return applyOneCall(doc);
+}
+
+// Same, parsed straight off the socket: only the filtered document is ever in RAM
+bool parseOneCallStream(Stream& stream) {
+  StaticJsonDocument<512> filter;
+  buildOneCallFilter(filter);
+
+  DynamicJsonDocument doc(12288);
+  DeserializationError err;
+  {
+    TRACE_SCOPE(NETWORK);  // Reading is paced by the network, so it counts as network time
+    err = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+  }
+  if (err) {
+    Serial.print("❌ JSON parse error: ");
+    Serial.println(err.c_str());
+    return false;
+  }
+  return applyOneCall(doc);
+}
+
+static bool applyOneCall(JsonDocument& doc) {
+  // Current weather
+  weatherData.temp10      = (int16_t)round(doc["current"]["temp"].as<float>() * 10.0f);
+  weatherData.feelsLike10 = (int16_t)round(doc["current"]["feels_like"].as<float>() * 10.0f);
+  const char* currentIcon = doc["current"]["weather"][0]["icon"] | "";
+  weatherData.icon        = decodeWeatherIcon(currentIcon);
+
+  // Today
+  JsonObject today = doc["daily"][0];
+  weatherData.today.high10 = (int16_t)round(today["temp"]["max"].as<float>() * 10.0f);
+  weatherData.today.low10  = (int16_t)round(today["temp"]["min"].as<float>() * 10.0f);
+
+  // ✅ Use current.icon instead of daily[0]
+  weatherData.today.icon = weatherData.icon;
+
+  // Tomorrow
+  JsonObject tomorrow = doc["daily"][1];
+  weatherData.tomorrow.high10 = (int16_t)round(tomorrow["temp"]["max"].as<float>() * 10.0f);
+  weatherData.tomorrow.low10  = (int16_t)round(tomorrow["temp"]["min"].as<float>() * 10.0f);
+  const char* tomorrowIcon = tomorrow["weather"][0]["icon"] | "";
+  weatherData.tomorrow.icon = decodeWeatherIcon(tomorrowIcon);
+
+  // Day names
+  time_t todayDT = today["dt"].as<time_t>();
+  time_t tomorrowDT = tomorrow["dt"].as<time_t>();
+  struct tm t;
+
+  localtime_r(&todayDT, &t);
+  weatherData.today.weekday = t.tm_wday;
+
+  localtime_r(&tomorrowDT, &t);
+  weatherData.tomorrow.weekday = t.tm_wday;
+
+  // Hourly series (48h) for the sparkline
+  JsonArray hourly = doc["hourly"];
+  hourlyForecast.clear();
+  for (JsonObject hour : hourly) {
+    HourlySample sample;
+    sample.temp10 = (int16_t)round(hour["temp"].as<float>() * 10.0f);
+    sample.pop = (uint8_t)constrain((int)round(hour["pop"].as<float>() * 100.0f), 0, 100);
+    sample.icon = HourlyForecast::packIcon(hour["weather"][0]["icon"] | "");
+    hourlyForecast.push(sample);
+  }
+  hourlyForecast.commit(hourly.size() > 0 ? hourly[0]["dt"].as<time_t>() : 0);
+  return true;
+}
+
+unsigned long msUntilWeatherRefresh() {
+  unsigned long now = millis();
+  unsigned long remaining = 0;
+  if (lastWeatherFetchTime != 0) {
+    unsigned long cacheInterval = RemoteConfigManager::getDurationMs(ConfigKey::WEATHER_REFRESH_SEC);  // 1 hour default
+    remaining = cacheInterval - min(now - lastWeatherFetchTime, cacheInterval);
+  }
+  if (lastWeatherAttemptTime != 0) {
+    remaining = max(remaining, WEATHER_RETRY_MS - min(now - lastWeatherAttemptTime, (unsigned long)WEATHER_RETRY_MS));
+  }
+  return remaining;
+}
+
+void updateWeatherCache() {
+  if (msUntilWeatherRefresh() > 0) return;
+  unsigned long now = millis();
+  lastWeatherAttemptTime = now;
 
   float lat = storedLat;
   float lon = storedLon;
@@ -34,78 +148,45 @@ void updateWeatherCache() {
     return;
   }
 
-  String apiKey = RemoteConfigManager::get("OPENWEATHER_API_KEY", "");
-  if (apiKey == "") {
+  const char* apiKey = RemoteConfigManager::getString(ConfigKey::OPENWEATHER_API_KEY);
+  if (apiKey[0] == '\0') {
     Serial.println("❌ One Call API key not found in remote config.");
     return;
   }
 
   String query = "https://api.openweathermap.org/data/3.0/onecall?lat=" + String(lat, 4)
                + "&lon=" + String(lon, 4)
-               + "&exclude=minutely,hourly,alerts"
-               + "&units=" + units
+               + "&exclude=minutely,alerts"
+               + "&units=metric"  // Canonical unit — converted locally on display
                + "&appid=" + apiKey;
 
   Serial.println("🌍 One Call 3.0 query: " + query);
 
   HTTPClient http;
   http.begin(query);
-  int code = http.GET();
+  http.useHTTP10(true);  // No chunked transfer encoding, so the body can be parsed off the stream as-is
+  Tracer::countRequest(Endpoint::OPENWEATHER);
+  int code;
+  {
+    TRACE_SCOPE(NETWORK);
+    code = http.GET();
+  }
 
   if (code == 200) {
-    String payload = http.getString();
-    Serial.println("📦 One Call API response received");
-
-    DynamicJsonDocument doc(8192);
-    DeserializationError err = deserializeJson(doc, payload);
-    if (err) {
-      Serial.print("❌ JSON parse error: ");
-      Serial.println(err.c_str());
+    if (!parseOneCallStream(http.getStream())) {
+      http.end();
       return;
     }
-
-    // Current weather
-    weatherData.temp      = String((int)round(doc["current"]["temp"].as<float>()));
-    weatherData.feelsLike = String((int)round(doc["current"]["feels_like"].as<float>()));
-    weatherData.icon      = doc["current"]["weather"][0]["icon"].as<String>();
-    Serial.println("📍 Current icon: " + weatherData.icon);
-
-    // Today
-    JsonObject today = doc["daily"][0];
-    weatherData.tempHigh = String((int)round(today["temp"]["max"].as<float>()));
-    weatherData.tempLow  = String((int)round(today["temp"]["min"].as<float>()));
-    weatherData.forecastHigh1 = weatherData.tempHigh;
-    weatherData.forecastLow1  = weatherData.tempLow;
-
-    // ✅ Use current.icon instead of daily[0]
-    weatherData.icon1 = weatherData.icon;
-    Serial.println("🌤️ icon1 set to current icon: " + weatherData.icon1);
-
-    // Tomorrow
-    JsonObject tomorrow = doc["daily"][1];
-    weatherData.forecastHigh2 = String((int)round(tomorrow["temp"]["max"].as<float>()));
-    weatherData.forecastLow2  = String((int)round(tomorrow["temp"]["min"].as<float>()));
-    weatherData.icon2 = tomorrow["weather"][0]["icon"].as<String>();
-    Serial.println("🔮 icon2 (tomorrow): " + weatherData.icon2);
-
-    // Day names
-    time_t todayDT = today["dt"].as<time_t>();
-    time_t tomorrowDT = tomorrow["dt"].as<time_t>();
-    char buf[4];
-
-    strftime(buf, sizeof(buf), "%a", localtime(&todayDT));
-    weatherData.forecastDay1 = String(buf);
-
-    strftime(buf, sizeof(buf), "%a", localtime(&tomorrowDT));
-    weatherData.forecastDay2 = String(buf);
+    Serial.printf("🕐 Hourly samples cached: %u\n", (unsigned)hourlyForecast.size());
 
     lastWeatherFetchTime = now;
     Serial.println("✅ Weather cache updated (One Call)");
-    Serial.println("🌡️ Temp now: " + weatherData.temp);
+    Serial.printf("🌡️ Temp now: %d\n", toDisplayDegrees(weatherData.temp10));
+    Serial.printf("🧠 Heap free: %u, largest block: %u\n", ESP.getFreeHeap(), ESP.getMaxAllocHeap());
 
     // 🔁 Force ForecastApp to redraw if it's currently showing
     BaseApp* activeApp = getActiveApp();
-    if (activeApp != nullptr && activeApp->getAppId() == "forecast") {
+    if (activeApp != nullptr && appManager.getActiveAppId() == AppId::forecast) {
       activeApp->setNeedsRedraw(true);
     }
 
@@ -116,12 +197,39 @@ void updateWeatherCache() {
   http.end();
 }
 
-String getTemperatureString(const String& unitSystem) {
-  char degreeSymbol = 247;
-  String unit = (unitSystem == "imperial") ? "F" : "C";
-  return weatherData.temp + String(degreeSymbol) + unit;
+bool useImperialUnits() {
+  return strcmp(units, "imperial") == 0;
+}
+
+int toDisplayDegrees(int16_t celsius10) {
+  if (useImperialUnits()) {
+    return (int)lroundf(celsius10 * 0.18f + 32.0f);
+  }
+  return (int)lroundf(celsius10 / 10.0f);
+}
+
+size_t formatDegrees(char* buf, size_t len, int16_t celsius10) {
+  char degree = 247;
+  if (celsius10 == WEATHER_NO_VALUE) {
+    return snprintf(buf, len, "--%c", degree);
+  }
+  return snprintf(buf, len, "%d%c", toDisplayDegrees(celsius10), degree);
 }
 
-String getUnits() {
+size_t formatTemperatureString(char* buf, size_t len) {
+  size_t n = formatDegrees(buf, len, weatherData.temp10);
+  if (n + 1 < len) {
+    buf[n++] = useImperialUnits() ? 'F' : 'C';
+    buf[n] = '\0';
+  }
+  return n;
+}
+
+const char* getWeekdayName(uint8_t weekday) {
+  static const char* const names[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+  return weekday < 7 ? names[weekday] : "";
+}
+
+const char* getUnits() {
   return units;
-}
\ No newline at end of file
+}
@@ -2,31 +2,43 @@
 #pragma once
 
 #include <Arduino.h>
+#include "WeatherIcons.h"
+
+#define WEATHER_NO_VALUE INT16_MIN  // Temperature not fetched yet ("--")
+#define WEATHER_NO_DAY 0xFF         // Weekday not fetched yet
+#define WEATHER_RETRY_MS 30000      // After a failed fetch
+
+// All temperatures are stored in tenths of a degree Celsius and converted on display
+struct DayForecast {
+  int16_t high10 = WEATHER_NO_VALUE;
+  int16_t low10 = WEATHER_NO_VALUE;
+  WeatherIcon icon = ICON_UNKNOWN;
+  uint8_t weekday = WEATHER_NO_DAY;  // 0 = Sunday, as in tm_wday
+};
 
 struct WeatherData {
   // Current conditions
-  String temp = "--";
-  String feelsLike = "--";
-  String tempHigh = "--";
-  String tempLow = "--";
-  String city = "";
-  String icon = "";
-
-  // Forecast for Today
-  String forecastDay1 = "";
-  String forecastHigh1 = "--";
-  String forecastLow1 = "--";
-  String icon1 = "";
-
-  // Forecast for Tomorrow
-  String forecastDay2 = "";
-  String forecastHigh2 = "--";
-  String forecastLow2 = "--";
-  String icon2 = "";
+  int16_t temp10 = WEATHER_NO_VALUE;
+  int16_t feelsLike10 = WEATHER_NO_VALUE;
+  WeatherIcon icon = ICON_UNKNOWN;
+  char city[24] = "";
+
+  // Forecast for Today and Tomorrow
+  DayForecast today;
+  DayForecast tomorrow;
 };
 
 extern WeatherData weatherData;
 
-String getUnits();
+const char* getUnits();
+bool useImperialUnits();
 void updateWeatherCache();
-String getTemperatureString(const String& unitSystem);
\ No newline at end of file
+unsigned long msUntilWeatherRefresh();  // 0 once updateWeatherCache() would fetch
+bool parseOneCallPayload(const char* payload, size_t len);  // Split out so it can be benchmarked offline
+bool parseOneCallStream(Stream& stream);                    // What updateWeatherCache() uses: no payload String
+
+// Display formatting — converts to the current units into caller-owned buffers
+int toDisplayDegrees(int16_t celsius10);
+size_t formatDegrees(char* buf, size_t len, int16_t celsius10);  // "23°"
+size_t formatTemperatureString(char* buf, size_t len);           // "23°C" for the current temp
+const char* getWeekdayName(uint8_t weekday);
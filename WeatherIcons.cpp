@@ -1,6 +1,7 @@
 #include "WeatherIcons.h"
 #include <Adafruit_Protomatter.h>
 #include "DisplayHelpers.h"
+#include "FrameKernels.h"
 
 extern Adafruit_Protomatter matrix;
 
@@ -80,47 +81,47 @@ const uint8_t bitmap_rain_large[32] = {
   0b00001010, 0b10000000
 };
 
-uint16_t getIconColor(const String& iconCode) {
-  if (iconCode.startsWith("01") || iconCode.startsWith("02")) {
-    return getScaledColor(255, 255, 0);  // Yellow
-  } else if (iconCode.startsWith("03") || iconCode.startsWith("04") || iconCode.endsWith("n")) {
-    return getScaledColor(255, 255, 255);  // White
-  } else if (iconCode.startsWith("09") || iconCode.startsWith("10") || iconCode.startsWith("11") || iconCode.startsWith("13")) {
-    return getScaledColor(0, 128, 255);  // Blue
-  } else {
-    return getScaledColor(192, 192, 192);  // Fallback gray
+WeatherIcon decodeWeatherIcon(const char* iconCode) {
+  if (!iconCode || strlen(iconCode) < 2) return ICON_UNKNOWN;
+
+  int code = (iconCode[0] - '0') * 10 + (iconCode[1] - '0');
+  bool night = iconCode[strlen(iconCode) - 1] == 'n';
+
+  if (code == 1 || code == 2) return ICON_SUN;
+  if (code == 3 || code == 4) return ICON_CLOUD;
+  if (night) return ICON_MOON;
+  if (code == 9 || code == 10 || code == 11 || code == 13) return ICON_RAIN;
+  return ICON_UNKNOWN;
+}
+
+uint16_t getIconColor(WeatherIcon icon) {
+  switch (icon) {
+    case ICON_SUN:   return matrix.color565(255, 255, 0);    // Yellow
+    case ICON_CLOUD:
+    case ICON_MOON:  return matrix.color565(255, 255, 255);  // White
+    case ICON_RAIN:  return matrix.color565(0, 128, 255);    // Blue
+    default:         return matrix.color565(192, 192, 192);  // Fallback gray
   }
 }
 
-void drawWeatherIcon(const String& iconCode, int x, int y) {
+void drawWeatherIcon(WeatherIcon icon, int x, int y) {
   const uint8_t* iconBitmap = nullptr;
-  uint8_t w = 8;
-  uint8_t h = 8;
+  uint8_t w = 16;
+  uint8_t h = 16;
 
-  if (iconCode.startsWith("01") || iconCode.startsWith("02")) {
-    iconBitmap = bitmap_sun_large;
-    w = 16;
-    h = 16;
-  } else if (iconCode.startsWith("03") || iconCode.startsWith("04")) {
-    iconBitmap = bitmap_cloud_large;
-    w = 32;
-    h = 32;
-  } else if (iconCode.endsWith("n")) {
-    iconBitmap = bitmap_moon_large;
-    w = 16;
-    h = 16;
-  } else if (iconCode.startsWith("09") || iconCode.startsWith("10") ||
-             iconCode.startsWith("11") || iconCode.startsWith("13")) {
-    iconBitmap = bitmap_rain_large;
-    w = 16;
-    h = 16;
+  switch (icon) {
+    case ICON_SUN:   iconBitmap = bitmap_sun_large; break;
+    case ICON_CLOUD: iconBitmap = bitmap_cloud_large; w = 32; h = 32; break;
+    case ICON_MOON:  iconBitmap = bitmap_moon_large; break;
+    case ICON_RAIN:  iconBitmap = bitmap_rain_large; break;
+    default: break;
   }
 
   if (iconBitmap) {
-    matrix.drawBitmap(x, y, iconBitmap, w, h, getIconColor(iconCode));
+    blitMask(iconBitmap, w, h, x, y, getIconColor(icon));
   } else {
     matrix.setCursor(x, y);
-    matrix.setTextColor(getScaledColor(192, 192, 192));
+    matrix.setTextColor(matrix.color565(192, 192, 192));
     matrix.print("?");
   }
-}
\ No newline at end of file
+}
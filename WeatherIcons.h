@@ -9,8 +9,20 @@ extern const uint8_t bitmap_cloud_large[128];
 extern const uint8_t bitmap_moon_large[32];
 extern const uint8_t bitmap_rain_large[32];
 
-// Returns a color for the icon based on the OpenWeatherMap icon code, with brightness scaling
-uint16_t getIconColor(const String& iconCode);
+// Icon bitmaps, decoded once from the OpenWeatherMap icon code when weather is fetched
+enum WeatherIcon : uint8_t {
+  ICON_UNKNOWN = 0,
+  ICON_SUN,
+  ICON_CLOUD,
+  ICON_MOON,
+  ICON_RAIN
+};
 
-// Draws the correct weather icon bitmap at the given x,y based on iconCode
-void drawWeatherIcon(const String& iconCode, int x, int y);
+// Maps an OpenWeatherMap icon code ("10d", "03n", ...) to its bitmap
+WeatherIcon decodeWeatherIcon(const char* iconCode);
+
+// Returns a color for the icon, with brightness scaling
+uint16_t getIconColor(WeatherIcon icon);
+
+// Draws the weather icon bitmap at the given x,y
+void drawWeatherIcon(WeatherIcon icon, int x, int y);
@@ -0,0 +1,3 @@
+// The Arduino builder compiles the .ino as C++ after prepending Arduino.h; this does the same.
+#include <Arduino.h>
+#include "../NovaFrame.ino"
@@ -0,0 +1,10 @@
+#include "Benchmarks.h"
+#include "DisplayHelpers.h"
+#include "HostRuntime.h"
+
+int main() {
+  host::setClockMode(host::ClockMode::HYBRID);
+  initializeDisplay();
+  runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "AppRegistry.h"
+#include "DisplayHelpers.h"
+#include "FrameKernels.h"
+#include "HostRuntime.h"
+#include "StandIns.h"
+
+// Each app's first frame after a boot against the stand-ins (05:00 local, the stand-in weather),
+// compared with host/goldens/<W>x<H>/<app>.ppm. Built once per panel geometry. Run with
+// NOVAFRAME_UPDATE_GOLDENS=1 to write the current frames as the new goldens.
+
+static std::string goldenPath(const char* app) {
+  const char* source = getenv("NOVAFRAME_SOURCE_DIR");
+  return std::string(source ? source : ".") + "/host/goldens/" + std::to_string(PANEL_WIDTH) + "x" +
+         std::to_string(PANEL_HEIGHT) + "/" + app + ".ppm";
+}
+
+// Binary PPM (P6), RGB565 widened to 8 bits per channel
+static std::vector<uint8_t> toPpm(const uint16_t* px) {
+  char header[32];
+  int n = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", (int)PANEL_WIDTH, (int)PANEL_HEIGHT);
+  std::vector<uint8_t> ppm(header, header + n);
+  for (int i = 0; i < Panel::pixels; i++) {
+    uint16_t c = px[i];
+    uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    ppm.push_back((r << 3) | (r >> 2));
+    ppm.push_back((g << 2) | (g >> 4));
+    ppm.push_back((b << 3) | (b >> 2));
+  }
+  return ppm;
+}
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) data.insert(data.end(), chunk, chunk + n);
+  fclose(f);
+  return true;
+}
+
+static bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) return false;
+  bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+  return fclose(f) == 0 && ok;
+}
+
+class GoldenTest : public testing::TestWithParam<AppId> {
+protected:
+  void SetUp() override { host::bootDevice(); }
+
+  // What AppManager::loadApp() puts on the panel
+  const uint16_t* render(AppId id) {
+    BaseApp* app = AppRegistry::get(id);
+    clearFrame();
+    app->prepare();
+    app->init();
+    app->redraw(true);
+    return matrix.getBuffer();
+  }
+};
+
+TEST_P(GoldenTest, FirstFrameMatchesGolden) {
+  const char* name = AppRegistry::getName(GetParam());
+  std::vector<uint8_t> actual = toPpm(render(GetParam()));
+  std::string path = goldenPath(name);
+
+  if (getenv("NOVAFRAME_UPDATE_GOLDENS")) {
+    ASSERT_TRUE(writeFile(path, actual)) << "could not write " << path;
+    return;
+  }
+
+  std::vector<uint8_t> golden;
+  ASSERT_TRUE(readFile(path, golden)) << path << " is missing; run with NOVAFRAME_UPDATE_GOLDENS=1";
+  if (golden == actual) return;
+
+  // Keep the frame for a side-by-side look, and point at the first pixel that moved
+  std::string saved = std::string(name) + "-" + std::to_string(PANEL_WIDTH) + "x" + std::to_string(PANEL_HEIGHT) + ".ppm";
+  writeFile(saved, actual);
+  size_t header = actual.size() - Panel::pixels * 3;
+  int changed = 0, first = -1;
+  for (int i = 0; i < Panel::pixels; i++) {
+    size_t at = header + i * 3;
+    if (golden.size() < at + 3 || memcmp(&golden[at], &actual[at], 3) != 0) {
+      if (first < 0) first = i;
+      changed++;
+    }
+  }
+  ADD_FAILURE() << name << ": " << changed << " pixel(s) differ from " << path << ", first at (" << first % PANEL_WIDTH
+                << ", " << first / PANEL_WIDTH << "); frame saved as " << saved;
+}
+
+INSTANTIATE_TEST_SUITE_P(Apps, GoldenTest,
+                         testing::Values(AppId::clock, AppId::clockWeather, AppId::weather, AppId::forecast, AppId::sparkline),
+                         [](const testing::TestParamInfo<AppId>& info) { return std::string(AppRegistry::getName(info.param)); });
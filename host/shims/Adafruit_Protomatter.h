@@ -0,0 +1,38 @@
+// Adafruit_Protomatter.h
+#pragma once
+
+// Host HUB75 driver: the canvas is the framebuffer, show() latches a copy that tests and golden
+// images read back.
+
+#include <Adafruit_GFX.h>
+#include <vector>
+
+enum ProtomatterStatus { PROTOMATTER_OK, PROTOMATTER_ERR_PINS, PROTOMATTER_ERR_MALLOC, PROTOMATTER_ERR_ARG };
+
+class Adafruit_Protomatter : public GFXcanvas16 {
+public:
+  Adafruit_Protomatter(uint16_t bitWidth, uint8_t bitDepth, uint8_t rgbCount, uint8_t* rgbList, uint8_t addrCount,
+                       uint8_t* addrList, uint8_t clockPin, uint8_t latchPin, uint8_t oePin, bool doubleBuffer,
+                       int8_t tile = 1, void* timer = nullptr)
+      : GFXcanvas16(bitWidth, (1 << addrCount) * 2 * rgbCount * (tile < 0 ? -tile : tile)) {
+    (void)bitDepth; (void)rgbList; (void)addrList; (void)clockPin; (void)latchPin; (void)oePin;
+    (void)doubleBuffer; (void)timer;
+  }
+
+  ProtomatterStatus begin() { return PROTOMATTER_OK; }
+  void show() {
+    shown.assign(buffer, buffer + (size_t)_width * _height);
+    frames++;
+  }
+  static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+
+  // What the panel is displaying: the buffer as of the last show()
+  const std::vector<uint16_t>& displayed() const { return shown; }
+  uint32_t frameCount() const { return frames; }
+
+private:
+  std::vector<uint16_t> shown;
+  uint32_t frames = 0;
+};
@@ -0,0 +1,730 @@
+#include "ArduinoJson.h"
+#include <errno.h>
+
+// ---------------------------------------------------------------------------------------------
+// Arena
+
+void JsonPool::init(uint8_t* storage, size_t capacity) {
+  buffer = storage;
+  cap = storage ? capacity : 0;
+  reset();
+}
+
+void JsonPool::reset() {
+  used = 0;
+  front = 0;
+  back = cap * 4;
+  building = 0;
+  overflow = false;
+}
+
+JsonNode* JsonPool::newNode() {
+  size_t bytes = (sizeof(JsonNode) + 7) & ~(size_t)7;
+  if (used + ARDUINOJSON_SLOT_SIZE > cap || back < front + bytes) {
+    overflow = true;
+    return nullptr;
+  }
+  back -= bytes;
+  used += ARDUINOJSON_SLOT_SIZE;
+  return new (buffer + back) JsonNode();
+}
+
+bool JsonPool::appendChar(char c) {
+  if (used + building + 2 > cap || front + building + 2 > back) {
+    overflow = true;
+    return false;
+  }
+  buffer[front + building++] = c;
+  return true;
+}
+
+const char* JsonPool::commitString() {
+  if (used + building + 1 > cap || front + building + 1 > back) {
+    overflow = true;
+    return nullptr;
+  }
+  buffer[front + building] = '\0';
+  const char* s = (const char*)buffer + front;
+  front += building + 1;
+  used += building + 1;
+  building = 0;
+  return s;
+}
+
+void JsonPool::releaseString(const char* s) {
+  size_t len = strlen(s) + 1;
+  if ((const uint8_t*)s + len != buffer + front) return;
+  front -= len;
+  used -= len;
+}
+
+const char* JsonPool::saveString(const char* s, size_t len) {
+  beginString();
+  for (size_t i = 0; i < len; i++) {
+    if (!appendChar(s[i])) return nullptr;
+  }
+  return commitString();
+}
+
+DynamicJsonDocument::DynamicJsonDocument(size_t capacity) { init((uint8_t*)malloc(capacity * 4), capacity); }
+
+DynamicJsonDocument::~DynamicJsonDocument() { free(buffer); }
+
+void JsonDocument::clear() {
+  reset();
+  root = JsonNode();
+}
+
+// ---------------------------------------------------------------------------------------------
+// Tree helpers
+
+namespace ArduinoJsonHost {
+
+const JsonNode* findMember(const JsonNode* object, const char* key) {
+  if (!object || object->type != JsonNodeType::Object || !key) return nullptr;
+  for (const JsonNode* n = object->value.list.head; n; n = n->next) {
+    if (strcmp(n->key, key) == 0) return n;
+  }
+  return nullptr;
+}
+
+const JsonNode* findElement(const JsonNode* array, size_t index) {
+  if (!array || array->type != JsonNodeType::Array) return nullptr;
+  const JsonNode* n = array->value.list.head;
+  while (n && index--) n = n->next;
+  return n;
+}
+
+JsonNode* makeContainer(JsonNode* node, JsonNodeType type) {
+  if (!node) return nullptr;
+  if (node->type == JsonNodeType::Null) {
+    node->type = type;
+    node->value.list = {nullptr, nullptr, 0};
+  }
+  return node->type == type ? node : nullptr;
+}
+
+JsonNode* addChild(JsonPool* pool, JsonNode* container, JsonNodeType containerType, const char* key) {
+  if (!makeContainer(container, containerType)) return nullptr;
+  JsonNode* n = pool->newNode();
+  if (!n) return nullptr;
+  if (key) {
+    n->key = pool->saveString(key, strlen(key));
+    if (!n->key) return nullptr;
+  }
+  if (container->value.list.tail) {
+    container->value.list.tail->next = n;
+  } else {
+    container->value.list.head = n;
+  }
+  container->value.list.tail = n;
+  container->value.list.count++;
+  return n;
+}
+
+bool toBool(const JsonNode* n) {
+  if (!n) return false;
+  switch (n->type) {
+    case JsonNodeType::Null: return false;
+    case JsonNodeType::Bool: return n->value.boolean;
+    case JsonNodeType::Int: return n->value.integer != 0;
+    case JsonNodeType::Float: return n->value.real != 0;
+    default: return true;
+  }
+}
+
+int64_t toInteger(const JsonNode* n) {
+  if (!n) return 0;
+  switch (n->type) {
+    case JsonNodeType::Bool: return n->value.boolean;
+    case JsonNodeType::Int: return n->value.integer;
+    case JsonNodeType::Float: return (int64_t)n->value.real;
+    case JsonNodeType::String: return strtoll(n->value.string, nullptr, 10);
+    default: return 0;
+  }
+}
+
+double toReal(const JsonNode* n) {
+  if (!n) return 0;
+  switch (n->type) {
+    case JsonNodeType::Bool: return n->value.boolean;
+    case JsonNodeType::Int: return (double)n->value.integer;
+    case JsonNodeType::Float: return n->value.real;
+    case JsonNodeType::String: return strtod(n->value.string, nullptr);
+    default: return 0;
+  }
+}
+
+bool isInteger(const JsonNode* n) { return n && n->type == JsonNodeType::Int; }
+
+void setNull(JsonNode* n) {
+  n->type = JsonNodeType::Null;
+  n->value = {};
+}
+
+void set(JsonPool* pool, JsonNode* n, bool v) {
+  n->type = JsonNodeType::Bool;
+  n->value.boolean = v;
+}
+
+void set(JsonPool* pool, JsonNode* n, const char* v) {
+  if (!v) return setNull(n);
+  const char* copy = pool->saveString(v, strlen(v));
+  if (!copy) return setNull(n);
+  n->type = JsonNodeType::String;
+  n->value.string = copy;
+}
+
+void set(JsonPool* pool, JsonNode* n, const String& v) { set(pool, n, v.c_str()); }
+
+void set(JsonPool* pool, JsonNode* n, double v) {
+  n->type = JsonNodeType::Float;
+  n->value.real = v;
+}
+
+void setInteger(JsonPool* pool, JsonNode* n, int64_t v) {
+  n->type = JsonNodeType::Int;
+  n->value.integer = v;
+}
+
+static void copyInto(JsonPool* pool, JsonNode* dst, const JsonNode* src) {
+  setNull(dst);
+  if (!src) return;
+  switch (src->type) {
+    case JsonNodeType::String: set(pool, dst, src->value.string); break;
+    case JsonNodeType::Array:
+    case JsonNodeType::Object:
+      makeContainer(dst, src->type);
+      for (const JsonNode* c = src->value.list.head; c; c = c->next) {
+        JsonNode* child = addChild(pool, dst, src->type, src->type == JsonNodeType::Object ? c->key : nullptr);
+        if (!child) return;
+        copyInto(pool, child, c);
+      }
+      break;
+    default: dst->type = src->type; dst->value = src->value; break;
+  }
+}
+
+static void serializeString(const char* s, String& out) {
+  out += '"';
+  for (; *s; s++) {
+    char c = *s;
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          char escape[8];
+          snprintf(escape, sizeof(escape), "\\u%04x", c);
+          out += escape;
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+void serialize(const JsonNode* n, String& out) {
+  char number[32];
+  if (!n) {
+    out += "null";
+    return;
+  }
+  switch (n->type) {
+    case JsonNodeType::Null: out += "null"; break;
+    case JsonNodeType::Bool: out += n->value.boolean ? "true" : "false"; break;
+    case JsonNodeType::Int:
+      snprintf(number, sizeof(number), "%lld", (long long)n->value.integer);
+      out += number;
+      break;
+    case JsonNodeType::Float:
+      if (isnan(n->value.real) || isinf(n->value.real)) {
+        out += "null";
+      } else {
+        snprintf(number, sizeof(number), "%.9g", n->value.real);
+        out += number;
+      }
+      break;
+    case JsonNodeType::String: serializeString(n->value.string, out); break;
+    case JsonNodeType::Array:
+    case JsonNodeType::Object: {
+      bool object = n->type == JsonNodeType::Object;
+      out += object ? '{' : '[';
+      for (const JsonNode* c = n->value.list.head; c; c = c->next) {
+        if (c != n->value.list.head) out += ',';
+        if (object) {
+          serializeString(c->key, out);
+          out += ':';
+        }
+        serialize(c, out);
+      }
+      out += object ? '}' : ']';
+      break;
+    }
+  }
+}
+
+}  // namespace ArduinoJsonHost
+
+using namespace ArduinoJsonHost;
+
+const JsonNode* JsonProxy::node() const {
+  const JsonNode* base = parentProxy ? parentProxy->node() : parentNode;
+  return memberKey ? findMember(base, memberKey) : findElement(base, elementIndex);
+}
+
+JsonNode* JsonProxy::materialize() const {
+  JsonNodeType parentType = memberKey ? JsonNodeType::Object : JsonNodeType::Array;
+  JsonNode* parent = parentProxy ? parentProxy->materializeAs(parentType) : makeContainer(parentNode, parentType);
+  if (!parent) return nullptr;
+
+  if (memberKey) {
+    JsonNode* existing = const_cast<JsonNode*>(findMember(parent, memberKey));
+    return existing ? existing : addChild(owner, parent, parentType, memberKey);
+  }
+  while (parent->value.list.count <= elementIndex) {
+    if (!addChild(owner, parent, parentType, nullptr)) return nullptr;
+  }
+  return const_cast<JsonNode*>(findElement(parent, elementIndex));
+}
+
+JsonNode* JsonProxy::materializeAs(JsonNodeType containerType) const { return makeContainer(materialize(), containerType); }
+
+const JsonProxy& JsonProxy::operator=(const JsonProxy& other) const {
+  JsonNode* n = materialize();
+  if (n) copyInto(owner, n, other.node());
+  return *this;
+}
+
+JsonArray JsonProxy::createNestedArray() const {
+  JsonNode* n = materialize();
+  if (n) setNull(n);
+  return JsonArray(owner, makeContainer(n, JsonNodeType::Array));
+}
+
+JsonObject JsonProxy::createNestedObject() const {
+  JsonNode* n = materialize();
+  if (n) setNull(n);
+  return JsonObject(owner, makeContainer(n, JsonNodeType::Object));
+}
+
+JsonArray JsonObject::createNestedArray(const char* key) const { return (*this)[key].createNestedArray(); }
+JsonObject JsonObject::createNestedObject(const char* key) const { return (*this)[key].createNestedObject(); }
+
+JsonObject JsonArray::createNestedObject() const {
+  JsonNode* n = data ? addChild(nodePool, data, JsonNodeType::Array, nullptr) : nullptr;
+  return JsonObject(nodePool, makeContainer(n, JsonNodeType::Object));
+}
+
+JsonArray JsonArray::createNestedArray() const {
+  JsonNode* n = data ? addChild(nodePool, data, JsonNodeType::Array, nullptr) : nullptr;
+  return JsonArray(nodePool, makeContainer(n, JsonNodeType::Array));
+}
+
+// ---------------------------------------------------------------------------------------------
+// Parser
+
+const char* DeserializationError::c_str() const {
+  switch (errorCode) {
+    case Ok: return "Ok";
+    case EmptyInput: return "EmptyInput";
+    case IncompleteInput: return "IncompleteInput";
+    case InvalidInput: return "InvalidInput";
+    case NoMemory: return "NoMemory";
+    case TooDeep: return "TooDeep";
+  }
+  return "???";
+}
+
+namespace {
+
+struct MemoryReader {
+  const char* p;
+  const char* end;
+  int read() { return p < end ? (unsigned char)*p++ : -1; }
+};
+
+struct StreamReader {
+  Stream* stream;
+  int read() {
+    char c;
+    return stream->readBytes(&c, 1) == 1 ? (unsigned char)c : -1;
+  }
+};
+
+// Filter semantics follow ArduinoJson 6: `true` keeps everything below it, an object filter keeps
+// the listed members ("*" for any other), an array filter applies its first element to every item.
+struct Filter {
+  const JsonNode* node;
+
+  bool keepsAll() const { return node && node->type == JsonNodeType::Bool && node->value.boolean; }
+  bool allow() const { return toBool(node); }
+  bool allowValue() const { return keepsAll(); }
+  bool allowObject() const { return keepsAll() || (node && node->type == JsonNodeType::Object); }
+  bool allowArray() const { return keepsAll() || (node && node->type == JsonNodeType::Array); }
+  Filter member(const char* key) const {
+    if (keepsAll()) return *this;
+    const JsonNode* m = findMember(node, key);
+    return Filter{m ? m : findMember(node, "*")};
+  }
+  Filter element() const { return keepsAll() ? *this : Filter{findElement(node, 0)}; }
+};
+
+const JsonNode keepEverything = [] {
+  JsonNode n;
+  n.type = JsonNodeType::Bool;
+  n.value.boolean = true;
+  return n;
+}();
+
+template <typename Reader>
+class Parser {
+public:
+  Parser(Reader reader, JsonPool* pool) : in(reader), pool(pool) {}
+
+  DeserializationError parse(JsonNode* root, Filter filter, int nesting) {
+    skipSpace();
+    if (peek() < 0) return DeserializationError::EmptyInput;
+    return parseValue(root, filter, nesting);
+  }
+
+private:
+  int peek() {
+    if (lookahead == NONE) lookahead = in.read();
+    return lookahead;
+  }
+  int next() {
+    int c = peek();
+    lookahead = NONE;
+    return c;
+  }
+  void skipSpace() {
+    while (peek() == ' ' || peek() == '\n' || peek() == '\r' || peek() == '\t') next();
+  }
+  DeserializationError endOfInput() const { return DeserializationError::IncompleteInput; }
+
+  DeserializationError parseValue(JsonNode* target, Filter filter, int nesting) {
+    skipSpace();
+    int c = peek();
+    if (c < 0) return endOfInput();
+    if (c == '{') return filter.allowObject() ? parseObject(target, filter, nesting) : skipContainer(nesting);
+    if (c == '[') return filter.allowArray() ? parseArray(target, filter, nesting) : skipContainer(nesting);
+    if (c == '"' || c == '\'') {
+      if (!filter.allowValue()) return readString(false, nullptr);
+      const char* s = nullptr;
+      DeserializationError err = readString(true, &s);
+      if (err) return err;
+      target->type = JsonNodeType::String;
+      target->value.string = s;
+      return DeserializationError::Ok;
+    }
+    return parseScalar(filter.allowValue() ? target : nullptr);
+  }
+
+  DeserializationError parseObject(JsonNode* target, Filter filter, int nesting) {
+    if (nesting <= 0) return DeserializationError::TooDeep;
+    next();
+    makeContainer(target, JsonNodeType::Object);
+    skipSpace();
+    if (peek() == '}') {
+      next();
+      return DeserializationError::Ok;
+    }
+    for (;;) {
+      skipSpace();
+      if (peek() < 0) return endOfInput();
+      if (peek() != '"' && peek() != '\'') return DeserializationError::InvalidInput;
+      const char* key = nullptr;
+      DeserializationError err = readString(true, &key);
+      if (err) return err;
+      skipSpace();
+      if (peek() < 0) return endOfInput();
+      if (next() != ':') return DeserializationError::InvalidInput;
+
+      Filter memberFilter = filter.member(key);
+      if (memberFilter.allow()) {
+        JsonNode* member = const_cast<JsonNode*>(findMember(target, key));
+        if (member) {
+          pool->releaseString(key);
+        } else {
+          member = pool->newNode();
+          if (!member) return DeserializationError::NoMemory;
+          member->key = key;
+          if (target->value.list.tail) {
+            target->value.list.tail->next = member;
+          } else {
+            target->value.list.head = member;
+          }
+          target->value.list.tail = member;
+          target->value.list.count++;
+        }
+        err = parseValue(member, memberFilter, nesting - 1);
+      } else {
+        pool->releaseString(key);
+        err = skipValue(nesting - 1);
+      }
+      if (err) return err;
+
+      skipSpace();
+      int c = next();
+      if (c < 0) return endOfInput();
+      if (c == '}') return DeserializationError::Ok;
+      if (c != ',') return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError parseArray(JsonNode* target, Filter filter, int nesting) {
+    if (nesting <= 0) return DeserializationError::TooDeep;
+    next();
+    makeContainer(target, JsonNodeType::Array);
+    skipSpace();
+    if (peek() == ']') {
+      next();
+      return DeserializationError::Ok;
+    }
+    Filter itemFilter = filter.element();
+    for (;;) {
+      DeserializationError err;
+      if (itemFilter.allow()) {
+        JsonNode* item = addChild(pool, target, JsonNodeType::Array, nullptr);
+        if (!item) return DeserializationError::NoMemory;
+        err = parseValue(item, itemFilter, nesting - 1);
+      } else {
+        err = skipValue(nesting - 1);
+      }
+      if (err) return err;
+
+      skipSpace();
+      int c = next();
+      if (c < 0) return endOfInput();
+      if (c == ']') return DeserializationError::Ok;
+      if (c != ',') return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError skipValue(int nesting) {
+    skipSpace();
+    int c = peek();
+    if (c < 0) return endOfInput();
+    if (c == '{' || c == '[') return skipContainer(nesting);
+    if (c == '"' || c == '\'') return readString(false, nullptr);
+    return parseScalar(nullptr);
+  }
+
+  DeserializationError skipContainer(int nesting) {
+    if (nesting <= 0) return DeserializationError::TooDeep;
+    int close = next() == '{' ? '}' : ']';
+    skipSpace();
+    if (peek() == close) {
+      next();
+      return DeserializationError::Ok;
+    }
+    for (;;) {
+      DeserializationError err;
+      if (close == '}') {
+        skipSpace();
+        err = readString(false, nullptr);
+        if (err) return err;
+        skipSpace();
+        if (peek() < 0) return endOfInput();
+        if (next() != ':') return DeserializationError::InvalidInput;
+      }
+      err = skipValue(nesting - 1);
+      if (err) return err;
+      skipSpace();
+      int c = next();
+      if (c < 0) return endOfInput();
+      if (c == close) return DeserializationError::Ok;
+      if (c != ',') return DeserializationError::InvalidInput;
+    }
+  }
+
+  static int hexDigit(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  }
+
+  bool keep(bool store, char c) { return !store || pool->appendChar(c); }
+
+  DeserializationError readString(bool store, const char** out) {
+    int quote = next();
+    if (quote != '"' && quote != '\'') return DeserializationError::InvalidInput;
+    if (store) pool->beginString();
+    for (;;) {
+      int c = next();
+      if (c < 0) return endOfInput();
+      if (c == quote) break;
+      if (c == '\\') {
+        c = next();
+        if (c < 0) return endOfInput();
+        switch (c) {
+          case 'b': c = '\b'; break;
+          case 'f': c = '\f'; break;
+          case 'n': c = '\n'; break;
+          case 'r': c = '\r'; break;
+          case 't': c = '\t'; break;
+          case 'u': {
+            uint32_t code = 0;
+            for (int i = 0; i < 4; i++) {
+              int d = next();
+              if (d < 0) return endOfInput();
+              if (hexDigit(d) < 0) return DeserializationError::InvalidInput;
+              code = code << 4 | hexDigit(d);
+            }
+            // UTF-8 encode; surrogate pairs are kept as two 3-byte sequences
+            if (code < 0x80) {
+              if (!keep(store, (char)code)) return DeserializationError::NoMemory;
+            } else if (code < 0x800) {
+              if (!keep(store, (char)(0xC0 | code >> 6)) || !keep(store, (char)(0x80 | (code & 0x3F)))) return DeserializationError::NoMemory;
+            } else {
+              if (!keep(store, (char)(0xE0 | code >> 12)) || !keep(store, (char)(0x80 | ((code >> 6) & 0x3F))) ||
+                  !keep(store, (char)(0x80 | (code & 0x3F)))) {
+                return DeserializationError::NoMemory;
+              }
+            }
+            continue;
+          }
+          default: break;  // \" \\ \/ and anything else map to themselves
+        }
+      }
+      if (!keep(store, (char)c)) return DeserializationError::NoMemory;
+    }
+    if (!store) return DeserializationError::Ok;
+    *out = pool->commitString();
+    return *out ? DeserializationError::Ok : DeserializationError::NoMemory;
+  }
+
+  DeserializationError parseScalar(JsonNode* target) {
+    char text[64];
+    size_t len = 0;
+    for (;;) {
+      int c = peek();
+      if (c < 0 || c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ':') break;
+      if (len + 1 >= sizeof(text)) return DeserializationError::InvalidInput;
+      text[len++] = (char)next();
+    }
+    text[len] = '\0';
+    if (len == 0) return peek() < 0 ? endOfInput() : DeserializationError::InvalidInput;
+
+    if (strcmp(text, "true") == 0 || strcmp(text, "false") == 0) {
+      if (target) set(pool, target, text[0] == 't');
+      return DeserializationError::Ok;
+    }
+    if (strcmp(text, "null") == 0) {
+      if (target) setNull(target);
+      return DeserializationError::Ok;
+    }
+
+    char* end = nullptr;
+    bool integral = strpbrk(text, ".eE") == nullptr;
+    if (integral) {
+      errno = 0;
+      long long v = strtoll(text, &end, 10);
+      if (*end == '\0' && errno == 0) {
+        if (target) setInteger(pool, target, v);
+        return DeserializationError::Ok;
+      }
+    }
+    double real = strtod(text, &end);
+    if (*end != '\0') return DeserializationError::InvalidInput;
+    if (target) set(pool, target, real);
+    return DeserializationError::Ok;
+  }
+
+  static constexpr int NONE = -2;
+  Reader in;
+  JsonPool* pool;
+  int lookahead = NONE;
+};
+
+template <typename Reader>
+DeserializationError run(JsonDocument& doc, Reader reader, const JsonNode* filter, uint8_t nesting) {
+  doc.clear();
+  Parser<Reader> parser(reader, &doc);
+  DeserializationError err = parser.parse(doc.rootNode(), Filter{filter ? filter : &keepEverything}, nesting);
+  if (err == DeserializationError::IncompleteInput && doc.overflowed()) return DeserializationError::NoMemory;
+  return err;
+}
+
+}  // namespace
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, DeserializationOption::NestingLimit nesting) {
+  return deserializeJson(doc, input, input ? strlen(input) : 0, nesting);
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t len, DeserializationOption::NestingLimit nesting) {
+  return run(doc, MemoryReader{input, input + len}, nullptr, nesting.value());
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const String& input, DeserializationOption::NestingLimit nesting) {
+  return deserializeJson(doc, input.c_str(), input.length(), nesting);
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, Stream& input, DeserializationOption::NestingLimit nesting) {
+  return run(doc, StreamReader{&input}, nullptr, nesting.value());
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting) {
+  return deserializeJson(doc, input, input ? strlen(input) : 0, filter, nesting);
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t len, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting) {
+  return run(doc, MemoryReader{input, input + len}, filter.node(), nesting.value());
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const String& input, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting) {
+  return deserializeJson(doc, input.c_str(), input.length(), filter, nesting);
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, Stream& input, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting) {
+  return run(doc, StreamReader{&input}, filter.node(), nesting.value());
+}
+
+// ---------------------------------------------------------------------------------------------
+// Serializer
+
+size_t serializeJson(const JsonDocument& doc, String& output) {
+  size_t before = output.length();
+  serialize(doc.node(), output);
+  return output.length() - before;
+}
+
+size_t serializeJson(JsonVariantConst v, String& output) {
+  size_t before = output.length();
+  serialize(v.node(), output);
+  return output.length() - before;
+}
+
+size_t serializeJson(const JsonDocument& doc, char* output, size_t size) {
+  String text;
+  serialize(doc.node(), text);
+  if (size == 0) return 0;
+  size_t n = min(text.length(), size - 1);
+  memcpy(output, text.c_str(), n);
+  output[n] = '\0';
+  return n;
+}
+
+size_t serializeJson(const JsonDocument& doc, Print& output) {
+  String text;
+  serialize(doc.node(), text);
+  return output.print(text);
+}
+
+size_t measureJson(const JsonDocument& doc) {
+  String text;
+  serialize(doc.node(), text);
+  return text.length();
+}
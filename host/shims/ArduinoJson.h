@@ -0,0 +1,505 @@
+// ArduinoJson.h
+#pragma once
+
+// The ArduinoJson 6 API subset the sketch uses. Like the real library a document owns one fixed
+// arena (one malloc for DynamicJsonDocument, none for StaticJsonDocument) and fails with NoMemory
+// once its capacity is used up. Capacity is charged at the device's 32-bit sizes: 16 bytes per value
+// slot plus the copied strings, so a document sized for the ESP32 overflows here when it would there.
+
+#include <Arduino.h>
+#include <new>
+
+#define ARDUINOJSON_SLOT_SIZE 16
+#define ARDUINOJSON_DEFAULT_NESTING_LIMIT 10
+
+enum class JsonNodeType : uint8_t { Null, Bool, Int, Float, String, Array, Object };
+
+struct JsonNode {
+  JsonNodeType type = JsonNodeType::Null;
+  union {
+    bool boolean;
+    int64_t integer;
+    double real;
+    const char* string;
+    struct {
+      JsonNode* head;
+      JsonNode* tail;
+      size_t count;
+    } list;
+  } value = {};
+  const char* key = nullptr;
+  JsonNode* next = nullptr;
+};
+
+class JsonPool {
+public:
+  JsonNode* newNode();
+  const char* saveString(const char* s, size_t len);
+  // Strings are built in place a character at a time while parsing
+  void beginString() { building = 0; }
+  bool appendChar(char c);
+  const char* commitString();
+  void releaseString(const char* s);  // Drops the most recently committed string, e.g. a skipped key
+
+  size_t capacity() const { return cap; }
+  size_t memoryUsage() const { return used; }
+  bool overflowed() const { return overflow; }
+
+protected:
+  void init(uint8_t* storage, size_t capacity);
+  void reset();
+
+  uint8_t* buffer = nullptr;
+  size_t cap = 0;
+  size_t used = 0;       // Modelled device bytes
+  size_t front = 0;      // Strings grow up from the start of the buffer
+  size_t back = 0;       // Nodes grow down from the end
+  size_t building = 0;
+  bool overflow = false;
+};
+
+class JsonObject;
+class JsonArray;
+class JsonVariant;
+class JsonVariantConst;
+class JsonProxy;
+class JsonDocument;
+
+namespace ArduinoJsonHost {
+const JsonNode* findMember(const JsonNode* object, const char* key);
+const JsonNode* findElement(const JsonNode* array, size_t index);
+JsonNode* addChild(JsonPool* pool, JsonNode* container, JsonNodeType containerType, const char* key);
+JsonNode* makeContainer(JsonNode* node, JsonNodeType type);
+bool toBool(const JsonNode* n);
+int64_t toInteger(const JsonNode* n);
+double toReal(const JsonNode* n);
+bool isInteger(const JsonNode* n);
+void serialize(const JsonNode* n, String& out);
+
+void setNull(JsonNode* n);
+void set(JsonPool* pool, JsonNode* n, bool v);
+void set(JsonPool* pool, JsonNode* n, const char* v);
+void set(JsonPool* pool, JsonNode* n, const String& v);
+void set(JsonPool* pool, JsonNode* n, double v);
+void setInteger(JsonPool* pool, JsonNode* n, int64_t v);
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type set(JsonPool* pool, JsonNode* n, T v) {
+  setInteger(pool, n, (int64_t)v);
+}
+inline void set(JsonPool* pool, JsonNode* n, float v) { set(pool, n, (double)v); }
+inline void set(JsonPool* pool, JsonNode* n, char* v) { set(pool, n, (const char*)v); }
+}  // namespace ArduinoJsonHost
+
+template <typename T, typename Enable = void>
+struct JsonConvert;
+
+// Read side shared by documents, views and proxies. Derived provides node() and pool().
+template <typename Derived>
+class JsonReadable {
+public:
+  template <typename T> T as() const { return JsonConvert<T>::from(self().pool(), self().node()); }
+  template <typename T> bool is() const { return JsonConvert<T>::check(self().node()); }
+  bool isNull() const { return !self().node() || self().node()->type == JsonNodeType::Null; }
+  size_t size() const {
+    const JsonNode* n = self().node();
+    return n && (n->type == JsonNodeType::Array || n->type == JsonNodeType::Object) ? n->value.list.count : 0;
+  }
+  bool containsKey(const char* key) const { return ArduinoJsonHost::findMember(self().node(), key) != nullptr; }
+  bool containsKey(const String& key) const { return containsKey(key.c_str()); }
+
+  const char* operator|(const char* fallback) const {
+    const JsonNode* n = self().node();
+    return n && n->type == JsonNodeType::String ? n->value.string : fallback;
+  }
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, T>::type operator|(T fallback) const {
+    return is<T>() ? as<T>() : fallback;
+  }
+  template <typename Other>
+  JsonVariantConst operator|(const JsonReadable<Other>& fallback) const;
+
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value || std::is_same<T, const char*>::value ||
+                                                           std::is_same<T, String>::value>::type>
+  operator T() const { return as<T>(); }
+
+  bool operator==(bool v) const { const JsonNode* n = self().node(); return n && n->type == JsonNodeType::Bool && n->value.boolean == v; }
+  bool operator==(const char* v) const { const char* s = as<const char*>(); return s && v && strcmp(s, v) == 0; }
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, bool>::type operator==(T v) const {
+    const JsonNode* n = self().node();
+    return n && (n->type == JsonNodeType::Int || n->type == JsonNodeType::Float) && ArduinoJsonHost::toReal(n) == (double)v;
+  }
+  template <typename T> bool operator!=(T v) const { return !(*this == v); }
+
+private:
+  const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+class JsonVariantConst : public JsonReadable<JsonVariantConst> {
+public:
+  JsonVariantConst() {}
+  JsonVariantConst(JsonPool* pool, const JsonNode* node) : nodePool(pool), data(node) {}
+  const JsonNode* node() const { return data; }
+  JsonPool* pool() const { return nodePool; }
+
+private:
+  JsonPool* nodePool = nullptr;
+  const JsonNode* data = nullptr;
+};
+
+template <typename Derived>
+template <typename Other>
+JsonVariantConst JsonReadable<Derived>::operator|(const JsonReadable<Other>& fallback) const {
+  const Other& other = static_cast<const Other&>(fallback);
+  if (!isNull()) return JsonVariantConst(self().pool(), self().node());
+  return JsonVariantConst(other.pool(), other.node());
+}
+
+// Member or element reached through operator[]; created on first write, like ArduinoJson's
+// MemberProxy/ElementProxy. Only lives for the full expression it appears in.
+class JsonProxy : public JsonReadable<JsonProxy> {
+public:
+  JsonProxy(JsonPool* pool, JsonNode* parent, const JsonProxy* parentProxy, const char* key, size_t index)
+      : owner(pool), parentNode(parent), parentProxy(parentProxy), memberKey(key), elementIndex(index) {}
+
+  const JsonNode* node() const;
+  JsonPool* pool() const { return owner; }
+  JsonNode* materialize() const;
+
+  JsonProxy operator[](const char* key) const { return JsonProxy(owner, nullptr, this, key, 0); }
+  JsonProxy operator[](const String& key) const { return (*this)[key.c_str()]; }
+  JsonProxy operator[](int index) const { return JsonProxy(owner, nullptr, this, nullptr, (size_t)index); }
+
+  template <typename T> const JsonProxy& operator=(const T& v) const {
+    JsonNode* n = materialize();
+    if (n) ArduinoJsonHost::set(owner, n, v);
+    return *this;
+  }
+  const JsonProxy& operator=(const JsonProxy& other) const;
+
+  JsonArray createNestedArray() const;
+  JsonObject createNestedObject() const;
+  template <typename T> bool add(const T& v) const;
+  bool set(const char* v) const { return (*this = v, true); }
+
+  operator JsonVariant() const;
+  operator JsonObject() const;
+  operator JsonArray() const;
+
+private:
+  JsonNode* materializeAs(JsonNodeType containerType) const;
+
+  JsonPool* owner;
+  JsonNode* parentNode;
+  const JsonProxy* parentProxy;
+  const char* memberKey;
+  size_t elementIndex;
+};
+
+class JsonVariant : public JsonReadable<JsonVariant> {
+public:
+  JsonVariant() {}
+  JsonVariant(JsonPool* pool, JsonNode* node) : nodePool(pool), data(node) {}
+  const JsonNode* node() const { return data; }
+  JsonPool* pool() const { return nodePool; }
+
+  JsonProxy operator[](const char* key) const { return JsonProxy(nodePool, data, nullptr, key, 0); }
+  JsonProxy operator[](const String& key) const { return (*this)[key.c_str()]; }
+  JsonProxy operator[](int index) const { return JsonProxy(nodePool, data, nullptr, nullptr, (size_t)index); }
+  template <typename T> bool set(const T& v) const {
+    if (!data) return false;
+    ArduinoJsonHost::set(nodePool, data, v);
+    return true;
+  }
+  template <typename T> const JsonVariant& operator=(const T& v) const { set(v); return *this; }
+
+  operator JsonObject() const;
+  operator JsonArray() const;
+
+private:
+  JsonPool* nodePool = nullptr;
+  JsonNode* data = nullptr;
+};
+
+class JsonString {
+public:
+  explicit JsonString(const char* s) : text(s) {}
+  const char* c_str() const { return text; }
+  size_t size() const { return text ? strlen(text) : 0; }
+  bool operator==(const char* other) const { return text && other && strcmp(text, other) == 0; }
+  bool operator!=(const char* other) const { return !(*this == other); }
+  bool isNull() const { return !text; }
+
+private:
+  const char* text;
+};
+
+class JsonPair {
+public:
+  JsonPair(JsonPool* pool, JsonNode* node) : nodePool(pool), data(node) {}
+  JsonString key() const { return JsonString(data->key); }
+  JsonVariant value() const { return JsonVariant(nodePool, data); }
+
+private:
+  JsonPool* nodePool;
+  JsonNode* data;
+};
+
+class JsonObject : public JsonReadable<JsonObject> {
+public:
+  class iterator {
+  public:
+    iterator(JsonPool* pool, JsonNode* node) : nodePool(pool), at(node) {}
+    JsonPair operator*() const { return JsonPair(nodePool, at); }
+    iterator& operator++() { at = at->next; return *this; }
+    bool operator!=(const iterator& other) const { return at != other.at; }
+    bool operator==(const iterator& other) const { return at == other.at; }
+
+  private:
+    JsonPool* nodePool;
+    JsonNode* at;
+  };
+
+  JsonObject() {}
+  JsonObject(JsonPool* pool, JsonNode* node) : nodePool(pool), data(node && node->type == JsonNodeType::Object ? node : nullptr) {}
+  const JsonNode* node() const { return data; }
+  JsonPool* pool() const { return nodePool; }
+  explicit operator bool() const { return data != nullptr; }
+
+  iterator begin() const { return iterator(nodePool, data ? data->value.list.head : nullptr); }
+  iterator end() const { return iterator(nodePool, nullptr); }
+  JsonProxy operator[](const char* key) const { return JsonProxy(nodePool, data, nullptr, key, 0); }
+  JsonProxy operator[](const String& key) const { return (*this)[key.c_str()]; }
+  JsonArray createNestedArray(const char* key) const;
+  JsonObject createNestedObject(const char* key) const;
+
+private:
+  JsonPool* nodePool = nullptr;
+  JsonNode* data = nullptr;
+};
+
+class JsonArray : public JsonReadable<JsonArray> {
+public:
+  class iterator {
+  public:
+    iterator(JsonPool* pool, JsonNode* node) : nodePool(pool), at(node) {}
+    JsonVariant operator*() const { return JsonVariant(nodePool, at); }
+    iterator& operator++() { at = at->next; return *this; }
+    bool operator!=(const iterator& other) const { return at != other.at; }
+    bool operator==(const iterator& other) const { return at == other.at; }
+
+  private:
+    JsonPool* nodePool;
+    JsonNode* at;
+  };
+
+  JsonArray() {}
+  JsonArray(JsonPool* pool, JsonNode* node) : nodePool(pool), data(node && node->type == JsonNodeType::Array ? node : nullptr) {}
+  const JsonNode* node() const { return data; }
+  JsonPool* pool() const { return nodePool; }
+  explicit operator bool() const { return data != nullptr; }
+
+  iterator begin() const { return iterator(nodePool, data ? data->value.list.head : nullptr); }
+  iterator end() const { return iterator(nodePool, nullptr); }
+  JsonProxy operator[](int index) const { return JsonProxy(nodePool, data, nullptr, nullptr, (size_t)index); }
+
+  template <typename T> bool add(const T& v) const {
+    JsonNode* n = data ? ArduinoJsonHost::addChild(nodePool, data, JsonNodeType::Array, nullptr) : nullptr;
+    if (!n) return false;
+    ArduinoJsonHost::set(nodePool, n, v);
+    return true;
+  }
+  JsonObject createNestedObject() const;
+  JsonArray createNestedArray() const;
+
+private:
+  JsonPool* nodePool = nullptr;
+  JsonNode* data = nullptr;
+};
+
+class JsonDocument : public JsonPool, public JsonReadable<JsonDocument> {
+public:
+  JsonDocument(const JsonDocument&) = delete;
+  JsonDocument& operator=(const JsonDocument&) = delete;
+
+  const JsonNode* node() const { return &root; }
+  JsonPool* pool() const { return const_cast<JsonDocument*>(this); }
+  using JsonReadable<JsonDocument>::size;
+  using JsonReadable<JsonDocument>::operator==;
+
+  JsonNode* rootNode() { return &root; }
+  void clear();
+
+  JsonProxy operator[](const char* key) { return JsonProxy(this, &root, nullptr, key, 0); }
+  JsonProxy operator[](const String& key) { return (*this)[key.c_str()]; }
+  JsonProxy operator[](int index) { return JsonProxy(this, &root, nullptr, nullptr, (size_t)index); }
+  JsonVariantConst operator[](const char* key) const { return JsonVariantConst(pool(), ArduinoJsonHost::findMember(&root, key)); }
+  JsonVariantConst operator[](const String& key) const { return (*this)[key.c_str()]; }
+
+  JsonArray createNestedArray(const char* key) { return JsonObject(this, ArduinoJsonHost::makeContainer(&root, JsonNodeType::Object)).createNestedArray(key); }
+  JsonObject createNestedObject(const char* key) { return JsonObject(this, ArduinoJsonHost::makeContainer(&root, JsonNodeType::Object)).createNestedObject(key); }
+  JsonArray to_array() { ArduinoJsonHost::setNull(&root); return JsonArray(this, ArduinoJsonHost::makeContainer(&root, JsonNodeType::Array)); }
+  template <typename T> bool add(const T& v) {
+    JsonNode* n = ArduinoJsonHost::addChild(this, ArduinoJsonHost::makeContainer(&root, JsonNodeType::Array), JsonNodeType::Array, nullptr);
+    if (!n) return false;
+    ArduinoJsonHost::set(this, n, v);
+    return true;
+  }
+  template <typename T> bool set(const T& v) { ArduinoJsonHost::set(this, &root, v); return true; }
+
+protected:
+  JsonDocument() {}
+
+  JsonNode root;
+};
+
+class DynamicJsonDocument : public JsonDocument {
+public:
+  explicit DynamicJsonDocument(size_t capacity);
+  ~DynamicJsonDocument();
+};
+
+template <size_t N>
+class StaticJsonDocument : public JsonDocument {
+public:
+  StaticJsonDocument() { init(storage, N); }
+
+private:
+  alignas(8) uint8_t storage[N * 4];  // Real sizes on a 64-bit host are up to 3x the modelled slot
+};
+
+class DeserializationError {
+public:
+  enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+
+  DeserializationError() {}
+  DeserializationError(Code c) : errorCode(c) {}
+  explicit operator bool() const { return errorCode != Ok; }
+  bool operator==(Code c) const { return errorCode == c; }
+  bool operator!=(Code c) const { return errorCode != c; }
+  Code code() const { return errorCode; }
+  const char* c_str() const;
+
+private:
+  Code errorCode = Ok;
+};
+
+namespace DeserializationOption {
+class Filter {
+public:
+  explicit Filter(const JsonDocument& doc) : filterNode(doc.node()) {}
+  explicit Filter(JsonVariantConst v) : filterNode(v.node()) {}
+  const JsonNode* node() const { return filterNode; }
+
+private:
+  const JsonNode* filterNode;
+};
+
+class NestingLimit {
+public:
+  explicit NestingLimit(uint8_t n = ARDUINOJSON_DEFAULT_NESTING_LIMIT) : limit(n) {}
+  uint8_t value() const { return limit; }
+
+private:
+  uint8_t limit;
+};
+}  // namespace DeserializationOption
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t len,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+DeserializationError deserializeJson(JsonDocument& doc, const String& input,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+DeserializationError deserializeJson(JsonDocument& doc, Stream& input,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t len, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+DeserializationError deserializeJson(JsonDocument& doc, const String& input, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+DeserializationError deserializeJson(JsonDocument& doc, Stream& input, DeserializationOption::Filter filter,
+                                     DeserializationOption::NestingLimit nesting = DeserializationOption::NestingLimit());
+
+size_t serializeJson(const JsonDocument& doc, String& output);
+size_t serializeJson(const JsonDocument& doc, char* output, size_t size);
+size_t serializeJson(const JsonDocument& doc, Print& output);
+size_t serializeJson(JsonVariantConst v, String& output);
+size_t measureJson(const JsonDocument& doc);
+
+// ---------------------------------------------------------------------------------------------
+// Conversions
+
+template <typename T>
+struct JsonConvert<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  static T from(JsonPool*, const JsonNode* n) { return (T)ArduinoJsonHost::toInteger(n); }
+  static bool check(const JsonNode* n) { return ArduinoJsonHost::isInteger(n); }
+};
+
+template <typename T>
+struct JsonConvert<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+  static T from(JsonPool*, const JsonNode* n) { return (T)ArduinoJsonHost::toReal(n); }
+  static bool check(const JsonNode* n) { return n && (n->type == JsonNodeType::Int || n->type == JsonNodeType::Float); }
+};
+
+template <>
+struct JsonConvert<bool> {
+  static bool from(JsonPool*, const JsonNode* n) { return ArduinoJsonHost::toBool(n); }
+  static bool check(const JsonNode* n) { return n && n->type == JsonNodeType::Bool; }
+};
+
+template <>
+struct JsonConvert<const char*> {
+  static const char* from(JsonPool*, const JsonNode* n) { return n && n->type == JsonNodeType::String ? n->value.string : nullptr; }
+  static bool check(const JsonNode* n) { return n && n->type == JsonNodeType::String; }
+};
+
+template <>
+struct JsonConvert<String> {
+  static String from(JsonPool*, const JsonNode* n) {
+    if (n && n->type == JsonNodeType::String) return String(n->value.string);
+    String out;
+    ArduinoJsonHost::serialize(n, out);
+    return out;
+  }
+  static bool check(const JsonNode* n) { return n && n->type == JsonNodeType::String; }
+};
+
+template <>
+struct JsonConvert<JsonObject> {
+  static JsonObject from(JsonPool* pool, const JsonNode* n) { return JsonObject(pool, const_cast<JsonNode*>(n)); }
+  static bool check(const JsonNode* n) { return n && n->type == JsonNodeType::Object; }
+};
+
+template <>
+struct JsonConvert<JsonArray> {
+  static JsonArray from(JsonPool* pool, const JsonNode* n) { return JsonArray(pool, const_cast<JsonNode*>(n)); }
+  static bool check(const JsonNode* n) { return n && n->type == JsonNodeType::Array; }
+};
+
+template <>
+struct JsonConvert<JsonVariant> {
+  static JsonVariant from(JsonPool* pool, const JsonNode* n) { return JsonVariant(pool, const_cast<JsonNode*>(n)); }
+  static bool check(const JsonNode* n) { return n != nullptr; }
+};
+
+template <>
+struct JsonConvert<JsonVariantConst> {
+  static JsonVariantConst from(JsonPool* pool, const JsonNode* n) { return JsonVariantConst(pool, n); }
+  static bool check(const JsonNode* n) { return n != nullptr; }
+};
+
+inline JsonProxy::operator JsonVariant() const { return JsonVariant(owner, const_cast<JsonNode*>(node())); }
+inline JsonProxy::operator JsonObject() const { return JsonObject(owner, const_cast<JsonNode*>(node())); }
+inline JsonProxy::operator JsonArray() const { return JsonArray(owner, const_cast<JsonNode*>(node())); }
+inline JsonVariant::operator JsonObject() const { return JsonObject(nodePool, data); }
+inline JsonVariant::operator JsonArray() const { return JsonArray(nodePool, data); }
+
+template <typename T> bool JsonProxy::add(const T& v) const {
+  JsonNode* array = materializeAs(JsonNodeType::Array);
+  JsonNode* n = array ? ArduinoJsonHost::addChild(owner, array, JsonNodeType::Array, nullptr) : nullptr;
+  if (!n) return false;
+  ArduinoJsonHost::set(owner, n, v);
+  return true;
+}
@@ -0,0 +1,42 @@
+// AsyncUDP.h
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+class AsyncUDPPacket {
+public:
+  AsyncUDPPacket(const uint8_t* data, size_t len) : bytes(data), len(len) {}
+  const uint8_t* data() { return bytes; }
+  size_t length() { return len; }
+
+private:
+  const uint8_t* bytes;
+  size_t len;
+};
+
+class AsyncUDP {
+public:
+  using PacketHandler = std::function<void(AsyncUDPPacket& packet)>;
+
+  ~AsyncUDP();
+  bool listen(uint16_t port);
+  void onPacket(PacketHandler fn) { handler = fn; }
+  void close();
+
+  // Host plumbing
+  uint16_t port() const { return listenPort; }
+  void deliver(const uint8_t* data, size_t len);
+
+private:
+  PacketHandler handler;
+  uint16_t listenPort = 0;
+};
+
+namespace host {
+
+// Hands a datagram to whatever listens on `port`, synchronously, as the async UDP task would.
+// Returns false when nothing is listening.
+bool sendUdp(uint16_t port, const uint8_t* data, size_t len);
+
+}  // namespace host
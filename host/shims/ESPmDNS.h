@@ -0,0 +1,15 @@
+// ESPmDNS.h
+#pragma once
+
+#include <Arduino.h>
+
+class MDNSResponder {
+public:
+  bool begin(const char* hostName) { name = hostName; return true; }
+  void end() {}
+  void addService(const char* service, const char* proto, uint16_t port) { (void)service; (void)proto; (void)port; }
+
+  String name;
+};
+
+extern MDNSResponder MDNS;
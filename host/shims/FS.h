@@ -0,0 +1,46 @@
+// FS.h
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include <string>
+
+namespace fs {
+
+// Read-only view of a host file's contents
+class File : public Stream {
+public:
+  File() = default;
+  explicit File(std::shared_ptr<std::string> contents) : data(std::move(contents)) {}
+
+  int available() override { return data ? (int)(data->size() - pos) : 0; }
+  int read() override { return available() > 0 ? (uint8_t)(*data)[pos++] : -1; }
+  int peek() override { return available() > 0 ? (uint8_t)(*data)[pos] : -1; }
+  using Print::write;
+  size_t write(uint8_t) override { return 0; }
+  size_t size() const { return data ? data->size() : 0; }
+  void close() { data.reset(); }
+  explicit operator bool() const { return data != nullptr; }
+
+private:
+  std::shared_ptr<std::string> data;
+  size_t pos = 0;
+};
+
+class FS {
+public:
+  File open(const char* path, const char* mode = "r");
+  bool exists(const char* path);
+  bool remove(const char* path);
+};
+
+}  // namespace fs
+
+using fs::File;
+
+namespace host {
+
+void putFile(const std::string& path, const std::string& contents);  // What LittleFS.open() will read
+void clearFiles();
+
+}  // namespace host
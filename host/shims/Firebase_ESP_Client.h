@@ -0,0 +1,184 @@
+// Firebase_ESP_Client.h
+#pragma once
+
+// Host stand-in for the Firebase ESP Client: the RTDB calls the firmware makes, answered from an
+// in-memory tree (host::rtdb()) with optional latency, outages and per-request accounting.
+
+#include <Arduino.h>
+#include <string>
+#include "HostJson.h"
+#include "HostRuntime.h"
+
+class FirebaseJsonArray;
+
+struct FirebaseJsonData {
+  bool success = false;
+  String type;          // "string", "int", "float", "boolean", "object", "array", "null"
+  String stringValue;
+  int intValue = 0;
+  float floatValue = 0;
+  bool boolValue = false;
+};
+
+class FirebaseJson {
+public:
+  void set(const String& path, int value) { at(path) = host::JsonValue::of(value); }
+  void set(const String& path, unsigned value) { at(path) = host::JsonValue::of((int64_t)value); }
+  void set(const String& path, long value) { at(path) = host::JsonValue::of((int64_t)value); }
+  void set(const String& path, float value) { at(path) = host::JsonValue::of((double)value); }
+  void set(const String& path, double value) { at(path) = host::JsonValue::of(value); }
+  void set(const String& path, bool value) { at(path) = host::JsonValue::of(value); }
+  void set(const String& path, const char* value) { at(path) = host::JsonValue::of(value); }
+  void set(const String& path, const String& value) { at(path) = host::JsonValue::of(value.c_str()); }
+  void set(const String& path, const FirebaseJsonArray& value);
+  void clear() { root = host::JsonValue::object(); }
+  void toString(String& out, bool prettify = false) const {
+    std::string text;
+    {
+      host::OffDevice offDevice;  // The library's scratch; only `out` is the caller's
+      text = root.serialize(prettify);
+    }
+    out = text.c_str();
+  }
+
+  host::JsonValue root = host::JsonValue::object();
+
+private:
+  host::JsonValue& at(const String& path) { return root.ensure(path.c_str()); }
+};
+
+class FirebaseJsonArray {
+public:
+  void add(int value) { root.items.push_back(host::JsonValue::of(value)); }
+  void add(float value) { root.items.push_back(host::JsonValue::of((double)value)); }
+  void add(bool value) { root.items.push_back(host::JsonValue::of(value)); }
+  void add(const char* value) { root.items.push_back(host::JsonValue::of(value)); }
+  void add(const String& value) { root.items.push_back(host::JsonValue::of(value.c_str())); }
+  size_t size() const { return root.items.size(); }
+  bool get(FirebaseJsonData& out, int index) const;
+  void clear() { root.items.clear(); }
+  void toString(String& out, bool prettify = false) const { out = root.serialize(prettify).c_str(); }
+
+  host::JsonValue root = host::JsonValue::array();
+};
+
+inline void FirebaseJson::set(const String& path, const FirebaseJsonArray& value) { at(path) = value.root; }
+
+class FirebaseData {
+public:
+  int intData() const { return (int)result.number(); }
+  float floatData() const { return (float)result.number(); }
+  bool boolData() const { return result.type == host::JsonValue::BOOL ? result.boolean : result.number() != 0; }
+  String stringData() const { return String(result.string.c_str()); }
+  template <typename T> T to() const;
+  String payload() const { return String(result.serialize().c_str()); }
+  String dataType() const;
+  String errorReason() const { return error; }
+  int httpCode() const { return code; }
+  FirebaseJson& jsonObject() { return object; }
+  FirebaseJsonArray& jsonArray() { return array; }
+
+  // Filled in by the RTDB stand-in
+  void setResult(const host::JsonValue& value);
+  void setError(int httpCode, const char* reason);
+
+private:
+  host::JsonValue result;
+  FirebaseJson object;
+  FirebaseJsonArray array;
+  String error;
+  int code = 0;
+};
+
+template <> inline const char* FirebaseData::to<const char*>() const { return result.string.c_str(); }
+template <> inline String FirebaseData::to<String>() const { return stringData(); }
+template <> inline int FirebaseData::to<int>() const { return intData(); }
+template <> inline bool FirebaseData::to<bool>() const { return boolData(); }
+template <> inline float FirebaseData::to<float>() const { return floatData(); }
+
+struct FirebaseAuth {
+  struct {
+    std::string email;
+    std::string password;
+  } user;
+};
+
+struct FirebaseConfig {
+  std::string api_key;
+  std::string database_url;
+};
+
+class FirebaseRTDB {
+public:
+  bool getInt(FirebaseData* fbdo, const char* path);
+  bool getFloat(FirebaseData* fbdo, const char* path);
+  bool getBool(FirebaseData* fbdo, const char* path);
+  bool getString(FirebaseData* fbdo, const char* path);
+  bool getJSON(FirebaseData* fbdo, const char* path);
+  bool getArray(FirebaseData* fbdo, const char* path);
+  bool setInt(FirebaseData* fbdo, const char* path, int value);
+  bool setFloat(FirebaseData* fbdo, const char* path, float value);
+  bool setBool(FirebaseData* fbdo, const char* path, bool value);
+  bool setString(FirebaseData* fbdo, const char* path, const char* value);
+  bool setString(FirebaseData* fbdo, const char* path, const String& value) { return setString(fbdo, path, value.c_str()); }
+  bool setJSON(FirebaseData* fbdo, const char* path, FirebaseJson* json);
+  bool updateNode(FirebaseData* fbdo, const char* path, FirebaseJson* json);
+  bool deleteNode(FirebaseData* fbdo, const char* path);
+
+  bool getInt(FirebaseData* fbdo, const String& path) { return getInt(fbdo, path.c_str()); }
+  bool getBool(FirebaseData* fbdo, const String& path) { return getBool(fbdo, path.c_str()); }
+  bool getString(FirebaseData* fbdo, const String& path) { return getString(fbdo, path.c_str()); }
+  bool getJSON(FirebaseData* fbdo, const String& path) { return getJSON(fbdo, path.c_str()); }
+  bool getArray(FirebaseData* fbdo, const String& path) { return getArray(fbdo, path.c_str()); }
+  bool setInt(FirebaseData* fbdo, const String& path, int value) { return setInt(fbdo, path.c_str(), value); }
+  bool setJSON(FirebaseData* fbdo, const String& path, FirebaseJson* json) { return setJSON(fbdo, path.c_str(), json); }
+  bool updateNode(FirebaseData* fbdo, const String& path, FirebaseJson* json) { return updateNode(fbdo, path.c_str(), json); }
+};
+
+class FirebaseClass {
+public:
+  void begin(FirebaseConfig* config, FirebaseAuth* auth);
+  bool ready();
+  void reconnectWiFi(bool) {}
+
+  FirebaseRTDB RTDB;
+};
+
+extern FirebaseClass Firebase;
+
+namespace host {
+
+// The database behind Firebase.RTDB
+class Rtdb {
+public:
+  JsonValue root;
+
+  void reset();                                          // Empty tree, online, no latency, counters cleared
+  bool seed(const char* path, const char* json);         // Replaces the node at path with parsed JSON
+  const JsonValue* find(const char* path) const;
+
+  void setOnline(bool online) { reachable = online; }    // Offline: every request fails, ready() stays true
+  void setLatencyMs(uint32_t ms) { latencyMs = ms; }     // Virtual time each request blocks the caller
+  void setTokenDelayMs(uint32_t ms) { tokenDelayMs = ms; }  // begin() to ready()
+  void failNextWrites(int count) { writeFailures = count; }
+
+  uint32_t reads = 0;
+  uint32_t writes = 0;
+  uint32_t failures = 0;
+
+  // Internal to the stand-in
+  bool online() const { return reachable; }
+  uint32_t latency() const { return latencyMs; }
+  uint32_t tokenDelay() const { return tokenDelayMs; }
+  bool takeWriteFailure() { return writeFailures > 0 && writeFailures-- > 0; }
+
+private:
+  bool reachable = true;
+  uint32_t latencyMs = 0;
+  uint32_t tokenDelayMs = 0;
+  int writeFailures = 0;
+};
+
+Rtdb& rtdb();
+
+}  // namespace host
@@ -0,0 +1,95 @@
+// HTTPClient.h
+#pragma once
+
+// Host HTTPClient: requests are answered in-process by handlers registered per host name with
+// host::serveHttp(), so the stand-in OpenWeather/ipgeolocation/GitHub Pages servers run on the
+// virtual clock and every request is counted.
+
+#include <Arduino.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "WiFiClient.h"
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_PARTIAL_CONTENT 206
+#define HTTP_CODE_NOT_FOUND 404
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+class HTTPClient {
+public:
+  HTTPClient() = default;
+  ~HTTPClient() { end(); }
+
+  bool begin(const String& url);
+  bool begin(WiFiClient& client, const String& url) { (void)client; return begin(url); }
+  void end();
+  int GET();
+  int POST(const String& body);
+  void addHeader(const String& name, const String& value);
+  void collectHeaders(const char* keys[], size_t count);
+  String header(const char* name);
+  bool hasHeader(const char* name);
+  int getSize() { return size; }
+  String getString();
+  WiFiClient& getStream() { return stream; }
+  WiFiClient* getStreamPtr() { return &stream; }
+  bool connected() { return stream.connected() || stream.available() > 0; }
+  void useHTTP10(bool enable) { http10 = enable; }
+  void setTimeout(uint16_t ms) { timeoutMs = ms; }
+  void setConnectTimeout(int32_t ms) { (void)ms; }
+  void setReuse(bool reuse) { (void)reuse; }
+  static String errorToString(int code);
+
+private:
+  int send(const char* method, const std::string& body);
+
+  std::string url;
+  std::vector<std::pair<std::string, std::string>> requestHeaders;
+  std::vector<std::string> wantedHeaders;
+  std::map<std::string, std::string> responseHeaders;
+  WiFiClient stream;
+  int size = -1;
+  bool http10 = false;
+  uint16_t timeoutMs = 5000;
+};
+
+namespace host {
+
+struct HttpRequest {
+  std::string method;
+  std::string host;
+  std::string path;                               // Includes the query string
+  std::map<std::string, std::string> headers;     // Names lower-cased
+  std::string body;
+  bool http10 = false;
+
+  std::string header(const std::string& name) const;
+  std::string query(const std::string& key) const;  // Raw value of ?key=, "" if absent
+};
+
+struct HttpResponse {
+  int status = 200;
+  std::map<std::string, std::string> headers;
+  std::string body;
+  uint32_t latencyMs = 40;        // Until the status line arrives
+  uint32_t bytesPerMs = 0;        // Body pacing; 0 = all at once
+  size_t dropAfter = SIZE_MAX;    // Connection closes after this many body bytes
+};
+
+using HttpHandler = std::function<HttpResponse(const HttpRequest&)>;
+
+void serveHttp(const std::string& hostName, HttpHandler handler);  // Replaces any earlier handler
+void clearHttpServers();
+uint32_t httpRequestCount(const std::string& hostName);
+void resetHttpRequestCounts();
+
+// Answers a GET for `content`, honouring "Range: bytes=N-" with 206 and Content-Range
+HttpResponse serveBytes(const HttpRequest& request, const std::string& content);
+
+}  // namespace host
@@ -0,0 +1,200 @@
+#include <Firebase_ESP_Client.h>
+#include "HostRuntime.h"
+
+using host::JsonValue;
+
+FirebaseClass Firebase;
+
+static bool begun = false;
+static uint64_t readyAtMicros = 0;
+
+host::Rtdb& host::rtdb() {
+  static Rtdb db;
+  return db;
+}
+
+void host::Rtdb::reset() {
+  OffDevice offDevice;
+  root = JsonValue::object();
+  reachable = true;
+  latencyMs = 0;
+  tokenDelayMs = 0;
+  writeFailures = 0;
+  reads = writes = failures = 0;
+  begun = false;
+}
+
+bool host::Rtdb::seed(const char* path, const char* json) {
+  OffDevice offDevice;
+  JsonValue value;
+  if (!JsonValue::parse(json, value)) return false;
+  root.ensure(path) = value;
+  return true;
+}
+
+const JsonValue* host::Rtdb::find(const char* path) const {
+  OffDevice offDevice;  // Path lookup is the server's work
+  return root.find(path);
+}
+
+bool FirebaseJsonArray::get(FirebaseJsonData& out, int index) const {
+  out = FirebaseJsonData();
+  if (index < 0 || (size_t)index >= root.items.size()) return false;
+  const JsonValue& v = root.items[index];
+  out.success = true;
+  switch (v.type) {
+    case JsonValue::STRING: out.type = "string"; out.stringValue = v.string.c_str(); break;
+    case JsonValue::INT: out.type = "int"; out.intValue = (int)v.integer; out.stringValue = String((long long)v.integer); break;
+    case JsonValue::FLOAT: out.type = "float"; out.floatValue = (float)v.real; out.stringValue = v.serialize().c_str(); break;
+    case JsonValue::BOOL: out.type = "boolean"; out.boolValue = v.boolean; out.stringValue = v.boolean ? "true" : "false"; break;
+    case JsonValue::ARRAY: out.type = "array"; out.stringValue = v.serialize().c_str(); break;
+    case JsonValue::OBJECT: out.type = "object"; out.stringValue = v.serialize().c_str(); break;
+    case JsonValue::NUL: out.type = "null"; break;
+  }
+  return true;
+}
+
+String FirebaseData::dataType() const {
+  switch (result.type) {
+    case JsonValue::STRING: return "string";
+    case JsonValue::INT: return "int";
+    case JsonValue::FLOAT: return "float";
+    case JsonValue::BOOL: return "boolean";
+    case JsonValue::ARRAY: return "array";
+    case JsonValue::OBJECT: return "json";
+    default: return "null";
+  }
+}
+
+// The response buffers belong to the library, not the firmware: keep them out of the heap counters
+void FirebaseData::setResult(const JsonValue& value) {
+  host::OffDevice offDevice;
+  result = value;
+  error = "";
+  code = 200;
+  object.root = value.type == JsonValue::OBJECT ? value : JsonValue::object();
+  array.root = value.type == JsonValue::ARRAY ? value : JsonValue::array();
+}
+
+void FirebaseData::setError(int httpCode, const char* reason) {
+  host::OffDevice offDevice;
+  result = JsonValue();
+  error = reason;
+  code = httpCode;
+}
+
+void FirebaseClass::begin(FirebaseConfig*, FirebaseAuth*) {
+  begun = true;
+  readyAtMicros = host::nowMicros() + (uint64_t)host::rtdb().tokenDelay() * 1000;
+}
+
+bool FirebaseClass::ready() {
+  return begun && host::nowMicros() >= readyAtMicros;
+}
+
+// Every request: round trip on the virtual clock, then fail if offline or not signed in
+static bool request(FirebaseData* fbdo, bool write) {
+  host::Rtdb& db = host::rtdb();
+  if (db.latency()) host::blockUntil(host::nowMicros() + (uint64_t)db.latency() * 1000);
+  if (write) db.writes++;
+  else db.reads++;
+  if (!Firebase.ready()) {
+    db.failures++;
+    fbdo->setError(401, "token is not ready (revoked or expired)");
+    return false;
+  }
+  if (!db.online() || (write && db.takeWriteFailure())) {
+    db.failures++;
+    fbdo->setError(-1, "connection refused");
+    return false;
+  }
+  return true;
+}
+
+static bool read(FirebaseData* fbdo, const char* path, bool (*accepts)(const JsonValue&)) {
+  if (!request(fbdo, false)) return false;
+  const JsonValue* node = host::rtdb().find(path);
+  if (!node || node->type == JsonValue::NUL) {
+    fbdo->setError(404, "path not exist");
+    return false;
+  }
+  if (!accepts(*node)) {
+    fbdo->setError(200, "data type mismatch");
+    return false;
+  }
+  fbdo->setResult(*node);
+  return true;
+}
+
+static bool write(FirebaseData* fbdo, const char* path, const JsonValue& value) {
+  if (!request(fbdo, true)) return false;
+  {
+    host::OffDevice offDevice;
+    host::rtdb().root.ensure(path) = value;
+  }
+  fbdo->setResult(value);
+  return true;
+}
+
+bool FirebaseRTDB::getInt(FirebaseData* fbdo, const char* path) {
+  return read(fbdo, path, [](const JsonValue& v) { return v.isNumber(); });
+}
+
+bool FirebaseRTDB::getFloat(FirebaseData* fbdo, const char* path) {
+  return read(fbdo, path, [](const JsonValue& v) { return v.isNumber(); });
+}
+
+bool FirebaseRTDB::getBool(FirebaseData* fbdo, const char* path) {
+  return read(fbdo, path, [](const JsonValue& v) { return v.type == JsonValue::BOOL; });
+}
+
+bool FirebaseRTDB::getString(FirebaseData* fbdo, const char* path) {
+  return read(fbdo, path, [](const JsonValue& v) { return v.type == JsonValue::STRING; });
+}
+
+bool FirebaseRTDB::getJSON(FirebaseData* fbdo, const char* path) {
+  return read(fbdo, path, [](const JsonValue& v) { return v.type == JsonValue::OBJECT; });
+}
+
+bool FirebaseRTDB::getArray(FirebaseData* fbdo, const char* path) {
+  return read(fbdo, path, [](const JsonValue& v) { return v.type == JsonValue::ARRAY; });
+}
+
+bool FirebaseRTDB::setInt(FirebaseData* fbdo, const char* path, int value) {
+  return write(fbdo, path, JsonValue::of(value));
+}
+
+bool FirebaseRTDB::setFloat(FirebaseData* fbdo, const char* path, float value) {
+  return write(fbdo, path, JsonValue::of((double)value));
+}
+
+bool FirebaseRTDB::setBool(FirebaseData* fbdo, const char* path, bool value) {
+  return write(fbdo, path, JsonValue::of(value));
+}
+
+bool FirebaseRTDB::setString(FirebaseData* fbdo, const char* path, const char* value) {
+  return write(fbdo, path, JsonValue::of(value));
+}
+
+bool FirebaseRTDB::setJSON(FirebaseData* fbdo, const char* path, FirebaseJson* json) {
+  return write(fbdo, path, json->root);
+}
+
+// PATCH semantics: each top-level child of the patch replaces the child of the same name
+bool FirebaseRTDB::updateNode(FirebaseData* fbdo, const char* path, FirebaseJson* json) {
+  if (!request(fbdo, true)) return false;
+  host::OffDevice offDevice;
+  JsonValue& node = host::rtdb().root.ensure(path);
+  if (node.type != JsonValue::OBJECT) node = JsonValue::object();
+  for (const auto& member : json->root.members) node.members[member.first] = member.second;
+  fbdo->setResult(JsonValue());  // The REST response to a PATCH echoes the patch; nothing reads it
+  return true;
+}
+
+bool FirebaseRTDB::deleteNode(FirebaseData* fbdo, const char* path) {
+  if (!request(fbdo, true)) return false;
+  host::OffDevice offDevice;
+  host::rtdb().root.remove(path);
+  fbdo->setResult(JsonValue());
+  return true;
+}
@@ -0,0 +1,183 @@
+#include "HostFlash.h"
+#include <esp_ota_ops.h>
+#include <Update.h>
+
+static uint8_t flash[host::FLASH_SIZE];
+static bool flashReady = false;
+static long budget = host::FLASH_UNLIMITED;
+static long used = 0;
+static bool powerLost = false;
+
+static uint8_t* chip() {
+  if (!flashReady) {
+    memset(flash, 0xFF, sizeof(flash));
+    flashReady = true;
+  }
+  return flash;
+}
+
+// One unit of work against the budget; false once power is gone
+static bool spend() {
+  if (powerLost) return false;
+  if (budget != host::FLASH_UNLIMITED && used >= budget) {
+    powerLost = true;
+    return false;
+  }
+  used++;
+  return true;
+}
+
+uint8_t* host::flashData() { return chip(); }
+
+void host::eraseFlash() {
+  memset(chip(), 0xFF, FLASH_SIZE);
+  restoreFlashPower();
+}
+
+void host::setFlashBudget(long units) {
+  budget = units;
+  used = 0;
+  powerLost = false;
+}
+
+long host::flashUnitsUsed() { return used; }
+bool host::flashPowerLost() { return powerLost; }
+
+void host::restoreFlashPower() { setFlashBudget(FLASH_UNLIMITED); }
+
+esp_err_t spi_flash_mmap(size_t src_addr, size_t size, spi_flash_mmap_memory_t memory, const void** out_ptr,
+                         spi_flash_mmap_handle_t* out_handle) {
+  if (src_addr + size > host::FLASH_SIZE || src_addr % SPI_FLASH_MMU_PAGE_SIZE) return ESP_ERR_INVALID_ARG;
+  *out_ptr = chip() + src_addr;
+  *out_handle = 1;
+  return ESP_OK;
+}
+
+void spi_flash_munmap(spi_flash_mmap_handle_t handle) {}
+
+esp_err_t spi_flash_read(size_t src_addr, void* dest, size_t size) {
+  if (src_addr + size > host::FLASH_SIZE) return ESP_ERR_INVALID_SIZE;
+  memcpy(dest, chip() + src_addr, size);
+  return ESP_OK;
+}
+
+esp_err_t spi_flash_write(size_t dest_addr, const void* src, size_t size) {
+  if (dest_addr + size > host::FLASH_SIZE) return ESP_ERR_INVALID_SIZE;
+  const uint8_t* bytes = (const uint8_t*)src;
+  uint8_t* dst = chip() + dest_addr;
+  for (size_t i = 0; i < size; i++) {
+    if (!spend()) return ESP_FAIL;
+    dst[i] &= bytes[i];  // NOR: programming only clears bits
+  }
+  return ESP_OK;
+}
+
+esp_err_t spi_flash_erase_range(size_t start_addr, size_t size) {
+  if (start_addr % SPI_FLASH_SEC_SIZE || size % SPI_FLASH_SEC_SIZE) return ESP_ERR_INVALID_ARG;
+  if (start_addr + size > host::FLASH_SIZE) return ESP_ERR_INVALID_SIZE;
+  for (size_t offset = 0; offset < size; offset += SPI_FLASH_SEC_SIZE) {
+    if (!spend()) return ESP_FAIL;
+    memset(chip() + start_addr + offset, 0xFF, SPI_FLASH_SEC_SIZE);
+  }
+  return ESP_OK;
+}
+
+esp_err_t spi_flash_erase_sector(size_t sector) { return spi_flash_erase_range(sector * SPI_FLASH_SEC_SIZE, SPI_FLASH_SEC_SIZE); }
+
+static const esp_partition_t partitions[] = {
+    {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, host::APP0_OFFSET, host::APP_PARTITION_SIZE, "app0", false},
+    {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, host::APP1_OFFSET, host::APP_PARTITION_SIZE, "app1", false},
+    {ESP_PARTITION_TYPE_DATA, 0x40, host::CLIPS_OFFSET, host::CLIPS_SIZE, "clips", false},
+};
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, int subtype, const char* label) {
+  for (const esp_partition_t& p : partitions) {
+    if (type != ESP_PARTITION_TYPE_ANY && p.type != type) continue;
+    if (subtype != ESP_PARTITION_SUBTYPE_ANY && p.subtype != subtype) continue;
+    if (label && strcmp(label, p.label) != 0) continue;
+    return &p;
+  }
+  return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* p, size_t src_offset, void* dst, size_t size) {
+  if (src_offset + size > p->size) return ESP_ERR_INVALID_SIZE;
+  return spi_flash_read(p->address + src_offset, dst, size);
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* p, size_t dst_offset, const void* src, size_t size) {
+  if (dst_offset + size > p->size) return ESP_ERR_INVALID_SIZE;
+  return spi_flash_write(p->address + dst_offset, src, size);
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* p, size_t offset, size_t size) {
+  if (offset + size > p->size) return ESP_ERR_INVALID_SIZE;
+  return spi_flash_erase_range(p->address + offset, size);
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t* p, size_t offset, size_t size, esp_partition_mmap_memory_t memory,
+                             const void** out_ptr, spi_flash_mmap_handle_t* out_handle) {
+  if (offset + size > p->size) return ESP_ERR_INVALID_SIZE;
+  *out_ptr = chip() + p->address + offset;
+  *out_handle = 1;
+  return ESP_OK;
+}
+
+const esp_partition_t* esp_ota_get_running_partition() { return &partitions[0]; }
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* start_from) { return &partitions[1]; }
+
+// ---------------------------------------------------------------------------------------------
+// Update
+
+UpdateClass Update;
+static size_t stagedSize = 0;
+static bool committed = false;
+
+bool UpdateClass::begin(size_t size) {
+  if (size == 0 || size > host::APP_PARTITION_SIZE) return false;
+  size_t eraseSize = (size + SPI_FLASH_SEC_SIZE - 1) & ~(size_t)(SPI_FLASH_SEC_SIZE - 1);
+  committed = false;
+  stagedSize = 0;
+  if (spi_flash_erase_range(host::APP1_OFFSET, eraseSize) != ESP_OK) {
+    error = 1;
+    return false;
+  }
+  running = true;
+  error = 0;
+  expected = size;
+  written = 0;
+  return true;
+}
+
+size_t UpdateClass::write(uint8_t* data, size_t len) {
+  if (!running || written + len > expected) return 0;
+  if (spi_flash_write(host::APP1_OFFSET + written, data, len) != ESP_OK) {
+    error = 1;
+    return 0;
+  }
+  written += len;
+  return len;
+}
+
+bool UpdateClass::end(bool evenIfRemaining) {
+  if (!running || error || (!evenIfRemaining && written != expected)) return false;
+  running = false;
+  stagedSize = written;
+  committed = true;
+  return true;
+}
+
+void UpdateClass::abort() {
+  running = false;
+  committed = false;
+}
+
+const uint8_t* host::stagedImage() { return chip() + APP1_OFFSET; }
+size_t host::stagedImageSize() { return stagedSize; }
+bool host::stagedImageCommitted() { return committed; }
+
+void host::resetUpdate() {
+  Update.abort();
+  stagedSize = 0;
+}
@@ -0,0 +1,37 @@
+// HostFlash.h
+#pragma once
+
+// Host model of the 8 MB NOR flash behind esp_spi_flash.h, esp_partition.h and Update. Programming
+// can only clear bits; erase sets a 4 KB sector back to 0xFF. A power budget cuts the supply partway
+// through a write or erase so storage code can be checked against every possible tear point.
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace host {
+
+constexpr size_t FLASH_SIZE = 8 * 1024 * 1024;
+constexpr uint32_t APP0_OFFSET = 0x10000;     // Running image
+constexpr uint32_t APP1_OFFSET = 0x210000;    // Update / OTA target
+constexpr uint32_t APP_PARTITION_SIZE = 0x200000;
+constexpr uint32_t CLIPS_OFFSET = 0x500000;
+constexpr uint32_t CLIPS_SIZE = 0x100000;
+
+uint8_t* flashData();
+void eraseFlash();                            // Whole chip back to 0xFF, power restored
+
+// Each programmed byte and each erased sector costs one unit. Once the budget is spent the operation
+// in progress stops where it is and every later write or erase fails, until restoreFlashPower().
+constexpr long FLASH_UNLIMITED = -1;
+void setFlashBudget(long units);
+long flashUnitsUsed();
+bool flashPowerLost();
+void restoreFlashPower();
+
+// Update: the image staged in APP1 and whether Update.end() accepted it
+const uint8_t* stagedImage();
+size_t stagedImageSize();
+bool stagedImageCommitted();
+void resetUpdate();
+
+}  // namespace host
@@ -0,0 +1,154 @@
+// Process-wide malloc interposer: counts every allocation for the host tests and benchmarks, models
+// the device's free heap, and forwards to the ESP-IDF heap hooks the way CONFIG_HEAP_USE_HOOKS does.
+
+#include "HostRuntime.h"
+#include <esp_heap_caps.h>
+#include <malloc.h>
+#include <string.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+static host::HeapCounters counters;
+static int offDeviceDepth = 0;
+
+// Live off-device blocks: open addressing with linear probing and backward-shift deletion, so no
+// allocation is needed to track them
+static constexpr size_t OFF_DEVICE_SLOTS = 1 << 18;
+static void* offDeviceBlocks[OFF_DEVICE_SLOTS];
+
+static size_t slotFor(void* ptr) {
+  uintptr_t h = (uintptr_t)ptr >> 4;
+  h ^= h >> 17;
+  h *= 0x9E3779B97F4A7C15ull;
+  return (h >> 20) & (OFF_DEVICE_SLOTS - 1);
+}
+
+static void rememberOffDevice(void* ptr) {
+  size_t i = slotFor(ptr);
+  while (offDeviceBlocks[i]) i = (i + 1) & (OFF_DEVICE_SLOTS - 1);
+  offDeviceBlocks[i] = ptr;
+}
+
+static bool forgetOffDevice(void* ptr) {
+  size_t i = slotFor(ptr);
+  while (offDeviceBlocks[i] != ptr) {
+    if (!offDeviceBlocks[i]) return false;
+    i = (i + 1) & (OFF_DEVICE_SLOTS - 1);
+  }
+  // Shift later members of the cluster back so lookups never stop early
+  size_t hole = i;
+  for (size_t j = (i + 1) & (OFF_DEVICE_SLOTS - 1); offDeviceBlocks[j]; j = (j + 1) & (OFF_DEVICE_SLOTS - 1)) {
+    size_t home = slotFor(offDeviceBlocks[j]);
+    bool movable = hole <= j ? (home <= hole || home > j) : (home <= hole && home > j);
+    if (movable) {
+      offDeviceBlocks[hole] = offDeviceBlocks[j];
+      hole = j;
+    }
+  }
+  offDeviceBlocks[hole] = nullptr;
+  return true;
+}
+
+host::OffDevice::OffDevice() { offDeviceDepth++; }
+host::OffDevice::~OffDevice() { offDeviceDepth--; }
+
+static int64_t baselineLiveBytes = 0;
+static int64_t baselineLiveBlocks = 0;
+static size_t minFreeHeap = host::DEVICE_HEAP_BYTES;
+
+static void noteAlloc(void* ptr, size_t size) {
+  if (offDeviceDepth) {
+    rememberOffDevice(ptr);
+    return;
+  }
+  counters.allocs++;
+  counters.allocBytes += size;
+  counters.liveBytes += malloc_usable_size(ptr);
+  counters.liveBlocks++;
+  size_t free = host::modelledFreeHeap();
+  if (free < minFreeHeap) minFreeHeap = free;
+  if (esp_heap_trace_alloc_hook) esp_heap_trace_alloc_hook(ptr, size, MALLOC_CAP_8BIT);
+}
+
+static void noteFree(void* ptr) {
+  if (forgetOffDevice(ptr)) return;
+  counters.frees++;
+  counters.liveBytes -= malloc_usable_size(ptr);
+  counters.liveBlocks--;
+  if (esp_heap_trace_free_hook) esp_heap_trace_free_hook(ptr);
+}
+
+extern "C" void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  if (ptr) noteAlloc(ptr, size);
+  return ptr;
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+  void* ptr = __libc_calloc(count, size);
+  if (ptr) noteAlloc(ptr, count * size);
+  return ptr;
+}
+
+extern "C" void* realloc(void* old, size_t size) {
+  if (!old) return malloc(size);
+  if (!size) {
+    free(old);
+    return nullptr;
+  }
+  // Grow by hand so the old block is only accounted as freed once the new one exists
+  size_t oldSize = malloc_usable_size(old);
+  void* ptr = malloc(size);
+  if (!ptr) return nullptr;
+  memcpy(ptr, old, oldSize < size ? oldSize : size);
+  free(old);
+  return ptr;
+}
+
+extern "C" void free(void* ptr) {
+  if (!ptr) return;
+  noteFree(ptr);
+  __libc_free(ptr);
+}
+
+host::HeapCounters host::heapCounters() { return counters; }
+
+void host::resetHeapBaseline() {
+  baselineLiveBytes = counters.liveBytes;
+  baselineLiveBlocks = counters.liveBlocks;
+  minFreeHeap = DEVICE_HEAP_BYTES;
+}
+
+size_t host::modelledFreeHeap() {
+  int64_t used = counters.liveBytes - baselineLiveBytes;
+  if (used <= 0) return DEVICE_HEAP_BYTES;
+  return used >= (int64_t)DEVICE_HEAP_BYTES ? 0 : DEVICE_HEAP_BYTES - used;
+}
+
+size_t host::modelledMinFreeHeap() { return minFreeHeap; }
+
+size_t heap_caps_get_free_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : host::modelledFreeHeap(); }
+size_t heap_caps_get_minimum_free_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : minFreeHeap; }
+size_t heap_caps_get_largest_free_block(uint32_t caps) { return heap_caps_get_free_size(caps); }
+size_t heap_caps_get_total_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : host::DEVICE_HEAP_BYTES; }
+
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t caps) {
+  memset(info, 0, sizeof(*info));
+  if (caps & MALLOC_CAP_SPIRAM) return;
+  info->total_free_bytes = host::modelledFreeHeap();
+  info->total_allocated_bytes = host::DEVICE_HEAP_BYTES - info->total_free_bytes;
+  info->largest_free_block = info->total_free_bytes;
+  info->minimum_free_bytes = minFreeHeap;
+  info->allocated_blocks = counters.liveBlocks - baselineLiveBlocks;
+  info->free_blocks = 1;
+  info->total_blocks = info->allocated_blocks + 1;
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? nullptr : malloc(size); }
+void* heap_caps_calloc(size_t count, size_t size, uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? nullptr : calloc(count, size); }
+void heap_caps_free(void* ptr) { free(ptr); }
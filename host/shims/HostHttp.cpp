@@ -0,0 +1,232 @@
+#include <HTTPClient.h>
+#include <WiFi.h>
+#include <algorithm>
+#include "HostRuntime.h"
+
+static std::map<std::string, host::HttpHandler>& servers() {
+  static std::map<std::string, host::HttpHandler> s;
+  return s;
+}
+
+static std::map<std::string, uint32_t>& requestCounts() {
+  static std::map<std::string, uint32_t> c;
+  return c;
+}
+
+static std::string lower(std::string s) {
+  for (char& c : s) c = tolower((unsigned char)c);
+  return s;
+}
+
+void host::serveHttp(const std::string& hostName, HttpHandler handler) {
+  servers()[hostName] = std::move(handler);
+}
+
+void host::clearHttpServers() {
+  servers().clear();
+}
+
+uint32_t host::httpRequestCount(const std::string& hostName) {
+  auto it = requestCounts().find(hostName);
+  return it == requestCounts().end() ? 0 : it->second;
+}
+
+void host::resetHttpRequestCounts() {
+  requestCounts().clear();
+}
+
+std::string host::HttpRequest::header(const std::string& name) const {
+  auto it = headers.find(lower(name));
+  return it == headers.end() ? "" : it->second;
+}
+
+std::string host::HttpRequest::query(const std::string& key) const {
+  size_t q = path.find('?');
+  while (q != std::string::npos) {
+    size_t start = q + 1;
+    size_t end = path.find('&', start);
+    std::string pair = path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    size_t eq = pair.find('=');
+    if (pair.substr(0, eq) == key) return eq == std::string::npos ? "" : pair.substr(eq + 1);
+    q = end;
+  }
+  return "";
+}
+
+host::HttpResponse host::serveBytes(const HttpRequest& request, const std::string& content) {
+  HttpResponse response;
+  std::string range = request.header("Range");
+  size_t from = 0;
+  if (range.rfind("bytes=", 0) == 0) from = strtoul(range.c_str() + 6, nullptr, 10);
+  if (from >= content.size() && from > 0) {
+    response.status = 416;
+    return response;
+  }
+  response.body = content.substr(from);
+  if (from > 0) {
+    response.status = 206;
+    response.headers["Content-Range"] = "bytes " + std::to_string(from) + "-" + std::to_string(content.size() - 1) +
+                                        "/" + std::to_string(content.size());
+  }
+  return response;
+}
+
+// --- WiFiClient ---
+
+void WiFiClient::load(const std::string& content, size_t dropAfter, uint32_t rate) {
+  body = content;
+  pos = 0;
+  limit = std::min(dropAfter, body.size());
+  bytesPerMs = rate;
+  startMicros = host::nowMicros();
+  open = true;
+  setTimeout(1000);
+}
+
+size_t WiFiClient::arrived() {
+  if (!bytesPerMs) return limit;
+  uint64_t ms = (host::nowMicros() - startMicros) / 1000;
+  return (size_t)std::min<uint64_t>(limit, ms * bytesPerMs);
+}
+
+int WiFiClient::available() {
+  return open ? (int)(arrived() - pos) : 0;
+}
+
+int WiFiClient::read() {
+  if (available() <= 0) return -1;
+  return (uint8_t)body[pos++];
+}
+
+int WiFiClient::peek() {
+  if (available() <= 0) return -1;
+  return (uint8_t)body[pos];
+}
+
+int WiFiClient::read(uint8_t* buf, size_t len) {
+  int avail = available();
+  if (avail <= 0) return -1;
+  size_t n = std::min(len, (size_t)avail);
+  memcpy(buf, body.data() + pos, n);
+  pos += n;
+  return (int)n;
+}
+
+// Open until every byte the server will send has arrived; the peer closes after the body
+uint8_t WiFiClient::connected() {
+  return open && arrived() < limit;
+}
+
+// --- HTTPClient ---
+
+bool HTTPClient::begin(const String& target) {
+  end();
+  url = target.c_str();
+  return url.rfind("http://", 0) == 0 || url.rfind("https://", 0) == 0;
+}
+
+void HTTPClient::end() {
+  stream.stop();
+  requestHeaders.clear();
+  responseHeaders.clear();
+  size = -1;
+}
+
+void HTTPClient::addHeader(const String& name, const String& value) {
+  requestHeaders.emplace_back(name.c_str(), value.c_str());
+}
+
+void HTTPClient::collectHeaders(const char* keys[], size_t count) {
+  wantedHeaders.clear();
+  for (size_t i = 0; i < count; i++) wantedHeaders.push_back(lower(keys[i]));
+}
+
+String HTTPClient::header(const char* name) {
+  auto it = responseHeaders.find(lower(name));
+  return it == responseHeaders.end() ? String() : String(it->second.c_str());
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+  return responseHeaders.count(lower(name)) > 0;
+}
+
+int HTTPClient::GET() {
+  return send("GET", "");
+}
+
+int HTTPClient::POST(const String& body) {
+  return send("POST", body.c_str());
+}
+
+// The request, the server and the socket buffers are off the device; what the firmware reads out of
+// the stream is counted. Scopes never span a block, where other tasks would run inside them.
+int HTTPClient::send(const char* method, const std::string& body) {
+  if (WiFi.status() != WL_CONNECTED) return HTTPC_ERROR_CONNECTION_REFUSED;
+
+  host::HttpResponse* response;
+  {
+    host::OffDevice offDevice;
+    host::HttpRequest request;
+    request.method = method;
+    request.body = body;
+    request.http10 = http10;
+    size_t hostStart = url.find("://") + 3;
+    size_t pathStart = url.find('/', hostStart);
+    request.host = url.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+    request.host = request.host.substr(0, request.host.find(':'));
+    request.path = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+    for (const auto& h : requestHeaders) request.headers[lower(h.first)] = h.second;
+
+    auto server = servers().find(request.host);
+    if (server == servers().end()) {
+      response = nullptr;
+    } else {
+      requestCounts()[request.host]++;
+      response = new host::HttpResponse(server->second(request));
+    }
+  }
+  if (!response) {
+    host::blockUntil(host::nowMicros() + (uint64_t)timeoutMs * 1000);
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+
+  host::blockUntil(host::nowMicros() + (uint64_t)response->latencyMs * 1000);
+  int status = response->status;
+  if (status > 0) {
+    host::OffDevice offDevice;
+    for (const auto& h : response->headers) {
+      std::string key = lower(h.first);
+      if (std::find(wantedHeaders.begin(), wantedHeaders.end(), key) != wantedHeaders.end()) responseHeaders[key] = h.second;
+    }
+    size = (int)response->body.size();
+    stream.load(response->body, response->dropAfter, response->bytesPerMs);
+  }
+  delete response;
+  return status;
+}
+
+String HTTPClient::getString() {
+  std::string out;
+  while (connected()) {
+    int c = stream.read();
+    if (c >= 0) {
+      out += (char)c;
+      continue;
+    }
+    uint64_t waitUntil = host::nowMicros() + (uint64_t)timeoutMs * 1000;
+    while (stream.available() <= 0 && stream.connected() && host::nowMicros() < waitUntil) delay(1);
+    if (stream.available() <= 0) break;
+  }
+  return String(out.c_str());
+}
+
+String HTTPClient::errorToString(int code) {
+  switch (code) {
+    case HTTPC_ERROR_CONNECTION_REFUSED: return "connection refused";
+    case HTTPC_ERROR_SEND_HEADER_FAILED: return "send header failed";
+    case HTTPC_ERROR_NOT_CONNECTED: return "not connected";
+    case HTTPC_ERROR_CONNECTION_LOST: return "connection lost";
+    case HTTPC_ERROR_READ_TIMEOUT: return "read Timeout";
+    default: return code > 0 ? String("HTTP ") + String(code) : String();
+  }
+}
@@ -0,0 +1,208 @@
+#include "HostJson.h"
+#include <ArduinoJson.h>
+
+using host::JsonValue;
+
+JsonValue JsonValue::of(bool v) {
+  JsonValue j;
+  j.type = BOOL;
+  j.boolean = v;
+  return j;
+}
+
+JsonValue JsonValue::of(int64_t v) {
+  JsonValue j;
+  j.type = INT;
+  j.integer = v;
+  return j;
+}
+
+JsonValue JsonValue::of(double v) {
+  JsonValue j;
+  j.type = FLOAT;
+  j.real = v;
+  return j;
+}
+
+JsonValue JsonValue::of(const std::string& v) {
+  JsonValue j;
+  j.type = STRING;
+  j.string = v;
+  return j;
+}
+
+JsonValue JsonValue::object() {
+  JsonValue j;
+  j.type = OBJECT;
+  return j;
+}
+
+JsonValue JsonValue::array() {
+  JsonValue j;
+  j.type = ARRAY;
+  return j;
+}
+
+static JsonValue fromNode(const JsonNode* n) {
+  JsonValue j;
+  if (!n) return j;
+  switch (n->type) {
+    case JsonNodeType::Null: break;
+    case JsonNodeType::Bool: j = JsonValue::of(n->value.boolean); break;
+    case JsonNodeType::Int: j = JsonValue::of((int64_t)n->value.integer); break;
+    case JsonNodeType::Float: j = JsonValue::of(n->value.real); break;
+    case JsonNodeType::String: j = JsonValue::of(n->value.string); break;
+    case JsonNodeType::Array:
+      j.type = JsonValue::ARRAY;
+      for (const JsonNode* c = n->value.list.head; c; c = c->next) j.items.push_back(fromNode(c));
+      break;
+    case JsonNodeType::Object:
+      j.type = JsonValue::OBJECT;
+      for (const JsonNode* c = n->value.list.head; c; c = c->next) j.members[c->key] = fromNode(c);
+      break;
+  }
+  return j;
+}
+
+bool JsonValue::parse(const std::string& text, JsonValue& out) {
+  DynamicJsonDocument doc(text.size() * 4 + 1024);
+  if (deserializeJson(doc, text.c_str(), text.size(), DeserializationOption::NestingLimit(32))) return false;
+  out = fromNode(doc.node());
+  return true;
+}
+
+static void appendString(const std::string& s, std::string& out) {
+  out += '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if ((unsigned char)c < 0x20) {
+      char escape[8];
+      snprintf(escape, sizeof(escape), "\\u%04x", c);
+      out += escape;
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+static void serializeInto(const JsonValue& j, std::string& out, bool pretty, int depth) {
+  std::string indent = pretty ? "\n" + std::string((depth + 1) * 2, ' ') : "";
+  std::string closing = pretty ? "\n" + std::string(depth * 2, ' ') : "";
+  char number[32];
+  switch (j.type) {
+    case JsonValue::NUL: out += "null"; break;
+    case JsonValue::BOOL: out += j.boolean ? "true" : "false"; break;
+    case JsonValue::INT:
+      snprintf(number, sizeof(number), "%lld", (long long)j.integer);
+      out += number;
+      break;
+    case JsonValue::FLOAT:
+      snprintf(number, sizeof(number), "%.9g", j.real);
+      out += number;
+      break;
+    case JsonValue::STRING: appendString(j.string, out); break;
+    case JsonValue::ARRAY:
+      out += '[';
+      for (size_t i = 0; i < j.items.size(); i++) {
+        if (i) out += ',';
+        out += indent;
+        serializeInto(j.items[i], out, pretty, depth + 1);
+      }
+      if (!j.items.empty()) out += closing;
+      out += ']';
+      break;
+    case JsonValue::OBJECT: {
+      out += '{';
+      bool first = true;
+      for (const auto& m : j.members) {
+        if (!first) out += ',';
+        first = false;
+        out += indent;
+        appendString(m.first, out);
+        out += pretty ? ": " : ":";
+        serializeInto(m.second, out, pretty, depth + 1);
+      }
+      if (!j.members.empty()) out += closing;
+      out += '}';
+      break;
+    }
+  }
+}
+
+std::string JsonValue::serialize(bool pretty) const {
+  std::string out;
+  serializeInto(*this, out, pretty, 0);
+  return out;
+}
+
+std::vector<std::string> host::splitPath(const std::string& path) {
+  std::vector<std::string> parts;
+  size_t start = 0;
+  while (start <= path.size()) {
+    size_t slash = path.find('/', start);
+    if (slash == std::string::npos) slash = path.size();
+    if (slash > start) parts.push_back(path.substr(start, slash - start));
+    start = slash + 1;
+  }
+  return parts;
+}
+
+static const JsonValue* child(const JsonValue* j, const std::string& key) {
+  if (j->type == JsonValue::OBJECT) {
+    auto it = j->members.find(key);
+    return it == j->members.end() ? nullptr : &it->second;
+  }
+  if (j->type == JsonValue::ARRAY) {
+    char* end = nullptr;
+    unsigned long index = strtoul(key.c_str(), &end, 10);
+    if (*end || index >= j->items.size()) return nullptr;
+    return &j->items[index];
+  }
+  return nullptr;
+}
+
+const JsonValue* JsonValue::find(const std::string& path) const {
+  const JsonValue* at = this;
+  for (const std::string& part : splitPath(path)) {
+    at = child(at, part);
+    if (!at) return nullptr;
+  }
+  return at;
+}
+
+JsonValue& JsonValue::ensure(const std::string& path) {
+  JsonValue* at = this;
+  for (const std::string& part : splitPath(path)) {
+    if (at->type == ARRAY) {
+      char* end = nullptr;
+      unsigned long index = strtoul(part.c_str(), &end, 10);
+      if (!*end) {
+        if (index >= at->items.size()) at->items.resize(index + 1);
+        at = &at->items[index];
+        continue;
+      }
+    }
+    if (at->type != OBJECT) *at = object();
+    at = &at->members[part];
+  }
+  return *at;
+}
+
+bool JsonValue::remove(const std::string& path) {
+  std::vector<std::string> parts = splitPath(path);
+  if (parts.empty()) {
+    *this = JsonValue();
+    return true;
+  }
+  JsonValue* parent = this;
+  for (size_t i = 0; i + 1 < parts.size(); i++) {
+    parent = const_cast<JsonValue*>(child(parent, parts[i]));
+    if (!parent) return false;
+  }
+  return parent->type == OBJECT && parent->members.erase(parts.back()) > 0;
+}
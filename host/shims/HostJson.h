@@ -0,0 +1,47 @@
+// HostJson.h
+#pragma once
+
+// Heap-backed JSON value for the host-side services (the in-memory RTDB, FirebaseJson and the
+// stand-in HTTP servers). Parsing goes through the ArduinoJson shim.
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace host {
+
+struct JsonValue {
+  enum Type { NUL, BOOL, INT, FLOAT, STRING, ARRAY, OBJECT };
+
+  Type type = NUL;
+  bool boolean = false;
+  int64_t integer = 0;
+  double real = 0;
+  std::string string;
+  std::vector<JsonValue> items;
+  std::map<std::string, JsonValue> members;
+
+  static JsonValue of(bool v);
+  static JsonValue of(int64_t v);
+  static JsonValue of(int v) { return of((int64_t)v); }
+  static JsonValue of(double v);
+  static JsonValue of(const std::string& v);
+  static JsonValue of(const char* v) { return of(std::string(v)); }
+  static JsonValue object();
+  static JsonValue array();
+  static bool parse(const std::string& text, JsonValue& out);
+
+  bool isNumber() const { return type == INT || type == FLOAT; }
+  double number() const { return type == INT ? (double)integer : type == FLOAT ? real : type == BOOL ? boolean : 0; }
+  std::string serialize(bool pretty = false) const;
+
+  // Slash-separated paths, e.g. "devices/abc/settings/brightness"; "" or "/" is this value
+  const JsonValue* find(const std::string& path) const;
+  JsonValue& ensure(const std::string& path);        // Creates objects along the way
+  bool remove(const std::string& path);
+};
+
+std::vector<std::string> splitPath(const std::string& path);
+
+}  // namespace host
@@ -0,0 +1,122 @@
+#include <Wire.h>
+#include <map>
+#include "HostRuntime.h"
+
+TwoWire Wire;
+
+static std::map<uint8_t, host::I2cDevice*>& bus() {
+  static std::map<uint8_t, host::I2cDevice*> devices;
+  return devices;
+}
+
+void host::attachI2c(uint8_t address, I2cDevice* device) {
+  bus()[address] = device;
+}
+
+void host::detachI2cDevices() {
+  bus().clear();
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  target = address;
+  txLen = 0;
+}
+
+size_t TwoWire::write(uint8_t b) {
+  if (txLen >= sizeof(tx)) return 0;
+  tx[txLen++] = b;
+  return 1;
+}
+
+// 0 = ACK, 2 = NACK on the address byte
+uint8_t TwoWire::endTransmission(bool) {
+  auto it = bus().find(target);
+  if (it == bus().end()) return 2;
+  if (txLen) it->second->onWrite(tx, txLen);
+  txLen = 0;
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool) {
+  rxPos = rxLen = 0;
+  auto it = bus().find(address);
+  if (it == bus().end()) return 0;
+  rxLen = (uint8_t)it->second->onRead(rx, min((size_t)quantity, sizeof(rx)));
+  return rxLen;
+}
+
+// --- mDNS, UDP, LittleFS ---
+
+#include <AsyncUDP.h>
+#include <ESPmDNS.h>
+#include <LittleFS.h>
+#include <algorithm>
+#include <vector>
+
+MDNSResponder MDNS;
+LittleFSFS LittleFS;
+
+static std::vector<AsyncUDP*>& sockets() {
+  static std::vector<AsyncUDP*> s;
+  return s;
+}
+
+AsyncUDP::~AsyncUDP() {
+  close();
+}
+
+bool AsyncUDP::listen(uint16_t port) {
+  close();
+  listenPort = port;
+  sockets().push_back(this);
+  return true;
+}
+
+void AsyncUDP::close() {
+  sockets().erase(std::remove(sockets().begin(), sockets().end(), this), sockets().end());
+  listenPort = 0;
+}
+
+void AsyncUDP::deliver(const uint8_t* data, size_t len) {
+  if (!handler) return;
+  AsyncUDPPacket packet(data, len);
+  handler(packet);
+}
+
+bool host::sendUdp(uint16_t port, const uint8_t* data, size_t len) {
+  for (AsyncUDP* socket : sockets()) {
+    if (socket->port() == port) {
+      socket->deliver(data, len);
+      return true;
+    }
+  }
+  return false;
+}
+
+static std::map<std::string, std::shared_ptr<std::string>>& files() {
+  static std::map<std::string, std::shared_ptr<std::string>> f;
+  return f;
+}
+
+void host::putFile(const std::string& path, const std::string& contents) {
+  OffDevice offDevice;
+  files()[path] = std::make_shared<std::string>(contents);
+}
+
+void host::clearFiles() {
+  files().clear();
+}
+
+fs::File fs::FS::open(const char* path, const char*) {
+  host::OffDevice offDevice;  // Contents stay in flash; reads come out a byte at a time
+  auto it = files().find(path);
+  return it == files().end() ? File() : File(std::make_shared<std::string>(*it->second));
+}
+
+bool fs::FS::exists(const char* path) {
+  return files().count(path) > 0;
+}
+
+bool fs::FS::remove(const char* path) {
+  return files().erase(path) > 0;
+}
@@ -0,0 +1,462 @@
+// Virtual clock, cooperative FreeRTOS scheduler and the small Arduino core services built on them
+
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <map>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------
+// Clock
+
+static host::ClockMode clockMode = host::ClockMode::MANUAL;
+static uint64_t virtualMicros = 0;
+static uint64_t realBase = 0;
+
+static uint64_t realMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+void host::setClockMode(ClockMode mode) {
+  virtualMicros = nowMicros();
+  realBase = realMicros();
+  clockMode = mode;
+}
+
+uint64_t host::nowMicros() {
+  if (clockMode == ClockMode::MANUAL) return virtualMicros;
+  return virtualMicros + (realMicros() - realBase);
+}
+
+void host::advanceMicros(uint64_t us) { virtualMicros += us; }
+
+void host::advanceTo(uint64_t us) {
+  uint64_t now = nowMicros();
+  if (us > now) virtualMicros += us - now;
+}
+
+unsigned long millis() { return host::nowMicros() / 1000; }
+unsigned long micros() { return host::nowMicros(); }
+int64_t esp_timer_get_time() { return host::nowMicros(); }
+
+// ---------------------------------------------------------------------------------------------
+// Scheduler
+
+#define HOST_TASK_STACK (512 * 1024)  // Host frames are far larger than Xtensa ones
+
+struct HostTask {
+  ucontext_t context;
+  void* stack = nullptr;
+  TaskFunction_t fn = nullptr;
+  void* arg = nullptr;
+  char name[16] = "loopTask";
+  bool dead = false;
+  bool blocked = false;
+  uint64_t wakeAt = 0;
+  bool (*ready)(void*) = nullptr;
+  void* readyCtx = nullptr;
+  uint32_t notifications = 0;
+};
+
+static HostTask loopTask;
+static HostTask* current = &loopTask;
+
+static std::vector<HostTask*>& taskList() {
+  static std::vector<HostTask*> tasks{&loopTask};
+  return tasks;
+}
+
+static std::multimap<uint64_t, std::function<void()>>& timerList() {
+  static std::multimap<uint64_t, std::function<void()>> timers;
+  return timers;
+}
+
+static bool runnable(HostTask* t, uint64_t now) {
+  if (t->dead) return false;
+  if (!t->blocked) return true;
+  if (t->ready && t->ready(t->readyCtx)) return true;
+  return now >= t->wakeAt;
+}
+
+static void fireTimers() {
+  auto& timers = timerList();
+  while (!timers.empty() && timers.begin()->first <= host::nowMicros()) {
+    std::function<void()> fn = std::move(timers.begin()->second);
+    timers.erase(timers.begin());
+    fn();
+  }
+}
+
+static void reapDeadTasks() {
+  auto& tasks = taskList();
+  for (size_t i = 0; i < tasks.size();) {
+    HostTask* t = tasks[i];
+    if (t->dead && t != current && t != &loopTask) {
+      munmap(t->stack, HOST_TASK_STACK);
+      delete t;
+      tasks.erase(tasks.begin() + i);
+    } else {
+      i++;
+    }
+  }
+}
+
+static void switchTo(HostTask* next) {
+  next->blocked = false;
+  next->ready = nullptr;
+  if (next == current) return;
+  HostTask* previous = current;
+  current = next;
+  swapcontext(&previous->context, &next->context);
+  reapDeadTasks();
+}
+
+static void schedule() {
+  auto& tasks = taskList();
+  for (;;) {
+    fireTimers();
+    uint64_t now = host::nowMicros();
+    size_t count = tasks.size();
+    size_t self = 0;
+    while (self < count && tasks[self] != current) self++;
+    for (size_t i = 1; i <= count; i++) {
+      HostTask* t = tasks[(self + i) % count];
+      if (runnable(t, now)) {
+        switchTo(t);
+        return;
+      }
+    }
+
+    uint64_t next = host::FOREVER;
+    for (HostTask* t : tasks) {
+      if (!t->dead && t->blocked) next = min(next, t->wakeAt);
+    }
+    if (!timerList().empty()) next = min(next, timerList().begin()->first);
+    if (next == host::FOREVER) {
+      fprintf(stderr, "host: every task is blocked forever (current: %s)\n", current->name);
+      abort();
+    }
+    host::advanceTo(next);
+  }
+}
+
+static void taskEntry() {
+  HostTask* self = current;
+  self->fn(self->arg);
+  self->dead = true;  // FreeRTOS tasks must not return; treat it as vTaskDelete(nullptr)
+  schedule();
+}
+
+void host::blockUntil(uint64_t deadlineUs, bool (*ready)(void*), void* ctx) {
+  current->blocked = true;
+  current->wakeAt = deadlineUs;
+  current->ready = ready;
+  current->readyCtx = ctx;
+  schedule();
+}
+
+void host::at(uint64_t us, std::function<void()> fn) {
+  OffDevice offDevice;
+  timerList().emplace(us, std::move(fn));
+}
+
+void host::runFor(uint64_t us) { blockUntil(nowMicros() + us); }
+
+size_t host::liveTasks() {
+  size_t live = 0;
+  for (HostTask* t : taskList()) live += !t->dead;
+  return live;
+}
+
+static uint64_t deadlineAfter(TickType_t ticks) {
+  if (ticks == portMAX_DELAY) return host::FOREVER;
+  return host::nowMicros() + (uint64_t)ticks * 1000;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t core) {
+  void* stack = mmap(nullptr, HOST_TASK_STACK, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (stack == MAP_FAILED) return pdFAIL;
+
+  HostTask* t = new HostTask();
+  t->stack = stack;
+  t->fn = fn;
+  t->arg = arg;
+  strncpy(t->name, name ? name : "task", sizeof(t->name) - 1);
+  getcontext(&t->context);
+  t->context.uc_stack.ss_sp = stack;
+  t->context.uc_stack.ss_size = HOST_TASK_STACK;
+  t->context.uc_link = nullptr;
+  makecontext(&t->context, taskEntry, 0);
+  taskList().push_back(t);
+  if (created) *created = t;
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* arg,
+                       UBaseType_t priority, TaskHandle_t* created) {
+  return xTaskCreatePinnedToCore(fn, name, stackDepth, arg, priority, created, 0);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task && task != current) {
+    task->dead = true;
+    return;
+  }
+  current->dead = true;
+  schedule();
+  abort();  // A deleted task is never resumed
+}
+
+void vTaskDelay(TickType_t ticks) { host::blockUntil(deadlineAfter(ticks)); }
+TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+TaskHandle_t xTaskGetCurrentTaskHandle() { return current; }
+const char* pcTaskGetName(TaskHandle_t task) { return (task ? task : current)->name; }
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) { return HOST_TASK_STACK; }
+
+static bool hasNotification(void* ctx) { return static_cast<HostTask*>(ctx)->notifications > 0; }
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  HostTask* self = current;
+  if (self->notifications == 0 && ticks > 0) host::blockUntil(deadlineAfter(ticks), hasNotification, self);
+  uint32_t value = self->notifications;
+  if (value) self->notifications = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  task->notifications++;
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+  task->notifications++;
+  if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdTRUE;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Queues and semaphores
+
+struct HostQueue {
+  uint8_t* storage;
+  size_t itemSize;
+  size_t length;
+  size_t head = 0;
+  size_t count = 0;
+};
+
+static bool queueHasItem(void* ctx) { return static_cast<HostQueue*>(ctx)->count > 0; }
+static bool queueHasSpace(void* ctx) {
+  HostQueue* q = static_cast<HostQueue*>(ctx);
+  return q->count < q->length;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  HostQueue* q = new HostQueue{(uint8_t*)malloc(length * itemSize), itemSize, length};
+  return q;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  free(queue->storage);
+  delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks) {
+  if (q->count == q->length && ticks > 0) host::blockUntil(deadlineAfter(ticks), queueHasSpace, q);
+  if (q->count == q->length) return errQUEUE_FULL;
+  memcpy(q->storage + ((q->head + q->count) % q->length) * q->itemSize, item, q->itemSize);
+  q->count++;
+  return pdTRUE;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t q, const void* item, TickType_t ticks) { return xQueueSend(q, item, ticks); }
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void* item, BaseType_t* higherPriorityTaskWoken) {
+  if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+  return xQueueSend(q, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks) {
+  if (q->count == 0 && ticks > 0) host::blockUntil(deadlineAfter(ticks), queueHasItem, q);
+  if (q->count == 0) return pdFALSE;
+  memcpy(item, q->storage + q->head * q->itemSize, q->itemSize);
+  q->head = (q->head + 1) % q->length;
+  q->count--;
+  return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t q) {
+  q->head = q->count = 0;
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) { return q->count; }
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) { return q->length - q->count; }
+
+struct HostSemaphore {
+  int count;
+  int limit;
+};
+
+static bool semaphoreAvailable(void* ctx) { return static_cast<HostSemaphore*>(ctx)->count > 0; }
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostSemaphore{1, 1}; }
+SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostSemaphore{0, 1}; }
+void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  if (s->count == 0 && ticks > 0) host::blockUntil(deadlineAfter(ticks), semaphoreAvailable, s);
+  if (s->count == 0) return pdFALSE;
+  s->count--;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  if (s->count >= s->limit) return pdFALSE;
+  s->count++;
+  return pdTRUE;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Arduino core
+
+void delay(uint32_t ms) { host::blockUntil(host::nowMicros() + (uint64_t)ms * 1000); }
+void delayMicroseconds(uint32_t us) { host::advanceMicros(us); }
+void yield() { host::blockUntil(host::nowMicros()); }
+
+#define HOST_PIN_COUNT 64
+
+static int8_t pinLevels[HOST_PIN_COUNT];
+static uint8_t pinModes[HOST_PIN_COUNT];
+static void (*pinIsrs[HOST_PIN_COUNT])();
+static int pinIsrModes[HOST_PIN_COUNT];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= HOST_PIN_COUNT) return;
+  pinModes[pin] = mode;
+  if (mode == INPUT_PULLUP && pinLevels[pin] == 0) pinLevels[pin] = HIGH + 1;  // Stored +1; 0 means never driven
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < HOST_PIN_COUNT) pinLevels[pin] = (value ? HIGH : LOW) + 1;
+}
+
+int digitalRead(uint8_t pin) {
+  if (pin >= HOST_PIN_COUNT || pinLevels[pin] == 0) return pinModes[pin] == INPUT_PULLUP ? HIGH : LOW;
+  return pinLevels[pin] - 1;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  if (pin >= HOST_PIN_COUNT) return;
+  pinIsrs[pin] = isr;
+  pinIsrModes[pin] = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < HOST_PIN_COUNT) pinIsrs[pin] = nullptr;
+}
+
+void host::setPin(uint8_t pin, int level) {
+  if (pin >= HOST_PIN_COUNT) return;
+  int previous = digitalRead(pin);
+  pinLevels[pin] = (level ? HIGH : LOW) + 1;
+  if (!pinIsrs[pin] || previous == digitalRead(pin)) return;
+  int mode = pinIsrModes[pin];
+  if (mode == CHANGE || (mode == RISING && level) || (mode == FALLING && !level)) pinIsrs[pin]();
+}
+
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) { randomState = seed ? seed : 1; }
+
+long random(long max) {
+  if (max <= 0) return 0;
+  randomState = randomState * 1103515245u + 12345u;
+  return (randomState >> 1) % max;
+}
+
+long random(long min, long max) { return min >= max ? min : min + random(max - min); }
+
+static uint32_t cpuMhz = 240;
+static int cpuChanges = 0;
+
+bool setCpuFrequencyMhz(uint32_t mhz) {
+  if (mhz != cpuMhz) cpuChanges++;
+  cpuMhz = mhz;
+  return true;
+}
+
+uint32_t getCpuFrequencyMhz() { return cpuMhz; }
+uint32_t getXtalFrequencyMhz() { return 40; }
+uint32_t getApbFrequency() { return 80000000; }
+int host::cpuFrequencyChanges() { return cpuChanges; }
+
+const char* esp_err_to_name(esp_err_t code) {
+  switch (code) {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    default: return "UNKNOWN ERROR";
+  }
+}
+
+// ---------------------------------------------------------------------------------------------
+// Serial and ESP
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static bool serialEcho = true;
+static bool serialCapture = false;
+static std::string serialCaptured;
+
+void host::setSerialEcho(bool echo) { serialEcho = echo; }
+void host::setSerialCapture(bool capture) { serialCapture = capture; }
+
+std::string host::takeSerialOutput() {
+  std::string out;
+  out.swap(serialCaptured);
+  return out;
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+  if (serialEcho) fwrite(data, 1, len, stdout);
+  if (serialCapture) serialCaptured.append((const char*)data, len);
+  return len;
+}
+
+uint32_t EspClass::getFreeHeap() { return host::modelledFreeHeap(); }
+uint32_t EspClass::getMinFreeHeap() { return host::modelledMinFreeHeap(); }
+uint32_t EspClass::getMaxAllocHeap() { return host::modelledFreeHeap(); }
+uint32_t EspClass::getHeapSize() { return host::DEVICE_HEAP_BYTES; }
+uint64_t EspClass::getEfuseMac() { return 0x2a8e4d12f0a4ULL; }
+
+static std::function<void()> restartHandler;
+static int restarts = 0;
+
+void host::onRestart(std::function<void()> handler) { restartHandler = std::move(handler); }
+int host::restartCount() { return restarts; }
+
+void EspClass::restart() {
+  restarts++;
+  if (restartHandler) {
+    restartHandler();
+    return;
+  }
+  printf("host: ESP.restart()\n");
+  exit(0);
+}
+
+// The device keeps time in UTC with no TZ rule; TimeCache stores local wall time as if it were UTC
+__attribute__((constructor)) static void hostTimezone() {
+  setenv("TZ", "UTC0", 1);
+  tzset();
+}
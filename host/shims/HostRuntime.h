@@ -0,0 +1,75 @@
+// HostRuntime.h
+#pragma once
+
+// Host-only controls for the Linux build: the virtual clock, the cooperative task scheduler that
+// stands in for FreeRTOS, heap counters, GPIO levels and captured Serial output. Firmware code
+// never includes this; tests, the benchmark runner and the simulator drive the device through it.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+namespace host {
+
+// MANUAL: time only moves when a task blocks (delay, vTaskDelay, queue/notify timeouts), so tests
+// are deterministic. HYBRID: real elapsed CPU time is added on top, so busy time and benchmarks
+// measure the host while idle waits are still skipped instantly.
+enum class ClockMode { MANUAL, HYBRID };
+
+void setClockMode(ClockMode mode);
+uint64_t nowMicros();
+void advanceMicros(uint64_t us);     // Jump forward without running other tasks
+void advanceTo(uint64_t us);
+
+// Scheduler. Every FreeRTOS task is a ucontext coroutine; the thread that calls setup()/loop() (or a
+// test body) is the loop task. Blocking calls park the caller until `ready(ctx)` holds or the
+// deadline passes, run whatever else is runnable and fast-forward the clock when nothing is.
+constexpr uint64_t FOREVER = UINT64_MAX;
+void blockUntil(uint64_t deadlineUs, bool (*ready)(void*) = nullptr, void* ctx = nullptr);
+void at(uint64_t us, std::function<void()> fn);  // Timer event, runs like an ISR at virtual time `us`
+void runFor(uint64_t us);                        // Block the caller and let the other tasks run
+size_t liveTasks();
+
+// Heap: every malloc/free in the process is counted. Free heap is modelled as DEVICE_HEAP_BYTES
+// minus what was allocated since the last resetHeapBaseline().
+constexpr size_t DEVICE_HEAP_BYTES = 320 * 1024;
+struct HeapCounters {
+  uint64_t allocs = 0;
+  uint64_t allocBytes = 0;
+  uint64_t frees = 0;
+  int64_t liveBytes = 0;
+  int64_t liveBlocks = 0;
+};
+HeapCounters heapCounters();
+
+// Allocations made while one of these is alive are off the device: the stand-in servers, the RTDB
+// tree and network buffers. They are left out of the counters, and so are their frees.
+class OffDevice {
+public:
+  OffDevice();
+  ~OffDevice();
+  OffDevice(const OffDevice&) = delete;
+  OffDevice& operator=(const OffDevice&) = delete;
+};
+
+void resetHeapBaseline();
+size_t modelledFreeHeap();
+size_t modelledMinFreeHeap();
+
+// GPIO: setPin() changes an input level and fires the attached interrupt like the hardware would
+void setPin(uint8_t pin, int level);
+
+// Serial goes to stdout unless muted; capture keeps a copy for assertions
+void setSerialEcho(bool echo);
+void setSerialCapture(bool capture);
+std::string takeSerialOutput();
+
+// ESP.restart() lands here; the default prints and exits
+void onRestart(std::function<void()> handler);
+int restartCount();
+
+// CPU clock requests made through setCpuFrequencyMhz()
+int cpuFrequencyChanges();
+
+}  // namespace host
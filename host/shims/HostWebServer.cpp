@@ -0,0 +1,132 @@
+#include <WebServer.h>
+#include <algorithm>
+#include "HostRuntime.h"
+
+static std::vector<WebServer*>& listeners() {
+  static std::vector<WebServer*> l;
+  return l;
+}
+
+WebServer::WebServer(int port) : listenPort((uint16_t)port) {}
+
+WebServer::~WebServer() {
+  stop();
+}
+
+void WebServer::begin() {
+  if (!listening) listeners().push_back(this);
+  listening = true;
+}
+
+void WebServer::stop() {
+  listeners().erase(std::remove(listeners().begin(), listeners().end(), this), listeners().end());
+  listening = false;
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction fn) {
+  routes.push_back({uri.c_str(), method, fn});
+}
+
+void WebServer::cancel(Pending* pending) {
+  queue.erase(std::remove(queue.begin(), queue.end(), pending), queue.end());
+}
+
+static bool hasQueued(void* ctx) {
+  return !static_cast<std::vector<WebServer::Pending*>*>(ctx)->empty();
+}
+
+void WebServer::handleClient() {
+  host::blockUntil(host::FOREVER, hasQueued, &queue);
+  Pending* pending = queue.front();
+  queue.erase(queue.begin());
+  current = pending;
+
+  std::string path = pending->request.uri.substr(0, pending->request.uri.find('?'));
+  bool handled = false;
+  for (const Route& route : routes) {
+    if (route.uri == path && (route.method == HTTP_ANY || route.method == pending->request.method)) {
+      route.fn();
+      handled = true;
+      break;
+    }
+  }
+  if (!handled && notFound) notFound();
+  if (!pending->response.code) pending->response.code = 500;
+  pending->done = true;
+  current = nullptr;
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+  if (!current) return;
+  current->response.code = code;
+  current->response.contentType = contentType ? contentType : "";
+  current->response.body = content.c_str();
+}
+
+String WebServer::uri() {
+  return String(current ? current->request.uri.c_str() : "");
+}
+
+HTTPMethod WebServer::method() {
+  return current ? current->request.method : HTTP_GET;
+}
+
+String WebServer::arg(const String& name) {
+  if (!current) return String();
+  if (name == "plain") return String(current->request.body.c_str());
+  const std::string& uri = current->request.uri;
+  std::string key = std::string(name.c_str()) + "=";
+  size_t q = uri.find('?');
+  while (q != std::string::npos) {
+    size_t start = q + 1;
+    size_t end = uri.find('&', start);
+    if (uri.compare(start, key.size(), key) == 0) {
+      return String(uri.substr(start + key.size(), end == std::string::npos ? std::string::npos : end - start - key.size()).c_str());
+    }
+    q = end;
+  }
+  return String();
+}
+
+bool WebServer::hasArg(const String& name) {
+  return name == "plain" ? current && !current->request.body.empty() : arg(name).length() > 0;
+}
+
+static std::string lowered(const String& s) {
+  std::string out = s.c_str();
+  for (char& c : out) c = tolower((unsigned char)c);
+  return out;
+}
+
+String WebServer::header(const String& name) {
+  if (!current) return String();
+  for (const auto& h : current->request.headers) {
+    std::string key = h.first;
+    for (char& c : key) c = tolower((unsigned char)c);
+    if (key == lowered(name)) return String(h.second.c_str());
+  }
+  return String();
+}
+
+bool WebServer::hasHeader(const String& name) {
+  return header(name).length() > 0;
+}
+
+static bool isDone(void* ctx) {
+  return static_cast<WebServer::Pending*>(ctx)->done;
+}
+
+host::WebResponse host::webRequest(uint16_t port, const WebRequest& request, uint32_t timeoutMs) {
+  for (WebServer* server : listeners()) {
+    if (server->port() != port) continue;
+    host::OffDevice offDevice;
+    WebServer::Pending pending;
+    pending.request = request;
+    server->enqueue(&pending);
+    host::blockUntil(host::nowMicros() + (uint64_t)timeoutMs * 1000, isDone, &pending);
+    if (pending.done) return pending.response;
+    server->cancel(&pending);
+    return WebResponse();
+  }
+  return WebResponse();
+}
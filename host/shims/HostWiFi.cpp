@@ -0,0 +1,83 @@
+#include <WiFi.h>
+#include <WiFiManager.h>
+#include "HostRuntime.h"
+
+WiFiClass WiFi;
+
+static bool associating = false;
+static uint64_t connectedAtMicros = 0;
+
+host::WifiNetwork& host::wifi() {
+  static WifiNetwork network;
+  return network;
+}
+
+void host::resetWifi() {
+  wifi() = WifiNetwork();
+  associating = false;
+}
+
+wl_status_t WiFiClass::begin() {
+  associating = true;
+  connectedAtMicros = host::nowMicros() + (uint64_t)host::wifi().connectDelayMs * 1000;
+  return WL_DISCONNECTED;
+}
+
+wl_status_t WiFiClass::begin(const char*, const char*) {
+  return begin();
+}
+
+wl_status_t WiFiClass::status() {
+  if (!associating) return WL_IDLE_STATUS;
+  if (!host::wifi().available) return WL_NO_SSID_AVAIL;
+  return host::nowMicros() >= connectedAtMicros ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+bool WiFiClass::disconnect(bool) {
+  associating = false;
+  return true;
+}
+
+String WiFiClass::SSID() {
+  return status() == WL_CONNECTED ? String(host::wifi().ssid.c_str()) : String();
+}
+
+const uint8_t* WiFiClass::BSSID() {
+  return host::wifi().bssid;
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+  memcpy(mac, host::wifi().mac, 6);
+  return mac;
+}
+
+String WiFiClass::macAddress() {
+  const uint8_t* m = host::wifi().mac;
+  char buf[18];
+  snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", m[0], m[1], m[2], m[3], m[4], m[5]);
+  return String(buf);
+}
+
+int8_t WiFiClass::RSSI() {
+  return status() == WL_CONNECTED ? host::wifi().rssi : 0;
+}
+
+IPAddress WiFiClass::localIP() {
+  return status() == WL_CONNECTED ? host::wifi().ip : IPAddress();
+}
+
+bool WiFiClass::setSleep(wifi_ps_type_t type) {
+  if (type != host::wifi().powerSave) host::wifi().sleepChanges++;
+  host::wifi().powerSave = type;
+  return true;
+}
+
+wifi_ps_type_t WiFiClass::getSleep() {
+  return host::wifi().powerSave;
+}
+
+// The captive portal never gets a visitor on the host: it times out like an abandoned setup
+bool WiFiManager::startConfigPortal(const char*) {
+  host::blockUntil(host::nowMicros() + (uint64_t)(timeoutSec ? timeoutSec : 180) * 1000000ULL);
+  return false;
+}
@@ -0,0 +1,18 @@
+// IPAddress.h
+#pragma once
+
+#include "WString.h"
+
+class IPAddress {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets{a, b, c, d} {}
+  uint8_t operator[](int i) const { return octets[i]; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buf);
+  }
+
+private:
+  uint8_t octets[4];
+};
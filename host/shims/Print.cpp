@@ -0,0 +1,71 @@
+#include <Arduino.h>
+
+size_t Print::write(const uint8_t* data, size_t len) {
+  size_t n = 0;
+  while (len--) n += write(*data++);
+  return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  size_t n = vprintf(format, args);
+  va_end(args);
+  return n;
+}
+
+size_t Print::vprintf(const char* format, va_list args) {
+  char local[256];
+  va_list copy;
+  va_copy(copy, args);
+  int len = vsnprintf(local, sizeof(local), format, copy);
+  va_end(copy);
+  if (len < 0) return 0;
+  if ((size_t)len < sizeof(local)) return write((const uint8_t*)local, len);
+
+  char* heap = (char*)malloc(len + 1);  // Same as the ESP32 core: only long lines touch the heap
+  if (!heap) return 0;
+  vsnprintf(heap, len + 1, format, args);
+  size_t n = write((const uint8_t*)heap, len);
+  free(heap);
+  return n;
+}
+
+size_t Print::print(long v, int base) {
+  char text[24];
+  snprintf(text, sizeof(text), base == HEX ? "%lx" : "%ld", v);
+  return write(text);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char text[24];
+  snprintf(text, sizeof(text), base == HEX ? "%lx" : "%lu", v);
+  return write(text);
+}
+
+int Stream::timedRead() {
+  unsigned long start = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    delay(1);
+  } while (millis() - start < timeoutMs);
+  return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t n = 0;
+  while (n < length) {
+    int c = timedRead();
+    if (c < 0) break;
+    buffer[n++] = (char)c;
+  }
+  return n;
+}
+
+String Stream::readString() {
+  String out;
+  int c;
+  while ((c = timedRead()) >= 0) out += (char)c;
+  return out;
+}
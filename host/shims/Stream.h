@@ -0,0 +1,21 @@
+// Stream.h
+#pragma once
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long ms) { timeoutMs = ms; }
+  unsigned long getTimeout() const { return timeoutMs; }
+  virtual size_t readBytes(char* buffer, size_t length);
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+  String readString();
+
+protected:
+  int timedRead();
+  unsigned long timeoutMs = 1000;
+};
@@ -0,0 +1,30 @@
+// Update.h
+#pragma once
+
+#include <Arduino.h>
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+
+// Writes the image into the inactive app partition of the host flash model (HostFlash.h)
+class UpdateClass {
+public:
+  bool begin(size_t size = UPDATE_SIZE_UNKNOWN);
+  size_t write(uint8_t* data, size_t len);
+  bool end(bool evenIfRemaining = false);
+  void abort();
+  bool isRunning() const { return running; }
+  bool hasError() const { return error != 0; }
+  uint8_t getError() const { return error; }
+  const char* errorString() const { return error ? "Flash Write Failed" : "No Error"; }
+  size_t progress() const { return written; }
+  size_t size() const { return expected; }
+  size_t remaining() const { return expected - written; }
+
+private:
+  bool running = false;
+  uint8_t error = 0;
+  size_t expected = 0;
+  size_t written = 0;
+};
+
+extern UpdateClass Update;
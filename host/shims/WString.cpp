@@ -0,0 +1,170 @@
+#include "WString.h"
+#include <ctype.h>
+#include <stdio.h>
+
+static String formatInteger(unsigned long long magnitude, bool negative, unsigned char base) {
+  char digits[72];
+  char* p = digits + sizeof(digits);
+  *--p = '\0';
+  do {
+    unsigned d = magnitude % base;
+    *--p = d < 10 ? '0' + d : 'a' + d - 10;
+    magnitude /= base;
+  } while (magnitude);
+  if (negative) *--p = '-';
+  return String(p);
+}
+
+String::String(int v, unsigned char base) : String((long long)v, base) {}
+String::String(unsigned int v, unsigned char base) : String((unsigned long long)v, base) {}
+String::String(long v, unsigned char base) : String((long long)v, base) {}
+String::String(unsigned long v, unsigned char base) : String((unsigned long long)v, base) {}
+
+String::String(long long v, unsigned char base) {
+  bool negative = v < 0 && base == 10;
+  unsigned long long magnitude = negative ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+  *this = formatInteger(magnitude, negative, base);
+}
+
+String::String(unsigned long long v, unsigned char base) { *this = formatInteger(v, false, base); }
+
+String::String(double v, unsigned int decimals) {
+  char text[64];
+  snprintf(text, sizeof(text), "%.*f", (int)decimals, v);
+  assign(text, strlen(text));
+}
+
+String& String::operator=(String&& s) noexcept {
+  if (this != &s) {
+    free(buf);
+    buf = s.buf;
+    len = s.len;
+    cap = s.cap;
+    s.buf = nullptr;
+    s.len = s.cap = 0;
+  }
+  return *this;
+}
+
+bool String::reserve(size_t n) {
+  if (n <= cap && buf) return true;
+  char* grown = (char*)realloc(buf, n + 1);
+  if (!grown) return false;
+  if (!buf) grown[0] = '\0';
+  buf = grown;
+  cap = n;
+  return true;
+}
+
+void String::assign(const char* s, size_t n) {
+  if (n == 0) {
+    len = 0;
+    if (buf) buf[0] = '\0';
+    return;
+  }
+  if (!reserve(n)) return;
+  memmove(buf, s, n);
+  buf[n] = '\0';
+  len = n;
+}
+
+char& String::operator[](size_t i) {
+  static char dummy;
+  if (i >= len) return dummy = 0, dummy;
+  return buf[i];
+}
+
+bool String::concat(const char* s, size_t n) {
+  if (n == 0) return true;
+  if (!reserve(len + n)) return false;
+  memmove(buf + len, s, n);
+  len += n;
+  buf[len] = '\0';
+  return true;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  if (from >= len) return -1;
+  const char* hit = strchr(c_str() + from, c);
+  return hit ? hit - c_str() : -1;
+}
+
+int String::indexOf(const String& s, unsigned int from) const {
+  if (from > len) return -1;
+  const char* hit = strstr(c_str() + from, s.c_str());
+  return hit ? hit - c_str() : -1;
+}
+
+int String::lastIndexOf(char c) const {
+  const char* hit = strrchr(c_str(), c);
+  return hit ? hit - c_str() : -1;
+}
+
+int String::lastIndexOf(const String& s) const {
+  if (s.len > len) return -1;
+  for (int i = len - s.len; i >= 0; i--) {
+    if (strncmp(c_str() + i, s.c_str(), s.len) == 0) return i;
+  }
+  return -1;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) {
+    unsigned int swap = from;
+    from = to;
+    to = swap;
+  }
+  if (from >= len) return String();
+  if (to > len) to = len;
+  return String(c_str() + from, to - from);
+}
+
+void String::replace(const String& find, const String& with) {
+  if (find.len == 0 || len == 0) return;
+  String out;
+  const char* p = c_str();
+  while (const char* hit = strstr(p, find.c_str())) {
+    out.concat(p, hit - p);
+    out.concat(with);
+    p = hit + find.len;
+  }
+  out.concat(p);
+  *this = static_cast<String&&>(out);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= len) return;
+  if (count > len - index) count = len - index;
+  memmove(buf + index, buf + index + count, len - index - count + 1);
+  len -= count;
+}
+
+void String::toLowerCase() {
+  for (size_t i = 0; i < len; i++) buf[i] = tolower((unsigned char)buf[i]);
+}
+
+void String::toUpperCase() {
+  for (size_t i = 0; i < len; i++) buf[i] = toupper((unsigned char)buf[i]);
+}
+
+void String::trim() {
+  if (len == 0) return;
+  size_t start = 0, end = len;
+  while (start < end && isspace((unsigned char)buf[start])) start++;
+  while (end > start && isspace((unsigned char)buf[end - 1])) end--;
+  memmove(buf, buf + start, end - start);
+  len = end - start;
+  buf[len] = '\0';
+}
+
+String operator+(const String& a, const String& b) {
+  String out;
+  out.reserve(a.length() + b.length());
+  out.concat(a);
+  out.concat(b);
+  return out;
+}
+
+String operator+(const String& a, const char* b) { return a + String(b); }
+String operator+(const char* a, const String& b) { return String(a) + b; }
+String operator+(const String& a, char b) { return a + String(b); }
@@ -0,0 +1,90 @@
+// WString.h
+#pragma once
+
+// Arduino String for the host build. Heap-backed with no small-string buffer, so every String the
+// firmware builds shows up in the allocation counters.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+class String {
+public:
+  String() {}
+  String(const char* s) { assign(s, s ? strlen(s) : 0); }
+  String(const char* s, size_t n) { assign(s, n); }
+  String(const String& s) { assign(s.buf, s.len); }
+  String(String&& s) noexcept : buf(s.buf), len(s.len), cap(s.cap) { s.buf = nullptr; s.len = s.cap = 0; }
+  explicit String(char c) { assign(&c, 1); }
+  explicit String(int v, unsigned char base = 10);
+  explicit String(unsigned int v, unsigned char base = 10);
+  explicit String(long v, unsigned char base = 10);
+  explicit String(unsigned long v, unsigned char base = 10);
+  explicit String(long long v, unsigned char base = 10);
+  explicit String(unsigned long long v, unsigned char base = 10);
+  explicit String(float v, unsigned int decimals = 2) : String((double)v, decimals) {}
+  explicit String(double v, unsigned int decimals = 2);
+  ~String() { free(buf); }
+
+  String& operator=(const String& s) { if (this != &s) assign(s.buf, s.len); return *this; }
+  String& operator=(String&& s) noexcept;
+  String& operator=(const char* s) { assign(s, s ? strlen(s) : 0); return *this; }
+
+  const char* c_str() const { return buf ? buf : ""; }
+  size_t length() const { return len; }
+  bool isEmpty() const { return len == 0; }
+  bool reserve(size_t n);
+  char charAt(size_t i) const { return i < len ? buf[i] : 0; }
+  char operator[](size_t i) const { return charAt(i); }
+  char& operator[](size_t i);
+
+  bool concat(const char* s, size_t n);
+  bool concat(const char* s) { return concat(s, s ? strlen(s) : 0); }
+  bool concat(const String& s) { return concat(s.buf, s.len); }
+  bool concat(char c) { return concat(&c, 1); }
+  template <typename T> bool concat(T v) { return concat(String(v)); }
+  template <typename T> String& operator+=(const T& v) { concat(v); return *this; }
+
+  int compareTo(const String& s) const { return strcmp(c_str(), s.c_str()); }
+  bool equals(const char* s) const { return strcmp(c_str(), s ? s : "") == 0; }
+  bool equalsIgnoreCase(const String& s) const { return strcasecmp(c_str(), s.c_str()) == 0; }
+  bool operator==(const String& s) const { return len == s.len && equals(s.c_str()); }
+  bool operator==(const char* s) const { return equals(s); }
+  bool operator!=(const String& s) const { return !(*this == s); }
+  bool operator!=(const char* s) const { return !equals(s); }
+  bool operator<(const String& s) const { return compareTo(s) < 0; }
+  bool startsWith(const String& prefix) const { return len >= prefix.len && strncmp(c_str(), prefix.c_str(), prefix.len) == 0; }
+  bool endsWith(const String& suffix) const { return len >= suffix.len && strcmp(c_str() + len - suffix.len, suffix.c_str()) == 0; }
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String& s, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  int lastIndexOf(const String& s) const;
+  String substring(unsigned int from) const { return substring(from, len); }
+  String substring(unsigned int from, unsigned int to) const;
+
+  void replace(const String& find, const String& with);
+  void remove(unsigned int index, unsigned int count = (unsigned int)-1);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+  long toInt() const { return atol(c_str()); }
+  float toFloat() const { return (float)atof(c_str()); }
+  double toDouble() const { return atof(c_str()); }
+
+private:
+  void assign(const char* s, size_t n);
+
+  char* buf = nullptr;
+  size_t len = 0;
+  size_t cap = 0;
+};
+
+String operator+(const String& a, const String& b);
+String operator+(const String& a, const char* b);
+String operator+(const char* a, const String& b);
+String operator+(const String& a, char b);
+template <typename T> String operator+(const String& a, T b) { return a + String(b); }
+inline bool operator==(const char* a, const String& b) { return b == a; }
+inline bool operator!=(const char* a, const String& b) { return b != a; }
@@ -0,0 +1,84 @@
+// WebServer.h
+#pragma once
+
+// Host WebServer: requests come from host::webRequest() instead of a socket. handleClient() parks
+// the calling task until one is queued, so the server task costs nothing while idle.
+
+#include <Arduino.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+namespace host {
+
+struct WebRequest {
+  HTTPMethod method = HTTP_GET;
+  std::string uri;                                // May carry ?name=value pairs
+  std::string body;
+  std::map<std::string, std::string> headers;
+};
+
+struct WebResponse {
+  int code = 0;
+  std::string contentType;
+  std::string body;
+};
+
+// Delivers a request to the WebServer listening on `port` and waits (on the virtual clock) until
+// it has been answered. Returns code 0 if nothing is listening or no answer came within timeoutMs.
+WebResponse webRequest(uint16_t port, const WebRequest& request, uint32_t timeoutMs = 5000);
+
+}  // namespace host
+
+class WebServer {
+public:
+  using THandlerFunction = std::function<void(void)>;
+
+  explicit WebServer(int port = 80);
+  ~WebServer();
+
+  void begin();
+  void stop();
+  void on(const String& uri, HTTPMethod method, THandlerFunction fn);
+  void on(const String& uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+  void onNotFound(THandlerFunction fn) { notFound = fn; }
+  void handleClient();
+
+  void send(int code, const char* contentType = nullptr, const String& content = String());
+  void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+  void sendHeader(const String& name, const String& value, bool first = false) { (void)name; (void)value; (void)first; }
+
+  String arg(const String& name);
+  bool hasArg(const String& name);
+  String header(const String& name);
+  bool hasHeader(const String& name);
+  void collectHeaders(const char* keys[], size_t count) { (void)keys; (void)count; }  // All headers are kept
+  String uri();
+  HTTPMethod method();
+
+  // Host plumbing
+  struct Pending {
+    host::WebRequest request;
+    host::WebResponse response;
+    bool done = false;
+  };
+  void enqueue(Pending* pending) { queue.push_back(pending); }
+  void cancel(Pending* pending);
+  uint16_t port() const { return listenPort; }
+
+private:
+  struct Route {
+    std::string uri;
+    HTTPMethod method;
+    THandlerFunction fn;
+  };
+  std::vector<Route> routes;
+  THandlerFunction notFound;
+  std::vector<Pending*> queue;
+  Pending* current = nullptr;
+  uint16_t listenPort;
+  bool listening = false;
+};
@@ -0,0 +1,51 @@
+// WiFi.h
+#pragma once
+
+#include <Arduino.h>
+#include <string>
+#include "IPAddress.h"
+
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4, WL_DISCONNECTED = 6 } wl_status_t;
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+typedef enum { WIFI_PS_NONE = 0, WIFI_PS_MIN_MODEM = 1, WIFI_PS_MAX_MODEM = 2 } wifi_ps_type_t;
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t) { return true; }
+  wl_status_t begin();
+  wl_status_t begin(const char* ssid, const char* password = nullptr);
+  wl_status_t status();
+  bool disconnect(bool wifiOff = false);
+  String SSID();
+  const uint8_t* BSSID();
+  uint8_t* macAddress(uint8_t* mac);
+  String macAddress();
+  int8_t RSSI();
+  IPAddress localIP();
+  bool setSleep(bool enabled) { return setSleep(enabled ? WIFI_PS_MIN_MODEM : WIFI_PS_NONE); }
+  bool setSleep(wifi_ps_type_t type);
+  wifi_ps_type_t getSleep();
+};
+
+extern WiFiClass WiFi;
+
+namespace host {
+
+// The network the device sees. begin() associates after connectDelayMs of virtual time if the
+// saved credentials are valid.
+struct WifiNetwork {
+  bool available = true;
+  std::string ssid = "HomeNet";
+  uint8_t bssid[6] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+  uint8_t mac[6] = {0x24, 0x6f, 0x28, 0xa1, 0xb2, 0xc3};
+  int8_t rssi = -58;
+  IPAddress ip = IPAddress(192, 168, 1, 42);
+  uint32_t connectDelayMs = 1200;
+  int sleepChanges = 0;
+  wifi_ps_type_t powerSave = WIFI_PS_MIN_MODEM;  // The core's default once associated
+};
+
+WifiNetwork& wifi();
+void resetWifi();
+
+}  // namespace host
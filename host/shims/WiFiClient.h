@@ -0,0 +1,33 @@
+// WiFiClient.h
+#pragma once
+
+#include <Arduino.h>
+#include <string>
+
+// Response body of a host HTTP request. Bytes arrive bytesPerMs at a time on the virtual clock
+// and the connection closes after dropAfter bytes, which is how tests cut a download short.
+class WiFiClient : public Stream {
+public:
+  void load(const std::string& body, size_t dropAfter, uint32_t bytesPerMs);
+  void stop() { open = false; }
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  int read(uint8_t* buf, size_t len);
+  using Stream::readBytes;
+  uint8_t connected();
+  operator bool() { return connected(); }
+  using Print::write;
+  size_t write(uint8_t) override { return 1; }
+
+private:
+  size_t arrived();
+
+  std::string body;
+  size_t pos = 0;
+  size_t limit = 0;
+  uint32_t bytesPerMs = 0;
+  uint64_t startMicros = 0;
+  bool open = false;
+};
@@ -0,0 +1,21 @@
+// WiFiManager.h
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+class WiFiManager {
+public:
+  void setConnectTimeout(unsigned long seconds) { timeoutSec = seconds; }
+  void setConfigPortalTimeout(unsigned long seconds) { timeoutSec = seconds; }
+  bool startConfigPortal(const char* apName);
+  void resetSettings() { resets++; }
+  void setMenu(std::vector<const char*>& menu) { (void)menu; }
+  void setMenu(const std::vector<const char*>& menu) { (void)menu; }
+  void setTitle(const String& title) { (void)title; }
+  void setCustomHeadElement(const char* html) { (void)html; }
+  void setCustomMenuHTML(const char* html) { (void)html; }
+
+  int resets = 0;
+  unsigned long timeoutSec = 0;
+};
@@ -0,0 +1,49 @@
+// Wire.h
+#pragma once
+
+#include <Arduino.h>
+
+namespace host {
+
+// A simulated I2C peripheral. Addresses with nothing attached NACK like an empty bus.
+class I2cDevice {
+public:
+  virtual ~I2cDevice() = default;
+  virtual void onWrite(const uint8_t* data, size_t len) { (void)data; (void)len; }
+  virtual size_t onRead(uint8_t* buf, size_t len) = 0;
+};
+
+void attachI2c(uint8_t address, I2cDevice* device);
+void detachI2cDevices();
+
+}  // namespace host
+
+class TwoWire : public Stream {
+public:
+  bool begin() { return true; }
+  bool begin(int sda, int scl, uint32_t frequency = 0) { (void)sda; (void)scl; (void)frequency; return true; }
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+
+  using Print::write;
+  size_t write(uint8_t b) override;
+  size_t write(int n) { return write((uint8_t)n); }
+  size_t write(unsigned int n) { return write((uint8_t)n); }
+  size_t write(long n) { return write((uint8_t)n); }
+  size_t write(unsigned long n) { return write((uint8_t)n); }
+  int available() override { return rxLen - rxPos; }
+  int read() override { return rxPos < rxLen ? rx[rxPos++] : -1; }
+  int peek() override { return rxPos < rxLen ? rx[rxPos] : -1; }
+
+private:
+  uint8_t target = 0;
+  uint8_t tx[32];
+  uint8_t txLen = 0;
+  uint8_t rx[32];
+  uint8_t rxLen = 0;
+  uint8_t rxPos = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,9 @@
+// esp32-hal-cpu.h
+#pragma once
+
+#include <stdint.h>
+
+bool setCpuFrequencyMhz(uint32_t mhz);
+uint32_t getCpuFrequencyMhz();
+uint32_t getXtalFrequencyMhz();
+uint32_t getApbFrequency();
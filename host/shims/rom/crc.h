@@ -0,0 +1,7 @@
+// crc.h
+#pragma once
+
+#include <stdint.h>
+
+// ESP32 ROM CRC-32 (IEEE, reflected); crc32_le(0, buf, len) is the standard zlib CRC
+uint32_t crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
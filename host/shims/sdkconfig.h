@@ -0,0 +1,8 @@
+// sdkconfig.h
+#pragma once
+
+// The few ESP-IDF options the sketch checks, as the host build configures them
+
+#define CONFIG_FREERTOS_HZ 1000
+#define CONFIG_SPI_FLASH_SIZE (8 * 1024 * 1024)
+#define CONFIG_HEAP_USE_HOOKS 1
@@ -0,0 +1,148 @@
+// Runs the whole sketch for days of virtual time against the service stand-ins and reports what a
+// bench board would take days to show: requests per endpoint per simulated day, and how the loop's
+// CPU time and the heap move hour by hour.
+//
+//   novaframe_sim [--days N] [--hourly] [--serial]
+
+#include <Firebase_ESP_Client.h>
+#include <HTTPClient.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include "DeviceRegistration.h"
+#include "HostRuntime.h"
+#include "StandIns.h"
+
+void loop();
+
+#define SIM_HOUR_US (3600ULL * 1000000ULL)
+#define SIM_DAY_US (24ULL * SIM_HOUR_US)
+
+// The rotation a set-up frame usually runs, so the weather apps drive their fetches; the first app
+// poll after boot picks it up
+#define SIM_APPS \
+  R"({"clock":{"enabled":true},"clockWeather":{"enabled":true},"weather":{"enabled":true},"forecast":{"enabled":true}})"
+
+struct Service {
+  const char* name;
+  const char* host;  // nullptr: the RTDB
+};
+
+static const Service SERVICES[] = {
+  { "openweather", "api.openweathermap.org" },
+  { "ipgeolocation", "api.ipgeolocation.io" },
+  { "ipApi", "ip-api.com" },
+  { "ipify", "api.ipify.org" },
+  { "githubPages", STANDIN_OTA_HOST },
+  { "rtdbRead", nullptr },
+  { "rtdbWrite", nullptr },
+};
+#define SERVICE_COUNT (sizeof(SERVICES) / sizeof(SERVICES[0]))
+
+static uint32_t requestTotal(size_t i) {
+  if (SERVICES[i].host) return host::httpRequestCount(SERVICES[i].host);
+  return strcmp(SERVICES[i].name, "rtdbRead") == 0 ? host::rtdb().reads : host::rtdb().writes;
+}
+
+static double threadCpuMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+struct Hour {
+  double cpuMs = 0;          // Host CPU spent inside loop(), stand-in servers included
+  uint32_t passes = 0;
+  size_t minFreeHeap = host::DEVICE_HEAP_BYTES;
+  size_t freeHeap = 0;       // At the end of the hour
+  int64_t liveBlocks = 0;
+};
+
+static void usage() {
+  fprintf(stderr, "usage: novaframe_sim [--days N] [--hourly] [--serial]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int days = 3;
+  bool hourly = false;
+  bool serial = false;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--days") && i + 1 < argc) days = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--hourly")) hourly = true;
+    else if (!strcmp(argv[i], "--serial")) serial = true;
+    else usage();
+  }
+  if (days < 1) usage();
+
+  host::setSerialEcho(serial);
+  bool restarted = false;
+  host::onRestart([&] { restarted = true; });
+  host::resetHeapBaseline();
+  host::bootDevice();
+  host::rtdb().seed((std::string("/novaFrame/devices/") + getMacId() + "/apps").c_str(), SIM_APPS);
+
+  uint64_t endUs = (uint64_t)days * SIM_DAY_US;
+  std::vector<Hour> hours(days * 24);
+  std::vector<uint32_t> perDay(days * SERVICE_COUNT);
+  uint32_t dayStart[SERVICE_COUNT];
+  for (size_t i = 0; i < SERVICE_COUNT; i++) dayStart[i] = 0;  // Boot traffic counts towards day 1
+
+  int day = 0;
+  while (host::nowMicros() < endUs && !restarted) {
+    double cpu = threadCpuMs();
+    loop();
+    Hour& hour = hours[std::min<uint64_t>(host::nowMicros() / SIM_HOUR_US, hours.size() - 1)];
+    hour.cpuMs += threadCpuMs() - cpu;
+    hour.passes++;
+    hour.freeHeap = host::modelledFreeHeap();
+    hour.minFreeHeap = std::min(hour.minFreeHeap, hour.freeHeap);
+    hour.liveBlocks = host::heapCounters().liveBlocks;
+
+    while (day < days && host::nowMicros() >= (uint64_t)(day + 1) * SIM_DAY_US) {
+      for (size_t i = 0; i < SERVICE_COUNT; i++) {
+        uint32_t total = requestTotal(i);
+        perDay[day * SERVICE_COUNT + i] = total - dayStart[i];
+        dayStart[i] = total;
+      }
+      day++;
+    }
+  }
+  if (restarted) printf("⚠️ Device restarted at %.1f h; stopping early\n", host::nowMicros() / (double)SIM_HOUR_US);
+
+  printf("\nRequests per simulated day\n%-14s", "endpoint");
+  for (int d = 0; d < day; d++) printf(" %8s%-2d", "day ", d + 1);
+  printf("\n");
+  for (size_t i = 0; i < SERVICE_COUNT; i++) {
+    printf("%-14s", SERVICES[i].name);
+    for (int d = 0; d < day; d++) printf(" %10lu", (unsigned long)perDay[d * SERVICE_COUNT + i]);
+    printf("\n");
+  }
+
+  // A day's row: CPU per pass and heap at its end; a leak shows as free heap falling day over day
+  printf("\n%-6s %12s %12s %12s %12s %12s\n", "day", "passes", "cpu ms", "us/pass", "min free", "live blocks");
+  for (int d = 0; d < day; d++) {
+    Hour total;
+    for (int h = d * 24; h < (d + 1) * 24; h++) {
+      total.cpuMs += hours[h].cpuMs;
+      total.passes += hours[h].passes;
+      total.minFreeHeap = std::min(total.minFreeHeap, hours[h].minFreeHeap);
+      if (hours[h].passes) total.liveBlocks = hours[h].liveBlocks;
+    }
+    printf("%-6d %12lu %12.1f %12.2f %12lu %12lld\n", d + 1, (unsigned long)total.passes, total.cpuMs,
+           total.passes ? total.cpuMs * 1000.0 / total.passes : 0.0, (unsigned long)total.minFreeHeap,
+           (long long)total.liveBlocks);
+  }
+
+  if (hourly) {
+    printf("\n%-6s %12s %12s %12s %12s\n", "hour", "passes", "cpu ms", "free heap", "live blocks");
+    for (size_t h = 0; h < hours.size() && h < (size_t)day * 24; h++) {
+      printf("%-6zu %12lu %12.2f %12lu %12lld\n", h, (unsigned long)hours[h].passes, hours[h].cpuMs,
+             (unsigned long)hours[h].freeHeap, (long long)hours[h].liveBlocks);
+    }
+  }
+  return restarted ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <Wire.h>
+#include "AmbientLight.h"
+#include "DeviceRegistration.h"
+#include "DisplayHelpers.h"
+#include "HostRuntime.h"
+#include "LoopScheduler.h"
+#include "StandIns.h"
+
+void loop();
+
+#define LEVEL_2_SCALE 51   // round(2 * 25.5)
+#define LEVEL_9_SCALE 230
+
+// A BH1750 in continuous high-resolution mode: two bytes, big-endian, 1.2 counts per lux
+class SimulatedBh1750 : public host::I2cDevice {
+public:
+  float lux = 300;
+  size_t onRead(uint8_t* buf, size_t len) override {
+    uint16_t raw = (uint16_t)constrain(lux * 1.2f, 0.0f, 65535.0f);
+    if (len > 0) buf[0] = raw >> 8;
+    if (len > 1) buf[1] = raw & 0xFF;
+    return len < 2 ? len : 2;
+  }
+};
+
+// Controller alone, one sample per step
+static uint8_t settle(BrightnessController& controller, float lux, int samples = 40) {
+  uint8_t scale = 0;
+  for (int i = 0; i < samples; i++) scale = controller.update(lux);
+  return scale;
+}
+
+TEST(BrightnessControllerTest, EndsOfTheLuxRangeMapToTheConfiguredLevels) {
+  BrightnessController controller;
+  controller.configure(2, 9);
+  EXPECT_EQ(LEVEL_2_SCALE, controller.update(0.1f));
+  controller.reset();
+  EXPECT_EQ(LEVEL_9_SCALE, controller.update(50000));
+}
+
+TEST(BrightnessControllerTest, BrighterRoomsNeverDimThePanel) {
+  BrightnessController controller;
+  uint8_t previous = 0;
+  for (float lux = 1; lux <= 2000; lux *= 1.5f) {
+    controller.reset();
+    uint8_t scale = controller.update(lux);
+    EXPECT_GE(scale, previous) << lux << " lux";
+    previous = scale;
+  }
+}
+
+TEST(BrightnessControllerTest, FlickerAroundALevelDoesntMoveIt) {
+  BrightnessController controller;
+  uint8_t steady = settle(controller, 40);
+  for (int i = 0; i < 200; i++) EXPECT_EQ(steady, controller.update(i % 2 ? 34.0f : 46.0f)) << "sample " << i;
+}
+
+TEST(BrightnessControllerTest, ASingleFlashIsDampedAndForgotten) {
+  BrightnessController controller, unfiltered;
+  uint8_t steady = settle(controller, 20);
+  uint8_t flashed = controller.update(5000);  // A torch across the sensor for one sample
+  EXPECT_LT(flashed, unfiltered.update(5000));
+  EXPECT_NEAR(steady, settle(controller, 20), AMBIENT_HYSTERESIS * 25.5f);  // Back within the dead band
+}
+
+TEST(BrightnessControllerTest, FollowsARoomGoingDark) {
+  BrightnessController controller;
+  uint8_t day = settle(controller, 800);
+  uint8_t night = settle(controller, 0.5f);
+  EXPECT_GT(day, night);
+  EXPECT_EQ(26, night);  // Level 1 by default
+}
+
+// The whole loop against the simulated sensor and the device settings in the RTDB
+class AmbientLightTest : public testing::Test {
+protected:
+  SimulatedBh1750 sensor;
+  std::string settings;
+
+  void SetUp() override {
+    host::detachI2cDevices();
+    host::attachI2c(0x23, &sensor);
+    host::bootDevice();  // setup() probes the bus and finds the sensor
+    settings = std::string("/novaFrame/devices/") + getMacId() + "/settings";
+    host::rtdb().seed((settings + "/autoBrightness").c_str(), "true");
+    host::rtdb().seed((settings + "/brightnessMin").c_str(), "2");
+    host::rtdb().seed((settings + "/brightnessMax").c_str(), "9");
+  }
+
+  void TearDown() override { host::detachI2cDevices(); }
+
+  void runFor(unsigned long ms) {
+    unsigned long until = millis() + ms;
+    while (millis() < until) loop();
+  }
+};
+
+TEST_F(AmbientLightTest, TracksTheRoomWithinTheConfiguredLevels) {
+  sensor.lux = 20000;
+  runFor(5000);
+  ASSERT_TRUE(ambientLight.isActive());
+  EXPECT_EQ(LEVEL_9_SCALE, getBrightnessScale());
+
+  sensor.lux = 0.5f;  // Lights off
+  runFor(60000);
+  EXPECT_EQ(LEVEL_2_SCALE, getBrightnessScale());
+}
+
+TEST_F(AmbientLightTest, ManualLevelReturnsWhenAutoBrightnessIsTurnedOff) {
+  host::rtdb().seed((settings + "/brightness").c_str(), "6");
+  sensor.lux = 0.5f;
+  runFor(30000);
+  ASSERT_EQ(LEVEL_2_SCALE, getBrightnessScale());
+
+  host::rtdb().seed((settings + "/autoBrightness").c_str(), "false");
+  runFor(AMBIENT_SETTINGS_POLL_MS + 5000);
+  EXPECT_FALSE(ambientLight.isActive());
+  EXPECT_EQ(brightnessLevelToScale(6), getBrightnessScale());
+}
+
+TEST_F(AmbientLightTest, NoSensorStaysInactive) {
+  host::detachI2cDevices();
+  AmbientLight unfitted;
+  unfitted.begin();
+  unfitted.update();
+  EXPECT_FALSE(unfitted.isActive());
+  EXPECT_EQ((unsigned long)LOOP_MAX_IDLE_MS, unfitted.msUntilNextSample());
+}
+
+TEST_F(AmbientLightTest, FailedSettingsReadKeepsTrackingTheRoom) {
+  sensor.lux = 0.5f;
+  runFor(30000);
+  ASSERT_TRUE(ambientLight.isActive());
+  ASSERT_EQ(LEVEL_2_SCALE, getBrightnessScale());
+
+  host::rtdb().setOnline(false);
+  runFor(AMBIENT_SETTINGS_POLL_MS + 5000);
+  EXPECT_TRUE(ambientLight.isActive());
+  EXPECT_EQ(LEVEL_2_SCALE, getBrightnessScale()) << "fell back to the manual level or the 1–10 range";
+}
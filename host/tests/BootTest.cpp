@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <Firebase_ESP_Client.h>
+#include <string>
+#include "DeviceRegistration.h"
+#include "HostRuntime.h"
+#include "StandIns.h"
+#include "TimeCache.h"
+
+void setup();
+void loop();
+extern TimeCache timeCache;
+extern float storedLat;
+extern float storedLon;
+extern char storedTimezone[];
+
+// The whole sketch booting while the Firebase token takes longer than setup() waits for it
+class BootTest : public testing::Test {
+protected:
+  void bootWithTokenDelay(uint32_t ms) {
+    host::provisionDevice();
+    host::serveCloud();
+    host::rtdb().setTokenDelayMs(ms);
+    setup();
+  }
+
+  void runUntil(unsigned long ms) {
+    while (millis() < ms) loop();
+  }
+
+  const host::JsonValue* setting(const char* field) {
+    return host::rtdb().find((std::string("/novaFrame/devices/") + getMacId() + "/settings/" + field).c_str());
+  }
+};
+
+TEST_F(BootTest, SlowTokenRegistersAndSyncsFromTheLoop) {
+  bootWithTokenDelay(FIREBASE_READY_TIMEOUT_MS + 10000);
+  ASSERT_FALSE(Firebase.ready()) << "setup() outwaited the token";
+  EXPECT_FALSE(timeCache.isSynced());
+  EXPECT_EQ(nullptr, setting("timeFormat"));
+
+  runUntil(FIREBASE_READY_TIMEOUT_MS + 12000);
+  EXPECT_NE(nullptr, setting("timeFormat")) << "registration never ran";
+  EXPECT_NE(nullptr, setting("appSequence"));
+
+  // The time fetch also needs the remote config's API key, which lands on its own retry
+  runUntil(2 * 60 * 1000);
+  EXPECT_TRUE(timeCache.isSynced()) << "the clock waits for the 6-hourly sync";
+}
+
+TEST_F(BootTest, CachedLocationDoesntWaitForFirebase) {
+  host::bootDevice();
+  runUntil(30000);  // The location is resolved and cached for this network
+  ASSERT_NE(0.0f, storedLat);
+  float lat = storedLat, lon = storedLon;
+
+  // Reboot on the same network with the token slower than setup() waits
+  storedLat = storedLon = 0.0f;
+  storedTimezone[0] = '\0';
+  host::rtdb().setTokenDelayMs(FIREBASE_READY_TIMEOUT_MS + 10000);
+  uint32_t geoLookups = host::httpRequestCount("ip-api.com");
+  setup();
+  ASSERT_FALSE(Firebase.ready());
+  EXPECT_EQ(lat, storedLat);
+  EXPECT_EQ(lon, storedLon);
+  EXPECT_STREQ("America/Toronto", storedTimezone);
+  EXPECT_EQ(geoLookups, host::httpRequestCount("ip-api.com"));
+}
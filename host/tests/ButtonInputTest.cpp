@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+#include <Firebase_ESP_Client.h>
+#include <HTTPClient.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "AppManager.h"
+#include "ButtonInput.h"
+#include "DeviceRegistration.h"
+#include "HostRuntime.h"
+#include "PowerManager.h"
+#include "StandIns.h"
+#include "Trace.h"
+
+void loop();
+extern AppManager appManager;
+extern unsigned long lastWeatherFetchTime;
+extern unsigned long lastWeatherAttemptTime;
+
+#define TEST_BUTTON_PIN 2  // BUTTON_PIN (A1) on the host core
+
+struct Edge {
+  unsigned long ms;
+  bool down;
+};
+
+struct Gesture {
+  ButtonEvent event;
+  unsigned long ms;
+  bool operator==(const Gesture& other) const { return event == other.event && ms == other.ms; }
+};
+
+static std::ostream& operator<<(std::ostream& out, const Gesture& g) {
+  static const char* names[] = { "none", "short", "double", "long" };
+  return out << names[(int)g.event] << "@" << g.ms;
+}
+
+// The recognizer as the button task drives it: every edge as the ISR timestamped it, and a tick each
+// millisecond with the pin's settled level. Bounce the recognizer swallows still moves the pin.
+static std::vector<Gesture> recognize(const std::vector<Edge>& edges, unsigned long untilMs) {
+  GestureRecognizer recognizer;
+  std::vector<Gesture> gestures;
+  auto note = [&](ButtonEvent event, unsigned long ms) {
+    if (event != ButtonEvent::NONE) gestures.push_back({ event, ms });
+  };
+  bool pin = false;
+  size_t next = 0;
+  for (unsigned long ms = 0; ms <= untilMs; ms++) {
+    for (; next < edges.size() && edges[next].ms == ms; next++) {
+      pin = edges[next].down;
+      note(recognizer.onEdge(pin, ms), ms);
+    }
+    note(recognizer.onTick(pin, ms), ms);
+  }
+  return gestures;
+}
+
+using Gestures = std::vector<Gesture>;
+
+TEST(GestureRecognizerTest, ShortPressFiresWhenTheDoubleWindowCloses) {
+  EXPECT_EQ((Gestures{ { ButtonEvent::SHORT_PRESS, 100 + BUTTON_DOUBLE_GAP_MS } }),
+            recognize({ { 0, true }, { 100, false } }, 3000));
+}
+
+TEST(GestureRecognizerTest, ContactBounceIsOnePress) {
+  EXPECT_EQ((Gestures{ { ButtonEvent::SHORT_PRESS, 120 + BUTTON_DOUBLE_GAP_MS } }),
+            recognize({ { 0, true }, { 4, false }, { 9, true }, { 15, false }, { 22, true },  // Make
+                        { 120, false }, { 126, true }, { 131, false } },                        // Break
+                      3000));
+}
+
+TEST(GestureRecognizerTest, SecondPressInsideTheGapIsADoublePress) {
+  EXPECT_EQ((Gestures{ { ButtonEvent::DOUBLE_PRESS, 390 } }),
+            recognize({ { 0, true }, { 90, false }, { 90 + BUTTON_DOUBLE_GAP_MS - 60, true }, { 390, false } }, 3000));
+}
+
+TEST(GestureRecognizerTest, SecondPressAfterTheGapIsTwoShortPresses) {
+  EXPECT_EQ((Gestures{ { ButtonEvent::SHORT_PRESS, 90 + BUTTON_DOUBLE_GAP_MS },
+                       { ButtonEvent::SHORT_PRESS, 600 + BUTTON_DOUBLE_GAP_MS } }),
+            recognize({ { 0, true }, { 90, false }, { 500, true }, { 600, false } }, 3000));
+}
+
+TEST(GestureRecognizerTest, LongPressFiresWhileStillHeldAndOnlyOnce) {
+  EXPECT_EQ((Gestures{ { ButtonEvent::LONG_PRESS, BUTTON_LONG_PRESS_MS } }),
+            recognize({ { 0, true }, { 3500, false } }, 6000));
+}
+
+TEST(GestureRecognizerTest, TapShorterThanTheDebounceIsNotAPhantomLongPress) {
+  // The release lands inside the debounce window and is swallowed; the settled pin resyncs it
+  EXPECT_EQ((Gestures{ { ButtonEvent::SHORT_PRESS, BUTTON_DEBOUNCE_MS + BUTTON_DOUBLE_GAP_MS } }),
+            recognize({ { 0, true }, { 12, false } }, 5000));
+}
+
+TEST(GestureRecognizerTest, TimeoutsTellTheTaskHowLongToSleep) {
+  GestureRecognizer recognizer;
+  EXPECT_EQ(ULONG_MAX, recognizer.msUntilTimeout(0));
+  recognizer.onEdge(true, 1000);
+  EXPECT_EQ((unsigned long)BUTTON_LONG_PRESS_MS - 500, recognizer.msUntilTimeout(1500));
+  recognizer.onEdge(false, 1600);
+  EXPECT_EQ((unsigned long)BUTTON_DOUBLE_GAP_MS - 100, recognizer.msUntilTimeout(1700));
+  EXPECT_EQ(ButtonEvent::SHORT_PRESS, recognizer.onTick(false, 1600 + BUTTON_DOUBLE_GAP_MS));
+  EXPECT_EQ(ULONG_MAX, recognizer.msUntilTimeout(2000));
+}
+
+TEST(GestureRecognizerTest, TimerWrapDoesntFireEarly) {
+  GestureRecognizer recognizer;
+  unsigned long start = ULONG_MAX - 100;
+  recognizer.onEdge(true, start);
+  EXPECT_EQ(ButtonEvent::NONE, recognizer.onTick(true, start + 1000));
+  EXPECT_EQ(ButtonEvent::LONG_PRESS, recognizer.onTick(true, start + BUTTON_LONG_PRESS_MS));
+}
+
+// The whole sketch: a press is acted on from the button task even while the loop task sits in a
+// slow RTDB call, instead of after it
+#define BUTTON_APPS R"({"clock":{"enabled":true},"weather":{"enabled":true},"forecast":{"enabled":true}})"
+#define SLOW_RTDB_MS 4000
+#define FRAME_MS 50
+
+class ButtonInputTest : public testing::Test {
+protected:
+  void SetUp() override {
+    host::bootDevice();
+    host::rtdb().seed((std::string("/novaFrame/devices/") + getMacId() + "/apps").c_str(), BUTTON_APPS);
+    runUntil(60000);  // The app poll has picked up the rotation
+    ASSERT_EQ(3u, appManager.getEnabledApps().size());
+  }
+
+  void runUntil(unsigned long ms) {
+    while (millis() < ms) loop();
+  }
+
+  void press(unsigned long atMs, unsigned long holdMs) {
+    host::at((uint64_t)atMs * 1000, [] { host::setPin(TEST_BUTTON_PIN, LOW); });
+    host::at((uint64_t)(atMs + holdMs) * 1000, [] { host::setPin(TEST_BUTTON_PIN, HIGH); });
+  }
+
+  // The active app at `ms`, read from the timer event as the panel would show it
+  void sampleAt(unsigned long ms, AppId* out) {
+    host::at((uint64_t)ms * 1000, [out] { *out = appManager.getActiveAppId(); });
+  }
+
+  // Rotation order; the 10 s rotation keeps moving too, so gestures are checked against this
+  AppId after(AppId id) {
+    const std::vector<AppId>& apps = appManager.getEnabledApps();
+    size_t i = std::find(apps.begin(), apps.end(), id) - apps.begin();
+    return apps[(i + 1) % apps.size()];
+  }
+};
+
+TEST_F(ButtonInputTest, ShortPressSwitchesWithinAFrameDuringASlowNetworkCall) {
+  host::rtdb().setLatencyMs(SLOW_RTDB_MS);  // The 5 s settings sync alone now blocks for 12 s
+  unsigned long pressAt = millis() + 7000;
+  unsigned long firesAt = pressAt + 80 + BUTTON_DOUBLE_GAP_MS;
+  AppId justBefore, justAfter;
+  uint32_t readsBefore = 0, readsAfter = 0;
+  uint32_t presentsBefore = 0, presentsAfter = 0;
+  press(pressAt, 80);
+  sampleAt(firesAt - 1, &justBefore);
+  sampleAt(firesAt + FRAME_MS, &justAfter);
+  host::at((uint64_t)(firesAt - 1) * 1000, [&] {
+    readsBefore = host::rtdb().reads;
+    presentsBefore = Tracer::getStats(TraceSpan::PRESENT).count;
+  });
+  host::at((uint64_t)(firesAt + FRAME_MS) * 1000, [&] {
+    readsAfter = host::rtdb().reads;
+    presentsAfter = Tracer::getStats(TraceSpan::PRESENT).count;
+  });
+  runUntil(firesAt + 2 * SLOW_RTDB_MS);
+
+  EXPECT_EQ(readsBefore, readsAfter) << "the loop wasn't blocked on the RTDB when the gesture fired";
+  EXPECT_EQ(after(justBefore), justAfter) << "the switch waited for the loop";
+  EXPECT_EQ(presentsBefore, presentsAfter) << "the button task's present landed in the loop task's trace";
+}
+
+TEST_F(ButtonInputTest, ShortPressSwitchesWithinAFrameDuringAPreloadFetch) {
+  // The weather goes stale and OpenWeather turns slow; the press lands while the clock is up and
+  // the rotation is fetching ahead for the weather app
+  unsigned long firesAt = 0;
+  AppId justBefore = AppId::NONE, justAfter = AppId::NONE;
+  host::serveHttp("api.openweathermap.org", [&](const host::HttpRequest&) {
+    if (!firesAt && appManager.getActiveAppId() == AppId::clock) {
+      unsigned long pressAt = millis() + 10;
+      firesAt = pressAt + 80 + BUTTON_DOUBLE_GAP_MS;
+      press(pressAt, 80);
+      sampleAt(firesAt - 1, &justBefore);
+      sampleAt(firesAt + FRAME_MS, &justAfter);
+    }
+    host::HttpResponse response;
+    response.body = host::oneCallResponse();
+    response.latencyMs = SLOW_RTDB_MS;
+    return response;
+  });
+  lastWeatherFetchTime = lastWeatherAttemptTime = 0;
+  unsigned long until = millis() + 60000;
+  while (millis() < until && (!firesAt || millis() < firesAt + 2 * SLOW_RTDB_MS)) loop();
+
+  ASSERT_NE(0u, firesAt) << "no preload fetch while the clock was up";
+  EXPECT_EQ(after(justBefore), justAfter) << "the switch waited for the preload";
+}
+
+TEST_F(ButtonInputTest, DoublePressGoesBack) {
+  AppId first;
+  unsigned long at = millis() + 1000;
+  press(at, 60);
+  sampleAt(at, &first);
+  runUntil(at + 2000);
+  ASSERT_EQ(after(first), appManager.getActiveAppId());
+
+  at = millis() + 500;  // A gesture restarts the rotation's 10 s, so nothing else moves meanwhile
+  press(at, 60);
+  press(at + 150, 60);
+  runUntil(at + 2000);
+  EXPECT_EQ(first, appManager.getActiveAppId());
+}
+
+TEST_F(ButtonInputTest, PressAtNightWakesThePanelWithinAFrame) {
+  std::string settings = std::string("/novaFrame/devices/") + getMacId() + "/settings";
+  host::rtdb().seed((settings + "/nightStart").c_str(), "0");  // 05:00 local is inside the schedule
+  host::rtdb().seed((settings + "/nightEnd").c_str(), "720");
+  runUntil(millis() + 65000);
+  ASSERT_TRUE(powerManager.isPanelBlanked());
+
+  // The gesture only flags the wake; the loop's next update() lifts the blanking
+  unsigned long at = millis() + 500;
+  unsigned long firesAt = at + 60 + BUTTON_DOUBLE_GAP_MS;
+  bool blanked = true;
+  press(at, 60);
+  host::at((uint64_t)(firesAt + FRAME_MS) * 1000, [&] { blanked = powerManager.isPanelBlanked(); });
+  runUntil(firesAt + FRAME_MS + 1);
+  EXPECT_FALSE(blanked);
+}
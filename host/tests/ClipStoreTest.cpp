@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "ClipStore.h"
+
+// The NFC1 decoder on clips built in memory, as tools/make_clip.py would lay them out
+
+#define K 0x0000
+#define R 0xF800
+#define G 0x07E0
+#define B 0x001F
+#define GUARD 0xBEEF
+
+struct TestFrame {
+  uint8_t firstRow;
+  uint8_t rowCount;
+  std::vector<uint8_t> rle;
+};
+
+// 4x3, four colours: a full frame, then a band that only redraws the middle row
+class ClipStoreTest : public testing::Test {
+protected:
+  uint16_t width = 4;
+  uint16_t height = 3;
+  std::vector<uint16_t> palette = { K, R, G, B };
+  std::vector<TestFrame> frames = {
+    { 0, 3, { 0x03, 1, 2, 3, 0,      // Literals: R G B K
+              0x83, 1,               // Run: R R R R
+              0x81, 2, 0x01, 3, 0 } },  // G G, then B K
+    { 1, 1, { 0x83, 3 } },           // B B B B
+  };
+
+  std::vector<uint8_t> build() {
+    ClipHeader header = {};
+    memcpy(header.magic, CLIP_MAGIC, 4);
+    header.width = width;
+    header.height = height;
+    header.frameCount = frames.size();
+    header.paletteSize = palette.size();
+
+    std::vector<uint8_t> clip((uint8_t*)&header, (uint8_t*)&header + sizeof(header));
+    clip.insert(clip.end(), (uint8_t*)palette.data(), (uint8_t*)(palette.data() + palette.size()));
+    clip.resize((clip.size() + 3) & ~(size_t)3);
+    size_t table = clip.size();
+    clip.resize(table + frames.size() * sizeof(ClipFrame));
+    for (size_t i = 0; i < frames.size(); i++) {
+      ClipFrame entry = { (uint32_t)clip.size(), 100, frames[i].firstRow, frames[i].rowCount };
+      memcpy(&clip[table + i * sizeof(ClipFrame)], &entry, sizeof(entry));
+      clip.insert(clip.end(), frames[i].rle.begin(), frames[i].rle.end());
+    }
+    return clip;
+  }
+
+  ClipFrame* frameEntry(std::vector<uint8_t>& clip, int index) {
+    size_t table = (sizeof(ClipHeader) + palette.size() * sizeof(uint16_t) + 3) & ~(size_t)3;
+    return (ClipFrame*)&clip[table + index * sizeof(ClipFrame)];
+  }
+
+  // A canvas with a guard row past its end, so writes off the bottom show up
+  std::vector<uint16_t> canvas(int w, int h) { return std::vector<uint16_t>(w * (h + 1), GUARD); }
+
+  bool decode(const std::vector<uint8_t>& clip, int index, std::vector<uint16_t>& out, int w, int h,
+              size_t size = 0) {
+    ClipView view;
+    if (!openClip(clip.data(), size ? size : clip.size(), view)) return false;
+    return decodeClipFrame(view, index, out.data(), w, h);
+  }
+};
+
+TEST_F(ClipStoreTest, DecodesLiteralsAndRunsAndBandsKeepEarlierRows) {
+  std::vector<uint8_t> clip = build();
+  std::vector<uint16_t> out = canvas(4, 3);
+  ASSERT_TRUE(decode(clip, 0, out, 4, 3));
+  EXPECT_EQ((std::vector<uint16_t>{ R, G, B, K, R, R, R, R, G, G, B, K, GUARD, GUARD, GUARD, GUARD }), out);
+
+  ASSERT_TRUE(decode(clip, 1, out, 4, 3));
+  EXPECT_EQ((std::vector<uint16_t>{ R, G, B, K, B, B, B, B, G, G, B, K, GUARD, GUARD, GUARD, GUARD }), out);
+}
+
+TEST_F(ClipStoreTest, ClipsToANarrowerShorterCanvas) {
+  std::vector<uint8_t> clip = build();
+  std::vector<uint16_t> out = canvas(3, 2);
+  ASSERT_TRUE(decode(clip, 0, out, 3, 2));
+  EXPECT_EQ((std::vector<uint16_t>{ R, G, B, R, R, R, GUARD, GUARD, GUARD }), out);
+
+  // The band lands inside; a band wholly below the canvas is decoded past without writing
+  ASSERT_TRUE(decode(clip, 1, out, 3, 2));
+  EXPECT_EQ((std::vector<uint16_t>{ R, G, B, B, B, B, GUARD, GUARD, GUARD }), out);
+  out = canvas(3, 1);
+  ASSERT_TRUE(decode(clip, 1, out, 3, 1));
+  EXPECT_EQ((std::vector<uint16_t>{ GUARD, GUARD, GUARD, GUARD, GUARD, GUARD }), out);
+}
+
+TEST_F(ClipStoreTest, TruncatedStreamIsRejected) {
+  std::vector<uint16_t> out = canvas(4, 3);
+  frames.resize(1);  // The frame's data ends the clip
+  std::vector<uint8_t> clip = build();
+  ASSERT_TRUE(decode(clip, 0, out, 4, 3));
+  EXPECT_FALSE(decode(clip, 0, out, 4, 3, clip.size() - 1)) << "literals cut short";
+  EXPECT_FALSE(decode(clip, 0, out, 4, 3, clip.size() - 4)) << "run token without its index";
+  EXPECT_FALSE(decode(clip, 0, out, 4, 3, clip.size() - 5)) << "row cut at a token boundary";
+
+  frames[0] = { 0, 1, { 0x81, 3 } };  // Half a row, then nothing
+  EXPECT_FALSE(decode(build(), 0, out, 4, 3));
+}
+
+TEST_F(ClipStoreTest, OutOfRangePaletteIndexIsRejected) {
+  std::vector<uint16_t> out = canvas(4, 3);
+  frames[1].rle = { 0x83, 4 };
+  EXPECT_FALSE(decode(build(), 1, out, 4, 3)) << "run";
+  frames[1].rle = { 0x03, 0, 1, 4, 2 };
+  EXPECT_FALSE(decode(build(), 1, out, 4, 3)) << "literal";
+}
+
+TEST_F(ClipStoreTest, RowsMustEndOnTheWidth) {
+  std::vector<uint16_t> out = canvas(4, 3);
+  frames[1].rle = { 0x84, 1 };  // Five pixels in a four-pixel row
+  EXPECT_FALSE(decode(build(), 1, out, 4, 3));
+  frames[1].rle = { 0x81, 1, 0x02, 1, 1, 1 };
+  EXPECT_FALSE(decode(build(), 1, out, 4, 3));
+}
+
+TEST_F(ClipStoreTest, BadHeaderAndFrameTableAreRejected) {
+  ClipView view;
+  std::vector<uint8_t> clip = build();
+  ASSERT_TRUE(openClip(clip.data(), clip.size(), view));
+  EXPECT_EQ(2, view.header->frameCount);
+
+  clip[0] = 'X';
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "magic";
+  EXPECT_FALSE(openClip(clip.data(), sizeof(ClipHeader) - 1, view)) << "short header";
+
+  clip = build();
+  ((ClipHeader*)clip.data())->frameCount = 0;
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "no frames";
+  ((ClipHeader*)clip.data())->frameCount = 40;
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "table runs past the clip";
+  ((ClipHeader*)clip.data())->frameCount = CLIP_MAX_FRAMES + 1;
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "too many frames";
+
+  clip = build();
+  ((ClipHeader*)clip.data())->paletteSize = 0;
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "no palette";
+}
+
+TEST_F(ClipStoreTest, FrameOffsetAndRowBoundsAreChecked) {
+  ClipView view;
+  std::vector<uint8_t> clip = build();
+  frameEntry(clip, 1)->offset = clip.size();
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "offset past the end";
+
+  clip = build();
+  frameEntry(clip, 1)->firstRow = 3;
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "band below the clip";
+
+  clip = build();
+  frameEntry(clip, 1)->rowCount = 3;
+  EXPECT_FALSE(openClip(clip.data(), clip.size(), view)) << "band runs off the bottom";
+}
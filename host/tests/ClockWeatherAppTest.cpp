@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "TestSupport.h"
+#include "ClockWeatherApp.h"
+#include "DisplayHelpers.h"
+#include "TimeCache.h"
+#include "WeatherCache.h"
+
+extern TimeCache timeCache;
+extern float storedLat;
+extern float storedLon;
+extern int timeFormatPreference;
+
+#define OPENWEATHER_HOST "api.openweathermap.org"
+
+class ClockWeatherAppTest : public testing::Test {
+protected:
+  void SetUp() override {
+    connectTestDevice();
+    storedLat = 43.6532f;
+    storedLon = -79.3832f;
+    host::serveHttp("api.ipgeolocation.io", [](const host::HttpRequest&) {
+      host::HttpResponse response;
+      response.body = R"({"timezone":"America/Toronto","date":"2025-10-09","time_24":"13:04:30"})";
+      return response;
+    });
+    serveWeather(200);
+    timeCache.init();
+    app.init();
+  }
+
+  void serveWeather(int status) {
+    host::serveHttp(OPENWEATHER_HOST, [status](const host::HttpRequest&) {
+      host::HttpResponse response;
+      response.status = status;
+      response.body = R"({"current":{"temp":12.3,"feels_like":11.0,"weather":[{"icon":"03d"}]},"hourly":[],"daily":[]})";
+      return response;
+    });
+  }
+
+  // loop() once and report whether it asked for a redraw
+  bool loopWantsRedraw() {
+    app.setNeedsRedraw(false);
+    app.loop();
+    return app.getNeedsRedraw();
+  }
+
+  // Pixels in the suffix's grey; the digits are white and the temperature cyan
+  int suffixPixels() {
+    app.redraw(true);
+    const uint16_t* px = matrix.getBuffer();
+    uint16_t grey = matrix.color565(180, 180, 180);
+    int lit = 0;
+    for (int i = 0; i < Panel::pixels; i++) lit += px[i] == grey;
+    return lit;
+  }
+
+  ClockWeatherApp app;
+};
+
+TEST_F(ClockWeatherAppTest, RedrawsWhenTheMinuteChanges) {
+  loopWantsRedraw();  // First pass: the fetch and the first minute
+  EXPECT_FALSE(loopWantsRedraw());
+
+  host::runFor((uint64_t)timeCache.msUntilNextMinute() * 1000 - 1000);
+  EXPECT_FALSE(loopWantsRedraw());
+  host::runFor(2000);
+  EXPECT_TRUE(loopWantsRedraw());
+  EXPECT_FALSE(loopWantsRedraw());
+}
+
+TEST_F(ClockWeatherAppTest, RedrawsWhenNewWeatherLands) {
+  EXPECT_TRUE(loopWantsRedraw());
+  EXPECT_EQ(123, weatherData.temp10);
+  EXPECT_EQ(1u, host::httpRequestCount(OPENWEATHER_HOST));
+}
+
+TEST_F(ClockWeatherAppTest, FetchesOnlyAtTheCacheDeadline) {
+  app.loop();
+  for (int i = 0; i < 600; i++) {
+    host::runFor(100 * 1000);
+    app.loop();
+  }
+  EXPECT_EQ(1u, host::httpRequestCount(OPENWEATHER_HOST));  // Next one is an hour out
+  EXPECT_LE(app.getNextUpdateMs(), 60000u);
+}
+
+TEST_F(ClockWeatherAppTest, FailedFetchWaitsBeforeRetrying) {
+  serveWeather(500);
+  for (int i = 0; i < 290; i++) {
+    app.loop();
+    host::runFor(100 * 1000);
+  }
+  EXPECT_EQ(1u, host::httpRequestCount(OPENWEATHER_HOST));
+  EXPECT_GT(app.getNextUpdateMs(), 0u);
+
+  host::runFor(1000 * 1000);
+  app.loop();
+  EXPECT_EQ(2u, host::httpRequestCount(OPENWEATHER_HOST));
+}
+
+TEST_F(ClockWeatherAppTest, DrawsTheSuffixOnlyWhenThePreferenceAsksForIt) {
+  app.loop();
+  timeFormatPreference = 0;  // 12h + AM/PM
+  EXPECT_GT(suffixPixels(), 0);
+  timeFormatPreference = 1;  // 12h, no suffix
+  EXPECT_EQ(0, suffixPixels());
+  timeFormatPreference = 2;
+  EXPECT_EQ(0, suffixPixels());
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "DisplayHelpers.h"
+#include "FrameKernels.h"
+
+// Each kernel against the Adafruit_GFX call it replaces, on the same noisy frame: random spans,
+// rects and masks at every alignment, including ones hanging off each edge of the panel.
+
+#define KERNEL_CASES 2000
+
+using Draw = std::function<void()>;
+
+class FrameKernelsTest : public testing::Test {
+protected:
+  std::mt19937 rng{ 0x4E46 };
+
+  int between(int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); }
+
+  // Anywhere from fully off the panel on one side to fully off on the other
+  int coordinate(int extent) { return between(-extent / 2 - 8, extent + 8); }
+
+  std::vector<uint16_t> fill(const std::vector<uint16_t>& seed, const Draw& draw) {
+    uint16_t* frame = matrix.getBuffer();
+    std::copy(seed.begin(), seed.end(), frame);
+    draw();
+    return std::vector<uint16_t>(frame, frame + Panel::pixels);
+  }
+
+  // Both draws start from the same random frame and must leave identical frames
+  void expectSame(const char* what, const Draw& kernel, const Draw& reference) {
+    std::vector<uint16_t> seed(Panel::pixels);
+    for (uint16_t& px : seed) px = (uint16_t)rng();
+    std::vector<uint16_t> fast = fill(seed, kernel);
+    std::vector<uint16_t> gfx = fill(seed, reference);
+    for (int i = 0; i < Panel::pixels; i++) {
+      if (fast[i] != gfx[i]) {
+        ADD_FAILURE() << what << ": pixel (" << i % Panel::width << ", " << i / Panel::width << ") is 0x" << std::hex
+                      << fast[i] << ", Adafruit_GFX drew 0x" << gfx[i];
+        return;
+      }
+    }
+  }
+};
+
+TEST_F(FrameKernelsTest, ClearFrameMatchesFillScreen) {
+  expectSame("clearFrame", [] { clearFrame(); }, [] { matrix.fillScreen(0); });
+}
+
+TEST_F(FrameKernelsTest, SpanHMatchesDrawFastHLine) {
+  for (int n = 0; n < KERNEL_CASES && !HasFailure(); n++) {
+    int x = coordinate(Panel::width), y = coordinate(Panel::height), w = between(0, Panel::width + 8);
+    uint16_t color = (uint16_t)rng();
+    std::string what = "fillSpanH(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(w) + ")";
+    expectSame(what.c_str(), [=] { fillSpanH(x, y, w, color); }, [=] { matrix.drawFastHLine(x, y, w, color); });
+  }
+}
+
+TEST_F(FrameKernelsTest, SpanVMatchesDrawFastVLine) {
+  for (int n = 0; n < KERNEL_CASES && !HasFailure(); n++) {
+    int x = coordinate(Panel::width), y = coordinate(Panel::height), h = between(0, Panel::height + 8);
+    uint16_t color = (uint16_t)rng();
+    std::string what = "fillSpanV(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(h) + ")";
+    expectSame(what.c_str(), [=] { fillSpanV(x, y, h, color); }, [=] { matrix.drawFastVLine(x, y, h, color); });
+  }
+}
+
+TEST_F(FrameKernelsTest, RectMatchesFillRect) {
+  for (int n = 0; n < KERNEL_CASES && !HasFailure(); n++) {
+    int x = coordinate(Panel::width), y = coordinate(Panel::height);
+    int w = between(0, Panel::width + 8), h = between(0, Panel::height + 8);
+    uint16_t color = (uint16_t)rng();
+    std::string what = "fillRectFast(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(w) +
+                       ", " + std::to_string(h) + ")";
+    expectSame(what.c_str(), [=] { fillRectFast(x, y, w, h, color); }, [=] { matrix.fillRect(x, y, w, h, color); });
+  }
+}
+
+TEST_F(FrameKernelsTest, FullWidthRectMatchesFillRect) {  // The contiguous-rows path
+  for (int y = -4; y < Panel::height && !HasFailure(); y += 3) {
+    int h = between(1, Panel::height);
+    expectSame("fillRectFast full width", [=] { fillRectFast(0, y, Panel::width, h, 0xF81F); },
+               [=] { matrix.fillRect(0, y, Panel::width, h, 0xF81F); });
+  }
+}
+
+TEST_F(FrameKernelsTest, MaskMatchesDrawBitmap) {
+  for (int n = 0; n < KERNEL_CASES && !HasFailure(); n++) {
+    int w = between(1, 40), h = between(1, 40);
+    int x = coordinate(Panel::width), y = coordinate(Panel::height);
+    // Mix of empty, full and random bytes so every branch of the blit runs
+    std::vector<uint8_t> mask(((w + 7) / 8) * h);
+    for (uint8_t& b : mask) {
+      int kind = between(0, 3);
+      b = kind == 0 ? 0x00 : kind == 1 ? 0xFF : (uint8_t)rng();
+    }
+    uint16_t color = (uint16_t)rng();
+    std::string what = "blitMask " + std::to_string(w) + "x" + std::to_string(h) + " at (" + std::to_string(x) + ", " +
+                       std::to_string(y) + ")";
+    expectSame(what.c_str(), [&] { blitMask(mask.data(), w, h, x, y, color); },
+               [&] { matrix.drawBitmap(x, y, mask.data(), w, h, color); });
+  }
+}
+
+// Adafruit_GFX flips a negative extent; the kernels draw nothing instead
+TEST_F(FrameKernelsTest, NegativeExtentsDrawNothing) {
+  Draw untouched = [] {};
+  expectSame("fillSpanH", [] { fillSpanH(10, 5, -6, 0xFFFF); }, untouched);
+  expectSame("fillSpanV", [] { fillSpanV(10, 5, -6, 0xFFFF); }, untouched);
+  expectSame("fillRectFast", [] { fillRectFast(10, 5, -6, 4, 0xFFFF); }, untouched);
+  expectSame("fillRectFast", [] { fillRectFast(10, 5, 6, -4, 0xFFFF); }, untouched);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "GeoCache.h"
+
+// The flash value's format and parser; lookup() and store() are covered by the boot tests
+
+static GeoLocation toronto() {
+  GeoLocation loc;
+  loc.network = 0x1A2B3C4D;
+  strcpy(loc.publicIp, "203.0.113.7");
+  loc.lat = 43.6532f;
+  loc.lon = -79.3832f;
+  loc.resolvedAt = 1760000400;
+  strcpy(loc.timezone, "America/Toronto");
+  strcpy(loc.city, "Toronto");
+  strcpy(loc.region, "ON");
+  return loc;
+}
+
+static bool parse(const std::string& text, GeoLocation& loc) {
+  return parseGeoLocation(text.c_str(), loc);
+}
+
+TEST(GeoCacheTest, RoundTrips) {
+  char buf[256];
+  GeoLocation loc = toronto();
+  ASSERT_NE(0u, formatGeoLocation(loc, buf, sizeof(buf)));
+  EXPECT_STREQ("1\t1a2b3c4d\t203.0.113.7\t43.6532\t-79.3832\t1760000400\tAmerica/Toronto\tToronto\tON", buf);
+
+  GeoLocation back;
+  ASSERT_TRUE(parseGeoLocation(buf, back));
+  EXPECT_EQ(loc.network, back.network);
+  EXPECT_STREQ(loc.publicIp, back.publicIp);
+  EXPECT_FLOAT_EQ(loc.lat, back.lat);
+  EXPECT_FLOAT_EQ(loc.lon, back.lon);
+  EXPECT_EQ(loc.resolvedAt, back.resolvedAt);
+  EXPECT_STREQ(loc.timezone, back.timezone);
+  EXPECT_STREQ(loc.city, back.city);
+  EXPECT_STREQ(loc.region, back.region);
+}
+
+TEST(GeoCacheTest, EmptyPlaceFieldsRoundTrip) {
+  char buf[256];
+  GeoLocation loc = toronto();
+  loc.city[0] = loc.region[0] = '\0';
+  ASSERT_NE(0u, formatGeoLocation(loc, buf, sizeof(buf)));
+  GeoLocation back;
+  ASSERT_TRUE(parseGeoLocation(buf, back));
+  EXPECT_STREQ("", back.city);
+  EXPECT_STREQ("", back.region);
+}
+
+TEST(GeoCacheTest, FormatNeedsRoomForTheWholeValue) {
+  char buf[256];
+  size_t n = formatGeoLocation(toronto(), buf, sizeof(buf));
+  ASSERT_NE(0u, n);
+  EXPECT_EQ(0u, formatGeoLocation(toronto(), buf, n));
+  EXPECT_EQ(n, formatGeoLocation(toronto(), buf, n + 1));
+}
+
+TEST(GeoCacheTest, WrongFieldCountIsRejected) {
+  GeoLocation loc = toronto();
+  EXPECT_FALSE(parse("1\t1a2b3c4d\t203.0.113.7\t43.6532\t-79.3832\t1760000400\tAmerica/Toronto\tToronto", loc));
+  EXPECT_FALSE(parse("1\t1a2b3c4d\t203.0.113.7\t43.6532\t-79.3832\t1760000400\tAmerica/Toronto\tToronto\tON\textra", loc));
+  EXPECT_FALSE(parse("", loc));
+  EXPECT_STREQ("Toronto", loc.city) << "a rejected value left the output alone";
+}
+
+TEST(GeoCacheTest, OtherFormatVersionsAreRejected) {
+  GeoLocation loc;
+  EXPECT_FALSE(parse("2\t1a2b3c4d\t203.0.113.7\t43.6532\t-79.3832\t1760000400\tAmerica/Toronto\tToronto\tON", loc));
+  EXPECT_FALSE(parse("x\t1a2b3c4d\t203.0.113.7\t43.6532\t-79.3832\t1760000400\tAmerica/Toronto\tToronto\tON", loc));
+}
+
+TEST(GeoCacheTest, MissingCoordinatesAreRejected) {
+  GeoLocation loc;
+  EXPECT_FALSE(parse("1\t1a2b3c4d\t203.0.113.7\t0.0000\t-79.3832\t1760000400\tAmerica/Toronto\tToronto\tON", loc));
+  EXPECT_FALSE(parse("1\t1a2b3c4d\t203.0.113.7\t43.6532\t\t1760000400\tAmerica/Toronto\tToronto\tON", loc));
+}
+
+TEST(GeoCacheTest, OverLongFieldsAreCutToTheirBuffers) {
+  std::string ip(100, '1'), tz(100, 'Z'), city(100, 'c'), region(100, 'r');
+  GeoLocation loc;
+  ASSERT_TRUE(parse("1\t1a2b3c4d\t" + ip + "\t43.6532\t-79.3832\t1760000400\t" + tz + "\t" + city + "\t" + region, loc));
+  EXPECT_EQ(ip.substr(0, GEO_IP_MAX_LEN - 1), loc.publicIp);
+  EXPECT_EQ(tz.substr(0, GEO_TZ_MAX_LEN - 1), loc.timezone);
+  EXPECT_EQ(city.substr(0, GEO_PLACE_MAX_LEN - 1), loc.city);
+  EXPECT_EQ(region.substr(0, GEO_PLACE_MAX_LEN - 1), loc.region);
+  EXPECT_FLOAT_EQ(-79.3832f, loc.lon) << "fields after an over-long one still line up";
+}
+
+TEST(GeoCacheTest, NumbersMustFillTheirField) {
+  GeoLocation loc;
+  EXPECT_FALSE(parse("1\t\t203.0.113.7\t43.6532\t-79.3832\t1760000400\tAmerica/Toronto\tToronto\tON", loc));
+  EXPECT_FALSE(parse("1\t1a2b3c4d\t203.0.113.7\t43.6532N\t-79.3832\t1760000400\tAmerica/Toronto\tToronto\tON", loc));
+  EXPECT_FALSE(parse("1\t1a2b3c4d\t203.0.113.7\t43.6532\t-79.3832\t-5\tAmerica/Toronto\tToronto\tON", loc));
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include "HostFlash.h"
+#include "HostRuntime.h"
+#include "KVStore.h"
+
+// Two 4 KB halves, so a few dozen updates fill one and force a compaction
+#define TEST_REGION 0x400000
+#define TEST_REGION_SIZE 0x2000
+
+using Steps = std::function<void(KVStore&)>;
+
+static std::string valueOf(const KVStore& store, const char* key) {
+  const char* value = store.get(key);
+  return value ? value : "<missing>";
+}
+
+class KVStoreTest : public testing::Test {
+protected:
+  void SetUp() override { host::eraseFlash(); }
+
+  // Fresh chip, the history replayed with full power, then a mount as at boot
+  void prepare(const Steps& history) {
+    host::eraseFlash();
+    KVStore store;
+    ASSERT_TRUE(store.begin(TEST_REGION, TEST_REGION_SIZE));
+    history(store);
+  }
+
+  // Flash units the operation costs on top of the history
+  long unitsFor(const Steps& history, const Steps& operation) {
+    prepare(history);
+    KVStore store;
+    store.begin(TEST_REGION, TEST_REGION_SIZE);
+    host::setFlashBudget(LONG_MAX);
+    operation(store);
+    long units = host::flashUnitsUsed();
+    host::restoreFlashPower();
+    return units;
+  }
+
+  // Cuts power after every possible number of units, then reboots and hands the remounted store
+  // to `check`. The store must also take a further write (`recover`, by default an unrelated key)
+  // and keep it across another reboot.
+  void tearEverywhere(const Steps& history, const Steps& operation, const Steps& check, const Steps& recover = nullptr) {
+    long units = unitsFor(history, operation);
+    ASSERT_GT(units, 0);
+    for (long cut = 0; cut < units; cut++) {
+      SCOPED_TRACE("power cut after " + std::to_string(cut) + " of " + std::to_string(units) + " units");
+      prepare(history);
+      {
+        KVStore store;
+        store.begin(TEST_REGION, TEST_REGION_SIZE);
+        host::setFlashBudget(cut);
+        operation(store);
+        ASSERT_TRUE(host::flashPowerLost());
+        host::restoreFlashPower();
+      }
+
+      KVStore rebooted;
+      ASSERT_TRUE(rebooted.begin(TEST_REGION, TEST_REGION_SIZE));
+      check(rebooted);
+      if (recover) recover(rebooted);
+      else ASSERT_TRUE(rebooted.set("after", "cut"));
+
+      KVStore again;
+      ASSERT_TRUE(again.begin(TEST_REGION, TEST_REGION_SIZE));
+      check(again);
+      if (!recover) EXPECT_EQ("cut", valueOf(again, "after"));
+      if (HasFailure()) return;
+    }
+  }
+};
+
+static void seed(KVStore& store) {
+  store.set("ssid", "HomeNet");
+  store.set("token", "first");
+}
+
+// Updates to `token` until the next one no longer fits in the active half
+static int updatesBeforeCompaction() {
+  host::eraseFlash();
+  KVStore store;
+  store.begin(TEST_REGION, TEST_REGION_SIZE);
+  seed(store);
+  host::setSerialCapture(true);
+  host::takeSerialOutput();
+  int n = 0;
+  for (;; n++) {
+    store.set("token", ("value-" + std::to_string(n) + std::string(40, 'x')).c_str());
+    if (host::takeSerialOutput().find("compacted") != std::string::npos) break;
+  }
+  host::setSerialCapture(false);
+  return n;
+}
+
+TEST_F(KVStoreTest, ValuesSurviveReboot) {
+  {
+    KVStore store;
+    ASSERT_TRUE(store.begin(TEST_REGION, TEST_REGION_SIZE));
+    EXPECT_TRUE(store.isEmpty());
+    seed(store);
+    ASSERT_TRUE(store.set("token", "second"));
+  }
+  KVStore store;
+  ASSERT_TRUE(store.begin(TEST_REGION, TEST_REGION_SIZE));
+  EXPECT_EQ(2u, store.count());
+  EXPECT_EQ("HomeNet", valueOf(store, "ssid"));
+  EXPECT_EQ("second", valueOf(store, "token"));
+}
+
+TEST_F(KVStoreTest, TornAppendKeepsOldOrNewValue) {
+  Steps history = [](KVStore& store) {
+    seed(store);
+    store.set("token", "second");  // The append path needs an active half
+  };
+  tearEverywhere(history, [](KVStore& store) { store.set("token", "third-and-longer"); },
+                 [](KVStore& store) {
+                   std::string token = valueOf(store, "token");
+                   EXPECT_TRUE(token == "second" || token == "third-and-longer") << token;
+                   EXPECT_EQ("HomeNet", valueOf(store, "ssid"));
+                 });
+}
+
+TEST_F(KVStoreTest, TornCompactionKeepsEveryKey) {
+  int n = updatesBeforeCompaction();
+  ASSERT_GT(n, 10);
+  std::string last = "value-" + std::to_string(n - 1) + std::string(40, 'x');
+  Steps history = [n](KVStore& store) {
+    seed(store);
+    for (int i = 0; i < n; i++) store.set("token", ("value-" + std::to_string(i) + std::string(40, 'x')).c_str());
+  };
+  tearEverywhere(history, [](KVStore& store) { store.set("token", "compacted"); },
+                 [&](KVStore& store) {
+                   std::string token = valueOf(store, "token");
+                   EXPECT_TRUE(token == last || token == "compacted") << token;
+                   EXPECT_EQ("HomeNet", valueOf(store, "ssid"));
+                 });
+}
+
+TEST_F(KVStoreTest, TornBatchIsAllOrNothing) {
+  static const char* keys[] = { "ssid", "token", "city" };
+  static const char* values[] = { "Office", "batch", "Toronto" };
+  tearEverywhere(seed, [](KVStore& store) { store.setMany(keys, values, 3); },
+                 [](KVStore& store) {
+                   bool old = valueOf(store, "ssid") == "HomeNet" && valueOf(store, "token") == "first" &&
+                              valueOf(store, "city") == "<missing>";
+                   bool updated = valueOf(store, "ssid") == "Office" && valueOf(store, "token") == "batch" &&
+                                  valueOf(store, "city") == "Toronto";
+                   EXPECT_TRUE(old || updated);
+                 });
+}
+
+TEST_F(KVStoreTest, TornMigrationKeepsLegacyImage) {
+  const char* legacy = R"({"ssid":"HomeNet"})";
+  static const char* keys[] = { "ssid" };
+  static const char* values[] = { "HomeNet" };
+  Steps history = [legacy](KVStore&) { memcpy(host::flashData() + TEST_REGION, legacy, strlen(legacy) + 1); };
+  tearEverywhere(history, [](KVStore& store) { store.setMany(keys, values, 1); },
+                 [legacy](KVStore& store) {
+                   if (store.isEmpty()) {
+                     EXPECT_STREQ(legacy, (const char*)store.rawRegion());
+                   } else {
+                     EXPECT_EQ("HomeNet", valueOf(store, "ssid"));
+                   }
+                 },
+                 [](KVStore& store) {  // Boot migrates again, as SecretsManager::load() does
+                   if (store.isEmpty()) ASSERT_TRUE(store.setMany(keys, values, 1));
+                 });
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <Firebase_ESP_Client.h>
+#include <WebServer.h>
+#include <string>
+#include "DeviceRegistration.h"
+#include "DisplayHelpers.h"
+#include "HostRuntime.h"
+#include "LanApi.h"
+#include "StandIns.h"
+
+void loop();
+
+#define TEST_TOKEN "lan-test-token"  // The stand-in device's LAN_API_TOKEN secret
+
+// The whole sketch, driven over its LAN API the way tools/lan_api.py does
+class LanApiTest : public testing::Test {
+protected:
+  std::string settings;
+
+  void SetUp() override {
+    host::bootDevice();
+    settings = std::string("/novaFrame/devices/") + getMacId() + "/settings";
+    host::rtdb().seed((settings + "/brightness").c_str(), "3");
+    runFor(6000);  // One settings poll
+    ASSERT_EQ(3, brightnessLevel);
+  }
+
+  void runFor(unsigned long ms) {
+    unsigned long until = millis() + ms;
+    while (millis() < until) loop();
+  }
+
+  host::WebResponse put(const std::string& body, const char* token = TEST_TOKEN) {
+    host::WebRequest request;
+    request.method = HTTP_PUT;
+    request.uri = "/api/settings";
+    request.body = body;
+    if (token) request.headers["Authorization"] = std::string("Bearer ") + token;
+    return host::webRequest(LAN_API_PORT, request);
+  }
+
+  int cloudBrightness() {
+    const host::JsonValue* node = host::rtdb().find((settings + "/brightness").c_str());
+    return node ? (int)node->number() : -1;
+  }
+};
+
+TEST_F(LanApiTest, WritesNeedTheToken) {
+  EXPECT_EQ(401, put(R"({"brightness":8})", nullptr).code);
+  EXPECT_EQ(401, put(R"({"brightness":8})", "lan-test-tokem").code);
+  EXPECT_EQ(401, put(R"({"brightness":8})", "lan-test-token-and-more").code);
+
+  host::WebRequest request;
+  request.method = HTTP_PUT;
+  request.uri = "/api/settings";
+  request.body = R"({"brightness":8})";
+  request.headers["X-Auth-Token"] = TEST_TOKEN;
+  EXPECT_EQ(202, host::webRequest(LAN_API_PORT, request).code);
+  runFor(100);
+  EXPECT_EQ(8, brightnessLevel);
+
+  request = host::WebRequest();
+  request.uri = "/api/settings";
+  EXPECT_EQ(200, host::webRequest(LAN_API_PORT, request).code) << "reads stay open";
+}
+
+TEST_F(LanApiTest, FailedWriteBackIsRetriedAndNotRevertedByThePoll) {
+  host::rtdb().failNextWrites(3);
+  ASSERT_EQ(202, put(R"({"brightness":8})").code);
+
+  // Several settings polls go by while Firebase still says 3
+  unsigned long until = millis() + 4 * LAN_API_SYNC_RETRY_MS;
+  while (millis() < until) {
+    loop();
+    ASSERT_EQ(8, brightnessLevel) << "reverted to the cloud value at " << millis() << " ms";
+  }
+  EXPECT_EQ(8, cloudBrightness());
+  EXPECT_FALSE(lanApi.isUnsynced(SettingsField::BRIGHTNESS));
+
+  // Synced: the poll owns the field again
+  host::rtdb().seed((settings + "/brightness").c_str(), "5");
+  runFor(6000);
+  EXPECT_EQ(5, brightnessLevel);
+}
+
+TEST_F(LanApiTest, ABadFieldRejectsTheWholeRequest) {
+  EXPECT_EQ(400, put(R"({"brightness":8,"units":"kelvin"})").code);
+  runFor(100);
+  EXPECT_EQ(3, brightnessLevel);
+}
+
+TEST_F(LanApiTest, AFullQueueRejectsTheWholeRequest) {
+  // The loop is parked in this test, so nothing drains the queue
+  for (int i = 0; i < LAN_API_COMMAND_QUEUE; i++) ASSERT_EQ(202, put(R"({"brightness":7})").code);
+  EXPECT_EQ(503, put(R"({"brightness":9,"units":"imperial"})").code);
+  runFor(100);
+  EXPECT_EQ(7, brightnessLevel);
+  EXPECT_STREQ("metric", units);
+}
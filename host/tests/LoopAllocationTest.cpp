@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <Firebase_ESP_Client.h>
+#include "DeviceRegistration.h"
+#include "DisplayHelpers.h"
+#include "HostRuntime.h"
+#include "StandIns.h"
+
+void loop();
+
+// Diagnostics go up every 5 minutes and allocate their report; windows below end before that
+#define STEADY_FROM_MS 60000UL
+#define STEADY_UNTIL_MS 295000UL
+
+struct Pass {
+  unsigned long atMs;
+  uint64_t allocs;
+};
+
+// One loop() per pass until `untilMs`; passes that allocated, with the RTDB reads made meanwhile
+static std::vector<Pass> runPasses(unsigned long untilMs, uint32_t* reads = nullptr) {
+  std::vector<Pass> allocating;
+  uint32_t before = host::rtdb().reads;
+  while (millis() < untilMs) {
+    Pass pass = { millis(), host::heapCounters().allocs };
+    loop();
+    pass.allocs = host::heapCounters().allocs - pass.allocs;
+    if (pass.allocs) allocating.push_back(pass);
+  }
+  if (reads) *reads = host::rtdb().reads - before;
+  return allocating;
+}
+
+static std::string describe(const std::vector<Pass>& passes) {
+  std::string text;
+  for (const Pass& pass : passes) text += std::to_string(pass.allocs) + " allocs at " + std::to_string(pass.atMs) + " ms\n";
+  return text;
+}
+
+static uint64_t frameHash() {
+  uint64_t h = 1469598103934665603ull;
+  const uint16_t* px = matrix.getBuffer();
+  for (int i = 0; i < PANEL_WIDTH * PANEL_HEIGHT; i++) h = (h ^ px[i]) * 1099511628211ull;
+  return h;
+}
+
+class LoopAllocationTest : public testing::Test {
+protected:
+  void SetUp() override {
+    host::bootDevice();
+    runPasses(STEADY_FROM_MS);  // First app poll and the deferred location check are behind us
+  }
+};
+
+TEST_F(LoopAllocationTest, SteadyStateFramesDontAllocate) {
+  uint64_t frame = frameHash();
+  uint32_t reads = 0;
+  std::vector<Pass> allocating = runPasses(STEADY_UNTIL_MS, &reads);
+  EXPECT_TRUE(allocating.empty()) << describe(allocating);
+  EXPECT_GE(reads, 3u * 40);                // Settings sync every 5 s, plus app and schedule polls
+  EXPECT_NE(frame, frameHash());            // The clock redrew as the minutes turned
+}
+
+TEST_F(LoopAllocationTest, SettingsChangeRedrawDoesntAllocate) {
+  std::string settings = std::string("/novaFrame/devices/") + getMacId() + "/settings";
+  host::rtdb().seed((settings + "/timeFormat").c_str(), "2");
+  host::rtdb().seed((settings + "/brightness").c_str(), "4");
+  host::rtdb().seed((settings + "/units").c_str(), "\"imperial\"");
+  uint64_t frame = frameHash();
+  std::vector<Pass> allocating = runPasses(STEADY_FROM_MS + 20000);
+  EXPECT_TRUE(allocating.empty()) << describe(allocating);
+  EXPECT_EQ(2, timeFormatPreference);
+  EXPECT_NE(frame, frameHash());
+}
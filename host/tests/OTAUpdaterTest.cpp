@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <mbedtls/sha256.h>
+#include <fstream>
+#include <sstream>
+#include "TestSupport.h"
+#include "ClipStore.h"
+#include "OTAUpdater.h"
+
+#define OTA_HOST "novaframe.github.io"
+
+static std::string sha256Hex(const std::string& data) {
+  unsigned char digest[32];
+  mbedtls_sha256((const unsigned char*)data.data(), data.size(), digest, 0);
+  char hex[65];
+  for (int i = 0; i < 32; i++) snprintf(hex + i * 2, 3, "%02x", digest[i]);
+  return hex;
+}
+
+static void putU32(std::string& out, uint32_t v) {
+  for (int i = 0; i < 4; i++) out += (char)(v >> (i * 8));
+}
+
+// NFP1 patch builder, same encoding as tools/make_delta.py
+struct Patch {
+  std::string bytes;
+
+  Patch(size_t newSize, size_t oldSize) : bytes("NFP1") {
+    putU32(bytes, newSize);
+    putU32(bytes, oldSize);
+  }
+  Patch& copy(uint32_t offset, uint32_t len) {
+    bytes += (char)0x01;
+    putU32(bytes, offset);
+    putU32(bytes, len);
+    return *this;
+  }
+  Patch& insert(const std::string& data) {
+    bytes += (char)0x02;
+    putU32(bytes, data.size());
+    bytes += data;
+    return *this;
+  }
+  std::string end() { return bytes + (char)0x00; }
+};
+
+class OTAUpdaterTest : public testing::Test {
+protected:
+  void SetUp() override {
+    connectTestDevice();
+    ASSERT_TRUE(loadTestSecrets(R"({"OTA_JSON_URL":"https://novaframe.github.io/ota/version.json","CURRENT_VERSION":"1.0.0"})"));
+    host::resetUpdate();
+    image.resize(300 * 1024);
+    for (size_t i = 0; i < image.size(); i++) image[i] = (char)(i * 31 + (i >> 9));
+  }
+
+  // version.json names `version` and, when `patch` is set, a patch from 1.0.0. The image drops the
+  // connection after dropAfter bytes for the first `drops` requests.
+  void serve(const char* version, int drops = 0, size_t dropAfter = SIZE_MAX) {
+    host::serveHttp(OTA_HOST, [=](const host::HttpRequest& request) {
+      host::HttpResponse response;
+      if (request.path == "/ota/version.json") {
+        response.body = std::string(R"({"version":")") + version + R"(","url":"https://novaframe.github.io/ota/firmware.bin","sha256":")" +
+                        sha256Hex(image) + R"(")";
+        if (!patch.empty()) response.body += R"(,"patches":{"1.0.0":{"url":"https://novaframe.github.io/ota/1.0.0.patch"}})";
+        response.body += "}";
+        return response;
+      }
+      if (request.path == "/ota/1.0.0.patch") {
+        patchRequests++;
+        response.body = patch;
+        response.bytesPerMs = 64;
+        return response;
+      }
+      ranges.push_back(request.header("range"));
+      response = host::serveBytes(request, image);
+      response.bytesPerMs = 64;
+      if ((int)ranges.size() <= drops) response.dropAfter = dropAfter;
+      return response;
+    });
+  }
+
+  // The running image the patch copies from
+  void installRunningImage(const std::string& running) {
+    memcpy(host::flashData() + host::APP0_OFFSET, running.data(), running.size());
+  }
+
+  // Runs the check to completion on the virtual clock
+  void runCheck() {
+    checkForOTAUpdate();
+    for (int i = 0; i < 600 && host::liveTasks() > baseTasks; i++) host::runFor(100 * 1000);
+  }
+
+  // version.json at the running version, listing `clip`; the clip's body stops after dropAfter bytes
+  void serveClip(const std::string& clip, size_t dropAfter = SIZE_MAX) {
+    host::serveHttp(OTA_HOST, [=](const host::HttpRequest& request) {
+      host::HttpResponse response;
+      if (request.path == "/ota/version.json") {
+        response.body = R"({"version":"1.0.0","url":"https://novaframe.github.io/ota/firmware.bin","sha256":"",)"
+                        R"("clip":{"url":"https://novaframe.github.io/ota/clip.nfc","sha256":")" + sha256Hex(clip) + R"("}})";
+        return response;
+      }
+      response = host::serveBytes(request, clip);
+      response.dropAfter = dropAfter;
+      return response;
+    });
+  }
+
+  // runCheck(), with the loop's side of the clip mapping handoff
+  void runClipCheck() {
+    checkForOTAUpdate();
+    for (int i = 0; i < 600 && host::liveTasks() > baseTasks; i++) {
+      ClipStore::update();
+      host::runFor(100 * 1000);
+    }
+    ClipStore::update();
+  }
+
+  void expectStagedImage() {
+    ASSERT_TRUE(host::stagedImageCommitted());
+    ASSERT_EQ(image.size(), host::stagedImageSize());
+    EXPECT_EQ(0, memcmp(image.data(), host::stagedImage(), image.size()));
+    EXPECT_TRUE(isOTAInProgress());  // Verified, waiting for otaLoop() to reboot
+    EXPECT_EQ("1.1.0", SecretsManager::get("CURRENT_VERSION"));
+  }
+
+  std::string image;
+  std::string patch;
+  int patchRequests = 0;
+  std::vector<std::string> ranges;
+  size_t baseTasks = host::liveTasks();
+};
+
+TEST_F(OTAUpdaterTest, UpToDateCheckLeavesNoLiveAllocations) {
+  serve("1.0.0");
+  runCheck();  // Warm-up: one-time allocations (task bookkeeping, the shim's connection state)
+
+  int64_t liveBlocks = host::heapCounters().liveBlocks;
+  runCheck();
+
+  EXPECT_TRUE(ranges.empty());
+  EXPECT_FALSE(isOTAInProgress());
+  EXPECT_EQ(liveBlocks, host::heapCounters().liveBlocks);
+}
+
+TEST_F(OTAUpdaterTest, ResumesWithRangeAfterDroppedConnections) {
+  serve("1.1.0", 2, 100 * 1024);
+  runCheck();
+
+  ASSERT_EQ(3u, ranges.size());
+  EXPECT_EQ("bytes=0-", ranges[0]);
+  EXPECT_EQ("bytes=102400-", ranges[1]);
+  EXPECT_EQ("bytes=204800-", ranges[2]);
+  expectStagedImage();
+}
+
+TEST_F(OTAUpdaterTest, AppliesPatchAgainstRunningImage) {
+  // The old image is the new one with its middle 50 KB moved to the front and a 4 KB gap
+  std::string running = image.substr(100 * 1024, 50 * 1024) + image.substr(0, 100 * 1024) +
+                        std::string(4096, '\xAA') + image.substr(150 * 1024);
+  installRunningImage(running);
+  patch = Patch(image.size(), running.size())
+              .copy(50 * 1024, 100 * 1024 - 16)
+              .insert(image.substr(100 * 1024 - 16, 16))
+              .copy(0, 50 * 1024)
+              .copy(154 * 1024, 150 * 1024)
+              .end();
+  serve("1.1.0");
+  runCheck();
+
+  EXPECT_EQ(1, patchRequests);
+  EXPECT_TRUE(ranges.empty());  // Never fell back to the full image
+  expectStagedImage();
+}
+
+TEST_F(OTAUpdaterTest, FallsBackToFullImageOnMalformedPatch) {
+  installRunningImage(image);
+  patch = Patch(image.size(), image.size()).copy(0, 200 * 1024).copy(250 * 1024, 100 * 1024).end();  // Past the end
+  serve("1.1.0");
+  runCheck();
+
+  EXPECT_EQ(1, patchRequests);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ("bytes=0-", ranges[0]);
+  expectStagedImage();
+}
+
+TEST_F(OTAUpdaterTest, FallsBackToFullImageOnPatchDigestMismatch) {
+  installRunningImage(image);
+  patch = Patch(image.size(), image.size()).copy(0, 1024).insert("x").copy(1025, image.size() - 1025).end();
+  serve("1.1.0");
+  runCheck();
+
+  EXPECT_EQ(1, patchRequests);
+  EXPECT_EQ(1u, ranges.size());
+  expectStagedImage();
+}
+
+// End to end with the real generator, when Python is around
+TEST_F(OTAUpdaterTest, AppliesPatchFromMakeDelta) {
+  const char* source = getenv("NOVAFRAME_SOURCE_DIR");
+  if (!source || system("python3 --version > /dev/null 2>&1") != 0) GTEST_SKIP() << "needs python3";
+
+  std::string running = image;
+  for (size_t i = 4096; i < running.size(); i += 40000) running[i] ^= 0x5A;  // Scattered one-byte edits
+  running.insert(64 * 1024, std::string(2000, '\x11'));
+  installRunningImage(running);
+
+  std::string dir = testing::TempDir();
+  std::ofstream(dir + "old.bin", std::ios::binary) << running;
+  std::ofstream(dir + "new.bin", std::ios::binary) << image;
+  std::string command = std::string("python3 ") + source + "/tools/make_delta.py " + dir + "old.bin " + dir + "new.bin " + dir + "out.patch";
+  ASSERT_EQ(0, system(command.c_str()));
+  std::stringstream out;
+  out << std::ifstream(dir + "out.patch", std::ios::binary).rdbuf();
+  patch = out.str();
+  ASSERT_LT(patch.size(), image.size() / 4);
+
+  serve("1.1.0");
+  runCheck();
+
+  EXPECT_TRUE(ranges.empty());
+  expectStagedImage();
+}
+
+// The partition is erased before the digest of what it held could be trusted again: a failed
+// download must not leave the old digest behind, or going back to that clip would skip the download
+TEST_F(OTAUpdaterTest, FailedClipDownloadForgetsTheOldClip) {
+  ClipStore::begin();
+  std::string first(64 * 1024, '\x5A'), second(64 * 1024, '\x3C');
+  serveClip(first);
+  runClipCheck();
+  ASSERT_EQ(sha256Hex(first), SecretsManager::get("CLIP_SHA256").c_str());
+
+  serveClip(second, 16 * 1024);
+  runClipCheck();
+  EXPECT_EQ("", SecretsManager::get("CLIP_SHA256"));
+
+  serveClip(first);  // The manifest goes back to the first clip
+  runClipCheck();
+  EXPECT_EQ(sha256Hex(first), SecretsManager::get("CLIP_SHA256").c_str());
+  EXPECT_EQ(0, memcmp(first.data(), host::flashData() + host::CLIPS_OFFSET, first.size()));
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "TestSupport.h"
+#include "DeviceRegistration.h"
+#include "DisplayHelpers.h"
+#include "PowerManager.h"
+#include "StreamReceiver.h"
+#include "TimeCache.h"
+
+extern TimeCache timeCache;
+extern float storedLat;
+extern float storedLon;
+
+class PowerManagerTest : public testing::Test {
+protected:
+  void SetUp() override {
+    connectTestDevice();
+    initializeDisplay();
+    storedLat = 43.6532f;
+    storedLon = -79.3832f;
+    host::serveHttp("api.ipgeolocation.io", [](const host::HttpRequest&) {
+      host::HttpResponse response;
+      response.body = R"({"timezone":"America/Toronto","date":"2025-10-09","time_24":"23:30:00"})";
+      return response;
+    });
+    timeCache.init();
+    host::rtdb().seed(getSettingsPath(SettingsField::ROOT), R"({"nightStart":1320,"nightEnd":420})");
+  }
+
+  // Past the schedule poll interval, then one loop pass
+  void nextPoll() {
+    host::runFor(61 * 1000 * 1000);
+    power.update();
+  }
+
+  PowerManager power;
+};
+
+TEST_F(PowerManagerTest, BlanksDuringTheNightSchedule) {
+  power.update();
+  EXPECT_TRUE(power.isPanelBlanked());
+}
+
+TEST_F(PowerManagerTest, FailedReadKeepsTheSchedule) {
+  power.update();
+  ASSERT_TRUE(power.isPanelBlanked());
+
+  host::rtdb().setOnline(false);
+  nextPoll();
+  EXPECT_TRUE(power.isPanelBlanked());
+}
+
+TEST_F(PowerManagerTest, RemovedScheduleTurnsThePanelBackOn) {
+  power.update();
+  ASSERT_TRUE(power.isPanelBlanked());
+
+  host::rtdb().root.remove(getSettingsPath(SettingsField::NIGHT_START));
+  nextPoll();
+  EXPECT_FALSE(power.isPanelBlanked());
+}
+
+TEST_F(PowerManagerTest, ShortIdlesKeepTheClock) {
+  power.update();
+  int changes = host::cpuFrequencyChanges();
+
+  power.beginIdle(CPU_IDLE_MIN_MS - 1);
+  power.endIdle();
+  EXPECT_EQ(changes, host::cpuFrequencyChanges());
+
+  power.beginIdle(500);
+  EXPECT_EQ(CPU_MHZ_IDLE, (int)getCpuFrequencyMhz());
+  power.endIdle();
+  EXPECT_EQ(CPU_MHZ_ACTIVE, (int)getCpuFrequencyMhz());
+  EXPECT_EQ(changes + 2, host::cpuFrequencyChanges());
+}
+
+TEST_F(PowerManagerTest, IdleRadioSleepsDeeperThanTheCoreDefault) {
+  ASSERT_EQ(WIFI_PS_MIN_MODEM, WiFi.getSleep());
+  power.update();
+  EXPECT_EQ(WIFI_PS_MAX_MODEM, WiFi.getSleep());
+}
+
+TEST_F(PowerManagerTest, LiveStreamKeepsTheRadioAwake) {
+  // Frames held for the DTIM beacon would miss the jitter buffer
+  std::vector<uint8_t> rgb(Panel::pixels * 3, 0x80);
+  for (int i = 0; i < STREAM_START_FRAMES; i++) {
+    streamReceiver.onChunk({ 0, (uint16_t)Panel::pixels, rgb.data(), 0, 0, true });
+    host::runFor(20 * 1000);
+  }
+  ASSERT_TRUE(streamReceiver.isLive());
+  power.update();
+  EXPECT_EQ(WIFI_PS_NONE, WiFi.getSleep());
+}
+
+// Savings are against a stock sketch, which already runs modem sleep: only the deeper mode
+// counts, and an awake radio counts against them
+TEST(PowerPolicyTest, SavingsAreMeasuredAgainstTheCoreDefault) {
+  PowerInputs in = { 600, NIGHT_DISABLED, NIGHT_DISABLED, false, false };
+  PowerState idle = PowerPolicy::evaluate(in);
+  in.networkBusy = true;
+  PowerState busy = PowerPolicy::evaluate(in);
+  PowerState stock;
+
+  EXPECT_EQ(RadioMode::MAX_MODEM_SLEEP, idle.radio);
+  EXPECT_EQ(RadioMode::AWAKE, busy.radio);
+  float baseline = PowerPolicy::estimateMilliamps(stock, false, 0);
+  EXPECT_LT(PowerPolicy::estimateMilliamps(idle, false, 0), baseline);
+  EXPECT_GT(PowerPolicy::estimateMilliamps(busy, false, 0), baseline);
+  EXPECT_EQ(baseline, PowerPolicy::estimateMilliamps({ true, RadioMode::MODEM_SLEEP, CPU_MHZ_IDLE }, false, 0));
+}
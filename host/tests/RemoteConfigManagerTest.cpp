@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "TestSupport.h"
+
+// Calls refreshIfChanged() once a second of virtual time, as loop() does at most
+static void pollFor(uint32_t seconds) {
+  for (uint32_t i = 0; i < seconds; i++) {
+    host::runFor(1000 * 1000);
+    RemoteConfigManager::refreshIfChanged();
+  }
+}
+
+TEST(RemoteConfigManagerTest, FetchesOnceWhenTheVersionIsUnchanged) {
+  connectTestDevice();
+  ASSERT_TRUE(RemoteConfigManager::has(ConfigKey::OPENWEATHER_API_KEY));
+  uint32_t reads = host::rtdb().reads;
+
+  pollFor(20 * 60);
+
+  EXPECT_EQ(4u, host::rtdb().reads - reads);  // One version read per 5 minute poll, no refetch
+}
+
+TEST(RemoteConfigManagerTest, VersionBumpRefetches) {
+  connectTestDevice();
+  host::rtdb().seed("/novaFrame/remoteConfig", R"({"version":2,"OPENWEATHER_API_KEY":"rotated"})");
+
+  pollFor(5 * 60 + 1);
+
+  EXPECT_STREQ("rotated", RemoteConfigManager::getString(ConfigKey::OPENWEATHER_API_KEY));
+}
+
+// No version stamp to read, and the boot fetch failed: the poll must still fetch the config
+TEST(RemoteConfigManagerTest, RetriesAFailedBootFetchWithoutAVersionStamp) {
+  connectTestDevice(R"("not an object")");
+  ASSERT_FALSE(RemoteConfigManager::has(ConfigKey::OPENWEATHER_API_KEY));
+  host::rtdb().seed("/novaFrame/remoteConfig", R"({"OPENWEATHER_API_KEY":"ow-test-key"})");
+
+  pollFor(15);
+
+  EXPECT_STREQ("ow-test-key", RemoteConfigManager::getString(ConfigKey::OPENWEATHER_API_KEY));
+}
+
+TEST(RemoteConfigManagerTest, BootFetchRetriesBackOff) {
+  connectTestDevice(R"("not an object")");
+  host::rtdb().setOnline(false);
+  uint32_t reads = host::rtdb().reads;
+
+  // Retries after 10, 20, 40, 80 and 160 s, then settles on the 5 minute poll interval
+  pollFor(4 * 60);
+  EXPECT_EQ(4u, host::rtdb().reads - reads);
+  pollFor(56 * 60);
+  EXPECT_LE(host::rtdb().reads - reads, 17u);
+
+  host::rtdb().setOnline(true);
+  host::rtdb().seed("/novaFrame/remoteConfig", TEST_REMOTE_CONFIG);
+  pollFor(5 * 60 + 1);
+  EXPECT_TRUE(RemoteConfigManager::has(ConfigKey::OPENWEATHER_API_KEY));
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "HostRuntime.h"
+#include "StreamReceiver.h"
+
+// The receiver fed decoded chunks directly, as the UDP task would after parsing
+
+#define RED 0xF800
+#define BLUE 0x001F
+
+class StreamReceiverTest : public testing::Test {
+protected:
+  std::unique_ptr<StreamReceiver> receiver{ new StreamReceiver() };  // Four full frames: not on the stack
+  std::vector<uint8_t> rgb;
+
+  // One packet's worth of a solid color, covering [offset, offset + count)
+  StreamChunk chunk(uint32_t offset, uint16_t count, uint16_t color, bool frameEnd, uint8_t sequence = 0,
+                    uint16_t universe = 0) {
+    rgb.assign(count * 3, 0);
+    for (uint16_t i = 0; i < count; i++) {
+      rgb[i * 3] = (color >> 8) & 0xF8;
+      rgb[i * 3 + 1] = (color >> 3) & 0xFC;
+      rgb[i * 3 + 2] = (color << 3) & 0xF8;
+    }
+    return { offset, count, rgb.data(), sequence, universe, frameEnd };
+  }
+
+  // A whole frame as two DDP packets, the push flag on the second
+  void sendFrame(uint16_t color, bool lastPacketLost = false) {
+    uint16_t half = Panel::pixels / 2;
+    receiver->onChunk(chunk(0, half, color, false));
+    if (!lastPacketLost) receiver->onChunk(chunk(half, Panel::pixels - half, color, true));
+  }
+
+  // The E1.31 universe's share of the frame
+  StreamChunk universeChunk(uint16_t universe, uint16_t color, uint8_t sequence) {
+    uint32_t offset = (uint32_t)(universe - STREAM_E131_FIRST_UNIVERSE) * STREAM_E131_PIXELS_PER_UNIVERSE;
+    uint16_t count = offset < (uint32_t)Panel::pixels
+                         ? min<uint32_t>(STREAM_E131_PIXELS_PER_UNIVERSE, Panel::pixels - offset)
+                         : STREAM_E131_PIXELS_PER_UNIVERSE;
+    return chunk(offset, count, color, universe == STREAM_E131_FIRST_UNIVERSE + STREAM_E131_UNIVERSES - 1, sequence,
+                 universe);
+  }
+
+  const uint16_t* due() {
+    host::runFor((uint64_t)(STREAM_JITTER_MS + 1) * 1000);
+    return receiver->takeDueFrame();
+  }
+};
+
+TEST_F(StreamReceiverTest, LostFrameEndDoesntTearTheNextFrame) {
+  sendFrame(RED, true);
+  sendFrame(BLUE);
+
+  const uint16_t* frame = due();
+  ASSERT_NE(nullptr, frame);
+  for (int i = 0; i < Panel::pixels; i++) ASSERT_EQ(BLUE, frame[i]) << "pixel " << i << " is from the torn frame";
+  StreamStats stats = receiver->getStats();
+  EXPECT_EQ(1u, stats.frames);
+  EXPECT_EQ(1u, stats.incomplete);
+  receiver->release(frame);
+}
+
+TEST_F(StreamReceiverTest, LostPushAndNextFrameStartIsIncomplete) {
+  // Numbered DDP: the end of one frame and the start of the next both go missing, so the offsets
+  // still line up; the sequence gap gives it away
+  uint16_t half = Panel::pixels / 2;
+  receiver->onChunk(chunk(0, half, RED, false, 1));
+  receiver->onChunk(chunk(half, Panel::pixels - half, BLUE, true, 4));
+  StreamStats stats = receiver->getStats();
+  EXPECT_EQ(1u, stats.frames);
+  EXPECT_EQ(1u, stats.incomplete);
+}
+
+TEST_F(StreamReceiverTest, DdpSequenceWrapIsNotAGap) {
+  // Numbered DDP runs 1..15 and wraps back to 1, skipping 0
+  uint16_t quarter = Panel::pixels / 4;
+  receiver->onChunk(chunk(0, quarter, RED, false, 14));
+  receiver->onChunk(chunk(quarter, quarter, RED, false, 15));
+  receiver->onChunk(chunk(2 * quarter, quarter, RED, false, 1));
+  receiver->onChunk(chunk(3 * quarter, Panel::pixels - 3 * quarter, RED, true, 2));
+  StreamStats stats = receiver->getStats();
+  EXPECT_EQ(1u, stats.frames);
+  EXPECT_EQ(0u, stats.incomplete);
+  EXPECT_EQ(0u, stats.late);
+
+  // And a packet from before the wrap is still late after it
+  receiver->onChunk(chunk(0, quarter, BLUE, false, 15));
+  EXPECT_EQ(1u, receiver->getStats().late);
+}
+
+TEST_F(StreamReceiverTest, E131UniversesKeepTheirOwnSequence) {
+  // A universe past the panel carries the sequence universe 1 is about to use; it mustn't make
+  // universe 1 look late
+  receiver->onChunk(universeChunk(STREAM_E131_FIRST_UNIVERSE + 32, RED, 5));
+  for (uint16_t u = 0; u < STREAM_E131_UNIVERSES; u++) {
+    receiver->onChunk(universeChunk(STREAM_E131_FIRST_UNIVERSE + u, BLUE, 5));
+  }
+  StreamStats stats = receiver->getStats();
+  EXPECT_EQ(0u, stats.late);
+  EXPECT_EQ(1u, stats.frames);
+  EXPECT_EQ(0u, stats.incomplete);
+
+  // A repeat of a universe already applied is late
+  receiver->onChunk(universeChunk(STREAM_E131_FIRST_UNIVERSE, BLUE, 5));
+  EXPECT_EQ(1u, receiver->getStats().late);
+}
+
+// The parsers fed raw datagrams, as they come off the sockets
+
+static std::vector<uint8_t> ddpDatagram(uint8_t flags, uint8_t sequence, uint32_t byteOffset,
+                                        const std::vector<uint8_t>& payload) {
+  std::vector<uint8_t> d = { flags, sequence, 0x01, 0x01,
+                             (uint8_t)(byteOffset >> 24), (uint8_t)(byteOffset >> 16),
+                             (uint8_t)(byteOffset >> 8), (uint8_t)byteOffset,
+                             (uint8_t)(payload.size() >> 8), (uint8_t)payload.size() };
+  if (flags & 0x10) d.insert(d.end(), { 0, 0, 0x12, 0x34 });  // Timecode
+  d.insert(d.end(), payload.begin(), payload.end());
+  return d;
+}
+
+static std::vector<uint8_t> e131Datagram(uint16_t universe, uint8_t sequence, const std::vector<uint8_t>& levels,
+                                         uint8_t options = 0, uint8_t startCode = 0) {
+  std::vector<uint8_t> d(126, 0);
+  memcpy(&d[4], "ASC-E1.17\0\0\0", 12);
+  d[21] = 0x04;        // Root vector: data
+  d[43] = 0x02;        // Framing vector: DMP
+  d[111] = sequence;
+  d[112] = options;
+  d[113] = universe >> 8;
+  d[114] = universe;
+  d[117] = 0x02;       // DMP set property
+  uint16_t properties = levels.size() + 1;
+  d[123] = properties >> 8;
+  d[124] = properties;
+  d[125] = startCode;
+  d.insert(d.end(), levels.begin(), levels.end());
+  return d;
+}
+
+TEST(StreamParserTest, DdpPacketDecodes) {
+  std::vector<uint8_t> payload = { 0xFF, 0, 0, 0, 0, 0xFF };
+  std::vector<uint8_t> d = ddpDatagram(0x41, 7, 30, payload);
+  StreamChunk c;
+  ASSERT_TRUE(parseDdpPacket(d.data(), d.size(), c));
+  EXPECT_EQ(10u, c.pixelOffset);
+  EXPECT_EQ(2u, c.pixelCount);
+  EXPECT_EQ(7, c.sequence);
+  EXPECT_EQ(0, c.universe);
+  EXPECT_TRUE(c.frameEnd);
+  EXPECT_EQ(d.data() + 10, c.rgb);
+
+  d = ddpDatagram(0x40, 0x27, 0, payload);  // Upper nibble is reserved
+  ASSERT_TRUE(parseDdpPacket(d.data(), d.size(), c));
+  EXPECT_EQ(7, c.sequence);
+  EXPECT_FALSE(c.frameEnd);
+}
+
+TEST(StreamParserTest, DdpTimecodeMovesThePayload) {
+  std::vector<uint8_t> d = ddpDatagram(0x51, 1, 0, { 1, 2, 3 });
+  StreamChunk c;
+  ASSERT_TRUE(parseDdpPacket(d.data(), d.size(), c));
+  EXPECT_EQ(d.data() + 14, c.rgb);
+  EXPECT_EQ(1, c.rgb[0]);
+  EXPECT_EQ(1u, c.pixelCount);
+}
+
+TEST(StreamParserTest, BadDdpPacketsAreRejected) {
+  std::vector<uint8_t> payload(6, 0);
+  StreamChunk c;
+  std::vector<uint8_t> d = ddpDatagram(0x41, 1, 0, payload);
+  EXPECT_FALSE(parseDdpPacket(d.data(), 9, c)) << "shorter than the header";
+  EXPECT_FALSE(parseDdpPacket(d.data(), d.size() - 1, c)) << "shorter than its length field";
+  d = ddpDatagram(0x51, 1, 0, payload);
+  EXPECT_FALSE(parseDdpPacket(d.data(), d.size() - 4, c)) << "timecode not accounted for";
+  d = ddpDatagram(0x81, 1, 0, payload);
+  EXPECT_FALSE(parseDdpPacket(d.data(), d.size(), c)) << "version 2";
+  d = ddpDatagram(0x43, 1, 0, payload);
+  EXPECT_FALSE(parseDdpPacket(d.data(), d.size(), c)) << "query";
+  d = ddpDatagram(0x41, 1, 4, payload);
+  EXPECT_FALSE(parseDdpPacket(d.data(), d.size(), c)) << "offset splits a pixel";
+}
+
+TEST(StreamParserTest, E131PacketDecodes) {
+  std::vector<uint8_t> levels = { 0xFF, 0, 0, 0, 0xFF, 0 };
+  std::vector<uint8_t> d = e131Datagram(STREAM_E131_FIRST_UNIVERSE + 1, 200, levels);
+  StreamChunk c;
+  ASSERT_TRUE(parseE131Packet(d.data(), d.size(), c));
+  EXPECT_EQ((uint32_t)STREAM_E131_PIXELS_PER_UNIVERSE, c.pixelOffset);
+  EXPECT_EQ(2u, c.pixelCount);
+  EXPECT_EQ(200, c.sequence);
+  EXPECT_EQ(STREAM_E131_FIRST_UNIVERSE + 1, c.universe);
+  EXPECT_EQ(d.data() + 126, c.rgb);
+  EXPECT_EQ(STREAM_E131_UNIVERSES == 2, c.frameEnd);
+
+  // A full universe: the two spare channels past 170 pixels are ignored
+  d = e131Datagram(STREAM_E131_FIRST_UNIVERSE, 1, std::vector<uint8_t>(512, 0));
+  ASSERT_TRUE(parseE131Packet(d.data(), d.size(), c));
+  EXPECT_EQ(STREAM_E131_PIXELS_PER_UNIVERSE, c.pixelCount);
+}
+
+TEST(StreamParserTest, BadE131PacketsAreRejected) {
+  std::vector<uint8_t> levels(6, 0);
+  StreamChunk c;
+  std::vector<uint8_t> d = e131Datagram(STREAM_E131_FIRST_UNIVERSE, 1, levels, 0x80);
+  EXPECT_FALSE(parseE131Packet(d.data(), d.size(), c)) << "preview data";
+  d = e131Datagram(STREAM_E131_FIRST_UNIVERSE, 1, levels, 0, 0xDD);
+  EXPECT_FALSE(parseE131Packet(d.data(), d.size(), c)) << "non-null start code";
+  d = e131Datagram(STREAM_E131_FIRST_UNIVERSE, 1, levels);
+  EXPECT_FALSE(parseE131Packet(d.data(), d.size() - 1, c)) << "shorter than its property count";
+  EXPECT_FALSE(parseE131Packet(d.data(), 125, c)) << "shorter than the header";
+  d = e131Datagram(0, 1, levels);
+  EXPECT_FALSE(parseE131Packet(d.data(), d.size(), c)) << "universe 0";
+  d = e131Datagram(STREAM_E131_FIRST_UNIVERSE, 1, levels);
+  d[4] = 'X';
+  EXPECT_FALSE(parseE131Packet(d.data(), d.size(), c)) << "not ACN";
+  d = e131Datagram(STREAM_E131_FIRST_UNIVERSE, 1, levels);
+  d[43] = 0x03;
+  EXPECT_FALSE(parseE131Packet(d.data(), d.size(), c)) << "sync packet";
+}
@@ -0,0 +1,10 @@
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include "HostRuntime.h"
+
+// Firmware logging is muted unless NOVAFRAME_SERIAL is set, so failures aren't buried in emoji
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  host::setSerialEcho(getenv("NOVAFRAME_SERIAL") != nullptr);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,41 @@
+// TestSupport.h
+#pragma once
+
+// Shared setup for the host test suites: a connected network and a signed-in RTDB holding the
+// global remote config, as the device has after setup().
+
+#include <Firebase_ESP_Client.h>
+#include <HTTPClient.h>
+#include <WiFi.h>
+#include "HostFlash.h"
+#include "HostRuntime.h"
+#include "RemoteConfigManager.h"
+#include "SecretsManager.h"
+
+#define TEST_REMOTE_CONFIG \
+  R"({"version":1,"OPENWEATHER_API_KEY":"ow-test-key","IP_GEO_LOCATION_API_KEY":"geo-test-key"})"
+
+inline void connectTestDevice(const char* remoteConfig = TEST_REMOTE_CONFIG) {
+  host::resetWifi();
+  host::clearHttpServers();
+  host::resetHttpRequestCounts();
+  WiFi.begin();
+  host::runFor((uint64_t)host::wifi().connectDelayMs * 1000);
+
+  host::rtdb().reset();
+  host::rtdb().seed("/novaFrame/remoteConfig", remoteConfig);
+  FirebaseConfig config;
+  FirebaseAuth auth;
+  Firebase.begin(&config, &auth);
+  RemoteConfigManager::begin();
+}
+
+// Secrets as a fresh device has them: the legacy JSON blob at the start of the secrets region, which
+// SecretsManager::load() migrates into its log
+#define TEST_SECRETS_OFFSET 0x490000
+
+inline bool loadTestSecrets(const char* json) {
+  host::eraseFlash();
+  memcpy(host::flashData() + TEST_SECRETS_OFFSET, json, strlen(json) + 1);
+  return SecretsManager::load();
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "TestSupport.h"
+#include "TimeCache.h"
+
+extern int timeFormatPreference;
+extern float storedLat;
+extern float storedLon;
+extern char storedTimezone[];
+
+// ipgeolocation stand-in answering with a fixed wall-clock time
+static std::string lastQuery;
+static void serveTimezone(int status, const char* date, const char* time24) {
+  host::serveHttp("api.ipgeolocation.io", [=](const host::HttpRequest& request) {
+    lastQuery = request.path;
+    host::HttpResponse response;
+    response.status = status;
+    response.body = std::string(R"({"timezone":"America/Toronto","date":")") + date + R"(","time_24":")" + time24 + "\"}";
+    return response;
+  });
+}
+
+class TimeCacheTest : public testing::Test {
+protected:
+  void SetUp() override {
+    connectTestDevice();
+    storedLat = 43.6532f;
+    storedLon = -79.3832f;
+    storedTimezone[0] = '\0';
+    timeFormatPreference = 2;
+    serveTimezone(200, "2025-10-09", "13:04:58");
+  }
+
+  TimeCache cache;
+};
+
+TEST_F(TimeCacheTest, InitSyncsFromTheTimezoneService) {
+  EXPECT_FALSE(cache.isSynced());
+  cache.init();
+  ASSERT_TRUE(cache.isSynced());
+  EXPECT_EQ(1u, host::httpRequestCount("api.ipgeolocation.io"));
+  EXPECT_NE(std::string::npos, lastQuery.find("apiKey=geo-test-key"));
+  EXPECT_NE(std::string::npos, lastQuery.find("&lat=43.6532&long=-79.3832"));
+
+  char buf[16];
+  cache.formatCurrentTime(buf, sizeof(buf));
+  EXPECT_STREQ("13:04:58", buf);
+}
+
+TEST_F(TimeCacheTest, CachedZoneReplacesTheCoordinateLookup) {
+  strcpy(storedTimezone, "America/Toronto");
+  cache.init();
+  EXPECT_NE(std::string::npos, lastQuery.find("&tz=America/Toronto"));
+  EXPECT_EQ(std::string::npos, lastQuery.find("&lat="));
+}
+
+TEST_F(TimeCacheTest, FailedFetchLeavesTheClockUnsynced) {
+  serveTimezone(500, "", "");
+  cache.init();
+  EXPECT_FALSE(cache.isSynced());
+  EXPECT_EQ(0, cache.now());
+}
+
+TEST_F(TimeCacheTest, TimeAdvancesWithMillis) {
+  cache.init();
+  host::advanceMicros(2500 * 1000ULL);  // 13:05:00.5
+  EXPECT_EQ(13, cache.getHour());
+  EXPECT_EQ(5, cache.getMinute());
+  char buf[16];
+  cache.formatCurrentTime(buf, sizeof(buf));
+  EXPECT_STREQ("13:05:00", buf);
+}
+
+TEST_F(TimeCacheTest, DeadlinesLandOnTheNextSecondAndMinute) {
+  cache.init();
+  host::advanceMicros(300 * 1000ULL);  // 13:04:58.3
+  EXPECT_EQ(700u, cache.msUntilNextSecond());
+  EXPECT_EQ(1700u, cache.msUntilNextMinute());
+
+  host::advanceMicros(1700 * 1000ULL);  // Exactly on the minute
+  EXPECT_EQ(5, cache.getMinute());
+  EXPECT_EQ(60000u, cache.msUntilNextMinute());
+}
+
+TEST_F(TimeCacheTest, BrokenDownTimeIsReusedWithinASecond) {
+  cache.init();
+  const struct tm* first = &cache.getTimeInfo();
+  int second = first->tm_sec;
+  host::advanceMicros(400 * 1000ULL);
+  EXPECT_EQ(second, cache.getTimeInfo().tm_sec);
+  host::advanceMicros(700 * 1000ULL);
+  EXPECT_EQ((second + 1) % 60, cache.getTimeInfo().tm_sec);
+}
+
+TEST_F(TimeCacheTest, FormatFollowsThePreference) {
+  cache.init();
+  char buf[16];
+  timeFormatPreference = 2;
+  cache.formatTime(buf, sizeof(buf));
+  EXPECT_STREQ("13:04", buf);
+
+  timeFormatPreference = 1;
+  cache.formatTime(buf, sizeof(buf));
+  EXPECT_STREQ("1:04", buf);
+
+  timeFormatPreference = 0;
+  cache.formatTime(buf, sizeof(buf));
+  EXPECT_STREQ("1:04 PM", buf);
+  EXPECT_EQ(String(buf), cache.getFormattedTime());
+}
+
+TEST_F(TimeCacheTest, DigitsComeWithoutTheSuffix) {
+  cache.init();
+  char buf[16];
+  timeFormatPreference = 0;
+  EXPECT_STREQ("PM", cache.formatTimeDigits(buf, sizeof(buf)));
+  EXPECT_STREQ("1:04", buf);
+
+  timeFormatPreference = 1;
+  EXPECT_STREQ("", cache.formatTimeDigits(buf, sizeof(buf)));
+  EXPECT_STREQ("1:04", buf);
+
+  timeFormatPreference = 2;
+  EXPECT_STREQ("", cache.formatTimeDigits(buf, sizeof(buf)));
+  EXPECT_STREQ("13:04", buf);
+}
+
+TEST_F(TimeCacheTest, FormatTimeDoesNotAllocate) {
+  cache.init();
+  char buf[16];
+  cache.formatTime(buf, sizeof(buf));
+
+  host::HeapCounters before = host::heapCounters();
+  for (int i = 0; i < 100; i++) {
+    host::advanceMicros(1000 * 1000ULL);
+    cache.formatTime(buf, sizeof(buf));
+    cache.formatCurrentTime(buf, sizeof(buf));
+  }
+  EXPECT_EQ(before.allocs, host::heapCounters().allocs);
+}
+
+TEST_F(TimeCacheTest, ResyncWaitsForTheConfiguredInterval) {
+  cache.init();
+  host::advanceMicros(60 * 60 * 1000000ULL);
+  cache.updateIfNeeded();
+  EXPECT_EQ(1u, host::httpRequestCount("api.ipgeolocation.io"));
+
+  host::advanceMicros(5 * 60 * 60 * 1000000ULL + 1000);
+  cache.updateIfNeeded();
+  EXPECT_EQ(2u, host::httpRequestCount("api.ipgeolocation.io"));
+}
+
+TEST_F(TimeCacheTest, FailedFetchIsRetriedWithBackoff) {
+  serveTimezone(500, "", "");
+  cache.init();
+  cache.updateIfNeeded();
+  EXPECT_EQ(1u, host::httpRequestCount("api.ipgeolocation.io")) << "retried without waiting";
+
+  host::advanceMicros((TIME_RETRY_MIN_MS + 1) * 1000ULL);
+  cache.updateIfNeeded();
+  EXPECT_EQ(2u, host::httpRequestCount("api.ipgeolocation.io"));
+  host::advanceMicros((TIME_RETRY_MIN_MS + 1) * 1000ULL);
+  cache.updateIfNeeded();
+  EXPECT_EQ(2u, host::httpRequestCount("api.ipgeolocation.io")) << "the wait didn't double";
+
+  serveTimezone(200, "2025-10-09", "13:04:58");
+  host::advanceMicros(TIME_RETRY_MIN_MS * 1000ULL);
+  cache.updateIfNeeded();
+  EXPECT_EQ(3u, host::httpRequestCount("api.ipgeolocation.io"));
+  EXPECT_TRUE(cache.isSynced());
+
+  // Synced: back on the 6-hourly schedule
+  host::advanceMicros(60 * 60 * 1000000ULL);
+  cache.updateIfNeeded();
+  EXPECT_EQ(3u, host::httpRequestCount("api.ipgeolocation.io"));
+}
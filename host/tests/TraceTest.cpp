@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "HostRuntime.h"
+#include "Trace.h"
+
+// delay() is the only thing that moves the virtual clock here, so every span lasts exactly what it waits
+TEST(TraceTest, NestedSpansReportSelfTime) {
+  {
+    TRACE_SCOPE(NETWORK);
+    delay(10);
+    {
+      TRACE_SCOPE(PARSE);
+      delay(30);
+      {
+        TRACE_SCOPE(APP_LOOP);
+        delay(4);
+      }
+    }
+    delay(5);
+  }
+
+  const TraceStats& network = Tracer::getStats(TraceSpan::NETWORK);
+  const TraceStats& parse = Tracer::getStats(TraceSpan::PARSE);
+  const TraceStats& appLoop = Tracer::getStats(TraceSpan::APP_LOOP);
+  EXPECT_EQ(49000u, network.totalMicros);
+  EXPECT_EQ(15000u, network.selfMicros);
+  EXPECT_EQ(34000u, parse.totalMicros);
+  EXPECT_EQ(30000u, parse.selfMicros);
+  EXPECT_EQ(4000u, appLoop.selfMicros);
+}
+
+TEST(TraceTest, SiblingsAddUpInTheParent) {
+  {
+    TRACE_SCOPE(REDRAW);
+    for (int i = 0; i < 3; i++) {
+      TRACE_SCOPE(PRESENT);
+      delay(2);
+    }
+    delay(1);
+  }
+  EXPECT_EQ(7000u, Tracer::getStats(TraceSpan::REDRAW).totalMicros);
+  EXPECT_EQ(1000u, Tracer::getStats(TraceSpan::REDRAW).selfMicros);
+  EXPECT_EQ(6000u, Tracer::getStats(TraceSpan::PRESENT).selfMicros);
+}
+
+TEST(TraceTest, SlowPassBlamesTheInnermostSpan) {
+  host::setSerialCapture(true);
+  delay(1);  // A pass starting at micros() == 0 reads as "no pass open"
+  Tracer::beginPass();
+  {
+    TRACE_SCOPE(NETWORK);
+    delay(100);
+    TRACE_SCOPE(PARSE);
+    delay(450);
+  }
+  Tracer::endPass();
+  std::string log = host::takeSerialOutput();
+  host::setSerialCapture(false);
+
+  EXPECT_NE(std::string::npos, log.find("mostly parse (450 ms)")) << log;
+}
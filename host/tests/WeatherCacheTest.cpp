@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "TestSupport.h"
+#include "WeatherCache.h"
+#include "HourlyForecast.h"
+
+extern float storedLat;
+extern float storedLon;
+extern unsigned long lastWeatherFetchTime;
+extern unsigned long lastWeatherAttemptTime;
+
+// One Call response padded with a large block the filter drops, as the real "minutely" array is
+static std::string oneCallBody() {
+  std::string body = R"({"lat":43.65,"lon":-79.38,"current":{"temp":12.34,"feels_like":11.02,"weather":[{"icon":"03d"}]},)";
+  body += R"("hourly":[)";
+  for (int i = 0; i < 48; i++) {
+    char hour[160];
+    snprintf(hour, sizeof(hour), R"(%s{"dt":%d,"temp":%d.5,"pop":0.25,"humidity":80,"weather":[{"id":800,"icon":"01d"}]})",
+             i ? "," : "", 1760000400 + i * 3600, i);
+    body += hour;
+  }
+  body += R"(],"padding":[)";
+  for (int i = 0; i < 2000; i++) body += i ? ",{\"dt\":1760000400,\"precipitation\":0}" : "{\"dt\":1760000400,\"precipitation\":0}";
+  body += R"(],"daily":[{"dt":1760000400,"temp":{"max":15.0,"min":6.0},"weather":[{"icon":"01d"}]},)";
+  body += R"({"dt":1760086800,"temp":{"max":17.5,"min":8.0},"weather":[{"icon":"10d"}]}]})";
+  return body;
+}
+
+class WeatherCacheTest : public testing::Test {
+protected:
+  void SetUp() override {
+    connectTestDevice();
+    storedLat = 43.6532f;
+    storedLon = -79.3832f;
+    weatherData = WeatherData();
+    lastWeatherFetchTime = 0;
+    lastWeatherAttemptTime = 0;
+    body = oneCallBody();
+  }
+
+  void serve(uint32_t bytesPerMs, size_t dropAfter = SIZE_MAX) {
+    host::serveHttp("api.openweathermap.org", [=](const host::HttpRequest& request) {
+      http10 = request.http10;
+      host::HttpResponse response;
+      response.body = body;
+      response.bytesPerMs = bytesPerMs;
+      response.dropAfter = dropAfter;
+      return response;
+    });
+  }
+
+  std::string body;
+  bool http10 = false;
+};
+
+TEST_F(WeatherCacheTest, ParsesTheResponseOffTheStream) {
+  serve(16);  // ~4 s on the virtual clock for the whole body
+  updateWeatherCache();
+
+  EXPECT_TRUE(http10);
+  EXPECT_EQ(123, weatherData.temp10);
+  EXPECT_EQ(110, weatherData.feelsLike10);
+  EXPECT_EQ(175, weatherData.tomorrow.high10);
+  EXPECT_EQ(48u, hourlyForecast.size());
+  EXPECT_NE(0u, lastWeatherFetchTime);
+}
+
+TEST_F(WeatherCacheTest, NeverHoldsThePayloadInRam) {
+  ASSERT_GT(body.size(), 60000u);
+  serve(0);
+  host::HeapCounters before = host::heapCounters();
+  updateWeatherCache();
+  host::HeapCounters after = host::heapCounters();
+
+  ASSERT_EQ(123, weatherData.temp10);
+  // Only the filtered document and the small request strings; a payload String would be 60 KB more
+  EXPECT_LT(after.allocBytes - before.allocBytes, 12288u * 4 + 4096);
+}
+
+TEST_F(WeatherCacheTest, TruncatedResponseKeepsTheOldDataAndRetries) {
+  serve(0, body.size() / 2);
+  updateWeatherCache();
+  EXPECT_EQ(WEATHER_NO_VALUE, weatherData.temp10);
+  EXPECT_EQ(0u, lastWeatherFetchTime);
+
+  serve(0);
+  updateWeatherCache();  // Too soon after the failure
+  EXPECT_EQ(1u, host::httpRequestCount("api.openweathermap.org"));
+  host::runFor((uint64_t)msUntilWeatherRefresh() * 1000);
+  updateWeatherCache();
+  EXPECT_EQ(123, weatherData.temp10);
+  EXPECT_EQ(2u, host::httpRequestCount("api.openweathermap.org"));
+}
+
+// A steady-state refresh, measured on the host heap: 19 allocations, 50 KB allocated, a 49 KB peak
+// (the 12 KB document plus the HTTP client), and nothing kept once the parse is done. The parsed
+// weather is all fixed-size fields, so a refresh can't leave blocks behind to fragment the heap.
+#define WEATHER_REFRESH_MAX_ALLOCS 24
+#define WEATHER_REFRESH_MAX_PEAK_BYTES (52 * 1024)
+
+TEST_F(WeatherCacheTest, RefreshAllocationsArePinned) {
+  serve(0);
+  updateWeatherCache();  // Warm-up: one-time allocations
+  ASSERT_EQ(123, weatherData.temp10);
+  host::runFor((uint64_t)msUntilWeatherRefresh() * 1000);
+
+  host::resetHeapBaseline();
+  host::HeapCounters before = host::heapCounters();
+  updateWeatherCache();
+  host::HeapCounters after = host::heapCounters();
+
+  ASSERT_EQ(2u, host::httpRequestCount("api.openweathermap.org"));
+  EXPECT_LE(after.allocs - before.allocs, (uint64_t)WEATHER_REFRESH_MAX_ALLOCS);
+  EXPECT_LE(host::DEVICE_HEAP_BYTES - host::modelledMinFreeHeap(), (size_t)WEATHER_REFRESH_MAX_PEAK_BYTES);
+  EXPECT_EQ(0, after.liveBlocks - before.liveBlocks);
+  EXPECT_EQ(0, after.liveBytes - before.liveBytes);
+}
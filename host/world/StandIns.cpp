@@ -0,0 +1,124 @@
+#include "StandIns.h"
+#include <HTTPClient.h>
+#include <Firebase_ESP_Client.h>
+#include <WiFi.h>
+#include <mbedtls/sha256.h>
+#include <time.h>
+#include "HostFlash.h"
+#include "HostRuntime.h"
+
+void setup();
+
+#define SECRETS_OFFSET 0x490000   // SecretsManager.cpp
+
+static host::CloudOptions options;
+
+static const char* DEVICE_SECRETS = R"({"FIREBASE_API_KEY":"fb-test-key","FIREBASE_HOST":"novaframe-test.firebaseio.com",)"
+                                    R"("FIREBASE_EMAIL":"device@novaframe.test","FIREBASE_PASSWORD":"hunter2",)"
+                                    R"("OTA_JSON_URL":"https://novaframe.github.io/ota/version.json","CURRENT_VERSION":"1.0.0",)"
+                                    R"("LAN_API_TOKEN":"lan-test-token"})";
+
+static const char* REMOTE_CONFIG =
+    R"({"version":1,"OPENWEATHER_API_KEY":"ow-standin-key","IP_GEO_LOCATION_API_KEY":"geo-standin-key"})";
+
+const host::CloudOptions& host::cloudOptions() { return options; }
+
+static int64_t utcNow() { return options.utcAtZero + (int64_t)(host::nowMicros() / 1000000); }
+
+static host::HttpResponse respond(const std::string& body, const char* contentType = "application/json") {
+  host::HttpResponse response;
+  response.headers["content-type"] = contentType;
+  response.body = body;
+  response.latencyMs = options.latencyMs;
+  response.bytesPerMs = options.bytesPerMs;
+  return response;
+}
+
+std::string host::oneCallResponse() {
+  int64_t hour = utcNow() / 3600 * 3600;
+  std::string body;
+  char part[192];
+  snprintf(part, sizeof(part),
+           R"({"lat":43.6532,"lon":-79.3832,"timezone_offset":%d,"current":{"dt":%lld,"temp":12.34,"feels_like":11.02,"humidity":71,"weather":[{"id":802,"icon":"03d"}]},"hourly":[)",
+           options.utcOffsetMinutes * 60, (long long)utcNow());
+  body += part;
+  for (int i = 0; i < 48; i++) {
+    snprintf(part, sizeof(part), R"(%s{"dt":%lld,"temp":%.2f,"pop":%.2f,"humidity":%d,"weather":[{"id":800,"icon":"01d"}]})",
+             i ? "," : "", (long long)(hour + i * 3600), 10.0 + (i % 24) * 0.4, (i % 7) / 10.0, 60 + i % 30);
+    body += part;
+  }
+  body += R"(],"daily":[)";
+  for (int i = 0; i < 8; i++) {
+    snprintf(part, sizeof(part), R"(%s{"dt":%lld,"temp":{"min":%.1f,"max":%.1f},"pop":0.2,"weather":[{"id":500,"icon":"10d"}]})",
+             i ? "," : "", (long long)(hour + i * 86400), 6.0 + i, 15.0 + i);
+    body += part;
+  }
+  body += "]}";
+  return body;
+}
+
+static std::string sha256Hex(const std::string& data) {
+  unsigned char digest[32];
+  mbedtls_sha256((const unsigned char*)data.data(), data.size(), digest, 0);
+  char hex[65];
+  for (int i = 0; i < 32; i++) snprintf(hex + i * 2, 3, "%02x", digest[i]);
+  return hex;
+}
+
+void host::serveCloud(const CloudOptions& cloud) {
+  options = cloud;
+
+  serveHttp("api.openweathermap.org", [](const HttpRequest&) { return respond(oneCallResponse()); });
+
+  // ipgeolocation: local wall time for the zone
+  serveHttp("api.ipgeolocation.io", [](const HttpRequest&) {
+    time_t local = (time_t)(utcNow() + options.utcOffsetMinutes * 60);
+    struct tm t;
+    gmtime_r(&local, &t);
+    char body[160];
+    snprintf(body, sizeof(body), R"({"timezone":"America/Toronto","date":"%04d-%02d-%02d","time_24":"%02d:%02d:%02d"})",
+             t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec);
+    return respond(body);
+  });
+
+  serveHttp("ip-api.com", [](const HttpRequest&) {
+    return respond(R"({"status":"success","query":")" STANDIN_PUBLIC_IP
+                   R"(","lat":43.6532,"lon":-79.3832,"timezone":"America/Toronto","city":"Toronto","region":"ON"})");
+  });
+
+  serveHttp("api.ipify.org", [](const HttpRequest&) { return respond(STANDIN_PUBLIC_IP, "text/plain"); });
+
+  // GitHub Pages: the manifest and the image it names
+  serveHttp(STANDIN_OTA_HOST, [](const HttpRequest& request) {
+    static std::string image(64 * 1024, '\x5A');
+    if (request.path == "/ota/version.json") {
+      return respond(R"({"version":")" + options.firmwareVersion + R"(","url":"https://)" STANDIN_OTA_HOST
+                     R"(/ota/firmware.bin","sha256":")" + sha256Hex(image) + R"("})");
+    }
+    if (request.path == "/ota/firmware.bin") {
+      HttpResponse response = serveBytes(request, image);
+      response.latencyMs = options.latencyMs;
+      response.bytesPerMs = options.bytesPerMs;
+      return response;
+    }
+    HttpResponse missing = respond("Not Found", "text/plain");
+    missing.status = 404;
+    return missing;
+  });
+}
+
+void host::provisionDevice() {
+  eraseFlash();
+  memcpy(flashData() + SECRETS_OFFSET, DEVICE_SECRETS, strlen(DEVICE_SECRETS) + 1);
+  resetWifi();
+  clearHttpServers();
+  resetHttpRequestCounts();
+  rtdb().reset();
+  rtdb().seed("/novaFrame/remoteConfig", REMOTE_CONFIG);
+}
+
+void host::bootDevice(const CloudOptions& cloud) {
+  provisionDevice();
+  serveCloud(cloud);
+  setup();
+}
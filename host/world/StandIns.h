@@ -0,0 +1,37 @@
+// StandIns.h
+#pragma once
+
+// The world the whole sketch runs in on the host: stand-ins for every external service it talks
+// to, a provisioned device (secrets in flash, Wi-Fi credentials, remote config in the RTDB), and
+// setup() run against them. Shared by the tests that boot the full sketch and the simulator.
+
+#include <stdint.h>
+#include <string>
+
+namespace host {
+
+#define STANDIN_OTA_HOST "novaframe.github.io"
+#define STANDIN_PUBLIC_IP "203.0.113.7"
+
+struct CloudOptions {
+  int64_t utcAtZero = 1760000400;          // 2025-10-09 09:00 UTC at virtual time 0
+  int utcOffsetMinutes = -4 * 60;          // Toronto in October
+  std::string firmwareVersion = "1.0.0";   // What version.json advertises
+  uint32_t latencyMs = 80;                 // Every HTTP stand-in
+  uint32_t bytesPerMs = 256;               // ~2 Mbit/s body pacing
+};
+
+// Registers handlers for OpenWeather, ipgeolocation, ip-api, ipify and GitHub Pages
+void serveCloud(const CloudOptions& options = CloudOptions());
+const CloudOptions& cloudOptions();
+
+// Wi-Fi, flash secrets and RTDB remote config as a provisioned device has them
+void provisionDevice();
+
+// provisionDevice() + serveCloud() + setup(). The caller then calls loop() repeatedly.
+void bootDevice(const CloudOptions& options = CloudOptions());
+
+// A One Call 3.0 response for the stand-in's current virtual time
+std::string oneCallResponse();
+
+}  // namespace host
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Compares NovaFrame on-device benchmark output against a baseline.
+
+Usage: bench_compare.py SERIAL.log [--baseline FILE] [--write-baseline] [--threshold PCT]
+
+Build with NOVAFRAME_BENCH set to 1 (Benchmarks.h), capture the serial output
+at boot, and pass the log here. Every "BENCH {...}" line is one result.
+A benchmark regresses when ns/op grows by more than the threshold (10% by
+default) or when it makes more heap allocations, or asks for more bytes, per
+op than the baseline. Allocations are counted by the IDF heap hooks; results
+from a build without them ("heap_hooks": false) only see retained growth, so
+those two columns are compared only between runs of the same kind. The exit
+status is 1 on any regression, so this can gate a release build.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "bench_baseline.json")
+
+
+def read_results(path):
+    results = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            marker = line.find("BENCH {")
+            if marker < 0:
+                continue
+            entry = json.loads(line[marker + len("BENCH "):])
+            results[entry["name"]] = entry
+    return results
+
+
+def heap(entry):
+    """(allocs/op, bytes/op, counted by hooks) — older logs only carry the net change"""
+    if "allocs_op" in entry:
+        return entry["allocs_op"], entry["bytes_op"], entry.get("heap_hooks", False)
+    return entry["net_allocs_op"], entry["net_bytes_op"], False
+
+
+def compare(current, baseline, threshold):
+    regressions = 0
+    print("%-24s %12s %12s %8s %8s %10s %10s" % (
+        "benchmark", "base ns/op", "ns/op", "change", "px/us", "allocs/op", "bytes/op"))
+    for name, cur in sorted(current.items()):
+        allocs, size, hooks = heap(cur)
+        pixels = "%.1f" % cur["px_us"] if cur.get("px_us") else "-"  # Fill and blit kernels only
+        base = baseline.get(name)
+        if base is None:
+            print("%-24s %12s %12.1f %8s %8s %10.3f %10.1f  (new)" % (name, "-", cur["ns_op"], "-", pixels, allocs, size))
+            continue
+
+        change = 100.0 * (cur["ns_op"] - base["ns_op"]) / base["ns_op"] if base["ns_op"] else 0.0
+        flags = []
+        if change > threshold:
+            flags.append("SLOWER")
+        base_allocs, base_size, base_hooks = heap(base)
+        if hooks != base_hooks:
+            flags.append("heap %s vs %s" % ("hooks" if hooks else "net", "hooks" if base_hooks else "net"))
+        elif allocs > base_allocs or size > base_size:
+            flags.append("HEAP")
+        if cur.get("cpu_mhz") != base.get("cpu_mhz"):
+            flags.append("clock %s vs %s MHz" % (cur.get("cpu_mhz"), base.get("cpu_mhz")))
+        if "SLOWER" in flags or "HEAP" in flags:
+            regressions += 1
+
+        print("%-24s %12.1f %12.1f %+7.1f%% %8s %10.3f %10.1f  %s" % (
+            name, base["ns_op"], cur["ns_op"], change, pixels, allocs, size, " ".join(flags)))
+
+    for name in sorted(set(baseline) - set(current)):
+        print("%-24s missing from this run" % name)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("log")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE)
+    parser.add_argument("--write-baseline", action="store_true")
+    parser.add_argument("--threshold", type=float, default=10.0)
+    args = parser.parse_args()
+
+    current = read_results(args.log)
+    if not current:
+        print("No BENCH lines found in %s" % args.log, file=sys.stderr)
+        return 1
+
+    if args.write_baseline:
+        with open(args.baseline, "w") as f:
+            json.dump(current, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("Wrote %d results to %s" % (len(current), args.baseline))
+        return 0
+
+    if not os.path.exists(args.baseline):
+        print("No baseline at %s — run again with --write-baseline" % args.baseline, file=sys.stderr)
+        return 1
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+
+    regressions = compare(current, baseline, args.threshold)
+    print("%d regression(s)" % regressions)
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
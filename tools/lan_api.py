@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Talks to a NovaFrame's LAN API from a Linux host.
+
+Usage:
+  lan_api.py [--token T] HOST settings                 # GET /api/settings
+  lan_api.py HOST metrics                  # GET /api/metrics
+  lan_api.py HOST set KEY=VALUE [...]      # PUT /api/settings, e.g. brightness=4 units=imperial
+  lan_api.py HOST app NAME                 # POST /api/app?name=NAME
+  lan_api.py HOST check                    # Round-trips a brightness change and times it
+
+HOST is the board's IP or its mDNS name (novaframe-XXXX.local, printed at boot).
+Writes (set, app, check) need the device's LAN_API_TOKEN secret, from --token or
+$NOVAFRAME_LAN_TOKEN; a device without one provisioned only serves reads.
+Writes are accepted with 202 and applied on the device's next loop pass, then
+written back to the Firebase settings node by the device itself.
+"""
+
+import argparse
+import json
+import os
+import sys
+import time
+import urllib.error
+import urllib.parse
+import urllib.request
+
+
+TOKEN = None
+
+
+def request(host, method, path, body=None):
+    data = json.dumps(body).encode() if body is not None else None
+    headers = {"Content-Type": "application/json"}
+    if TOKEN:
+        headers["Authorization"] = "Bearer " + TOKEN
+    req = urllib.request.Request("http://%s%s" % (host, path), data=data, method=method, headers=headers)
+    try:
+        with urllib.request.urlopen(req, timeout=5) as resp:
+            return resp.status, json.loads(resp.read() or b"{}")
+    except urllib.error.HTTPError as e:
+        return e.code, json.loads(e.read() or b"{}")
+
+
+def parse_value(text):
+    try:
+        return int(text)
+    except ValueError:
+        return text
+
+
+def check(host):
+    status, before = request(host, "GET", "/api/settings")
+    if status != 200:
+        print("GET /api/settings failed: %d %s" % (status, before))
+        return 1
+    original = before["brightness"]
+    target = 1 if original != 1 else 2
+
+    start = time.monotonic()
+    status, body = request(host, "PUT", "/api/settings", {"brightness": target})
+    if status != 202:
+        print("PUT rejected: %d %s" % (status, body))
+        return 1
+    while time.monotonic() - start < 5:
+        _, now = request(host, "GET", "/api/settings")
+        if now["brightness"] == target:
+            print("brightness %d -> %d visible after %.0f ms" % (original, target, (time.monotonic() - start) * 1000))
+            break
+        time.sleep(0.05)
+    else:
+        print("brightness change not visible after 5 s")
+        return 1
+
+    status, _ = request(host, "PUT", "/api/settings", {"brightness": 0})
+    print("out-of-range brightness -> %d (expect 400)" % status)
+    request(host, "PUT", "/api/settings", {"brightness": original})
+    return 0 if status == 400 else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--token", default=os.environ.get("NOVAFRAME_LAN_TOKEN"),
+                        help="LAN_API_TOKEN for writes (default $NOVAFRAME_LAN_TOKEN)")
+    parser.add_argument("host")
+    parser.add_argument("command", choices=["settings", "metrics", "set", "app", "check"])
+    parser.add_argument("args", nargs="*")
+    args = parser.parse_args()
+    global TOKEN
+    TOKEN = args.token
+
+    if args.command == "check":
+        return check(args.host)
+    if args.command == "settings":
+        status, body = request(args.host, "GET", "/api/settings")
+    elif args.command == "metrics":
+        status, body = request(args.host, "GET", "/api/metrics")
+    elif args.command == "set":
+        changes = dict((k, parse_value(v)) for k, v in (a.split("=", 1) for a in args.args))
+        status, body = request(args.host, "PUT", "/api/settings", changes)
+    else:
+        if not args.args:
+            parser.error("app needs a NAME")
+        status, body = request(args.host, "POST", "/api/app?name=" + urllib.parse.quote(args.args[0]))
+
+    print(json.dumps(body, indent=2))
+    return 0 if 200 <= status < 300 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""Converts a GIF or a PNG sequence into a NovaFrame clip ("NFC1", see ClipStore.h).
+
+Usage:
+  make_clip.py INPUT... -o clip.nfc [--size 64x32] [--loops N] [--delay MS]
+  make_clip.py --info clip.nfc
+  make_clip.py --selftest
+
+INPUT is one animated GIF or several still images (frames in argument order,
+--delay apart). Reading images needs Pillow; --info and --selftest do not.
+
+Colours are reduced to RGB565 and a shared palette of at most 256 entries.
+Each frame stores only the band of rows that changed since the previous one,
+RLE-coded per row, so static backgrounds cost nothing after the first frame.
+
+To publish a clip, host the .nfc file and add it to version.json:
+  "clip": { "url": "https://.../clip.nfc", "sha256": "<sha256sum of the file>" }
+Devices fetch it on their next OTA check once their firmware is current.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = b"NFC1"
+HEADER = struct.Struct("<4sHHHHHH")
+FRAME = struct.Struct("<IHBB")
+MAX_FRAMES = 1024
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def encode_row(indices):
+    out = bytearray()
+    i = 0
+    n = len(indices)
+    while i < n:
+        run = 1
+        while i + run < n and run < 128 and indices[i + run] == indices[i]:
+            run += 1
+        if run >= 3:
+            out += bytes((0x80 | (run - 1), indices[i]))
+            i += run
+            continue
+        start = i
+        while i < n and i - start < 128:
+            if i + 2 < n and indices[i] == indices[i + 1] == indices[i + 2]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out += bytes(indices[start:i])
+    return bytes(out)
+
+
+def encode(frames, width, height, delays, loops):
+    """frames: lists of RGB565 values, row-major. Returns the clip bytes."""
+    palette = []
+    lookup = {}
+    indexed = []
+    for frame in frames:
+        row = []
+        for c in frame:
+            if c not in lookup:
+                if len(palette) == 256:
+                    raise ValueError("more than 256 colours after RGB565 reduction; quantize the input first")
+                lookup[c] = len(palette)
+                palette.append(c)
+            row.append(lookup[c])
+        indexed.append(row)
+    if len(palette) % 2:
+        palette.append(0)
+
+    table_offset = (HEADER.size + 2 * len(palette) + 3) & ~3
+    data_offset = table_offset + FRAME.size * len(frames)
+    body = bytearray()
+    table = []
+    previous = None
+    for n, frame in enumerate(indexed):
+        rows = [frame[y * width:(y + 1) * width] for y in range(height)]
+        changed = [y for y in range(height) if previous is None or rows[y] != previous[y]]
+        first, count = (changed[0], changed[-1] - changed[0] + 1) if changed else (0, 0)
+        table.append(FRAME.pack(data_offset + len(body), delays[n], first, count))
+        for y in range(first, first + count):
+            body += encode_row(rows[y])
+        previous = rows
+
+    out = bytearray(HEADER.pack(MAGIC, width, height, len(frames), len(palette), loops, 0))
+    out += struct.pack("<%dH" % len(palette), *palette)
+    out += b"\x00" * (table_offset - len(out))
+    out += b"".join(table) + body
+    return bytes(out)
+
+
+def decode(clip):
+    """Reference decoder mirroring decodeClipFrame. Yields (delay_ms, frame) with frames as RGB565 lists."""
+    magic, width, height, count, palette_size, loops, _ = HEADER.unpack_from(clip)
+    if magic != MAGIC:
+        raise ValueError("not an NFC1 clip")
+    palette = struct.unpack_from("<%dH" % palette_size, clip, HEADER.size)
+    table_offset = (HEADER.size + 2 * palette_size + 3) & ~3
+    canvas = [0] * (width * height)
+    for n in range(count):
+        offset, delay, first, rows = FRAME.unpack_from(clip, table_offset + n * FRAME.size)
+        p = offset
+        for y in range(first, first + rows):
+            x = 0
+            while x < width:
+                token = clip[p]
+                p += 1
+                run = (token & 0x7F) + 1
+                if x + run > width:
+                    raise ValueError("row overrun in frame %d" % n)
+                if token & 0x80:
+                    canvas[y * width + x:y * width + x + run] = [palette[clip[p]]] * run
+                    p += 1
+                else:
+                    canvas[y * width + x:y * width + x + run] = [palette[i] for i in clip[p:p + run]]
+                    p += run
+                x += run
+        yield delay, list(canvas)
+
+
+def load_frames(paths, width, height, delay):
+    try:
+        from PIL import Image, ImageSequence
+    except ImportError:
+        sys.exit("Reading images needs Pillow: pip install pillow")
+
+    delays = []
+    sources = []
+    if len(paths) == 1:
+        image = Image.open(paths[0])
+        for frame in ImageSequence.Iterator(image):
+            sources.append((frame.copy(), frame.info.get("duration", delay)))
+    else:
+        sources = [(Image.open(p), delay) for p in paths]
+
+    if len(sources) > MAX_FRAMES:
+        sys.exit("too many frames (%d > %d)" % (len(sources), MAX_FRAMES))
+
+    # Quantize every frame together so they share one palette of at most 256 colours
+    sheet = Image.new("RGB", (width, height * len(sources)))
+    for n, (image, ms) in enumerate(sources):
+        image = image.convert("RGB")
+        if image.size != (width, height):
+            image = image.resize((width, height))
+        sheet.paste(image, (0, n * height))
+        delays.append(max(0, min(int(ms), 0xFFFF)))
+    pixels = [rgb565(*px) for px in sheet.quantize(colors=256).convert("RGB").getdata()]
+    frames = [pixels[n * width * height:(n + 1) * width * height] for n in range(len(sources))]
+    return frames, delays
+
+
+def info(path):
+    clip = open(path, "rb").read()
+    magic, width, height, count, palette_size, loops, _ = HEADER.unpack_from(clip)
+    total = sum(d for d, _ in decode(clip))
+    print("%s: %dx%d, %d frames, %d colours, loops %s, %.1f s, %d bytes, sha256 %s" % (
+        path, width, height, count, palette_size, loops or "forever", total / 1000.0, len(clip),
+        hashlib.sha256(clip).hexdigest()))
+
+
+def selftest():
+    width, height = 64, 32
+    frames, delays = [], []
+    for n in range(24):
+        frame = []
+        for y in range(height):
+            for x in range(width):
+                if y < 8:
+                    frame.append(rgb565(0, 0, 64))                       # Static band: never re-encoded
+                elif abs(x - n * 2) < 4:
+                    frame.append(rgb565(255, 160, 0))                    # Moving bar: runs
+                else:
+                    frame.append(rgb565((x // 8) * 32, (y // 8) * 64, (n // 4) * 40))  # Gradient: literals
+        frames.append(frame)
+        delays.append(40)
+    clip = encode(frames, width, height, delays, 0)
+    decoded = [f for _, f in decode(clip)]
+    ok = decoded == frames
+    raw = width * height * 2 * len(frames)
+    print("selftest: %d frames, %d bytes (%.1f%% of raw RGB565) — %s" % (len(frames), len(clip), 100.0 * len(clip) / raw,
+                                                                        "ok" if ok else "FAIL"))
+    return 0 if ok else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="*")
+    parser.add_argument("-o", "--output")
+    parser.add_argument("--size", default="64x32")
+    parser.add_argument("--loops", type=int, default=0, help="0 = forever")
+    parser.add_argument("--delay", type=int, default=100, help="ms per frame for still images")
+    parser.add_argument("--info", metavar="CLIP")
+    parser.add_argument("--selftest", action="store_true")
+    args = parser.parse_args()
+
+    if args.selftest:
+        return selftest()
+    if args.info:
+        info(args.info)
+        return 0
+    if not args.inputs or not args.output:
+        parser.error("INPUT and -o are required")
+
+    width, height = (int(v) for v in args.size.lower().split("x"))
+    frames, delays = load_frames(args.inputs, width, height, args.delay)
+    clip = encode(frames, width, height, delays, args.loops)
+    with open(args.output, "wb") as f:
+        f.write(clip)
+    info(args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
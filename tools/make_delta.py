@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Builds a NovaFrame delta OTA patch ("NFP1") from two firmware images.
+
+Usage: make_delta.py OLD.bin NEW.bin OUT.patch
+
+The patch is a header (magic, new size, old size) followed by COPY ops that
+reference the running image on the device and INSERT ops carrying new bytes.
+The device applies it as a stream (see applyDeltaPatch in OTAUpdater.cpp).
+After writing, the patch is applied in memory and checked against NEW.bin.
+"""
+
+import hashlib
+import struct
+import sys
+
+MAGIC = b"NFP1"
+OP_END = 0x00
+OP_COPY = 0x01
+OP_INSERT = 0x02
+
+BLOCK = 32       # Minimum match length worth a COPY op
+INDEX_STEP = 4   # Index every 4th offset of the old image
+
+
+def build_index(old):
+    index = {}
+    for i in range(0, len(old) - BLOCK + 1, INDEX_STEP):
+        index.setdefault(old[i:i + BLOCK], i)
+    return index
+
+
+def match_length(old, q, new, p):
+    n = 0
+    limit = min(len(old) - q, len(new) - p)
+    while n + 256 <= limit and old[q + n:q + n + 256] == new[p + n:p + n + 256]:
+        n += 256
+    while n < limit and old[q + n] == new[p + n]:
+        n += 1
+    return n
+
+
+def diff(old, new):
+    index = build_index(old)
+    ops = []
+    literal_start = 0
+    p = 0
+    expected = None  # Where the next byte would sit in old if the last copy continued
+
+    while p + BLOCK <= len(new):
+        q = None
+        if expected is not None and expected + BLOCK <= len(old) and \
+                old[expected:expected + BLOCK] == new[p:p + BLOCK]:
+            q = expected
+        else:
+            q = index.get(new[p:p + BLOCK])
+
+        if q is None:
+            p += 1
+            if expected is not None:
+                expected += 1
+            continue
+
+        # Grow the match backwards into pending literal bytes
+        back = 0
+        while p - back > literal_start and q - back > 0 and old[q - back - 1] == new[p - back - 1]:
+            back += 1
+        p -= back
+        q -= back
+
+        length = match_length(old, q, new, p)
+        if p > literal_start:
+            ops.append((OP_INSERT, new[literal_start:p]))
+        ops.append((OP_COPY, q, length))
+        p += length
+        literal_start = p
+        expected = q + length
+
+    if literal_start < len(new):
+        ops.append((OP_INSERT, new[literal_start:]))
+    return ops
+
+
+def encode(ops, new_size, old_size):
+    out = bytearray(MAGIC)
+    out += struct.pack("<II", new_size, old_size)
+    for op in ops:
+        if op[0] == OP_COPY:
+            out += struct.pack("<BII", OP_COPY, op[1], op[2])
+        else:
+            out += struct.pack("<BI", OP_INSERT, len(op[1]))
+            out += op[1]
+    out.append(OP_END)
+    return bytes(out)
+
+
+def apply(old, patch):
+    if patch[:4] != MAGIC:
+        raise ValueError("bad magic")
+    new_size, old_size = struct.unpack_from("<II", patch, 4)
+    pos = 12
+    out = bytearray()
+    while True:
+        op = patch[pos]
+        pos += 1
+        if op == OP_END:
+            break
+        if op == OP_COPY:
+            offset, length = struct.unpack_from("<II", patch, pos)
+            pos += 8
+            if offset + length > old_size:
+                raise ValueError("copy out of range")
+            out += old[offset:offset + length]
+        elif op == OP_INSERT:
+            (length,) = struct.unpack_from("<I", patch, pos)
+            pos += 4
+            out += patch[pos:pos + length]
+            pos += length
+        else:
+            raise ValueError("unknown op 0x%02x" % op)
+    if len(out) != new_size:
+        raise ValueError("size mismatch")
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) != 4:
+        print(__doc__.strip().splitlines()[2])
+        return 1
+
+    old = open(sys.argv[1], "rb").read()
+    new = open(sys.argv[2], "rb").read()
+    patch = encode(diff(old, new), len(new), len(old))
+
+    if apply(old, patch) != new:
+        print("Patch does not reproduce NEW.bin", file=sys.stderr)
+        return 1
+
+    with open(sys.argv[3], "wb") as f:
+        f.write(patch)
+
+    saved = 100.0 * (1 - len(patch) / len(new))
+    print("Full image: %d bytes" % len(new))
+    print("Patch:      %d bytes (%.1f%% smaller)" % (len(patch), saved))
+    print("New sha256: %s" % hashlib.sha256(new).hexdigest())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
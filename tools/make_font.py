@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""Packs a BDF bitmap font into a NovaFrame PackedFont header.
+
+Usage: make_font.py FONT.bdf NAME OUT.h [--kern FILE] [--chars " 0123456789:"]
+
+Each glyph is stored row-aligned, one or more bytes per row, MSB first. The
+advance width comes from DWIDTH and the placement from BBX. The optional kern
+file has one "left right adjust" pair per line; '#' starts a comment. The
+glyph table is dense from the lowest to the highest included code point, and
+code points without a glyph get an empty entry.
+
+TTF/OTF sources are converted to BDF first, e.g. with otf2bdf or FontForge,
+at the pixel size the panel needs.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+def parse_bdf(path):
+    glyphs = {}
+    ascent = None
+    glyph = None
+    in_bitmap = False
+    with open(path) as f:
+        for raw in f:
+            line = raw.strip()
+            if not line:
+                continue
+            key, _, rest = line.partition(" ")
+            if key == "FONT_ASCENT":
+                ascent = int(rest)
+            elif key == "STARTCHAR":
+                glyph = {"rows": []}
+            elif key == "ENCODING" and glyph is not None:
+                glyph["code"] = int(rest.split()[0])
+            elif key == "DWIDTH" and glyph is not None:
+                glyph["advance"] = int(rest.split()[0])
+            elif key == "BBX" and glyph is not None:
+                glyph["w"], glyph["h"], glyph["xoff"], glyph["yoff"] = (int(v) for v in rest.split())
+            elif key == "BITMAP":
+                in_bitmap = True
+            elif key == "ENDCHAR":
+                if glyph.get("code", -1) >= 0:
+                    glyphs[glyph["code"]] = glyph
+                glyph = None
+                in_bitmap = False
+            elif in_bitmap:
+                glyph["rows"].append(line)
+    if ascent is None:
+        raise ValueError("BDF has no FONT_ASCENT")
+    return ascent, glyphs
+
+
+def parse_kern(path):
+    pairs = []
+    with open(path) as f:
+        for raw in f:
+            line = raw.split("#", 1)[0].strip()
+            if not line:
+                continue
+            left, right, adjust = line.split()
+            pairs.append((ord(left), ord(right), int(adjust)))
+    return pairs
+
+
+def pack_rows(glyph):
+    """Re-packs BDF hex rows to exactly ceil(w / 8) bytes per row."""
+    width_bytes = (glyph["w"] + 7) // 8
+    out = []
+    for row in glyph["rows"]:
+        value = int(row, 16)
+        bdf_bytes = len(row) // 2
+        value >>= 8 * (bdf_bytes - width_bytes)
+        out.extend(value.to_bytes(width_bytes, "big"))
+    return out
+
+
+def emit(name, ascent, glyphs, kerning, source):
+    first, last = min(glyphs), max(glyphs)
+    upper = re.sub(r"(?<!^)(?=[A-Z])", "_", name).upper()  # ClockFont → CLOCK_FONT
+    bitmap = []
+    table = []
+    for code in range(first, last + 1):
+        g = glyphs.get(code)
+        if g is None:
+            table.append((0, 0, 0, 0, 0, 0, "missing"))
+            continue
+        offset = len(bitmap)
+        bitmap.extend(pack_rows(g))
+        # Top of the glyph measured down from the top of the line
+        top = ascent - g["yoff"] - g["h"]
+        label = "' '" if code == 32 else repr(chr(code))
+        table.append((offset, g["w"], g["h"], g["xoff"], top, g["advance"], label))
+
+    if len(bitmap) > 0xFFFF:
+        raise ValueError("bitmap too large for 16-bit offsets")
+
+    lines = [
+        "// %s.h — generated by tools/make_font.py from %s; do not edit" % (name, source),
+        "#pragma once",
+        "",
+        '#include "PackedFont.h"',
+        "",
+        "static const uint8_t %s_BITMAP[] = {" % upper,
+    ]
+    for i in range(0, len(bitmap), 16):
+        lines.append("  " + ", ".join("0x%02X" % b for b in bitmap[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const PackedGlyph %s_GLYPHS[] = {" % upper)
+    lines.append("  // offset, width, height, xOffset, top, advance")
+    for offset, w, h, xoff, top, adv, label in table:
+        lines.append("  { %4d, %2d, %2d, %2d, %2d, %2d },  // %s" % (offset, w, h, xoff, top, adv, label))
+    lines.append("};")
+    lines.append("")
+    if kerning:
+        lines.append("static const KernPair %s_KERNING[] = {" % upper)
+        for left, right, adjust in kerning:
+            lines.append("  { '%s', '%s', %d }," % (chr(left), chr(right), adjust))
+        lines.append("};")
+        kern_ref, kern_count = "%s_KERNING" % upper, len(kerning)
+    else:
+        kern_ref, kern_count = "nullptr", 0
+    lines.append("")
+    lines.append("static const PackedFont %s = {" % upper)
+    lines.append("  %s_BITMAP, %s_GLYPHS, %s, %d, 0x%02X, 0x%02X, %d" % (
+        upper, upper, kern_ref, kern_count, first, last, ascent))
+    lines.append("};")
+    return "\n".join(lines) + "\n", len(bitmap)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("bdf")
+    parser.add_argument("name")
+    parser.add_argument("out")
+    parser.add_argument("--kern")
+    parser.add_argument("--chars", help="only pack these characters")
+    args = parser.parse_args()
+
+    ascent, glyphs = parse_bdf(args.bdf)
+    if args.chars:
+        glyphs = {c: g for c, g in glyphs.items() if chr(c) in args.chars}
+    if not glyphs:
+        print("No glyphs selected", file=sys.stderr)
+        return 1
+
+    kerning = parse_kern(args.kern) if args.kern else []
+    kerning = [k for k in kerning if k[0] in glyphs and k[1] in glyphs]
+
+    source = os.path.relpath(args.bdf, os.path.dirname(os.path.abspath(args.out)))
+    text, size = emit(args.name, ascent, glyphs, kerning, source.replace(os.sep, "/"))
+    with open(args.out, "w") as f:
+        f.write(text)
+    print("%d glyphs, %d bitmap bytes, %d kerning pairs → %s" % (len(glyphs), size, len(kerning), args.out))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+"""Streams frames to a NovaFrame over DDP or E1.31, and receives them on a host.
+
+Usage:
+  stream_send.py HOST [--protocol ddp|e131] [--fps 30] [--seconds 10] [--size 64x32]
+                      [--pattern plasma|bars] [--jitter MS] [--loss PCT]
+  stream_send.py --listen [--protocol ddp|e131] [--size 64x32] [--seconds 10]
+  stream_send.py --selftest
+
+HOST is the board's IP or novaframe-XXXX.local. The device shows the stream
+after three complete frames and returns to its app rotation two seconds after
+the last one.
+
+--jitter delays each frame by a random 0..MS, and --loss drops that share of
+packets, so the device's jitter buffer and drop/late counters can be exercised
+without a bad network.
+
+--listen decodes packets the same way the firmware does (StreamReceiver.cpp)
+and prints fps, incomplete frames and late packets. --selftest sends both
+protocols over loopback to a listener and checks every frame arrives intact.
+"""
+
+import argparse
+import math
+import random
+import socket
+import struct
+import sys
+import threading
+import time
+
+DDP_PORT = 4048
+E131_PORT = 5568
+DDP_MAX_PIXELS = 480                 # 1440 data bytes keeps each datagram under a 1500-byte MTU
+E131_PIXELS_PER_UNIVERSE = 170
+E131_FIRST_UNIVERSE = 1
+E131_ACN_ID = b"ASC-E1.17\x00\x00\x00"
+E131_CID = bytes(range(16))
+
+
+def ddp_packets(frame, first_packet):
+    """frame is bytes of RGB888; yields DDP datagrams, push flag on the last.
+
+    DDP numbers packets, not frames: 1..15, wrapping, 0 meaning unnumbered."""
+    step = DDP_MAX_PIXELS * 3
+    for i, offset in enumerate(range(0, len(frame), step)):
+        data = frame[offset:offset + step]
+        last = offset + step >= len(frame)
+        flags = 0x40 | (0x01 if last else 0)
+        sequence = (first_packet + i) % 15 + 1
+        header = struct.pack(">BBBBIH", flags, sequence, 0x0B, 1, offset, len(data))
+        yield header + data
+
+
+def e131_packet(universe, sequence, data):
+    channels = len(data)
+    dmp = struct.pack(">HBBHHH", 0x7000 | (10 + channels + 1), 0x02, 0xA1, 0, 1, channels + 1) + b"\x00" + data
+    name = b"NovaFrame stream".ljust(64, b"\x00")
+    framing = struct.pack(">HI", 0x7000 | (77 + len(dmp)), 0x00000002) + name + \
+        struct.pack(">BHBBH", 100, 0, sequence & 0xFF, 0, universe) + dmp
+    root = struct.pack(">HH", 0x0010, 0) + E131_ACN_ID + \
+        struct.pack(">HI", 0x7000 | (22 + len(framing)), 0x00000004) + E131_CID + framing
+    return root
+
+
+def e131_packets(frame, sequence):
+    step = E131_PIXELS_PER_UNIVERSE * 3
+    for i, offset in enumerate(range(0, len(frame), step)):
+        yield e131_packet(E131_FIRST_UNIVERSE + i, sequence, frame[offset:offset + step])
+
+
+def parse(packet, protocol, pixels):
+    """Returns (pixel offset, rgb bytes, sequence, frame end) or None — mirrors the firmware."""
+    if protocol == "ddp":
+        if len(packet) < 10 or packet[0] & 0xC0 != 0x40 or packet[0] & 0x02:
+            return None
+        header = 14 if packet[0] & 0x10 else 10
+        offset, length = struct.unpack(">IH", packet[4:10])
+        if len(packet) < header + length or offset % 3:
+            return None
+        return offset // 3, packet[header:header + length], packet[1] & 0x0F, bool(packet[0] & 0x01)
+
+    if len(packet) < 126 or packet[4:16] != E131_ACN_ID or packet[125] != 0:
+        return None
+    universe = struct.unpack(">H", packet[113:115])[0]
+    channels = struct.unpack(">H", packet[123:125])[0] - 1
+    last_universe = E131_FIRST_UNIVERSE + (pixels - 1) // E131_PIXELS_PER_UNIVERSE
+    offset = (universe - E131_FIRST_UNIVERSE) * E131_PIXELS_PER_UNIVERSE
+    return offset, packet[126:126 + channels], packet[111], universe == last_universe
+
+
+def pattern(name, width, height, t):
+    out = bytearray(width * height * 3)
+    for y in range(height):
+        for x in range(width):
+            i = (y * width + x) * 3
+            if name == "bars":
+                band = (x * 8 // width + int(t * 4)) % 8
+                out[i:i + 3] = bytes(((band & 1) * 255, (band >> 1 & 1) * 255, (band >> 2 & 1) * 255))
+            else:
+                v = math.sin(x / 6.0 + t) + math.sin(y / 4.0 - t) + math.sin((x + y) / 8.0 + t * 0.7)
+                out[i:i + 3] = bytes(int(127 + 127 * math.sin(v * math.pi / 3 + k * 2.1)) for k in range(3))
+    return bytes(out)
+
+
+def send(host, protocol, fps, seconds, width, height, pattern_name, jitter_ms, loss_pct, frames=None):
+    port = DDP_PORT if protocol == "ddp" else E131_PORT
+    packets_for = ddp_packets if protocol == "ddp" else e131_packets
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    addr = (socket.gethostbyname(host), port)
+
+    interval = 1.0 / fps
+    start = time.monotonic()
+    sent = packets = 0
+    total = len(frames) if frames else int(seconds * fps)
+    for n in range(total):
+        due = start + n * interval
+        time.sleep(max(0.0, due - time.monotonic()) + random.uniform(0, jitter_ms / 1000.0))
+        frame = frames[n] if frames else pattern(pattern_name, width, height, n * interval)
+        for packet in packets_for(frame, packets if protocol == "ddp" else n + 1):
+            packets += 1
+            if random.uniform(0, 100) >= loss_pct:
+                sock.sendto(packet, addr)
+        sent += 1
+    elapsed = time.monotonic() - start
+    print("sent %d frames in %.1f s (%.1f fps, %s)" % (sent, elapsed, sent / elapsed, protocol))
+
+
+def listen(protocol, width, height, seconds, received=None, ready=None):
+    pixels = width * height
+    port = DDP_PORT if protocol == "ddp" else E131_PORT
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(("", port))
+    sock.settimeout(0.5)
+    if ready:
+        ready.set()
+
+    frame = bytearray(pixels * 3)
+    filled = 0
+    frames = incomplete = late = 0
+    last_seq = {}
+    deadline = time.monotonic() + seconds
+    first = last = None
+    while time.monotonic() < deadline:
+        try:
+            packet, _ = sock.recvfrom(2048)
+        except socket.timeout:
+            continue
+        chunk = parse(packet, protocol, pixels)
+        if not chunk:
+            continue
+        offset, rgb, seq, end = chunk
+        key = 0 if protocol == "ddp" else offset
+        if seq and key in last_seq:
+            ahead = (seq - last_seq[key]) % (16 if protocol == "ddp" else 256)
+            if ahead == 0 or ahead > (8 if protocol == "ddp" else 236):
+                late += 1
+                continue
+        last_seq[key] = seq
+        count = min(len(rgb), max(0, (pixels - offset) * 3))
+        frame[offset * 3:offset * 3 + count] = rgb[:count]
+        filled += count // 3
+        if end:
+            last = time.monotonic()
+            first = first or last
+            frames += 1
+            if filled < pixels:
+                incomplete += 1
+            if received is not None:
+                received.append(bytes(frame))
+            filled = 0
+    fps = (frames - 1) / (last - first) if frames > 1 and last > first else 0.0
+    print("received %d frames (%.1f fps), incomplete %d, late %d (%s)" % (frames, fps, incomplete, late, protocol))
+    return frames, incomplete, late
+
+
+def selftest():
+    width, height = 64, 32
+    failures = 0
+    for protocol in ("ddp", "e131"):
+        frames = [pattern("plasma", width, height, n * 0.1) for n in range(20)]
+        received = []
+        ready = threading.Event()
+        listener = threading.Thread(target=listen, args=(protocol, width, height, 2.0, received, ready))
+        listener.start()
+        ready.wait()
+        send("127.0.0.1", protocol, 60, 0, width, height, "plasma", 0, 0, frames)
+        listener.join()
+        ok = received == frames
+        print("%s: %d/%d frames intact — %s" % (protocol, len(received), len(frames), "ok" if ok else "FAIL"))
+        failures += not ok
+    return 1 if failures else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("host", nargs="?")
+    parser.add_argument("--protocol", choices=["ddp", "e131"], default="ddp")
+    parser.add_argument("--fps", type=float, default=30)
+    parser.add_argument("--seconds", type=float, default=10)
+    parser.add_argument("--size", default="64x32")
+    parser.add_argument("--pattern", choices=["plasma", "bars"], default="plasma")
+    parser.add_argument("--jitter", type=float, default=0, help="max random delay per frame, ms")
+    parser.add_argument("--loss", type=float, default=0, help="percent of packets to drop")
+    parser.add_argument("--listen", action="store_true")
+    parser.add_argument("--selftest", action="store_true")
+    args = parser.parse_args()
+
+    if args.selftest:
+        return selftest()
+    width, height = (int(v) for v in args.size.lower().split("x"))
+    if args.listen:
+        listen(args.protocol, width, height, args.seconds)
+        return 0
+    if not args.host:
+        parser.error("HOST is required unless --listen or --selftest is given")
+    send(args.host, args.protocol, args.fps, args.seconds, width, height, args.pattern, args.jitter, args.loss)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())